@@ -6,7 +6,7 @@
 /// \brief Unified umbrella header for the LogIt++ library.
 ///
 /// Including this header provides a fully self-contained entry point that
-/// aggregates configuration, utilities, formatters, loggers and the logging
+/// aggregates configuration, utilities, formatters, loggers, readers and the logging
 /// façade. No additional includes are required to start using the library.
 
 #include "logit/config.hpp"
@@ -14,6 +14,7 @@
 #include "logit/utils.hpp"
 #include "logit/formatter.hpp"
 #include "logit/loggers.hpp"
+#include "logit/readers.hpp"
 #include "logit/Logger.hpp"
 #include "logit/log_macros.hpp"
 
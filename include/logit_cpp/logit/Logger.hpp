@@ -9,10 +9,12 @@
 #include "loggers/ILogger.hpp"
 #include "formatter.hpp"
 #include "detail/TaskExecutor.hpp"
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <atomic>
+#include <vector>
 
 namespace logit {
 
@@ -132,24 +134,31 @@ namespace logit {
         /// \brief Logs a LogRecord using added loggers and formatters.
         ///
         /// Formats the log message using each logger's corresponding formatter and sends
-        /// the formatted message to the logger.
+        /// the formatted message to the logger. Waits a logger defers, such as a durable
+        /// group commit, run after the lock is released so other threads keep logging.
         /// \param record Log record to be logged.
         void log(const LogRecord& record) {
             if (m_shutdown) return;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            // Log to the specific logger if the index is valid
-            if (record.logger_index >= 0 && record.logger_index < static_cast<int>(m_loggers.size())) {
-                const auto& strategy = m_loggers[record.logger_index];
-                if (!strategy.enabled) return;
-                if (static_cast<int>(record.log_level) < static_cast<int>(strategy.logger->get_log_level())) return;
-                strategy.logger->log(record, strategy.formatter->format(record));
-                return;
+            std::vector<std::function<void()>> completions;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                // Log to the specific logger if the index is valid
+                if (record.logger_index >= 0 && record.logger_index < static_cast<int>(m_loggers.size())) {
+                    const auto& strategy = m_loggers[record.logger_index];
+                    if (!strategy.enabled) return;
+                    if (static_cast<int>(record.log_level) < static_cast<int>(strategy.logger->get_log_level())) return;
+                    dispatch(strategy, record, completions);
+                } else {
+                    for (const auto& strategy : m_loggers) {
+                        if (strategy.single_mode) continue;
+                        if (!strategy.enabled) continue;
+                        if (static_cast<int>(record.log_level) < static_cast<int>(strategy.logger->get_log_level())) continue;
+                        dispatch(strategy, record, completions);
+                    }
+                }
             }
-            for (const auto& strategy : m_loggers) {
-                if (strategy.single_mode) continue;
-                if (!strategy.enabled) continue;
-                if (static_cast<int>(record.log_level) < static_cast<int>(strategy.logger->get_log_level())) continue;
-                strategy.logger->log(record, strategy.formatter->format(record));
+            for (const auto& completion : completions) {
+                completion();
             }
         }
 
@@ -198,7 +207,7 @@ namespace logit {
         /// \param args Arguments to be logged.
         /// \return Tuple containing logged arguments.
         template <typename... Ts>
-        auto log_and_return(const LogRecord& record, Ts&&... args) -> decltype(std::forward_as_tuple(std::forward<Ts>(args)...)) {
+        auto log_and_return(LogRecord record, Ts&&... args) -> decltype(std::forward_as_tuple(std::forward<Ts>(args)...)) {
             this->print(record, args...);
             return std::forward_as_tuple(std::forward<Ts>(args)...);
         }
@@ -211,7 +220,7 @@ namespace logit {
         /// \param args Argument to be logged.
         /// \return Logged argument.
         template <typename T>
-        auto log_and_return(const LogRecord& record, T&& args) -> decltype(args) {
+        auto log_and_return(LogRecord record, T&& args) -> decltype(args) {
             this->print(record, args);
             return std::forward<decltype(args)>(args);
         }
@@ -219,7 +228,7 @@ namespace logit {
         /// \brief Logs message without arguments and returns empty tuple.
         /// \param record Log record.
         /// \return Empty tuple.
-        auto log_and_return(const LogRecord& record) -> std::tuple<> {
+        auto log_and_return(LogRecord record) -> std::tuple<> {
             this->print(record);
             return {};
         }
@@ -257,9 +266,19 @@ namespace logit {
 
         std::vector<LoggerStrategy> m_loggers;        ///< Container for logger-formatter pairs.
         mutable std::mutex m_mutex;                   ///< Mutex for thread safety during logging operations.
+        std::string m_format_buffer;                  ///< Reused buffer for formatted messages, guarded by `m_mutex`.
         std::atomic<bool> m_shutdown = ATOMIC_VAR_INIT(false); ///< Flag indicating if shutdown was requested.
 
-        void print(const LogRecord& record) {
+        /// \brief Formats a record for one logger and collects the wait the logger defers.
+        void dispatch(const LoggerStrategy& strategy, const LogRecord& record,
+                      std::vector<std::function<void()>>& completions) {
+            m_format_buffer.clear();
+            strategy.formatter->format_to(record, m_format_buffer);
+            std::function<void()> completion = strategy.logger->log_deferred(record, m_format_buffer);
+            if (completion) completions.push_back(std::move(completion));
+        }
+
+        void print(LogRecord& record) {
             log(record);
         }
         
@@ -268,20 +287,16 @@ namespace logit {
 #	pragma warning(disable: 4127) // conditional expression is constant
 #endif
 
-        /// \brief Logs a record with given arguments.
+        /// \brief Fills the record arguments in place and logs it.
         /// \tparam Ts Types of arguments.
         /// \param record Log record.
         /// \param args Arguments to be logged.
         template <typename... Ts>
-        void print(const LogRecord& record, Ts const&... args) {
-            if (sizeof...(Ts) == 0) {
-                log(record);
-                return;
+        void print(LogRecord& record, Ts const&... args) {
+            if (sizeof...(Ts) != 0) {
+                fill_args_array(record.args_array, argument_names(record.arg_names), args...);
             }
-            LogRecord mutable_record = record;
-            auto var_names = split_arguments(mutable_record.arg_names);
-            mutable_record.args_array = args_to_array(var_names.begin(), args...);
-            log(mutable_record);
+            log(record);
         }
         
 #ifdef _MSC_VER
@@ -31,6 +31,13 @@
     #define LOGIT_TASK_EXECUTOR_BLOCK_WAIT_USEC 200
 #endif
 
+/// \brief Number of arguments a `LogRecord` stores without a heap allocation.
+///
+/// Records with more arguments move them to the heap.
+#ifndef LOGIT_ARGS_INLINE_CAPACITY
+    #define LOGIT_ARGS_INLINE_CAPACITY 8
+#endif
+
 /// \name Log Level Colors
 /// Default colors for each log level.
 /// \{
@@ -137,6 +144,18 @@
     #define LOGIT_FILE_LOGGER_MAX_ROTATED_FILES 0
 #endif
 
+/// \brief Defines the conventional file name of a zstd dictionary kept beside the logs.
+/// If `LOGIT_ZSTD_DICTIONARY_NAME` is not defined, it defaults to "logit.zdict".
+#ifndef LOGIT_ZSTD_DICTIONARY_NAME
+    #define LOGIT_ZSTD_DICTIONARY_NAME "logit.zdict"
+#endif
+
+/// \brief Defines the file name of the state shared by processes writing one log directory.
+/// If `LOGIT_SHARED_STATE_NAME` is not defined, it defaults to "logit.shared".
+#ifndef LOGIT_SHARED_STATE_NAME
+    #define LOGIT_SHARED_STATE_NAME "logit.shared"
+#endif
+
 /// \brief Defines the default log pattern for unique file-based loggers.
 /// If `LOGIT_UNIQUE_FILE_LOGGER_PATTERN` is not defined, it defaults to "%v".
 #ifndef LOGIT_UNIQUE_FILE_LOGGER_PATTERN
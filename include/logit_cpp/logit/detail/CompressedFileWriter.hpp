@@ -0,0 +1,521 @@
+#pragma once
+#ifndef _LOGIT_COMPRESSED_FILE_WRITER_HPP_INCLUDED
+#define _LOGIT_COMPRESSED_FILE_WRITER_HPP_INCLUDED
+
+/// \file CompressedFileWriter.hpp
+/// \brief File writer that compresses data with gzip or zstd while it is written.
+
+#include "IFileWriter.hpp"
+#include "CompressionWorker.hpp"
+#include "ZstdDictionary.hpp"
+#include "ZstdSeekTable.hpp"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(LOGIT_HAS_ZLIB)
+#   include <zlib.h>
+#endif
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#endif
+
+namespace logit { namespace detail {
+
+    /// \class CompressedFileWriter
+    /// \brief Compresses data into another file writer.
+    ///
+    /// `flush()` emits everything written so far as a decodable block (`Z_SYNC_FLUSH` or
+    /// `ZSTD_e_flush`), so a streaming decoder can read the live file up to the last flush.
+    /// A frame (gzip member or zstd frame) is closed every `frame_bytes` of input and on
+    /// `close()`; files are sequences of complete frames once closed, and reopening a file
+    /// appends new frames. A frame torn by a crash is cut off on open and its decodable
+    /// content is written again as a complete frame, so new frames never follow a partial
+    /// one. Zero bytes after the last frame (the preallocated tail of a memory-mapped
+    /// file) are cut off as well. Frame counters and sizes are reported by the underlying writer.
+    /// With a `ZstdDictionary`, every zstd frame is compressed against the dictionary.
+    ///
+    /// With `seek_table` (zstd only) frames end at record boundaries, after `frame_bytes` of
+    /// input or once their first record is `frame_interval_ms` old, and `close()` appends a
+    /// seek table (see ZstdSeekTable.hpp) that maps first timestamps to frames. Reopening the
+    /// file removes the table and extends it; data left without a table by a crash becomes
+    /// one entry with an unknown start time.
+    class CompressedFileWriter : public IFileWriter {
+    public:
+        /// \brief Returns true if the library was built with support for the algorithm.
+        static bool is_supported(CompressType type) {
+#           if defined(LOGIT_HAS_ZLIB)
+            if (type == CompressType::GZIP) return true;
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            if (type == CompressType::ZSTD) return true;
+#           endif
+            (void)type;
+            return false;
+        }
+
+        /// \brief Returns the file name suffix of the algorithm.
+        static const char* extension(CompressType type) {
+            return type == CompressType::ZSTD ? ".zst" : ".gz";
+        }
+
+        /// \brief Constructor.
+        /// \param sink Writer receiving the compressed bytes.
+        /// \param type `CompressType::GZIP` or `CompressType::ZSTD`.
+        /// \param level Compression level.
+        /// \param frame_bytes Input bytes after which the current frame is closed (0 = on close only).
+        /// \param frame_interval_ms Age of the first record that closes a frame with a seek table (0 = off).
+        /// \param seek_table Align frames with records and append a seek table; ignored for gzip.
+        /// \param dictionary Dictionary for zstd frames (optional); ignored for gzip.
+        CompressedFileWriter(std::unique_ptr<IFileWriter> sink, CompressType type, int level, uint64_t frame_bytes,
+                             uint32_t frame_interval_ms = 0, bool seek_table = false,
+                             std::shared_ptr<const ZstdDictionary> dictionary = nullptr)
+            : m_sink(std::move(sink)), m_dictionary(std::move(dictionary)), m_type(type), m_frame_bytes(frame_bytes),
+              m_frame_interval_ms(frame_interval_ms),
+              m_seek_table(seek_table && type == CompressType::ZSTD), m_out(64 * 1024) {
+            if (!is_supported(type)) {
+                throw std::invalid_argument("Streaming compression is not available for this type");
+            }
+#           if defined(LOGIT_HAS_ZLIB)
+            if (m_type == CompressType::GZIP) {
+                m_zs = z_stream();
+                // 15 window bits plus 16 selects the gzip wrapper.
+                if (deflateInit2(&m_zs, clamp_level(level, 1, 9), Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                    throw std::runtime_error("Failed to initialize gzip stream");
+                }
+            }
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            if (m_type == CompressType::ZSTD) {
+                m_cctx = ZSTD_createCCtx();
+                if (!m_cctx) throw std::runtime_error("Failed to initialize zstd stream");
+                ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, clamp_level(level, 1, 19));
+                ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_checksumFlag, 1);
+                if (m_dictionary && !m_dictionary->attach(m_cctx)) {
+                    ZSTD_freeCCtx(m_cctx);
+                    throw std::runtime_error("Failed to attach zstd dictionary");
+                }
+            }
+#           endif
+        }
+
+        CompressedFileWriter(const CompressedFileWriter&) = delete;
+        CompressedFileWriter& operator=(const CompressedFileWriter&) = delete;
+
+        /// \brief Closes the current frame and releases the compressor.
+        ~CompressedFileWriter() override {
+            try {
+                close();
+            } catch (...) {}
+#           if defined(LOGIT_HAS_ZLIB)
+            if (m_type == CompressType::GZIP) deflateEnd(&m_zs);
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            if (m_cctx) ZSTD_freeCCtx(m_cctx);
+#           endif
+        }
+
+        /// \brief Opens the file and starts a new frame.
+        ///
+        /// Existing frames are decoded to find the end of the last complete one, so
+        /// reopening a large gzip file takes one decompression pass.
+        bool open(const std::string& path, size_t buffer_size) override {
+            close();
+            if (m_seek_table) load_seek_table(path);
+            uint64_t frames_size = 0;
+            std::string torn;
+            if (!cut_torn_frame(path, frames_size, torn)) return false;
+            if (m_seek_table && m_table_valid && m_entries.empty() && frames_size > 0) {
+                // Frames written before a crash; their start time is unknown.
+                add_entry(0, frames_size, 0);
+            }
+            if (!m_sink->open(path, buffer_size)) return false;
+            reset_stream();
+            m_content_in = 0;
+            m_content_base = 0;
+            m_content_known = m_sink->file_size() == 0;
+            if (!m_content_known && m_seek_table && m_table_valid && !m_entries.empty()) {
+                // Frames written before a crash have an unknown size.
+                m_content_known = true;
+                for (const auto& entry : m_entries) {
+                    if (entry.decompressed_size == 0) m_content_known = false;
+                    m_content_base += entry.decompressed_size;
+                }
+            }
+            if (!torn.empty()) restore_frame(torn);
+            return true;
+        }
+
+        bool is_open() const override { return m_sink->is_open(); }
+
+        /// \brief Returns true if no data waits in the compressor or the underlying writer.
+        bool empty() const override { return m_pending == 0 && m_sink->empty(); }
+
+        /// \brief Returns the compressed size of the file.
+        uint64_t file_size() const override { return m_sink->file_size(); }
+
+        /// \brief Returns the uncompressed size of the file; known for new files and for files
+        /// with a complete seek table.
+        bool content_size(uint64_t& size) const override {
+            size = m_content_base + m_content_in;
+            return m_content_known;
+        }
+
+        /// \brief Closes the current frame when it is full before a record starts a new one.
+        void begin_record(int64_t timestamp_ms) override {
+            if (!m_seek_table || !is_open()) return;
+            if (m_frame_in > 0 &&
+                ((m_frame_bytes > 0 && m_frame_in >= m_frame_bytes) ||
+                 (m_frame_interval_ms > 0 && timestamp_ms - m_frame_ts >= static_cast<int64_t>(m_frame_interval_ms)))) {
+                end_frame();
+            }
+            if (m_frame_in == 0) m_frame_ts = timestamp_ms;
+        }
+
+        void write(const char* data, size_t size) override {
+            append(data, size);
+        }
+
+        void write_line(const char* data, size_t size) override {
+            static const char line_break = '\n';
+            append(data, size);
+            append(&line_break, 1);
+        }
+
+        /// \brief Emits pending input as a decodable block and flushes the underlying writer.
+        void flush() override {
+            if (!is_open()) return;
+            if (m_pending > 0) {
+                compress(nullptr, 0, Directive::Flush);
+                m_pending = 0;
+            }
+            m_sink->flush();
+        }
+
+        void drain() override {
+            flush();
+            m_sink->drain();
+        }
+
+        void sync() override {
+            flush();
+            m_sink->sync();
+        }
+
+        int duplicate() const override { return m_sink->duplicate(); }
+
+        /// \brief Closes the current frame, appends the seek table and closes the file.
+        void close() override {
+            if (!is_open()) return;
+            try {
+                if (m_frame_in > 0) end_frame();
+                if (m_seek_table && m_table_valid && !m_entries.empty()) {
+                    const std::string table = encode_seek_table(m_entries);
+                    m_sink->write(table.data(), table.size());
+                }
+            } catch (...) {
+                m_entries.clear();
+                m_sink->close();
+                throw;
+            }
+            m_entries.clear();
+            m_sink->close();
+        }
+
+        FileWriteStats stats() const override { return m_sink->stats(); }
+
+    private:
+        enum class Directive { Continue, Flush, End };
+
+        std::unique_ptr<IFileWriter> m_sink; ///< Writer receiving the compressed bytes.
+        std::shared_ptr<const ZstdDictionary> m_dictionary; ///< Dictionary referenced by the zstd context.
+        CompressType m_type;                  ///< Compression algorithm.
+        uint64_t m_frame_bytes;               ///< Input size that closes a frame.
+        uint32_t m_frame_interval_ms;         ///< Record age that closes a frame.
+        bool     m_seek_table;                ///< Frames are indexed by a seek table.
+        bool     m_table_valid = true;        ///< Every frame of the file has an entry.
+        uint64_t m_frame_in = 0;              ///< Input bytes in the current frame.
+        uint64_t m_frame_out = 0;             ///< Compressed bytes of the current frame.
+        uint64_t m_pending  = 0;              ///< Input bytes since the last flush.
+        uint64_t m_content_base = 0;          ///< Uncompressed size of the file when opened.
+        uint64_t m_content_in = 0;            ///< Input bytes since the file was opened.
+        bool     m_content_known = true;      ///< `m_content_base` is exact.
+        int64_t  m_frame_ts = 0;              ///< Timestamp of the first record in the frame.
+        std::vector<SeekTableEntry> m_entries;///< Seek table of the open file.
+        std::vector<char> m_out;              ///< Output chunk handed to the sink.
+#       if defined(LOGIT_HAS_ZLIB)
+        z_stream m_zs;                        ///< Deflate state for gzip.
+#       endif
+#       if defined(LOGIT_HAS_ZSTD)
+        ZSTD_CCtx* m_cctx = nullptr;          ///< Compression context for zstd.
+#       endif
+
+        void append(const char* data, size_t size) {
+            if (!is_open() || size == 0) return;
+            compress(data, size, Directive::Continue);
+            m_frame_in += size;
+            m_content_in += size;
+            m_pending += size;
+            if (!m_seek_table && m_frame_bytes > 0 && m_frame_in >= m_frame_bytes) end_frame();
+        }
+
+        void end_frame() {
+            compress(nullptr, 0, Directive::End);
+            if (m_seek_table) add_entry(m_frame_ts, m_frame_out, m_frame_in);
+            m_frame_in = 0;
+            m_frame_out = 0;
+            m_pending = 0;
+#           if defined(LOGIT_HAS_ZLIB)
+            if (m_type == CompressType::GZIP) deflateReset(&m_zs);
+#           endif
+        }
+
+        /// \brief Appends a table entry; frames too large for the table disable it.
+        void add_entry(int64_t first_ts_ms, uint64_t compressed, uint64_t decompressed) {
+            if (compressed > UINT32_MAX || decompressed > UINT32_MAX) {
+                m_table_valid = false;
+                return;
+            }
+            SeekTableEntry entry;
+            entry.first_ts_ms = first_ts_ms;
+            entry.compressed_size = static_cast<uint32_t>(compressed);
+            entry.decompressed_size = static_cast<uint32_t>(decompressed);
+            m_entries.push_back(entry);
+        }
+
+        /// \brief Takes over the seek table of an existing file and removes it from the file.
+        void load_seek_table(const std::string& path) {
+            m_entries.clear();
+            m_table_valid = true;
+            uint64_t file_size = 0;
+            const uint64_t table_size = read_seek_table(path, m_entries, file_size);
+            if (table_size > 0 && !truncate_file(path, file_size - table_size)) {
+                m_entries.clear();
+                m_table_valid = false;
+            }
+        }
+
+        /// \class FrameDecoder
+        /// \brief Decodes the frames of an existing file one at a time.
+        class FrameDecoder {
+        public:
+            FrameDecoder(CompressType type, const ZstdDictionary* dictionary)
+                : m_type(type), m_buffer(64 * 1024) {
+#               if defined(LOGIT_HAS_ZLIB)
+                if (m_type == CompressType::GZIP) {
+                    m_zs = z_stream();
+                    if (inflateInit2(&m_zs, 15 + 16) != Z_OK) throw std::runtime_error("Failed to initialize gzip decoder");
+                }
+#               endif
+#               if defined(LOGIT_HAS_ZSTD)
+                if (m_type == CompressType::ZSTD) {
+                    m_dctx = ZSTD_createDCtx();
+                    if (!m_dctx) throw std::runtime_error("Failed to initialize zstd decoder");
+                    if (dictionary && !dictionary->attach(m_dctx)) {
+                        ZSTD_freeDCtx(m_dctx);
+                        throw std::runtime_error("Failed to attach zstd dictionary");
+                    }
+                }
+#               endif
+                (void)dictionary;
+            }
+
+            FrameDecoder(const FrameDecoder&) = delete;
+            FrameDecoder& operator=(const FrameDecoder&) = delete;
+
+            ~FrameDecoder() {
+#               if defined(LOGIT_HAS_ZLIB)
+                if (m_type == CompressType::GZIP) inflateEnd(&m_zs);
+#               endif
+#               if defined(LOGIT_HAS_ZSTD)
+                if (m_dctx) ZSTD_freeDCtx(m_dctx);
+#               endif
+            }
+
+            /// \brief Decodes input up to the end of the current frame.
+            /// \param used Receives the number of bytes consumed.
+            /// \param frame_end Receives true if a frame ends after the consumed bytes.
+            /// \param out Receives the decoded content (optional).
+            /// \return False if the input is not a valid continuation of the frame.
+            bool decode(const char* data, size_t size, size_t& used, bool& frame_end, std::string* out) {
+                used = 0;
+                frame_end = false;
+#               if defined(LOGIT_HAS_ZLIB)
+                if (m_type == CompressType::GZIP) {
+                    m_zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+                    m_zs.avail_in = static_cast<uInt>(size);
+                    int res = Z_OK;
+                    for (;;) {
+                        m_zs.next_out = reinterpret_cast<Bytef*>(&m_buffer[0]);
+                        m_zs.avail_out = static_cast<uInt>(m_buffer.size());
+                        res = inflate(&m_zs, Z_NO_FLUSH);
+                        if (out) out->append(&m_buffer[0], m_buffer.size() - m_zs.avail_out);
+                        if (res != Z_OK || (m_zs.avail_in == 0 && m_zs.avail_out != 0)) break;
+                    }
+                    used = size - m_zs.avail_in;
+                    if (res == Z_STREAM_END) {
+                        frame_end = true;
+                        inflateReset(&m_zs);
+                        return true;
+                    }
+                    return res == Z_OK || res == Z_BUF_ERROR;
+                }
+#               endif
+#               if defined(LOGIT_HAS_ZSTD)
+                if (m_type == CompressType::ZSTD) {
+                    ZSTD_inBuffer in = { data, size, 0 };
+                    for (;;) {
+                        ZSTD_outBuffer output = { &m_buffer[0], m_buffer.size(), 0 };
+                        const size_t res = ZSTD_decompressStream(m_dctx, &output, &in);
+                        if (ZSTD_isError(res)) {
+                            used = in.pos;
+                            return false;
+                        }
+                        if (out) out->append(&m_buffer[0], output.pos);
+                        if (res == 0) {
+                            frame_end = true;
+                            break;
+                        }
+                        if (in.pos == in.size && output.pos < output.size) break;
+                    }
+                    used = in.pos;
+                    return true;
+                }
+#               endif
+                (void)data; (void)size; (void)out;
+                return false;
+            }
+
+        private:
+            CompressType m_type;        ///< Compression algorithm.
+            std::vector<char> m_buffer; ///< Output chunk.
+#           if defined(LOGIT_HAS_ZLIB)
+            z_stream m_zs;              ///< Inflate state for gzip.
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            ZSTD_DCtx* m_dctx = nullptr; ///< Decompression context for zstd.
+#           endif
+        }; // class FrameDecoder
+
+        /// \brief Cuts everything after the last complete frame of an existing file.
+        /// \param path File path (UTF-8).
+        /// \param size Receives the size of the complete frames, which is the new file size.
+        /// \param torn Receives the bytes of a partial last frame, without trailing zero bytes.
+        /// \return False if the file could not be truncated.
+        bool cut_torn_frame(const std::string& path, uint64_t& size, std::string& torn) const {
+            size = 0;
+            torn.clear();
+#           if defined(_WIN32)
+            std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary);
+#           else
+            std::ifstream file(path.c_str(), std::ios::binary);
+#           endif
+            if (!file) return true;
+            FrameDecoder decoder(m_type, m_dictionary.get());
+            std::vector<char> chunk(64 * 1024);
+            uint64_t offset = 0;
+            uint64_t complete = 0;
+            bool valid = true;
+            while (valid && file) {
+                file.read(&chunk[0], static_cast<std::streamsize>(chunk.size()));
+                const size_t count = static_cast<size_t>(file.gcount());
+                size_t pos = 0;
+                while (valid && pos < count) {
+                    size_t used = 0;
+                    bool frame_end = false;
+                    valid = decoder.decode(&chunk[pos], count - pos, used, frame_end, nullptr);
+                    pos += used;
+                    if (frame_end) complete = offset + pos;
+                    if (valid && used == 0 && !frame_end) break;
+                }
+                offset += count;
+            }
+            file.clear();
+            file.seekg(0, std::ios::end);
+            const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+            size = complete;
+            if (complete == file_size) return true;
+            torn.resize(static_cast<size_t>(file_size - complete));
+            file.seekg(static_cast<std::streamoff>(complete));
+            if (!file.read(&torn[0], static_cast<std::streamsize>(torn.size()))) torn.clear();
+            // Zero bytes at the end are preallocated space, not compressed data.
+            const size_t last = torn.find_last_not_of('\0');
+            torn.resize(last == std::string::npos ? 0 : last + 1);
+            file.close();
+            return truncate_file(path, complete);
+        }
+
+        /// \brief Writes the decodable content of a torn frame as a complete frame.
+        void restore_frame(const std::string& torn) {
+            std::string content;
+            FrameDecoder decoder(m_type, m_dictionary.get());
+            size_t used = 0;
+            bool frame_end = false;
+            decoder.decode(torn.data(), torn.size(), used, frame_end, &content);
+            if (content.empty()) return;
+            // The records of the frame are older than any record written next.
+            m_frame_ts = 0;
+            append(content.data(), content.size());
+            if (m_frame_in > 0) end_frame();
+        }
+
+        /// \brief Drops any partial frame left by a failed write.
+        void reset_stream() {
+            m_frame_in = 0;
+            m_frame_out = 0;
+            m_pending = 0;
+#           if defined(LOGIT_HAS_ZLIB)
+            if (m_type == CompressType::GZIP) deflateReset(&m_zs);
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            if (m_type == CompressType::ZSTD) ZSTD_CCtx_reset(m_cctx, ZSTD_reset_session_only);
+#           endif
+        }
+
+        /// \brief Feeds input to the compressor and passes the output to the sink.
+        void compress(const char* data, size_t size, Directive directive) {
+#           if defined(LOGIT_HAS_ZLIB)
+            if (m_type == CompressType::GZIP) {
+                const int flush = directive == Directive::End ? Z_FINISH
+                    : (directive == Directive::Flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+                m_zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+                m_zs.avail_in = static_cast<uInt>(size);
+                for (;;) {
+                    m_zs.next_out = reinterpret_cast<Bytef*>(&m_out[0]);
+                    m_zs.avail_out = static_cast<uInt>(m_out.size());
+                    const int res = deflate(&m_zs, flush);
+                    if (res == Z_STREAM_ERROR) throw std::runtime_error("gzip stream error");
+                    const size_t produced = m_out.size() - m_zs.avail_out;
+                    if (produced > 0) m_sink->write(&m_out[0], produced);
+                    m_frame_out += produced;
+                    if (flush == Z_FINISH ? res == Z_STREAM_END : m_zs.avail_out != 0) break;
+                }
+                return;
+            }
+#           endif
+#           if defined(LOGIT_HAS_ZSTD)
+            if (m_type == CompressType::ZSTD) {
+                const ZSTD_EndDirective mode = directive == Directive::End ? ZSTD_e_end
+                    : (directive == Directive::Flush ? ZSTD_e_flush : ZSTD_e_continue);
+                ZSTD_inBuffer in = { data, size, 0 };
+                for (;;) {
+                    ZSTD_outBuffer out = { &m_out[0], m_out.size(), 0 };
+                    const size_t remaining = ZSTD_compressStream2(m_cctx, &out, &in, mode);
+                    if (ZSTD_isError(remaining)) throw std::runtime_error(ZSTD_getErrorName(remaining));
+                    if (out.pos > 0) m_sink->write(&m_out[0], out.pos);
+                    m_frame_out += out.pos;
+                    if (mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0) break;
+                }
+                return;
+            }
+#           endif
+            (void)data; (void)size; (void)directive;
+        }
+    }; // class CompressedFileWriter
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_COMPRESSED_FILE_WRITER_HPP_INCLUDED
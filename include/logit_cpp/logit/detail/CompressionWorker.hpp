@@ -5,6 +5,8 @@
 /// \file CompressionWorker.hpp
 /// \brief Background worker that compresses rotated log files.
 
+#include "ZstdDictionary.hpp"
+#include <memory>
 #include <string>
 #include <queue>
 #include <thread>
@@ -12,7 +14,18 @@
 #include <condition_variable>
 #include <fstream>
 #include <vector>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <sys/stat.h>
+#if defined(__linux__)
+#   include <sys/resource.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#elif defined(_WIN32)
+#   include <windows.h>
+#endif
 
 #if defined(LOGIT_HAS_ZLIB)
 #   include <zlib.h>
@@ -21,32 +34,70 @@
 #   include <zstd.h>
 #endif
 
-namespace logit { namespace detail {
+namespace logit {
+
+    /// \struct CompressionOptions
+    /// \brief Scheduling settings of the background compressor.
+    struct CompressionOptions {
+        unsigned threads = 1;          ///< Worker threads compressing files in parallel.
+        int      zstd_workers = 0;     ///< `ZSTD_c_nbWorkers` used for large files (0 = single-threaded).
+        uint64_t zstd_mt_min_bytes = 64ULL * 1024 * 1024; ///< Minimal file size compressed with zstd workers.
+        int      nice = 0;             ///< Niceness added to worker threads (per-thread on Linux; lower thread priority on Windows).
+    };
+
+    /// \struct CompressionStats
+    /// \brief Counters of the background compressor.
+    struct CompressionStats {
+        uint64_t queue_depth = 0; ///< Files waiting for or undergoing compression.
+        uint64_t files       = 0; ///< Files compressed successfully.
+        uint64_t failures    = 0; ///< Files that could not be compressed.
+        uint64_t bytes_in    = 0; ///< Size of the source files.
+        uint64_t bytes_out   = 0; ///< Size of the compressed files (0 for external commands).
+        uint64_t busy_us     = 0; ///< Time spent compressing, summed over workers.
+
+        /// \brief Average compression rate of one worker in source bytes per second.
+        double bytes_per_sec() const {
+            return busy_us ? static_cast<double>(bytes_in) * 1e6 / static_cast<double>(busy_us) : 0.0;
+        }
+    };
+
+namespace detail {
 
     /// \brief Compress a file using the specified compression type.
     /// \param type Compression algorithm to use.
     /// \param src Path to the source file.
     /// \param level Compression level.
     /// \param external_cmd Command template for CompressType::EXTERNAL_CMD.
+    /// \param zstd_workers Value of `ZSTD_c_nbWorkers` (0 = single-threaded).
+    /// \param dictionary Dictionary for zstd (optional).
     /// \return true on success.
     bool compress_file(CompressType type,
                        const std::string& src,
                        int level,
-                       const std::string& external_cmd);
+                       const std::string& external_cmd,
+                       int zstd_workers = 0,
+                       const ZstdDictionary* dictionary = nullptr);
 
     /// \class CompressionWorker
-    /// \brief Background worker performing asynchronous compression.
+    /// \brief Pool of background threads performing asynchronous compression.
+    ///
+    /// Queued files are taken by the first idle thread, so a burst of rotations is
+    /// compressed in parallel. Large zstd files may additionally use zstd's own workers.
     class CompressionWorker {
     public:
-        /// \brief Create worker thread.
+        /// \brief Create worker threads.
         /// \param type Compression algorithm.
         /// \param level Compression level.
         /// \param external_cmd External command template.
+        /// \param options Thread count, zstd workers and priority.
+        /// \param dictionary Dictionary for zstd (optional).
         CompressionWorker(CompressType type,
                            int level,
-                           std::string external_cmd);
+                           std::string external_cmd,
+                           const CompressionOptions& options = CompressionOptions(),
+                           std::shared_ptr<const ZstdDictionary> dictionary = nullptr);
 
-        /// \brief Stop worker thread and finish pending tasks.
+        /// \brief Stop worker threads and finish pending tasks.
         ~CompressionWorker();
 
         /// \brief Enqueue a file for compression.
@@ -56,22 +107,74 @@ namespace logit { namespace detail {
         /// \brief Wait until all queued files are processed.
         void wait();
 
+        /// \brief Returns a snapshot of the compressor counters.
+        CompressionStats stats() const;
+
     private:
         /// \brief Worker loop processing queued files.
         void run();
 
+        /// \brief Compresses one file and updates the counters.
+        void process(const std::string& src);
+
         CompressType m_type;
         int m_level;
         std::string m_external_cmd;
+        CompressionOptions m_options;
+        std::shared_ptr<const ZstdDictionary> m_dictionary;
         std::queue<std::string> m_q;
-        std::thread m_thread;
-        std::mutex m_mx;
+        std::vector<std::thread> m_threads;
+        mutable std::mutex m_mx;
         std::condition_variable m_cv;
         std::condition_variable m_cv_idle;
         bool m_stop = false;
-        bool m_busy = false;
+        unsigned m_active = 0;
+        CompressionStats m_stats;
     };
 
+    /// \brief Returns the size of a file, or 0 if it cannot be read.
+    inline uint64_t file_size_of(const std::string& path) {
+#       if defined(_WIN32)
+        struct _stat64 st;
+        return ::_stat64(path.c_str(), &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+#       else
+        struct stat st;
+        return ::stat(path.c_str(), &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+#       endif
+    }
+
+    /// \brief Returns the modification time of a file in milliseconds, or 0 if it cannot be read.
+    inline int64_t file_mtime_ms(const std::string& path) {
+#       if defined(_WIN32)
+        struct _stat64 st;
+        return ::_stat64(path.c_str(), &st) == 0 ? static_cast<int64_t>(st.st_mtime) * 1000 : 0;
+#       else
+        struct stat st;
+        return ::stat(path.c_str(), &st) == 0 ? static_cast<int64_t>(st.st_mtime) * 1000 : 0;
+#       endif
+    }
+
+    /// \brief Returns the zstd worker count for a file of the given size.
+    inline int zstd_workers_for(const CompressionOptions& options, uint64_t size) {
+        return size >= options.zstd_mt_min_bytes ? options.zstd_workers : 0;
+    }
+
+    /// \brief Lowers the scheduling priority of the calling thread.
+    /// \param nice Niceness to add; values <= 0 leave the priority unchanged.
+    inline void lower_thread_priority(int nice) {
+        if (nice <= 0) return;
+#       if defined(__linux__)
+        // Linux applies the niceness of a thread id to that thread only.
+        const id_t tid = static_cast<id_t>(::syscall(SYS_gettid));
+        errno = 0;
+        const int current = ::getpriority(PRIO_PROCESS, tid);
+        if (errno == 0) ::setpriority(PRIO_PROCESS, tid, current + nice);
+#       elif defined(_WIN32)
+        ::SetThreadPriority(::GetCurrentThread(),
+                            nice >= 10 ? THREAD_PRIORITY_LOWEST : THREAD_PRIORITY_BELOW_NORMAL);
+#       endif
+    }
+
     /// \brief Clamp value to inclusive range.
     /// \param v Input value.
     /// \param lo Lower bound.
@@ -120,10 +223,14 @@ namespace logit { namespace detail {
     /// \param src Source path.
     /// \param dst_tmp Temporary output path.
     /// \param level Compression level.
+    /// \param workers Value of `ZSTD_c_nbWorkers` (0 = single-threaded).
+    /// \param dictionary Dictionary shared by the files (optional).
     /// \return true on success.
     inline bool compress_file_zstd(const std::string& src,
                                    const std::string& dst_tmp,
-                                   int level) {
+                                   int level,
+                                   int workers = 0,
+                                   const ZstdDictionary* dictionary = nullptr) {
 #       if defined(LOGIT_HAS_ZSTD)
         std::ifstream in(src.c_str(), std::ios::binary);
         std::ofstream out(dst_tmp.c_str(), std::ios::binary | std::ios::trunc);
@@ -132,6 +239,9 @@ namespace logit { namespace detail {
         ZSTD_CCtx* cctx = ZSTD_createCCtx();
         if (!cctx) return false;
         ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, clamp_level(level, 1, 19));
+        // Libraries built without multithreading reject the parameter and stay single-threaded.
+        if (workers > 0) ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, workers);
+        if (dictionary && !dictionary->attach(cctx)) { ZSTD_freeCCtx(cctx); return false; }
 
         const size_t inChunk  = ZSTD_CStreamInSize();
         const size_t outChunk = ZSTD_CStreamOutSize();
@@ -160,7 +270,7 @@ namespace logit { namespace detail {
             }
         }
 #       else
-        (void)src; (void)dst_tmp; (void)level; return false;
+        (void)src; (void)dst_tmp; (void)level; (void)workers; (void)dictionary; return false;
 #       endif
     }
 
@@ -184,7 +294,9 @@ namespace logit { namespace detail {
     inline bool compress_file(CompressType type,
                               const std::string& src,
                               int level,
-                              const std::string& external_cmd) {
+                              const std::string& external_cmd,
+                              int zstd_workers,
+                              const ZstdDictionary* dictionary) {
         if (type == CompressType::NONE) return true;
         if (type == CompressType::EXTERNAL_CMD) {
             return compress_file_external(src, external_cmd, level);
@@ -193,7 +305,7 @@ namespace logit { namespace detail {
         std::string tmp = dst + ".tmp";
         bool ok = false;
         if (type == CompressType::GZIP) ok = compress_file_gzip(src, tmp, level);
-        else ok = compress_file_zstd(src, tmp, level);
+        else ok = compress_file_zstd(src, tmp, level, zstd_workers, dictionary);
         if (!ok) { std::remove(tmp.c_str()); return false; }
         if (std::rename(tmp.c_str(), dst.c_str()) != 0) { std::remove(tmp.c_str()); return false; }
         std::remove(src.c_str());
@@ -202,10 +314,16 @@ namespace logit { namespace detail {
 
     inline CompressionWorker::CompressionWorker(CompressType type,
                                                 int level,
-                                                std::string external_cmd)
-        : m_type(type), m_level(level), m_external_cmd(std::move(external_cmd)) {
+                                                std::string external_cmd,
+                                                const CompressionOptions& options,
+                                                std::shared_ptr<const ZstdDictionary> dictionary)
+        : m_type(type), m_level(level), m_external_cmd(std::move(external_cmd)), m_options(options),
+          m_dictionary(std::move(dictionary)) {
         if (m_type != CompressType::NONE) {
-            m_thread = std::thread(&CompressionWorker::run, this);
+            const unsigned count = m_options.threads > 0 ? m_options.threads : 1;
+            for (unsigned i = 0; i < count; ++i) {
+                m_threads.emplace_back(&CompressionWorker::run, this);
+            }
         }
     }
 
@@ -215,7 +333,9 @@ namespace logit { namespace detail {
             m_stop = true;
             m_cv.notify_all();
         }
-        if (m_thread.joinable()) m_thread.join();
+        for (auto& thread : m_threads) {
+            if (thread.joinable()) thread.join();
+        }
     }
 
     inline void CompressionWorker::enqueue(std::string path) {
@@ -226,10 +346,18 @@ namespace logit { namespace detail {
 
     inline void CompressionWorker::wait() {
         std::unique_lock<std::mutex> lk(m_mx);
-        m_cv_idle.wait(lk, [this]{ return m_q.empty() && !m_busy; });
+        m_cv_idle.wait(lk, [this]{ return m_q.empty() && m_active == 0; });
+    }
+
+    inline CompressionStats CompressionWorker::stats() const {
+        std::lock_guard<std::mutex> lk(m_mx);
+        CompressionStats stats = m_stats;
+        stats.queue_depth = m_q.size() + m_active;
+        return stats;
     }
 
     inline void CompressionWorker::run() {
+        lower_thread_priority(m_options.nice);
         for (;;) {
             std::string src;
             {
@@ -238,19 +366,41 @@ namespace logit { namespace detail {
                 if (m_stop && m_q.empty()) break;
                 src = std::move(m_q.front());
                 m_q.pop();
-                m_busy = true;
+                ++m_active;
             }
 
-            compress_file(m_type, src, m_level, m_external_cmd);
+            process(src);
 
             {
                 std::lock_guard<std::mutex> lk(m_mx);
-                m_busy = false;
-                if (m_q.empty()) m_cv_idle.notify_all();
+                --m_active;
+                if (m_q.empty() && m_active == 0) m_cv_idle.notify_all();
             }
         }
     }
 
+    inline void CompressionWorker::process(const std::string& src) {
+        const uint64_t size_in = file_size_of(src);
+        const int workers = m_type == CompressType::ZSTD ? zstd_workers_for(m_options, size_in) : 0;
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = compress_file(m_type, src, m_level, m_external_cmd, workers, m_dictionary.get());
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        uint64_t size_out = 0;
+        if (ok && (m_type == CompressType::GZIP || m_type == CompressType::ZSTD)) {
+            size_out = file_size_of(src + (m_type == CompressType::GZIP ? ".gz" : ".zst"));
+        }
+        std::lock_guard<std::mutex> lk(m_mx);
+        if (!ok) {
+            ++m_stats.failures;
+            return;
+        }
+        ++m_stats.files;
+        m_stats.bytes_in += size_in;
+        m_stats.bytes_out += size_out;
+        m_stats.busy_us += static_cast<uint64_t>(elapsed);
+    }
+
 }} // namespace logit::detail
 
 #endif // _LOGIT_COMPRESSION_WORKER_HPP_INCLUDED
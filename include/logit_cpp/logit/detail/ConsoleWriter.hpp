@@ -0,0 +1,381 @@
+#pragma once
+#ifndef _LOGIT_CONSOLE_WRITER_HPP_INCLUDED
+#define _LOGIT_CONSOLE_WRITER_HPP_INCLUDED
+
+/// \file ConsoleWriter.hpp
+/// \brief Buffered writer for the standard output and error descriptors.
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#   include <fcntl.h>
+#   include <poll.h>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace logit { namespace detail {
+
+    /// \class ConsoleWriter
+    /// \brief Collects lines for a descriptor such as 1 or 2 and writes them in large chunks.
+    ///
+    /// The descriptor is not owned. A line that does not fit into the buffer is written
+    /// after the buffered data without copying. The writer is not thread-safe; only the
+    /// counters may be read concurrently.
+    ///
+    /// In non-blocking mode (`set_non_blocking()`) a write never waits for the reader.
+    /// Bytes the descriptor does not take are kept in a pending buffer of bounded size
+    /// and sent before any new data once `poll` reports the descriptor writable. Whole
+    /// lines that do not fit are dropped and counted; the next data that reaches the
+    /// descriptor is preceded by a line with the number of dropped records.
+    class ConsoleWriter {
+    public:
+        typedef std::chrono::steady_clock clock;
+
+        ConsoleWriter() = default;
+        ConsoleWriter(const ConsoleWriter&) = delete;
+        ConsoleWriter& operator=(const ConsoleWriter&) = delete;
+
+        ~ConsoleWriter() {
+            close_own_fd();
+        }
+
+        /// \brief Attaches the writer to a descriptor in blocking mode.
+        /// \param fd Descriptor to write to.
+        /// \param buffer_size Capacity of the buffer.
+        void open(int fd, size_t buffer_size) {
+            close_own_fd();
+            m_fd = fd;
+            m_target = fd;
+            m_non_blocking = false;
+            m_socket = false;
+            m_pending.clear();
+            m_at_line_start = true;
+            m_dropping = false;
+            m_notice_at = SIZE_MAX;
+            m_buffer.clear();
+            m_buffer.reserve(buffer_size > 0 ? buffer_size : 4096);
+#           if defined(_WIN32)
+            m_tty = false;
+#           else
+            m_tty = ::isatty(fd) == 1;
+#           endif
+        }
+
+        /// \brief Detaches the writer, closing the descriptor it opened itself; unsent data is discarded.
+        void close() {
+            close_own_fd();
+            m_fd = -1;
+            m_target = -1;
+            m_non_blocking = false;
+            m_pending.clear();
+            m_dropping = false;
+            m_notice_at = SIZE_MAX;
+            m_buffer.clear();
+        }
+
+        /// \brief Stops waiting for the reader of the descriptor.
+        ///
+        /// Pipes and terminals are reopened through `/proc/self/fd` with `O_NONBLOCK` on
+        /// Linux, so other writers of the same descriptor keep blocking semantics; sockets
+        /// are written with `MSG_DONTWAIT`. Elsewhere `O_NONBLOCK` is set on the descriptor
+        /// itself. Regular files are left alone, since writing them never waits for a reader.
+        /// \param pending_limit Most bytes kept while the descriptor is not writable.
+        void set_non_blocking(size_t pending_limit) {
+#           if !defined(_WIN32)
+            m_pending_limit = pending_limit;
+            struct stat st;
+            if (::fstat(m_fd, &st) != 0 || S_ISREG(st.st_mode)) return;
+            m_non_blocking = true;
+            if (S_ISSOCK(st.st_mode)) {
+                m_socket = true;
+                return;
+            }
+#           if defined(__linux__)
+            if (S_ISFIFO(st.st_mode) || S_ISCHR(st.st_mode)) {
+                const std::string path = "/proc/self/fd/" + std::to_string(m_fd);
+                const int fd = ::open(path.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+                if (fd >= 0) {
+                    m_own_fd = fd;
+                    m_target = fd;
+                    return;
+                }
+            }
+#           endif
+            const int flags = ::fcntl(m_fd, F_GETFL);
+            if (flags < 0 || ::fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) != 0) m_non_blocking = false;
+#           else
+            (void)pending_limit;
+#           endif
+        }
+
+        /// \brief Waits up to `timeout_ms` for the reader to take the pending bytes, then drops the rest.
+        void drain_pending(uint32_t timeout_ms) {
+#           if !defined(_WIN32)
+            const clock::time_point deadline = clock::now() + std::chrono::milliseconds(timeout_ms);
+            if (m_non_blocking) report_drops();
+            while (!m_pending.empty()) {
+                const int64_t left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - clock::now()).count();
+                if (left <= 0) break;
+                struct pollfd pfd;
+                pfd.fd = m_target;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                const int res = ::poll(&pfd, 1, static_cast<int>(left));
+                if (res < 0 && errno != EINTR) break;
+                if (res > 0) send_pending();
+            }
+            if (!m_pending.empty()) {
+                // A notice that was never sent is folded back into the count.
+                size_t size = m_pending.size();
+                if (m_notice_at != SIZE_MAX) {
+                    m_unreported += m_notice_count;
+                    size = m_notice_at;
+                    m_notice_at = SIZE_MAX;
+                }
+                drop(m_pending.data(), size);
+                m_pending.clear();
+            }
+#           else
+            (void)timeout_ms;
+#           endif
+        }
+
+        /// \brief Returns true if the descriptor is a terminal.
+        bool is_tty() const { return m_tty; }
+
+        /// \brief Returns true if nothing is buffered.
+        bool empty() const { return m_buffer.empty(); }
+
+        /// \brief Returns when the oldest buffered byte was added.
+        clock::time_point oldest() const { return m_oldest; }
+
+        /// \brief Buffers a line, writing out the buffer first if the line does not fit.
+        void write_line(const char* data, size_t size) {
+            append(data, size, true);
+        }
+
+        /// \brief Buffers bytes without a line break.
+        void write(const char* data, size_t size) {
+            append(data, size, false);
+        }
+
+        /// \brief Writes out the buffered data.
+        void flush() {
+            if (m_buffer.empty()) return;
+            send(m_buffer.data(), m_buffer.size());
+            m_buffer.clear();
+            m_flush_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint64_t flush_count() const { return m_flush_count.load(std::memory_order_relaxed); } ///< Buffers written out.
+        uint64_t write_calls() const { return m_write_calls.load(std::memory_order_relaxed); } ///< Write system calls.
+        uint64_t bytes_written() const { return m_bytes_written.load(std::memory_order_relaxed); } ///< Bytes written.
+        uint64_t dropped_records() const { return m_dropped_records.load(std::memory_order_relaxed); } ///< Records dropped in non-blocking mode.
+        size_t pending_bytes() const { return m_pending.size(); } ///< Bytes waiting for a stalled reader.
+
+    private:
+        int               m_fd = -1;          ///< Descriptor given to `open()`.
+        int               m_target = -1;      ///< Descriptor written to; `m_own_fd` if it was reopened.
+        int               m_own_fd = -1;      ///< Non-blocking descriptor opened by the writer.
+        bool              m_tty = false;      ///< The descriptor is a terminal.
+        bool              m_non_blocking = false; ///< Writes never wait for the reader.
+        bool              m_socket = false;   ///< The descriptor is a socket written with `MSG_DONTWAIT`.
+        bool              m_at_line_start = true; ///< The last byte sent or kept ends a line.
+        bool              m_dropping = false; ///< A line was dropped before its end; the rest goes too.
+        size_t            m_notice_at = SIZE_MAX; ///< Offset of a notice that ends `m_pending`.
+        uint64_t          m_notice_count = 0; ///< Records announced by that notice.
+        size_t            m_pending_limit = 0; ///< Capacity of `m_pending`.
+        std::vector<char> m_pending;          ///< Bytes a stalled reader has not taken yet.
+        uint64_t          m_unreported = 0;   ///< Dropped records not yet announced in the output.
+        std::vector<char> m_buffer;           ///< Pending lines; its capacity is the buffer size.
+        clock::time_point m_oldest;           ///< When the first pending byte was added.
+        std::atomic<uint64_t> m_flush_count = ATOMIC_VAR_INIT(0);
+        std::atomic<uint64_t> m_write_calls = ATOMIC_VAR_INIT(0);
+        std::atomic<uint64_t> m_bytes_written = ATOMIC_VAR_INIT(0);
+        std::atomic<uint64_t> m_dropped_records = ATOMIC_VAR_INIT(0);
+
+        void close_own_fd() {
+#           if !defined(_WIN32)
+            if (m_own_fd >= 0) ::close(m_own_fd);
+#           endif
+            m_own_fd = -1;
+        }
+
+        /// \brief Buffers bytes and an optional line break; oversized data bypasses the buffer.
+        void append(const char* data, size_t size, bool newline) {
+            const size_t total = size + (newline ? 1 : 0);
+            if (m_buffer.size() + total > m_buffer.capacity()) {
+                flush();
+                if (total > m_buffer.capacity()) {
+                    send(data, size);
+                    if (newline) send("\n", 1);
+                    return;
+                }
+            }
+            if (m_buffer.empty()) m_oldest = clock::now();
+            m_buffer.insert(m_buffer.end(), data, data + size);
+            if (newline) m_buffer.push_back('\n');
+        }
+
+        /// \brief Sends bytes in the order they were produced, in either mode.
+        void send(const char* data, size_t size) {
+            if (!m_non_blocking) {
+                write_all(data, size);
+                return;
+            }
+            if (m_dropping) {
+                const char* end = static_cast<const char*>(std::memchr(data, '\n', size));
+                const size_t rest = end ? static_cast<size_t>(end - data) + 1 : size;
+                drop(data, rest);
+                data += rest;
+                size -= rest;
+                if (size == 0) return;
+            }
+            report_drops();
+            if (!m_pending.empty()) send_pending();
+            size_t written = 0;
+            if (m_pending.empty()) {
+                written = write_some(data, size);
+                if (written > 0) m_at_line_start = data[written - 1] == '\n';
+            }
+            if (written < size) keep(data + written, size - written);
+        }
+
+        /// \brief Sends as much pending data as the descriptor takes.
+        void send_pending() {
+            const size_t written = write_some(m_pending.data(), m_pending.size());
+            m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(written));
+            if (m_notice_at != SIZE_MAX) m_notice_at = written > m_notice_at ? SIZE_MAX : m_notice_at - written;
+        }
+
+        /// \brief Queues a line with the number of records dropped since the last notice.
+        ///
+        /// The notice marks the gap, ahead of any newer record. While it is still the
+        /// last pending line, further drops update it instead of adding another one.
+        void report_drops() {
+            if (m_unreported == 0) return;
+            if (m_notice_at != SIZE_MAX) {
+                m_unreported += m_notice_count;
+                m_pending.resize(m_notice_at);
+            } else if (!m_at_line_start) {
+                m_pending.push_back('\n');
+            }
+            const std::string notice = "[logit] dropped " + std::to_string(m_unreported) + " console records\n";
+            m_notice_at = m_pending.size();
+            m_notice_count = m_unreported;
+            m_unreported = 0;
+            m_pending.insert(m_pending.end(), notice.begin(), notice.end());
+            m_at_line_start = true;
+        }
+
+        /// \brief Keeps unsent bytes, dropping whole lines beyond `m_pending_limit`.
+        ///
+        /// A line already partly sent or kept is always completed so the output never
+        /// holds a torn record.
+        void keep(const char* data, size_t size) {
+            if (m_pending.size() + size > m_pending_limit) {
+                size_t fit = 0;
+                const bool line_open = m_pending.empty() ? !m_at_line_start : m_pending.back() != '\n';
+                if (line_open) {
+                    const char* end = static_cast<const char*>(std::memchr(data, '\n', size));
+                    fit = end ? static_cast<size_t>(end - data) + 1 : size;
+                }
+                // Keep whole lines after it while they fit.
+                while (fit < size) {
+                    const char* end = static_cast<const char*>(std::memchr(data + fit, '\n', size - fit));
+                    const size_t next = end ? static_cast<size_t>(end - data) + 1 : size;
+                    if (m_pending.size() + next > m_pending_limit) break;
+                    fit = next;
+                }
+                drop(data + fit, size - fit);
+                size = fit;
+            }
+            m_pending.insert(m_pending.end(), data, data + size);
+            if (size > 0) {
+                m_at_line_start = data[size - 1] == '\n';
+                m_notice_at = SIZE_MAX;
+            }
+        }
+
+        /// \brief Counts the records in bytes that are discarded.
+        ///
+        /// A record is counted at its first dropped byte, so one split across calls counts once.
+        void drop(const char* data, size_t size) {
+            uint64_t records = 0;
+            for (size_t i = 0; i < size; ++i) {
+                if (!m_dropping) {
+                    ++records;
+                    m_dropping = true;
+                }
+                if (data[i] == '\n') m_dropping = false;
+            }
+            m_dropped_records.fetch_add(records, std::memory_order_relaxed);
+            m_unreported += records;
+        }
+
+        /// \brief Writes until the descriptor would block; returns the bytes taken.
+        ///
+        /// Bytes that cannot be written because of an error count as taken.
+        size_t write_some(const char* data, size_t size) {
+#           if !defined(_WIN32)
+            size_t done = 0;
+            while (done < size) {
+                ssize_t res;
+                if (m_socket) {
+                    int flags = MSG_DONTWAIT;
+#                   ifdef MSG_NOSIGNAL
+                    flags |= MSG_NOSIGNAL;
+#                   endif
+                    res = ::send(m_target, data + done, size - done, flags);
+                } else {
+                    res = ::write(m_target, data + done, size - done);
+                }
+                m_write_calls.fetch_add(1, std::memory_order_relaxed);
+                if (res < 0) {
+                    if (errno == EINTR) continue;
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) return done;
+                    return size;
+                }
+                m_bytes_written.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+                done += static_cast<size_t>(res);
+            }
+            return done;
+#           else
+            (void)data;
+            return size;
+#           endif
+        }
+
+        /// \brief Writes all bytes, retrying on partial writes and `EINTR`; gives up on errors.
+        void write_all(const char* data, size_t size) {
+#           if !defined(_WIN32)
+            while (size > 0) {
+                const ssize_t res = ::write(m_fd, data, size);
+                m_write_calls.fetch_add(1, std::memory_order_relaxed);
+                if (res < 0) {
+                    if (errno == EINTR) continue;
+                    return;
+                }
+                m_bytes_written.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+                data += res;
+                size -= static_cast<size_t>(res);
+            }
+#           else
+            (void)data;
+            (void)size;
+#           endif
+        }
+    }; // class ConsoleWriter
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_CONSOLE_WRITER_HPP_INCLUDED
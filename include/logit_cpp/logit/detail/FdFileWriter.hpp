@@ -0,0 +1,273 @@
+#pragma once
+#ifndef _LOGIT_FD_FILE_WRITER_HPP_INCLUDED
+#define _LOGIT_FD_FILE_WRITER_HPP_INCLUDED
+
+/// \file FdFileWriter.hpp
+/// \brief Append-only file writer built on a raw descriptor and a user-space buffer.
+
+#include "IFileWriter.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#   include "../utils/encoding_utils.hpp"
+#   include <io.h>
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#else
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#   include <sys/types.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+#endif
+
+namespace logit { namespace detail {
+
+    /// \class FdFileWriter
+    /// \brief Appends data to a file through a descriptor opened with `O_APPEND`.
+    ///
+    /// Data is collected in a page-aligned buffer and submitted when the buffer fills up or
+    /// `flush()` is called. A record that does not fit is sent together with the buffered
+    /// bytes in one `writev` call, so large records are never copied. If a write fails, the
+    /// bytes that did not reach the file stay in the buffer and go out with the next flush.
+    /// The writer is not thread-safe; only the counters may be read concurrently.
+    class FdFileWriter : public IFileWriter {
+    public:
+        static const size_t buffer_alignment = 4096; ///< Alignment of the user-space buffer.
+
+        FdFileWriter() = default;
+        FdFileWriter(const FdFileWriter&) = delete;
+        FdFileWriter& operator=(const FdFileWriter&) = delete;
+
+        /// \brief Flushes pending data and closes the descriptor.
+        ~FdFileWriter() override {
+            try {
+                close();
+            } catch (...) {}
+        }
+
+        /// \brief Opens a file for appending, creating it if needed.
+        /// \param path File path (UTF-8).
+        /// \param buffer_size Capacity of the user-space buffer.
+        /// \return True on success.
+        bool open(const std::string& path, size_t buffer_size) override {
+            close();
+#           if defined(_WIN32)
+            m_fd = ::_open(utf8_to_ansi(path).c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY,
+                           _S_IREAD | _S_IWRITE);
+#           else
+            m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#           endif
+            if (m_fd < 0) return false;
+            if (buffer_size == 0) buffer_size = buffer_alignment;
+            m_size = 0;
+            if (buffer_size != m_capacity) allocate(buffer_size);
+            return true;
+        }
+
+        /// \brief Returns true if a file is open.
+        bool is_open() const override { return m_fd >= 0; }
+
+        /// \brief Returns true if no data is waiting in the buffer.
+        bool empty() const override { return m_size == 0; }
+
+        /// \brief Returns the current size of the file, excluding buffered data.
+        uint64_t file_size() const override {
+            if (m_fd < 0) return 0;
+#           if defined(_WIN32)
+            struct _stat64 st;
+            return ::_fstat64(m_fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+#           else
+            struct stat st;
+            return ::fstat(m_fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+#           endif
+        }
+
+        /// \brief Appends bytes.
+        void write(const char* data, size_t size) override {
+            append(data, size, false);
+        }
+
+        /// \brief Appends bytes followed by a line break.
+        void write_line(const char* data, size_t size) override {
+            append(data, size, true);
+        }
+
+        /// \brief Submits buffered data to the file.
+        void flush() override {
+            if (m_size == 0 || m_fd < 0) return;
+            submit(nullptr, 0, false);
+        }
+
+        /// \brief Submits buffered data; `write` completes synchronously.
+        void drain() override {
+            flush();
+        }
+
+        /// \brief Flushes pending data and waits until the file data reaches the disk.
+        void sync() override {
+            flush();
+            if (m_fd >= 0 && !sync_descriptor(m_fd)) {
+                throw std::system_error(errno, std::generic_category(), "Failed to sync log file");
+            }
+        }
+
+        /// \brief Returns a duplicate of the descriptor that stays valid after `close()`.
+        /// \return New descriptor owned by the caller, or -1.
+        int duplicate() const override {
+            return duplicate_descriptor(m_fd);
+        }
+
+        /// \brief Flushes pending data and closes the file.
+        void close() override {
+            if (m_fd < 0) return;
+            const int fd = m_fd;
+            try {
+                flush();
+            } catch (...) {
+                close_descriptor(fd);
+                m_fd = -1;
+                m_size = 0;
+                throw;
+            }
+            close_descriptor(fd);
+            m_fd = -1;
+        }
+
+        /// \brief Returns a snapshot of the writer counters.
+        FileWriteStats stats() const override {
+            FileWriteStats stats;
+            stats.flushes = m_flushes.load(std::memory_order_relaxed);
+            stats.write_calls = m_write_calls.load(std::memory_order_relaxed);
+            stats.bytes_written = m_bytes_written.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        int m_fd = -1;                      ///< Descriptor of the open file.
+        std::unique_ptr<char[]> m_storage;  ///< Allocation holding the aligned buffer.
+        char*  m_buffer   = nullptr;        ///< Aligned user-space buffer.
+        size_t m_capacity = 0;              ///< Buffer capacity.
+        size_t m_size     = 0;              ///< Bytes waiting in the buffer.
+        std::atomic<uint64_t> m_flushes       = ATOMIC_VAR_INIT(0); ///< Buffer submissions.
+        std::atomic<uint64_t> m_write_calls   = ATOMIC_VAR_INIT(0); ///< System calls issued.
+        std::atomic<uint64_t> m_bytes_written = ATOMIC_VAR_INIT(0); ///< Bytes written.
+
+        /// \brief Replaces the buffer with one of `capacity` bytes, keeping the buffered data.
+        void allocate(size_t capacity) {
+            std::unique_ptr<char[]> storage(new char[capacity + buffer_alignment]);
+            const uintptr_t raw = reinterpret_cast<uintptr_t>(storage.get());
+            const uintptr_t aligned = (raw + buffer_alignment - 1) & ~static_cast<uintptr_t>(buffer_alignment - 1);
+            char* buffer = reinterpret_cast<char*>(aligned);
+            if (m_size != 0) std::memcpy(buffer, m_buffer, m_size);
+            m_storage.swap(storage);
+            m_buffer = buffer;
+            m_capacity = capacity;
+        }
+
+        /// \brief Copies data into the buffer or submits it together with the buffer.
+        void append(const char* data, size_t size, bool newline) {
+            if (m_fd < 0) return;
+            const size_t total = size + (newline ? 1 : 0);
+            if (m_size + total <= m_capacity) {
+                std::memcpy(m_buffer + m_size, data, size);
+                m_size += size;
+                if (newline) m_buffer[m_size++] = '\n';
+                if (m_size == m_capacity) submit(nullptr, 0, false);
+                return;
+            }
+            submit(data, size, newline);
+        }
+
+        /// \brief Writes the buffer followed by an optional extra block in one call.
+        void submit(const char* extra, size_t extra_size, bool newline) {
+            static const char line_break = '\n';
+            const char* parts[3] = { m_buffer, extra, &line_break };
+            size_t sizes[3] = { m_size, extra_size, static_cast<size_t>(newline ? 1 : 0) };
+            try {
+                write_parts(parts, sizes, 3);
+            } catch (...) {
+                keep_unwritten(parts, sizes, extra_size + sizes[2]);
+                throw;
+            }
+            m_size = 0;
+            m_flushes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// \brief Moves the bytes a failed submission did not write back into the buffer.
+        ///
+        /// Buffered bytes are always kept. The extra record is kept if part of it already
+        /// reached the file, so the file never ends with a torn record, or if it still fits
+        /// into the buffer; otherwise it is dropped and the caller sees the exception.
+        /// \param parts Unwritten parts left by `write_parts()`.
+        /// \param sizes Unwritten sizes left by `write_parts()`.
+        /// \param record_size Size of the extra record including its line break.
+        void keep_unwritten(const char** parts, const size_t* sizes, size_t record_size) {
+            if (sizes[0] != 0) std::memmove(m_buffer, parts[0], sizes[0]);
+            m_size = sizes[0];
+            const size_t record_left = sizes[1] + sizes[2];
+            if (record_left == 0) return;
+            if (m_size + record_left > m_capacity) {
+                if (record_left == record_size) return;
+                allocate(m_size + record_left);
+            }
+            if (sizes[1] != 0) std::memcpy(m_buffer + m_size, parts[1], sizes[1]);
+            m_size += sizes[1];
+            if (sizes[2] != 0) m_buffer[m_size++] = '\n';
+        }
+
+        /// \brief Writes all parts, retrying partial writes and interrupted calls.
+        void write_parts(const char** parts, size_t* sizes, int count) {
+            int first = 0;
+            while (first < count && sizes[first] == 0) ++first;
+            while (first < count) {
+#               if defined(_WIN32)
+                const int res = ::_write(m_fd, parts[first], static_cast<unsigned int>(sizes[first]));
+                if (res < 0) {
+                    throw std::system_error(errno, std::generic_category(), "Failed to write log file");
+                }
+                size_t written = static_cast<size_t>(res);
+#               else
+                struct iovec iov[3];
+                int iov_count = 0;
+                for (int i = first; i < count; ++i) {
+                    if (sizes[i] == 0) continue;
+                    iov[iov_count].iov_base = const_cast<char*>(parts[i]);
+                    iov[iov_count].iov_len = sizes[i];
+                    ++iov_count;
+                }
+                const ssize_t res = iov_count == 1
+                    ? ::write(m_fd, iov[0].iov_base, iov[0].iov_len)
+                    : ::writev(m_fd, iov, iov_count);
+                if (res < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "Failed to write log file");
+                }
+                size_t written = static_cast<size_t>(res);
+#               endif
+                m_write_calls.fetch_add(1, std::memory_order_relaxed);
+                m_bytes_written.fetch_add(written, std::memory_order_relaxed);
+                while (first < count && written >= sizes[first]) {
+                    written -= sizes[first];
+                    sizes[first] = 0;
+                    ++first;
+                }
+                if (first < count) {
+                    parts[first] += written;
+                    sizes[first] -= written;
+                }
+                while (first < count && sizes[first] == 0) ++first;
+            }
+        }
+    }; // class FdFileWriter
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_FD_FILE_WRITER_HPP_INCLUDED
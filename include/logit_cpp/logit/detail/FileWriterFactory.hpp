@@ -0,0 +1,121 @@
+#pragma once
+#ifndef _LOGIT_FILE_WRITER_FACTORY_HPP_INCLUDED
+#define _LOGIT_FILE_WRITER_FACTORY_HPP_INCLUDED
+
+/// \file FileWriterFactory.hpp
+/// \brief Selects the `IFileWriter` of a `FileWriteMode` and reports which modes are available.
+
+#include "IFileWriter.hpp"
+#include "FdFileWriter.hpp"
+#include "IoUringFileWriter.hpp"
+#include "MmapFileWriter.hpp"
+#include "CompressedFileWriter.hpp"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace logit { namespace detail {
+
+    /// \struct FileWriterOptions
+    /// \brief Settings of the writer stack of one logger.
+    struct FileWriterOptions {
+        FileWriteMode mode = FileWriteMode::Stream; ///< Backend that puts bytes into the file.
+        unsigned uring_queue_depth = 8;             ///< Registered buffers of `FileWriteMode::IoUring`.
+        uint32_t uring_sync_interval_ms = 1000;     ///< Interval of queued data syncs of `FileWriteMode::IoUring`.
+        uint64_t mmap_extent_bytes = 16 * 1024 * 1024; ///< Preallocation step of `FileWriteMode::Mmap`.
+        size_t   mmap_window_bytes = 1024 * 1024;   ///< Mapped window of `FileWriteMode::Mmap`.
+        bool     mmap_trim_zero_tail = true;        ///< Data never ends with zero bytes; the zero tail is cut on open.
+        CompressType live_compress = CompressType::NONE; ///< Streaming compression of the file (NONE = off).
+        int      compress_level = 1;                ///< Level of the streaming compression.
+        uint64_t compress_frame_bytes = 4 * 1024 * 1024; ///< Uncompressed bytes per gzip member or zstd frame.
+        uint32_t compress_frame_interval_ms = 0;    ///< Longest age of a seekable frame (0 = size only).
+        bool     compress_seekable = false;         ///< Append a zstd seek table.
+        std::shared_ptr<const ZstdDictionary> dictionary; ///< Dictionary of zstd frames, if any.
+    };
+
+    /// \brief Returns true if the kernel lets this process create an io_uring instance.
+    ///
+    /// The probe runs once; builds without `LOGIT_HAS_IO_URING` always return false.
+    inline bool io_uring_available() {
+#       if defined(__linux__) && defined(LOGIT_HAS_IO_URING)
+        static const bool available = []() {
+            struct io_uring ring;
+            if (io_uring_queue_init(2, &ring, 0) < 0) return false;
+            io_uring_queue_exit(&ring);
+            return true;
+        }();
+        return available;
+#       else
+        return false;
+#       endif
+    }
+
+    /// \brief Checks whether a write mode can be used in this build and on this system.
+    /// \param mode Write mode.
+    /// \param reason Receives the reason if the mode is not available.
+    /// \return True if `create_file_writer()` can create the writer.
+    inline bool is_write_mode_available(FileWriteMode mode, std::string& reason) {
+        switch (mode) {
+        case FileWriteMode::IoUring:
+            if (io_uring_available()) return true;
+#           if defined(__linux__) && defined(LOGIT_HAS_IO_URING)
+            reason = "the kernel refused to create an io_uring instance";
+#           else
+            reason = "io_uring support is not compiled in (LOGIT_WITH_IO_URING)";
+#           endif
+            return false;
+        case FileWriteMode::Mmap:
+#           if defined(_WIN32)
+            reason = "memory-mapped files are not supported on Windows";
+            return false;
+#           else
+            return true;
+#           endif
+        case FileWriteMode::Stream:
+        case FileWriteMode::BufferedFd:
+            break;
+        }
+        return true;
+    }
+
+    /// \brief Creates the writer that puts bytes into the file.
+    ///
+    /// With streaming compression the writer is wrapped in a `CompressedFileWriter`.
+    /// The mode must be available (`is_write_mode_available()`).
+    /// \return Writer, or null for `FileWriteMode::Stream` without compression.
+    /// \throws std::invalid_argument if the mode or the compression is not available.
+    inline std::unique_ptr<IFileWriter> create_file_writer(const FileWriterOptions& options) {
+        std::unique_ptr<IFileWriter> writer;
+        switch (options.mode) {
+        case FileWriteMode::Stream:
+            if (options.live_compress == CompressType::NONE) return writer;
+            throw std::invalid_argument("Streaming compression needs a descriptor writer");
+        case FileWriteMode::BufferedFd:
+            writer.reset(new FdFileWriter());
+            break;
+        case FileWriteMode::IoUring:
+#           if defined(__linux__) && defined(LOGIT_HAS_IO_URING)
+            writer.reset(new IoUringFileWriter(options.uring_queue_depth, options.uring_sync_interval_ms));
+            break;
+#           else
+            throw std::invalid_argument("io_uring support is not compiled in");
+#           endif
+        case FileWriteMode::Mmap:
+#           if !defined(_WIN32)
+            writer.reset(new MmapFileWriter(options.mmap_extent_bytes, options.mmap_window_bytes,
+                                            options.mmap_trim_zero_tail));
+            break;
+#           else
+            throw std::invalid_argument("Memory-mapped files are not supported on Windows");
+#           endif
+        }
+        if (options.live_compress == CompressType::NONE) return writer;
+        return std::unique_ptr<IFileWriter>(new CompressedFileWriter(
+            std::move(writer), options.live_compress, options.compress_level, options.compress_frame_bytes,
+            options.compress_frame_interval_ms, options.compress_seekable, options.dictionary));
+    }
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_FILE_WRITER_FACTORY_HPP_INCLUDED
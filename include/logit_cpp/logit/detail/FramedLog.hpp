@@ -0,0 +1,213 @@
+#pragma once
+#ifndef _LOGIT_FRAMED_LOG_HPP_INCLUDED
+#define _LOGIT_FRAMED_LOG_HPP_INCLUDED
+
+/// \file FramedLog.hpp
+/// \brief Record framing of `FileLogger::Config::framed` files and the recovery scanner.
+///
+/// \code
+/// [8 bytes "LOGITFRM"]
+/// [u32 crc32c][u32 payload size][u64 sequence][payload] x N
+/// \endcode
+///
+/// All integers are little-endian. The CRC-32C covers the payload size, the sequence
+/// number and the payload, so a frame is only accepted if it was written completely.
+/// Text records keep their line break inside the payload.
+
+#include "../utils/binary_codec.hpp"
+#include "../utils/crc32c.hpp"
+#include "ZstdSeekTable.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \struct FrameGap
+    /// \brief Damage found between two valid frames.
+    struct FrameGap {
+        uint64_t offset = 0;          ///< File offset where the damage starts.
+        uint64_t bytes = 0;           ///< Unreadable bytes skipped (0 for a sequence gap only).
+        uint64_t missing_records = 0; ///< Sequence numbers missing before the next valid frame.
+    };
+
+    /// \struct FrameScanResult
+    /// \brief Summary of a framed log file.
+    struct FrameScanResult {
+        bool     framed = false;      ///< The file starts with the frame magic (or is empty).
+        uint64_t file_size = 0;       ///< Size of the file.
+        uint64_t valid_size = 0;      ///< End of the last valid frame; later bytes are a torn tail.
+        uint64_t records = 0;         ///< Number of valid frames.
+        uint64_t first_sequence = 0;  ///< Sequence number of the first valid frame.
+        uint64_t last_sequence = 0;   ///< Highest sequence number of the valid frames.
+        std::vector<FrameGap> gaps;   ///< Damage between valid frames, in file order.
+
+        /// \brief Returns true if the file ends with bytes that do not form a frame.
+        bool torn_tail() const { return valid_size < file_size; }
+    };
+
+namespace detail {
+
+    static const char kFramedLogMagic[8] = { 'L', 'O', 'G', 'I', 'T', 'F', 'R', 'M' }; ///< Magic of a framed log.
+    const size_t   kFrameHeaderSize = 16;                ///< Bytes before the payload of a frame.
+    const uint32_t kFrameMaxPayload = 16U * 1024 * 1024; ///< Longest payload; longer records are cut.
+
+    /// \brief Fills the header of a frame.
+    /// \param header Receives `kFrameHeaderSize` bytes.
+    /// \param sequence Sequence number of the record.
+    /// \param data Payload.
+    /// \param size Payload size, at most `kFrameMaxPayload`.
+    inline void make_frame_header(char* header, uint64_t sequence, const char* data, size_t size) {
+        for (size_t i = 0; i < 4; ++i) header[4 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+        for (size_t i = 0; i < 8; ++i) header[8 + i] = static_cast<char>((sequence >> (8 * i)) & 0xFF);
+        const uint32_t crc = crc32c_extend(crc32c(header + 4, 12), data, size);
+        for (size_t i = 0; i < 4; ++i) header[i] = static_cast<char>((crc >> (8 * i)) & 0xFF);
+    }
+
+    /// \class FrameInput
+    /// \brief Buffered reader that keeps a window of the file in memory for the scanner.
+    class FrameInput {
+    public:
+        explicit FrameInput(std::istream& in) : m_in(in), m_buffer(1024 * 1024) {}
+
+        /// \brief Makes `size` bytes available at the current position.
+        /// \return False if the file ends earlier.
+        bool ensure(size_t size) {
+            if (m_end - m_pos >= size) return true;
+            std::memmove(&m_buffer[0], &m_buffer[m_pos], m_end - m_pos);
+            m_base += m_pos;
+            m_end -= m_pos;
+            m_pos = 0;
+            if (m_buffer.size() < size) m_buffer.resize((std::max)(size, m_buffer.size() * 2));
+            while (m_end < size && !m_eof) {
+                m_in.read(&m_buffer[m_end], static_cast<std::streamsize>(m_buffer.size() - m_end));
+                const size_t got = static_cast<size_t>(m_in.gcount());
+                if (got == 0) m_eof = true;
+                m_end += got;
+            }
+            return m_end - m_pos >= size;
+        }
+
+        const char* data() const { return m_buffer.data() + m_pos; } ///< Bytes at the current position.
+        uint64_t offset() const { return m_base + m_pos; }          ///< File offset of the current position.
+        void skip(size_t size) { m_pos += size; }                   ///< Advances the position.
+
+    private:
+        std::istream&     m_in;
+        std::vector<char> m_buffer;
+        size_t            m_pos = 0;
+        size_t            m_end = 0;
+        uint64_t          m_base = 0;
+        bool              m_eof = false;
+    };
+
+} // namespace detail
+
+    /// \brief Scans a framed log and passes the payload of every valid frame to a callback.
+    ///
+    /// Damaged bytes are skipped until the next valid frame and reported as a gap; damage
+    /// at the end of the file is reported as a torn tail instead.
+    /// \tparam Callback Callable accepting `(uint64_t sequence, const char* data, size_t size)`.
+    /// \param path Path of the file (UTF-8).
+    /// \param callback Receives the payloads in file order.
+    /// \return Summary of the file; `framed` is false if it is not a framed log.
+    /// \throws std::runtime_error if the file cannot be opened.
+    template <typename Callback>
+    FrameScanResult scan_framed_log(const std::string& path, Callback callback) {
+        FrameScanResult result;
+#       if defined(_WIN32)
+        std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary | std::ios::ate);
+#       else
+        std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+#       endif
+        if (!file) throw std::runtime_error("Failed to open framed log: " + path);
+        result.file_size = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+        detail::FrameInput in(file);
+        const size_t magic_size = sizeof(detail::kFramedLogMagic);
+        const size_t head = static_cast<size_t>((std::min)(result.file_size, static_cast<uint64_t>(magic_size)));
+        in.ensure(head);
+        result.framed = std::memcmp(in.data(), detail::kFramedLogMagic, head) == 0;
+        if (!result.framed || head < magic_size) return result; // empty, foreign or torn magic
+        in.skip(magic_size);
+        result.valid_size = magic_size;
+
+        bool in_gap = false;
+        uint64_t gap_start = 0;
+        while (in.ensure(detail::kFrameHeaderSize)) {
+            detail::BinaryCursor header(in.data(), detail::kFrameHeaderSize);
+            uint64_t crc = 0;
+            uint64_t size = 0;
+            uint64_t sequence = 0;
+            header.get_fixed(crc, 4);
+            header.get_fixed(size, 4);
+            header.get_fixed(sequence, 8);
+            bool valid = size <= detail::kFrameMaxPayload &&
+                         in.ensure(detail::kFrameHeaderSize + static_cast<size_t>(size));
+            if (valid) {
+                const char* payload = in.data() + detail::kFrameHeaderSize;
+                valid = crc32c_extend(crc32c(in.data() + 4, 12), payload, static_cast<size_t>(size)) == crc;
+            }
+            if (!valid) {
+                if (!in_gap) {
+                    in_gap = true;
+                    gap_start = in.offset();
+                }
+                in.skip(1);
+                continue;
+            }
+            FrameGap gap;
+            gap.offset = in_gap ? gap_start : in.offset();
+            gap.bytes = in_gap ? in.offset() - gap_start : 0;
+            // Frames of several processes (`FileLogger::Config::shared`) may be slightly out
+            // of order; a record counted as missing can then still follow later.
+            if (result.records > 0 && sequence > result.last_sequence + 1) {
+                gap.missing_records = sequence - result.last_sequence - 1;
+            }
+            if (gap.bytes > 0 || gap.missing_records > 0) result.gaps.push_back(gap);
+            in_gap = false;
+            if (result.records == 0) result.first_sequence = sequence;
+            result.last_sequence = (std::max)(result.last_sequence, sequence);
+            ++result.records;
+            callback(sequence, in.data() + detail::kFrameHeaderSize, static_cast<size_t>(size));
+            in.skip(detail::kFrameHeaderSize + static_cast<size_t>(size));
+            result.valid_size = in.offset();
+        }
+        return result;
+    }
+
+    /// \brief Scans a framed log without reading the payloads.
+    inline FrameScanResult scan_framed_log(const std::string& path) {
+        return scan_framed_log(path, [](uint64_t, const char*, size_t) {});
+    }
+
+    /// \brief Scans a framed log and cuts off a torn tail.
+    /// \param path Path of the file (UTF-8).
+    /// \return Summary of the file before truncation.
+    /// \throws std::runtime_error if the file cannot be opened or truncated.
+    inline FrameScanResult recover_framed_log(const std::string& path) {
+        const FrameScanResult result = scan_framed_log(path);
+        if (result.framed && result.torn_tail() && !detail::truncate_file(path, result.valid_size)) {
+            throw std::runtime_error("Failed to truncate framed log: " + path);
+        }
+        return result;
+    }
+
+    /// \brief Returns the payloads of the valid frames of a framed log, concatenated.
+    /// \throws std::runtime_error if the file cannot be opened or is not a framed log.
+    inline std::string read_framed_log(const std::string& path) {
+        std::string out;
+        const FrameScanResult result = scan_framed_log(path, [&out](uint64_t, const char* data, size_t size) {
+            out.append(data, size);
+        });
+        if (!result.framed) throw std::runtime_error("Not a framed log: " + path);
+        return out;
+    }
+
+}; // namespace logit
+
+#endif // _LOGIT_FRAMED_LOG_HPP_INCLUDED
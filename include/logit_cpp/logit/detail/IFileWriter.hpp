@@ -0,0 +1,141 @@
+#pragma once
+#ifndef _LOGIT_IFILE_WRITER_HPP_INCLUDED
+#define _LOGIT_IFILE_WRITER_HPP_INCLUDED
+
+/// \file IFileWriter.hpp
+/// \brief Interface of the descriptor-based writers used by `FileLogger`.
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32)
+#   include <io.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+namespace logit {
+
+    /// \struct FileWriteStats
+    /// \brief Counters of a buffered file writer.
+    struct FileWriteStats {
+        uint64_t flushes       = 0; ///< Number of times the buffer was submitted to the file.
+        uint64_t write_calls   = 0; ///< Number of system calls that submitted data.
+        uint64_t bytes_written = 0; ///< Bytes handed to the operating system.
+        uint64_t syncs         = 0; ///< Number of `fdatasync` calls and submitted sync requests.
+        uint64_t sync_failures = 0; ///< Durable records released because their group commit sync failed.
+
+        /// \brief Average number of bytes per system call.
+        double bytes_per_write() const {
+            return write_calls ? static_cast<double>(bytes_written) / static_cast<double>(write_calls) : 0.0;
+        }
+    };
+
+namespace detail {
+
+    /// \brief Writes the file data of a descriptor to the disk.
+    /// \param fd Open descriptor.
+    /// \return True on success.
+    inline bool sync_descriptor(int fd) {
+#       if defined(_WIN32)
+        return ::_commit(fd) == 0;
+#       elif defined(__APPLE__)
+        return ::fsync(fd) == 0;
+#       else
+        int res = 0;
+        do {
+            res = ::fdatasync(fd);
+        } while (res != 0 && errno == EINTR);
+        return res == 0;
+#       endif
+    }
+
+    /// \brief Duplicates a descriptor.
+    /// \param fd Open descriptor.
+    /// \return New descriptor owned by the caller, or -1.
+    inline int duplicate_descriptor(int fd) {
+        if (fd < 0) return -1;
+#       if defined(_WIN32)
+        return ::_dup(fd);
+#       else
+        return ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+#       endif
+    }
+
+    /// \brief Closes a descriptor.
+    /// \param fd Open descriptor.
+    inline void close_descriptor(int fd) {
+#       if defined(_WIN32)
+        ::_close(fd);
+#       else
+        ::close(fd);
+#       endif
+    }
+
+    /// \class IFileWriter
+    /// \brief Append-only writer owning the descriptor of the active log file.
+    ///
+    /// Implementations buffer data in user space. They are not thread-safe; `FileLogger`
+    /// serializes all calls except `stats()`, which may be read concurrently.
+    class IFileWriter {
+    public:
+        virtual ~IFileWriter() = default;
+
+        /// \brief Opens a file for appending, creating it if needed.
+        /// \param path File path (UTF-8).
+        /// \param buffer_size Capacity of the user-space buffer.
+        /// \return True on success.
+        virtual bool open(const std::string& path, size_t buffer_size) = 0;
+
+        /// \brief Returns true if a file is open.
+        virtual bool is_open() const = 0;
+
+        /// \brief Returns true if no data is waiting in the buffer.
+        virtual bool empty() const = 0;
+
+        /// \brief Returns the size of the file including data already submitted.
+        virtual uint64_t file_size() const = 0;
+
+        /// \brief Returns the size of the file content before compression, right after `open()`.
+        /// \param size Receives the size.
+        /// \return False if the size is unknown.
+        virtual bool content_size(uint64_t& size) const {
+            size = file_size();
+            return true;
+        }
+
+        /// \brief Called before the bytes of each record are written.
+        /// \param timestamp_ms Timestamp of the record.
+        virtual void begin_record(int64_t timestamp_ms) { (void)timestamp_ms; }
+
+        /// \brief Appends bytes.
+        virtual void write(const char* data, size_t size) = 0;
+
+        /// \brief Appends bytes followed by a line break.
+        virtual void write_line(const char* data, size_t size) = 0;
+
+        /// \brief Submits buffered data to the operating system.
+        virtual void flush() = 0;
+
+        /// \brief Submits buffered data and waits until every submitted write has completed.
+        virtual void drain() = 0;
+
+        /// \brief Drains the writer and waits until the file data reaches the disk.
+        virtual void sync() = 0;
+
+        /// \brief Returns a duplicate of the descriptor that stays valid after `close()`.
+        /// \return New descriptor owned by the caller, or -1.
+        virtual int duplicate() const = 0;
+
+        /// \brief Drains pending data and closes the file.
+        virtual void close() = 0;
+
+        /// \brief Returns a snapshot of the writer counters.
+        virtual FileWriteStats stats() const = 0;
+    }; // class IFileWriter
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_IFILE_WRITER_HPP_INCLUDED
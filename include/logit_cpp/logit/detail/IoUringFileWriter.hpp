@@ -0,0 +1,330 @@
+#pragma once
+#ifndef _LOGIT_IO_URING_FILE_WRITER_HPP_INCLUDED
+#define _LOGIT_IO_URING_FILE_WRITER_HPP_INCLUDED
+
+/// \file IoUringFileWriter.hpp
+/// \brief Append-only file writer that submits buffers through an io_uring submission ring.
+///
+/// Available on Linux when liburing is found at configure time (`LOGIT_WITH_IO_URING`,
+/// which defines `LOGIT_HAS_IO_URING`).
+
+#if defined(__linux__) && defined(LOGIT_HAS_IO_URING)
+
+#include "IFileWriter.hpp"
+#include <liburing.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace logit { namespace detail {
+
+    /// \class IoUringFileWriter
+    /// \brief Writes log data with `IORING_OP_WRITE_FIXED` from a set of registered buffers.
+    ///
+    /// Records are copied into the current buffer. A full buffer is submitted at the next
+    /// file offset and the writer continues with a free buffer, so the logging thread never
+    /// waits for the write itself; it only waits for a completion when every buffer is in
+    /// flight. A data sync (`IORING_FSYNC_DATASYNC`) is queued behind the writes at a
+    /// configurable interval. The writer is not thread-safe; only the counters may be read
+    /// concurrently.
+    class IoUringFileWriter : public IFileWriter {
+    public:
+        static const size_t buffer_alignment = 4096; ///< Alignment of the registered buffers.
+
+        /// \brief Constructor.
+        /// \param queue_depth Number of registered buffers and ring entries.
+        /// \param sync_interval_ms Interval of queued data syncs (0 = none).
+        IoUringFileWriter(unsigned queue_depth = 8, uint32_t sync_interval_ms = 1000)
+            : m_queue_depth(queue_depth < 2 ? 2 : queue_depth),
+              m_sync_interval(std::chrono::milliseconds(sync_interval_ms)) {
+        }
+
+        IoUringFileWriter(const IoUringFileWriter&) = delete;
+        IoUringFileWriter& operator=(const IoUringFileWriter&) = delete;
+
+        /// \brief Drains pending writes, closes the file and releases the ring.
+        ~IoUringFileWriter() override {
+            try {
+                close();
+            } catch (...) {}
+            if (m_ring_ready) io_uring_queue_exit(&m_ring);
+            for (auto& buffer : m_buffers) std::free(buffer.data);
+        }
+
+        /// \brief Opens a file; the ring and its buffers are set up on first use.
+        bool open(const std::string& path, size_t buffer_size) override {
+            close();
+            if (!m_ring_ready && !init_ring(buffer_size)) return false;
+            // Writes carry explicit offsets, so completions may arrive in any order.
+            m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+            if (m_fd < 0) return false;
+            struct stat st;
+            m_offset = ::fstat(m_fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+            m_last_sync = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        bool is_open() const override { return m_fd >= 0; }
+        bool empty() const override { return m_buffers.empty() || m_buffers[m_current].size == 0; }
+
+        /// \brief Returns the file size including submitted and buffered data.
+        uint64_t file_size() const override { return m_offset + (empty() ? 0 : m_buffers[m_current].size); }
+
+        void write(const char* data, size_t size) override {
+            append(data, size);
+        }
+
+        void write_line(const char* data, size_t size) override {
+            static const char line_break = '\n';
+            append(data, size);
+            append(&line_break, 1);
+        }
+
+        /// \brief Submits the current buffer and queues a data sync when it is due.
+        void flush() override {
+            if (m_fd < 0) return;
+            submit_current();
+            if (m_sync_interval.count() > 0 &&
+                std::chrono::steady_clock::now() - m_last_sync >= m_sync_interval) {
+                queue_sync();
+            }
+            if (m_pending_sqes) submit_ring();
+            reap(false);
+        }
+
+        /// \brief Submits the current buffer and waits for all completions.
+        void drain() override {
+            if (m_fd < 0) return;
+            submit_current();
+            if (m_pending_sqes) submit_ring();
+            while (m_in_flight) reap(true);
+            check_error();
+        }
+
+        void sync() override {
+            drain();
+            if (m_fd >= 0 && !sync_descriptor(m_fd)) {
+                throw std::system_error(errno, std::generic_category(), "Failed to sync log file");
+            }
+        }
+
+        int duplicate() const override {
+            return duplicate_descriptor(m_fd);
+        }
+
+        void close() override {
+            if (m_fd < 0) return;
+            try {
+                drain();
+            } catch (...) {
+                close_descriptor(m_fd);
+                m_fd = -1;
+                throw;
+            }
+            close_descriptor(m_fd);
+            m_fd = -1;
+        }
+
+        FileWriteStats stats() const override {
+            FileWriteStats stats;
+            stats.flushes = m_flushes.load(std::memory_order_relaxed);
+            stats.write_calls = m_write_calls.load(std::memory_order_relaxed);
+            stats.bytes_written = m_bytes_written.load(std::memory_order_relaxed);
+            stats.syncs = m_syncs.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        /// \struct Buffer
+        /// \brief Registered buffer and the write it belongs to.
+        struct Buffer {
+            char*    data = nullptr;   ///< Registered memory.
+            size_t   size = 0;         ///< Bytes filled or submitted.
+            uint64_t offset = 0;       ///< File offset of the submitted write.
+            bool     in_flight = false;///< A write from this buffer has not completed yet.
+        };
+
+        unsigned m_queue_depth;                     ///< Number of buffers and ring entries.
+        std::chrono::steady_clock::duration m_sync_interval; ///< Interval of queued data syncs.
+        struct io_uring m_ring;                     ///< Submission and completion rings.
+        bool m_ring_ready = false;                  ///< The ring is initialized.
+        std::vector<Buffer> m_buffers;              ///< Registered buffers.
+        size_t m_capacity = 0;                      ///< Capacity of each buffer.
+        size_t m_current = 0;                       ///< Buffer being filled.
+        unsigned m_in_flight = 0;                   ///< Submitted requests without completion.
+        unsigned m_pending_sqes = 0;                ///< Prepared requests not yet submitted.
+        int m_fd = -1;                              ///< Descriptor of the open file.
+        uint64_t m_offset = 0;                      ///< Offset of the next write.
+        int m_error = 0;                            ///< First error reported by a completion.
+        std::chrono::steady_clock::time_point m_last_sync; ///< Time of the last queued sync.
+        std::atomic<uint64_t> m_flushes       = ATOMIC_VAR_INIT(0); ///< Buffer submissions.
+        std::atomic<uint64_t> m_write_calls   = ATOMIC_VAR_INIT(0); ///< `io_uring_submit` calls.
+        std::atomic<uint64_t> m_bytes_written = ATOMIC_VAR_INIT(0); ///< Bytes submitted.
+        std::atomic<uint64_t> m_syncs         = ATOMIC_VAR_INIT(0); ///< Queued data syncs.
+
+        /// \brief Creates the ring and registers the buffers.
+        bool init_ring(size_t buffer_size) {
+            if (buffer_size < buffer_alignment) buffer_size = buffer_alignment;
+            if (io_uring_queue_init(m_queue_depth * 2, &m_ring, 0) < 0) return false;
+            m_capacity = buffer_size;
+            m_buffers.resize(m_queue_depth);
+            std::vector<struct iovec> iov(m_queue_depth);
+            bool ok = true;
+            for (unsigned i = 0; i < m_queue_depth && ok; ++i) {
+                void* memory = nullptr;
+                ok = posix_memalign(&memory, buffer_alignment, buffer_size) == 0;
+                m_buffers[i].data = static_cast<char*>(memory);
+                iov[i].iov_base = memory;
+                iov[i].iov_len = buffer_size;
+            }
+            if (ok) ok = io_uring_register_buffers(&m_ring, iov.data(), m_queue_depth) == 0;
+            if (!ok) {
+                io_uring_queue_exit(&m_ring);
+                for (auto& buffer : m_buffers) std::free(buffer.data);
+                m_buffers.clear();
+                return false;
+            }
+            m_ring_ready = true;
+            return true;
+        }
+
+        /// \brief Copies data into the buffers, submitting every buffer that fills up.
+        void append(const char* data, size_t size) {
+            if (m_fd < 0) return;
+            while (size > 0) {
+                Buffer& buffer = m_buffers[m_current];
+                const size_t chunk = size < m_capacity - buffer.size ? size : m_capacity - buffer.size;
+                std::memcpy(buffer.data + buffer.size, data, chunk);
+                buffer.size += chunk;
+                data += chunk;
+                size -= chunk;
+                if (buffer.size == m_capacity) {
+                    submit_current();
+                    submit_ring();
+                }
+            }
+        }
+
+        /// \brief Prepares a fixed-buffer write for the current buffer and moves to the next one.
+        void submit_current() {
+            Buffer& buffer = m_buffers[m_current];
+            if (buffer.size == 0) return;
+            struct io_uring_sqe* sqe = acquire_sqe();
+            buffer.offset = m_offset;
+            buffer.in_flight = true;
+            io_uring_prep_write_fixed(sqe, m_fd, buffer.data, static_cast<unsigned>(buffer.size),
+                                      buffer.offset, static_cast<int>(m_current));
+            io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(static_cast<uintptr_t>(m_current + 1)));
+            m_offset += buffer.size;
+            m_bytes_written.fetch_add(buffer.size, std::memory_order_relaxed);
+            m_flushes.fetch_add(1, std::memory_order_relaxed);
+            ++m_in_flight;
+            ++m_pending_sqes;
+            m_current = (m_current + 1) % m_buffers.size();
+            while (m_buffers[m_current].in_flight) {
+                if (m_pending_sqes) submit_ring();
+                reap(true);
+            }
+            check_error();
+        }
+
+        /// \brief Queues a data sync ordered after all submitted writes.
+        void queue_sync() {
+            struct io_uring_sqe* sqe = acquire_sqe();
+            io_uring_prep_fsync(sqe, m_fd, IORING_FSYNC_DATASYNC);
+            io_uring_sqe_set_flags(sqe, IOSQE_IO_DRAIN);
+            io_uring_sqe_set_data(sqe, nullptr);
+            ++m_in_flight;
+            ++m_pending_sqes;
+            m_last_sync = std::chrono::steady_clock::now();
+            m_syncs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// \brief Returns a free submission entry, making room in the ring if needed.
+        struct io_uring_sqe* acquire_sqe() {
+            struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+            while (!sqe) {
+                submit_ring();
+                reap(true);
+                sqe = io_uring_get_sqe(&m_ring);
+            }
+            return sqe;
+        }
+
+        /// \brief Submits prepared entries with one system call.
+        void submit_ring() {
+            int res = 0;
+            do {
+                res = io_uring_submit(&m_ring);
+            } while (res == -EINTR);
+            if (res < 0) throw std::system_error(-res, std::generic_category(), "io_uring_submit failed");
+            m_pending_sqes = 0;
+            m_write_calls.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// \brief Processes completions; waits for at least one when `block` is set.
+        void reap(bool block) {
+            struct io_uring_cqe* cqe = nullptr;
+            if (block && m_in_flight) {
+                int res = 0;
+                do {
+                    res = io_uring_wait_cqe(&m_ring, &cqe);
+                } while (res == -EINTR);
+                if (res < 0) throw std::system_error(-res, std::generic_category(), "io_uring_wait_cqe failed");
+            } else if (io_uring_peek_cqe(&m_ring, &cqe) != 0) {
+                return;
+            }
+            while (cqe) {
+                complete(cqe);
+                io_uring_cqe_seen(&m_ring, cqe);
+                cqe = nullptr;
+                if (io_uring_peek_cqe(&m_ring, &cqe) != 0) break;
+            }
+        }
+
+        /// \brief Releases the buffer of a completed write, finishing short writes synchronously.
+        void complete(struct io_uring_cqe* cqe) {
+            --m_in_flight;
+            const uintptr_t tag = reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(cqe));
+            if (cqe->res < 0 && !m_error) m_error = -cqe->res;
+            if (tag == 0) return;
+            Buffer& buffer = m_buffers[tag - 1];
+            size_t done = cqe->res > 0 ? static_cast<size_t>(cqe->res) : 0;
+            while (cqe->res >= 0 && done < buffer.size) {
+                const ssize_t res = ::pwrite(m_fd, buffer.data + done, buffer.size - done,
+                                             static_cast<off_t>(buffer.offset + done));
+                if (res < 0 && errno == EINTR) continue;
+                if (res <= 0) {
+                    if (!m_error) m_error = res < 0 ? errno : EIO;
+                    break;
+                }
+                done += static_cast<size_t>(res);
+            }
+            buffer.size = 0;
+            buffer.in_flight = false;
+        }
+
+        /// \brief Throws the first error reported by a completion.
+        void check_error() {
+            if (!m_error) return;
+            const int error = m_error;
+            m_error = 0;
+            throw std::system_error(error, std::generic_category(), "Failed to write log file");
+        }
+    }; // class IoUringFileWriter
+
+}} // namespace logit::detail
+
+#endif // defined(__linux__) && defined(LOGIT_HAS_IO_URING)
+
+#endif // _LOGIT_IO_URING_FILE_WRITER_HPP_INCLUDED
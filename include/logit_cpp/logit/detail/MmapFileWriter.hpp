@@ -0,0 +1,241 @@
+#pragma once
+#ifndef _LOGIT_MMAP_FILE_WRITER_HPP_INCLUDED
+#define _LOGIT_MMAP_FILE_WRITER_HPP_INCLUDED
+
+/// \file MmapFileWriter.hpp
+/// \brief Append-only file writer that copies records into a memory-mapped window.
+
+#if !defined(_WIN32)
+
+#include "IFileWriter.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace logit { namespace detail {
+
+    /// \class MmapFileWriter
+    /// \brief Appends by `memcpy` into a shared mapping of a preallocated file.
+    ///
+    /// The file is grown in large extents with `fallocate` (or `ftruncate` where the file
+    /// system does not support it) and written through a sliding window mapped with `mmap`.
+    /// Writes do not issue system calls until the window has to move, and the file size is
+    /// only updated when an extent is added. If the extent cannot be allocated, for example
+    /// on a full disk, the write throws instead of mapping a hole. On `close()` the file is truncated to the bytes actually
+    /// written. While the file is open, readers see a zero-filled tail after the last record.
+    ///
+    /// Text logs that were not closed cleanly keep that zero tail; `trim_zero_tail` makes
+    /// `open()` continue after the last non-zero byte instead.
+    class MmapFileWriter : public IFileWriter {
+    public:
+        /// \brief Constructor.
+        /// \param extent_bytes Bytes added to the file at a time.
+        /// \param window_bytes Size of the mapped window, rounded up to whole pages.
+        /// \param trim_zero_tail Drop trailing zero bytes left by an unclean shutdown on open.
+        MmapFileWriter(uint64_t extent_bytes, size_t window_bytes, bool trim_zero_tail)
+            : m_trim_zero_tail(trim_zero_tail) {
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            if (window_bytes < page) window_bytes = page;
+            m_window_size = (window_bytes + page - 1) / page * page;
+            m_extent = extent_bytes < m_window_size ? m_window_size : extent_bytes;
+        }
+
+        MmapFileWriter(const MmapFileWriter&) = delete;
+        MmapFileWriter& operator=(const MmapFileWriter&) = delete;
+
+        /// \brief Unmaps the window, truncates the file and closes it.
+        ~MmapFileWriter() override {
+            try {
+                close();
+            } catch (...) {}
+        }
+
+        /// \brief Opens a file; `buffer_size` is not used, the mapping is the buffer.
+        bool open(const std::string& path, size_t buffer_size) override {
+            (void)buffer_size;
+            close();
+            m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (m_fd < 0) return false;
+            struct stat st;
+            if (::fstat(m_fd, &st) != 0) {
+                close_descriptor(m_fd);
+                m_fd = -1;
+                return false;
+            }
+            m_allocated = static_cast<uint64_t>(st.st_size);
+            m_length = m_trim_zero_tail ? data_length(m_allocated) : m_allocated;
+            return true;
+        }
+
+        bool is_open() const override { return m_fd >= 0; }
+
+        /// \brief Always true: written data is already in the page cache.
+        bool empty() const override { return true; }
+
+        /// \brief Returns the number of bytes written, excluding the preallocated tail.
+        uint64_t file_size() const override { return m_length; }
+
+        void write(const char* data, size_t size) override {
+            append(data, size);
+        }
+
+        void write_line(const char* data, size_t size) override {
+            static const char line_break = '\n';
+            append(data, size);
+            append(&line_break, 1);
+        }
+
+        /// \brief Nothing to submit; the mapping is shared with the page cache.
+        void flush() override {}
+
+        /// \brief Nothing to wait for; the mapping is shared with the page cache.
+        void drain() override {}
+
+        /// \brief Writes the mapped window back and syncs the file data.
+        void sync() override {
+            if (m_fd < 0) return;
+            if (m_map && ::msync(m_map, m_window_size, MS_SYNC) != 0) {
+                throw std::system_error(errno, std::generic_category(), "Failed to sync log file");
+            }
+            if (!sync_descriptor(m_fd)) {
+                throw std::system_error(errno, std::generic_category(), "Failed to sync log file");
+            }
+        }
+
+        int duplicate() const override {
+            return duplicate_descriptor(m_fd);
+        }
+
+        /// \brief Unmaps the window, truncates the file to its real length and closes it.
+        void close() override {
+            if (m_fd < 0) return;
+            unmap();
+            int error = 0;
+            if (m_allocated != m_length && ::ftruncate(m_fd, static_cast<off_t>(m_length)) != 0) {
+                error = errno;
+            }
+            close_descriptor(m_fd);
+            m_fd = -1;
+            m_allocated = m_length = 0;
+            if (error) throw std::system_error(error, std::generic_category(), "Failed to truncate log file");
+        }
+
+        FileWriteStats stats() const override {
+            FileWriteStats stats;
+            stats.flushes = m_remaps.load(std::memory_order_relaxed);
+            stats.write_calls = m_syscalls.load(std::memory_order_relaxed);
+            stats.bytes_written = m_bytes_written.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        bool     m_trim_zero_tail;      ///< Continue after the last non-zero byte on open.
+        size_t   m_window_size = 0;     ///< Size of the mapped window.
+        uint64_t m_extent = 0;          ///< Preallocation step.
+        int      m_fd = -1;             ///< Descriptor of the open file.
+        uint64_t m_length = 0;          ///< Bytes written to the file.
+        uint64_t m_allocated = 0;       ///< Current size of the file including the preallocated tail.
+        char*    m_map = nullptr;       ///< Mapped window.
+        uint64_t m_window_start = 0;    ///< File offset of the mapped window.
+        std::atomic<uint64_t> m_remaps        = ATOMIC_VAR_INIT(0); ///< Window moves.
+        std::atomic<uint64_t> m_syscalls      = ATOMIC_VAR_INIT(0); ///< `mmap`, `munmap` and allocation calls.
+        std::atomic<uint64_t> m_bytes_written = ATOMIC_VAR_INIT(0); ///< Bytes copied into the mapping.
+
+        /// \brief Copies data into the mapping, moving the window as needed.
+        void append(const char* data, size_t size) {
+            if (m_fd < 0) return;
+            while (size > 0) {
+                if (!m_map || m_length >= m_window_start + m_window_size) map_window();
+                const uint64_t room = m_window_start + m_window_size - m_length;
+                const size_t chunk = size < room ? size : static_cast<size_t>(room);
+                std::memcpy(m_map + (m_length - m_window_start), data, chunk);
+                m_length += chunk;
+                data += chunk;
+                size -= chunk;
+                m_bytes_written.fetch_add(chunk, std::memory_order_relaxed);
+            }
+        }
+
+        /// \brief Maps the window containing the current end of data.
+        void map_window() {
+            unmap();
+            const uint64_t start = m_length - m_length % m_window_size;
+            reserve(start + m_window_size);
+            void* map = ::mmap(nullptr, m_window_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                               m_fd, static_cast<off_t>(start));
+            m_syscalls.fetch_add(1, std::memory_order_relaxed);
+            if (map == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "Failed to map log file");
+            }
+            m_map = static_cast<char*>(map);
+            m_window_start = start;
+            m_remaps.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// \brief Releases the current window.
+        void unmap() {
+            if (!m_map) return;
+            ::munmap(m_map, m_window_size);
+            m_syscalls.fetch_add(1, std::memory_order_relaxed);
+            m_map = nullptr;
+        }
+
+        /// \brief Grows the file by whole extents until it covers `end` bytes.
+        void reserve(uint64_t end) {
+            if (end <= m_allocated) return;
+            uint64_t target = m_allocated + m_extent;
+            if (target < end) target = end;
+            target = (target + m_window_size - 1) / m_window_size * m_window_size;
+            int error = EOPNOTSUPP;
+#           if defined(__linux__)
+            if (::fallocate(m_fd, 0, static_cast<off_t>(m_allocated), static_cast<off_t>(target - m_allocated)) == 0) {
+                error = 0;
+            } else {
+                error = errno;
+            }
+            m_syscalls.fetch_add(1, std::memory_order_relaxed);
+#           endif
+            // Only a file system without fallocate support gets a sparse extension: after
+            // ENOSPC or EDQUOT, stores into the mapped hole would raise SIGBUS instead.
+            if (error == EOPNOTSUPP || error == ENOSYS) {
+                error = ::ftruncate(m_fd, static_cast<off_t>(target)) == 0 ? 0 : errno;
+                m_syscalls.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (error != 0) {
+                throw std::system_error(error, std::generic_category(), "Failed to preallocate log file");
+            }
+            m_allocated = target;
+        }
+
+        /// \brief Returns the file length without its zero-filled tail.
+        uint64_t data_length(uint64_t size) const {
+            char chunk[4096];
+            uint64_t end = size;
+            while (end > 0) {
+                const size_t count = end < sizeof(chunk) ? static_cast<size_t>(end) : sizeof(chunk);
+                const uint64_t start = end - count;
+                if (::pread(m_fd, chunk, count, static_cast<off_t>(start)) != static_cast<ssize_t>(count)) {
+                    return size;
+                }
+                for (size_t i = count; i > 0; --i) {
+                    if (chunk[i - 1] != 0) return start + i;
+                }
+                end = start;
+            }
+            return 0;
+        }
+    }; // class MmapFileWriter
+
+}} // namespace logit::detail
+
+#endif // !defined(_WIN32)
+
+#endif // _LOGIT_MMAP_FILE_WRITER_HPP_INCLUDED
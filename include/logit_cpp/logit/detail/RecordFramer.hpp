@@ -0,0 +1,90 @@
+#pragma once
+#ifndef _LOGIT_RECORD_FRAMER_HPP_INCLUDED
+#define _LOGIT_RECORD_FRAMER_HPP_INCLUDED
+
+/// \file RecordFramer.hpp
+/// \brief Builds the frames of `FileLogger::Config::framed` logs and recovers their files.
+
+#include "FramedLog.hpp"
+#include "CompressionWorker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace logit { namespace detail {
+
+    /// \class RecordFramer
+    /// \brief Collects the payload of one record and wraps it in a frame.
+    ///
+    /// Between `begin()` and `end()` the logger appends the bytes of a record instead of
+    /// writing them; `frame()` then holds header and payload for one write call. Sequence
+    /// numbers continue those found by `recover()`, or come from a counter shared with
+    /// other processes (`share_sequence()`). The class is not thread-safe.
+    class RecordFramer {
+    public:
+        /// \brief Cuts off a torn tail of a framed log and continues its sequence numbers.
+        /// \param path Path of the log file (UTF-8).
+        /// \return False if the file holds content that is not framed.
+        /// \throws std::runtime_error if the file cannot be read or truncated.
+        bool recover(const std::string& path) {
+#           if defined(_WIN32)
+            if (file_size_of(utf8_to_ansi(path)) == 0) return true;
+#           else
+            if (file_size_of(path) == 0) return true;
+#           endif
+            const FrameScanResult result = recover_framed_log(path);
+            if (!result.framed) return false;
+            if (result.torn_tail() || !result.gaps.empty()) {
+                std::cerr << "Recovered framed log " << path << ": cut "
+                          << (result.file_size - result.valid_size) << " bytes of a torn tail, found "
+                          << result.gaps.size() << " gaps" << std::endl;
+            }
+            if (result.records > 0) m_sequence = (std::max)(m_sequence, result.last_sequence);
+            return true;
+        }
+
+        /// \brief Takes sequence numbers from a counter shared with other processes.
+        /// \param sequence Last sequence number in use; null returns to the own counter.
+        void share_sequence(std::atomic<uint64_t>* sequence) { m_shared_sequence = sequence; }
+
+        /// \brief Starts collecting the payload of a record.
+        void begin() {
+            m_frame.assign(kFrameHeaderSize, '\0');
+            m_capture = true;
+        }
+
+        /// \brief Returns true between `begin()` and `end()`.
+        bool capturing() const { return m_capture; }
+
+        /// \brief Appends payload bytes.
+        void append(const char* data, size_t size) { m_frame.append(data, size); }
+
+        /// \brief Ends the payload and fills the header; payloads longer than `kFrameMaxPayload` are cut.
+        /// \return False if the payload is empty and nothing is to be written.
+        bool end() {
+            m_capture = false;
+            if (m_frame.size() == kFrameHeaderSize) return false;
+            if (m_frame.size() > kFrameHeaderSize + kFrameMaxPayload) {
+                m_frame.resize(kFrameHeaderSize + kFrameMaxPayload);
+            }
+            const uint64_t sequence = m_shared_sequence ? m_shared_sequence->fetch_add(1) + 1 : ++m_sequence;
+            make_frame_header(&m_frame[0], sequence, m_frame.data() + kFrameHeaderSize,
+                              m_frame.size() - kFrameHeaderSize);
+            return true;
+        }
+
+        /// \brief Returns the frame completed by `end()`.
+        const std::string& frame() const { return m_frame; }
+
+    private:
+        std::string m_frame;                ///< Header followed by the payload of the current record.
+        uint64_t    m_sequence = 0;         ///< Sequence number of the last framed record.
+        std::atomic<uint64_t>* m_shared_sequence = nullptr; ///< Counter shared with other processes, if any.
+        bool        m_capture = false;      ///< `begin()` was called without `end()`.
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_RECORD_FRAMER_HPP_INCLUDED
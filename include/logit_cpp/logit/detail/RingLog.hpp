@@ -0,0 +1,179 @@
+#pragma once
+#ifndef _LOGIT_RING_LOG_HPP_INCLUDED
+#define _LOGIT_RING_LOG_HPP_INCLUDED
+
+/// \file RingLog.hpp
+/// \brief File format of `RingFileLogger` and the reader that restores record order.
+///
+/// \code
+/// [header, kRingHeaderSize bytes]
+/// [data area of `capacity` bytes, overwritten as a circular buffer]
+/// \endcode
+///
+/// The header starts with the magic "LOGITRNG", followed by the format version, the
+/// header size, the capacity, the write cursor, the number of completed laps and the
+/// last sequence number, as 32/64-bit integers in host byte order. Records in the data
+/// area are frames as in `FramedLog.hpp`, each starting at a multiple of
+/// `kRingAlignment`; a frame never wraps, the rest of the lap is zero-filled instead.
+/// Readers order records by their sequence numbers, so the cursor is only a hint and
+/// a record written just before the process died is found even if the header was not
+/// updated.
+
+#include "FramedLog.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \struct RingScanResult
+    /// \brief Summary of a ring log file.
+    struct RingScanResult {
+        bool     valid = false;       ///< The file has a ring log header.
+        uint64_t capacity = 0;        ///< Size of the data area.
+        uint64_t generation = 0;      ///< Laps completed according to the header.
+        uint64_t records = 0;         ///< Number of valid records.
+        uint64_t first_sequence = 0;  ///< Sequence number of the oldest record.
+        uint64_t last_sequence = 0;   ///< Sequence number of the newest record.
+    };
+
+namespace detail {
+
+    static const char kRingLogMagic[8] = { 'L', 'O', 'G', 'I', 'T', 'R', 'N', 'G' }; ///< Magic of a ring log.
+    const uint32_t kRingLogVersion = 1;    ///< Current format version.
+    const size_t   kRingHeaderSize = 4096; ///< Bytes before the data area; one page.
+    const size_t   kRingAlignment  = 8;    ///< Alignment of frames in the data area.
+
+    /// \struct RingLogHeader
+    /// \brief Header at the start of a ring log file.
+    struct RingLogHeader {
+        char     magic[8];    ///< `kRingLogMagic`.
+        uint32_t version;     ///< `kRingLogVersion`.
+        uint32_t header_size; ///< `kRingHeaderSize`.
+        uint64_t capacity;    ///< Size of the data area.
+        uint64_t cursor;      ///< Offset of the next record in the data area.
+        uint64_t generation;  ///< Laps completed.
+        uint64_t sequence;    ///< Sequence number of the last record.
+    };
+
+    /// \brief Returns the bytes a record occupies in the data area.
+    inline uint64_t ring_frame_size(uint64_t payload_size) {
+        const uint64_t size = kFrameHeaderSize + payload_size;
+        return (size + kRingAlignment - 1) / kRingAlignment * kRingAlignment;
+    }
+
+    /// \brief Checks whether a valid frame starts at `data`.
+    /// \param data Start of the candidate frame.
+    /// \param available Bytes from `data` to the end of the data area.
+    /// \param sequence Receives the sequence number.
+    /// \param size Receives the payload size.
+    /// \return True if the frame is complete and its checksum matches.
+    inline bool parse_ring_frame(const char* data, uint64_t available, uint64_t& sequence, uint64_t& size) {
+        if (available < kFrameHeaderSize) return false;
+        BinaryCursor header(data, kFrameHeaderSize);
+        uint64_t crc = 0;
+        header.get_fixed(crc, 4);
+        header.get_fixed(size, 4);
+        header.get_fixed(sequence, 8);
+        if (sequence == 0 || size > available - kFrameHeaderSize) return false;
+        return crc32c_extend(crc32c(data + 4, 12), data + kFrameHeaderSize, static_cast<size_t>(size)) == crc;
+    }
+
+    /// \brief Returns true if `header` describes a ring log of this version.
+    inline bool is_ring_log_header(const RingLogHeader& header) {
+        return std::memcmp(header.magic, kRingLogMagic, sizeof(kRingLogMagic)) == 0 &&
+               header.version == kRingLogVersion && header.header_size == kRingHeaderSize &&
+               header.capacity >= kRingAlignment && header.capacity % kRingAlignment == 0 &&
+               header.cursor <= header.capacity;
+    }
+
+    /// \struct RingFrameRef
+    /// \brief Position of a valid record in the data area.
+    struct RingFrameRef {
+        uint64_t sequence; ///< Sequence number.
+        uint64_t offset;   ///< Offset of the frame in the data area.
+        uint64_t size;     ///< Payload size.
+    };
+
+    /// \brief Finds all valid records of a data area, oldest first.
+    ///
+    /// Damaged or partly overwritten frames are skipped in steps of `kRingAlignment`.
+    inline std::vector<RingFrameRef> find_ring_frames(const char* data, uint64_t capacity) {
+        std::vector<RingFrameRef> frames;
+        uint64_t offset = 0;
+        while (offset + kFrameHeaderSize <= capacity) {
+            RingFrameRef frame;
+            frame.offset = offset;
+            if (parse_ring_frame(data + offset, capacity - offset, frame.sequence, frame.size)) {
+                frames.push_back(frame);
+                offset += ring_frame_size(frame.size);
+            } else {
+                offset += kRingAlignment;
+            }
+        }
+        std::sort(frames.begin(), frames.end(), [](const RingFrameRef& a, const RingFrameRef& b) {
+            return a.sequence < b.sequence;
+        });
+        return frames;
+    }
+
+} // namespace detail
+
+    /// \brief Reads a ring log and passes its records to a callback in chronological order.
+    /// \tparam Callback Callable accepting `(uint64_t sequence, const char* data, size_t size)`.
+    /// \param path Path of the file (UTF-8).
+    /// \param callback Receives the payloads, oldest first.
+    /// \return Summary of the file; `valid` is false if it is not a ring log.
+    /// \throws std::runtime_error if the file cannot be opened.
+    template <typename Callback>
+    RingScanResult scan_ring_log(const std::string& path, Callback callback) {
+        RingScanResult result;
+#       if defined(_WIN32)
+        std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary);
+#       else
+        std::ifstream file(path.c_str(), std::ios::binary);
+#       endif
+        if (!file) throw std::runtime_error("Failed to open ring log: " + path);
+        detail::RingLogHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !detail::is_ring_log_header(header)) {
+            return result;
+        }
+        result.valid = true;
+        result.capacity = header.capacity;
+        result.generation = header.generation;
+        std::vector<char> data(static_cast<size_t>(header.capacity));
+        file.seekg(static_cast<std::streamoff>(detail::kRingHeaderSize));
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        const uint64_t got = static_cast<uint64_t>(file.gcount());
+        const std::vector<detail::RingFrameRef> frames = detail::find_ring_frames(data.data(), got);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            const detail::RingFrameRef& frame = frames[i];
+            callback(frame.sequence, data.data() + frame.offset + detail::kFrameHeaderSize,
+                     static_cast<size_t>(frame.size));
+        }
+        result.records = frames.size();
+        if (!frames.empty()) {
+            result.first_sequence = frames.front().sequence;
+            result.last_sequence = frames.back().sequence;
+        }
+        return result;
+    }
+
+    /// \brief Returns the records of a ring log, oldest first, concatenated.
+    /// \throws std::runtime_error if the file cannot be opened or is not a ring log.
+    inline std::string read_ring_log(const std::string& path) {
+        std::string out;
+        const RingScanResult result = scan_ring_log(path, [&out](uint64_t, const char* data, size_t size) {
+            out.append(data, size);
+        });
+        if (!result.valid) throw std::runtime_error("Not a ring log: " + path);
+        return out;
+    }
+
+}; // namespace logit
+
+#endif // _LOGIT_RING_LOG_HPP_INCLUDED
@@ -0,0 +1,276 @@
+#pragma once
+#ifndef _LOGIT_SHARED_LOG_STATE_HPP_INCLUDED
+#define _LOGIT_SHARED_LOG_STATE_HPP_INCLUDED
+
+/// \file SharedLogState.hpp
+/// \brief State of a log directory shared by several processes (`FileLogger::Config::shared`).
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#if !defined(_WIN32)
+#   include <fcntl.h>
+#   include <sys/file.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace logit { namespace detail {
+
+    /// \struct SharedLogHeader
+    /// \brief Counters mapped from the state file into every writing process.
+    struct SharedLogHeader {
+        uint32_t magic;                   ///< `SharedLogState::magic` once initialized.
+        uint32_t version;                 ///< Layout version.
+        std::atomic<int64_t>  date_ts;    ///< Date of the current log file.
+        std::atomic<uint64_t> generation; ///< Incremented whenever the current file is replaced.
+        std::atomic<uint64_t> size;       ///< Bytes written or reserved in the current file.
+        std::atomic<uint64_t> sequence;   ///< Last sequence number of framed records.
+    };
+
+    /// \class SharedLogState
+    /// \brief Lock file with a shared-memory header that coordinates rotation between processes.
+    ///
+    /// The file is mapped with `MAP_SHARED`, so the counters are updated with atomic
+    /// operations without system calls. Writers hold a shared `flock` on the same file
+    /// (`lock_shared()`) from checking the generation until their record is written;
+    /// rotation takes the exclusive lock (`lock()`), so no process appends to a file
+    /// while it is renamed and compressed. Locks nest within a process, and an exclusive
+    /// lock taken while the shared one is held upgrades it; `flock` drops the shared lock
+    /// first, so state read before the upgrade has to be checked again. The class is not
+    /// thread-safe. On Windows `open()` fails and the locks do nothing.
+    class SharedLogState {
+    public:
+        static const uint32_t magic = 0x4C475348; ///< "HSGL" in little-endian order.
+        static const uint32_t version = 1;        ///< Current layout version.
+
+        SharedLogState() = default;
+        SharedLogState(const SharedLogState&) = delete;
+        SharedLogState& operator=(const SharedLogState&) = delete;
+
+        ~SharedLogState() { close(); }
+
+        /// \brief Opens or creates the state file and maps its header.
+        /// \param path File path (UTF-8).
+        /// \return True on success.
+        bool open(const std::string& path) {
+            close();
+#           if defined(_WIN32)
+            (void)path;
+            return false;
+#           else
+            m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (m_fd < 0) return false;
+            lock();
+            bool ok = false;
+            struct stat st;
+            if (::fstat(m_fd, &st) == 0 &&
+                (static_cast<size_t>(st.st_size) >= sizeof(SharedLogHeader) ||
+                 ::ftruncate(m_fd, sizeof(SharedLogHeader)) == 0)) {
+                void* map = ::mmap(nullptr, sizeof(SharedLogHeader), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+                if (map != MAP_FAILED) {
+                    m_header = static_cast<SharedLogHeader*>(map);
+                    if (m_header->magic != magic || m_header->version != version) {
+                        m_header->date_ts.store(-1);
+                        m_header->generation.store(1);
+                        m_header->size.store(0);
+                        m_header->sequence.store(0);
+                        m_header->version = version;
+                        m_header->magic = magic;
+                    }
+                    ok = true;
+                }
+            }
+            unlock();
+            if (!ok) close();
+            return ok;
+#           endif
+        }
+
+        /// \brief Unmaps the header and closes the file.
+        void close() {
+#           if !defined(_WIN32)
+            if (m_header) ::munmap(m_header, sizeof(SharedLogHeader));
+            m_header = nullptr;
+            if (m_fd >= 0) ::close(m_fd);
+#           endif
+            m_fd = -1;
+            m_lock_depth = 0;
+            m_exclusive_depth = 0;
+        }
+
+        /// \brief Returns true if the header is mapped.
+        bool is_open() const { return m_header != nullptr; }
+
+        /// \brief Returns the mapped header.
+        SharedLogHeader& header() { return *m_header; }
+
+        /// \brief Takes the exclusive lock, waiting for other processes; does nothing if closed.
+        void lock() {
+            if (m_fd < 0) return;
+            ++m_lock_depth;
+            if (m_exclusive_depth++ > 0) return;
+            take(LockMode::Exclusive);
+        }
+
+        /// \brief Releases a lock taken by `lock()`, returning to a held shared lock.
+        void unlock() {
+            if (m_fd < 0 || m_exclusive_depth == 0) return;
+            --m_lock_depth;
+            if (--m_exclusive_depth > 0) return;
+            take(m_lock_depth > 0 ? LockMode::Shared : LockMode::None);
+        }
+
+        /// \brief Takes the shared lock of a writer; does nothing if closed.
+        void lock_shared() {
+            if (m_fd < 0 || m_lock_depth++ > 0) return;
+            take(LockMode::Shared);
+        }
+
+        /// \brief Releases a lock taken by `lock_shared()`.
+        void unlock_shared() {
+            if (m_fd < 0 || m_lock_depth == 0 || --m_lock_depth > 0) return;
+            take(LockMode::None);
+        }
+
+    private:
+        /// \brief Lock held by the process.
+        enum class LockMode { None, Shared, Exclusive };
+
+        int              m_fd = -1;           ///< Descriptor of the state file.
+        SharedLogHeader* m_header = nullptr;  ///< Mapped header.
+        int              m_lock_depth = 0;    ///< Nesting depth of all locks.
+        int              m_exclusive_depth = 0; ///< Nesting depth of `lock()`.
+
+        /// \brief Changes the `flock` of the descriptor, waiting for other processes.
+        void take(LockMode mode) {
+#           if !defined(_WIN32)
+            const int operation = mode == LockMode::Exclusive ? LOCK_EX
+                                : (mode == LockMode::Shared ? LOCK_SH : LOCK_UN);
+            while (::flock(m_fd, operation) != 0 && errno == EINTR) {}
+#           else
+            (void)mode;
+#           endif
+        }
+    };
+
+    /// \class SharedLogLock
+    /// \brief Holds a lock of a `SharedLogState` for a scope.
+    class SharedLogLock {
+    public:
+        /// \param state Locked state.
+        /// \param exclusive False for the shared lock of a writer.
+        explicit SharedLogLock(SharedLogState& state, bool exclusive = true)
+            : m_state(state), m_exclusive(exclusive) {
+            if (m_exclusive) m_state.lock();
+            else m_state.lock_shared();
+        }
+
+        ~SharedLogLock() {
+            if (m_exclusive) m_state.unlock();
+            else m_state.unlock_shared();
+        }
+
+        SharedLogLock(const SharedLogLock&) = delete;
+        SharedLogLock& operator=(const SharedLogLock&) = delete;
+
+    private:
+        SharedLogState& m_state;
+        bool            m_exclusive;
+    };
+
+    /// \class SharedFileCoordinator
+    /// \brief Tracks the current file of a log directory written by several processes.
+    ///
+    /// The shared header holds the date, size and generation of the current file. A process
+    /// remembers the generation of the file it has open; once another process rotates the
+    /// file or starts a new day, `replaced()` tells the writer to reopen it. Record sizes
+    /// are reserved in the shared size, so size rotation happens once across processes.
+    /// Callers hold the locks of `state()` as documented on each method. Without `open()`
+    /// every method leaves the decisions to the local state of the caller.
+    class SharedFileCoordinator {
+    public:
+        /// \brief Opens the shared state file.
+        /// \param path File path (UTF-8).
+        /// \return True on success.
+        bool open(const std::string& path) { return m_state.open(path); }
+
+        /// \brief Returns true if the shared state is open.
+        bool is_open() const { return m_state.is_open(); }
+
+        /// \brief Returns the state whose locks guard the current file.
+        SharedLogState& state() { return m_state; }
+
+        /// \brief Returns the counter of framed record sequence numbers, or null if not open.
+        std::atomic<uint64_t>* sequence() { return is_open() ? &m_state.header().sequence : nullptr; }
+
+        /// \brief Returns true if another process has replaced the open file; needs a lock.
+        bool replaced() {
+            return is_open() && m_state.header().generation.load() != m_generation;
+        }
+
+        /// \brief Publishes a newly opened file of a later date to the other processes.
+        ///
+        /// Called with the exclusive lock held. A process still writing an earlier date does
+        /// not move the shared state back.
+        /// \param date_ts Date of the opened file.
+        /// \param size Size of the opened file.
+        void publish(int64_t date_ts, uint64_t size) {
+            if (!is_open()) return;
+            SharedLogHeader& header = m_state.header();
+            if (date_ts > header.date_ts.load()) {
+                header.date_ts.store(date_ts);
+                header.size.store(size);
+                header.generation.fetch_add(1);
+            }
+            m_generation = header.generation.load();
+        }
+
+        /// \brief Returns the size of the current file counted across processes.
+        /// \param date_ts Date of the file the caller has open.
+        /// \param local_size Size known to the caller, returned for files of other dates.
+        uint64_t file_size(int64_t date_ts, uint64_t local_size) {
+            if (is_open() && m_state.header().date_ts.load() == date_ts) {
+                return m_state.header().size.load();
+            }
+            return local_size;
+        }
+
+        /// \brief Counts a record in the shared size of the current file; needs a lock.
+        /// \param date_ts Date of the file the caller has open; files of an earlier day are not rotated.
+        /// \param size Bytes of the record.
+        /// \param max_size Size limit of a file (0 = none).
+        /// \param empty_size Size of a file without records; such a file takes any record.
+        /// \return False if the record does not fit and the file has to be rotated first;
+        /// nothing is reserved then.
+        bool reserve(int64_t date_ts, uint64_t size, uint64_t max_size, uint64_t empty_size) {
+            SharedLogHeader& header = m_state.header();
+            if (header.date_ts.load() != date_ts) return true;
+            // A record that does not fit is not counted, so it cannot push other processes over the limit.
+            uint64_t before = header.size.load();
+            for (;;) {
+                if (max_size != 0 && before + size > max_size && before > empty_size) return false;
+                if (header.size.compare_exchange_weak(before, before + size)) return true;
+            }
+        }
+
+        /// \brief Records the rotation of the current file; needs the exclusive lock.
+        /// \param date_ts Date of the rotated file.
+        /// \param size Size of the file that replaced it.
+        void rotated(int64_t date_ts, uint64_t size) {
+            SharedLogHeader& header = m_state.header();
+            if (header.date_ts.load() != date_ts) return;
+            header.size.store(size);
+            m_generation = header.generation.fetch_add(1) + 1;
+        }
+
+    private:
+        SharedLogState m_state;          ///< Lock file and mapped header.
+        uint64_t       m_generation = 0; ///< Generation of the shared state the open file belongs to.
+    };
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_SHARED_LOG_STATE_HPP_INCLUDED
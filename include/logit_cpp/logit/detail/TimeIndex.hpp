@@ -0,0 +1,247 @@
+#pragma once
+#ifndef _LOGIT_TIME_INDEX_HPP_INCLUDED
+#define _LOGIT_TIME_INDEX_HPP_INCLUDED
+
+/// \file TimeIndex.hpp
+/// \brief Sparse time index stored beside a log file.
+///
+/// The index of `2024-05-01.log` (or of its compressed copy `2024-05-01.log.gz`) is
+/// `2024-05-01.log.idx`:
+///
+/// \code
+/// [u32 0x5849474C "LGIX"][u32 version]
+/// [i64 timestamp ms][u64 offset] x N
+/// \endcode
+///
+/// All integers are little-endian. An entry points at the first byte of a record in the
+/// uncompressed content of the log file, so offsets remain valid after compression.
+/// Entries are appended in file order; a partial entry left by a crash is ignored.
+
+#include "../utils/binary_codec.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \struct TimeIndexEntry
+    /// \brief Position of one indexed record.
+    struct TimeIndexEntry {
+        int64_t  timestamp_ms = 0; ///< Timestamp of the record.
+        uint64_t offset = 0;       ///< Offset of the record in the uncompressed content.
+    };
+
+namespace detail {
+
+    const uint32_t kTimeIndexMagic     = 0x5849474CU; ///< Magic of a time index ("LGIX").
+    const uint32_t kTimeIndexVersion   = 1;           ///< Version of the index layout.
+    const size_t   kTimeIndexHeaderSize = 8;          ///< Bytes before the first entry.
+    const size_t   kTimeIndexEntrySize = 16;          ///< Bytes per entry.
+
+    /// \brief Returns the index path of a log file, ignoring a compression suffix.
+    inline std::string time_index_path(const std::string& log_path) {
+        static const char* const suffixes[] = { ".gz", ".zst" };
+        for (const char* suffix : suffixes) {
+            const std::string text(suffix);
+            if (log_path.size() > text.size() &&
+                log_path.compare(log_path.size() - text.size(), text.size(), text) == 0) {
+                return log_path.substr(0, log_path.size() - text.size()) + ".idx";
+            }
+        }
+        return log_path + ".idx";
+    }
+
+    /// \brief Checks whether a file name belongs to a time index.
+    inline bool is_time_index_name(const std::string& name) {
+        return name.size() > 4 && name.compare(name.size() - 4, 4, ".idx") == 0;
+    }
+
+    /// \brief Reads a time index.
+    /// \param path Index path (UTF-8).
+    /// \param entries Receives the entries.
+    /// \return False if the file is missing or is not a time index.
+    inline bool read_time_index(const std::string& path, std::vector<TimeIndexEntry>& entries) {
+        entries.clear();
+#       if defined(_WIN32)
+        std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary);
+#       else
+        std::ifstream file(path.c_str(), std::ios::binary);
+#       endif
+        if (!file) return false;
+        char header[kTimeIndexHeaderSize];
+        if (!file.read(header, sizeof(header))) return false;
+        BinaryCursor header_cursor(header, sizeof(header));
+        uint64_t magic = 0;
+        uint64_t version = 0;
+        header_cursor.get_fixed(magic, 4);
+        header_cursor.get_fixed(version, 4);
+        if (magic != kTimeIndexMagic || version > kTimeIndexVersion) return false;
+        char raw[kTimeIndexEntrySize];
+        while (file.read(raw, sizeof(raw))) {
+            BinaryCursor cursor(raw, sizeof(raw));
+            uint64_t ts = 0;
+            TimeIndexEntry entry;
+            cursor.get_fixed(ts, 8);
+            cursor.get_fixed(entry.offset, 8);
+            entry.timestamp_ms = static_cast<int64_t>(ts);
+            entries.push_back(entry);
+        }
+        return true;
+    }
+
+    /// \class TimeIndexWriter
+    /// \brief Appends index entries for the records of one log file.
+    ///
+    /// The first record after `open()` is always indexed; later records are indexed once
+    /// `every_records` records or `interval_ms` milliseconds have passed since the last
+    /// entry. Entries are flushed immediately, so the index is at most one entry behind
+    /// the log after a crash.
+    class TimeIndexWriter {
+    public:
+        /// \brief Opens the index of a log file.
+        ///
+        /// Entries of an existing index that point past `content_size` belong to content
+        /// that is gone and are dropped.
+        /// \param log_path Path of the log file (UTF-8).
+        /// \param content_size Current size of the uncompressed log content.
+        /// \param every_records Records between entries (0 = time only).
+        /// \param interval_ms Milliseconds between entries (0 = count only).
+        /// \return True if the index is open.
+        bool open(const std::string& log_path, uint64_t content_size, uint32_t every_records, uint32_t interval_ms) {
+            close();
+            m_every_records = every_records;
+            m_interval_ms = interval_ms;
+            m_since_entry = 0;
+            m_has_entry = false;
+            const std::string path = time_index_path(log_path);
+            std::vector<TimeIndexEntry> entries;
+            const bool valid = read_time_index(path, entries);
+            size_t keep = 0;
+            while (keep < entries.size() && entries[keep].offset < content_size) ++keep;
+            const bool rewrite = !valid || keep != entries.size();
+            std::ios_base::openmode mode = std::ios_base::binary |
+                (rewrite ? std::ios_base::trunc : std::ios_base::app);
+#           if defined(_WIN32)
+            m_file.open(utf8_to_ansi(path).c_str(), mode | std::ios_base::out);
+#           else
+            m_file.open(path.c_str(), mode | std::ios_base::out);
+#           endif
+            if (!m_file.is_open()) return false;
+            if (rewrite) {
+                std::string data;
+                put_fixed(data, kTimeIndexMagic, 4);
+                put_fixed(data, kTimeIndexVersion, 4);
+                for (size_t i = 0; i < keep; ++i) append_entry(data, entries[i]);
+                m_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+                m_file.flush();
+            }
+            return m_file.good();
+        }
+
+        /// \brief Returns true if an index is open.
+        bool is_open() const { return m_file.is_open(); }
+
+        /// \brief Indexes a record if an entry is due.
+        /// \param timestamp_ms Timestamp of the record.
+        /// \param offset Offset of the record in the uncompressed content.
+        void add(int64_t timestamp_ms, uint64_t offset) {
+            if (!m_file.is_open()) return;
+            if (m_has_entry &&
+                !(m_every_records > 0 && m_since_entry >= m_every_records) &&
+                !(m_interval_ms > 0 && timestamp_ms - m_last_ts >= static_cast<int64_t>(m_interval_ms))) {
+                ++m_since_entry;
+                return;
+            }
+            TimeIndexEntry entry;
+            entry.timestamp_ms = timestamp_ms;
+            entry.offset = offset;
+            std::string data;
+            append_entry(data, entry);
+            m_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            m_file.flush();
+            m_has_entry = true;
+            m_last_ts = timestamp_ms;
+            m_since_entry = 1;
+        }
+
+        /// \brief Closes the index.
+        void close() {
+            if (m_file.is_open()) m_file.close();
+            m_file.clear();
+        }
+
+    private:
+        std::ofstream m_file;           ///< Open index file.
+        uint32_t m_every_records = 0;   ///< Records between entries.
+        uint32_t m_interval_ms = 0;     ///< Time between entries.
+        uint32_t m_since_entry = 0;     ///< Records since the last entry.
+        bool     m_has_entry = false;   ///< An entry was written since `open()`.
+        int64_t  m_last_ts = 0;         ///< Timestamp of the last entry.
+
+        static void append_entry(std::string& out, const TimeIndexEntry& entry) {
+            put_fixed(out, static_cast<uint64_t>(entry.timestamp_ms), 8);
+            put_fixed(out, entry.offset, 8);
+        }
+    }; // class TimeIndexWriter
+
+    /// \class FileTimeIndex
+    /// \brief Keeps the time index of the current file of a logger.
+    ///
+    /// Decides which files get an index and moves the index along when its log file is
+    /// rotated; the entries are written by a `TimeIndexWriter`. Disabled until `configure()`.
+    class FileTimeIndex {
+    public:
+        /// \brief Enables the index.
+        /// \param every_records Records between entries (0 = time only).
+        /// \param interval_ms Milliseconds between entries (0 = count only).
+        void configure(uint32_t every_records, uint32_t interval_ms) {
+            m_enabled = true;
+            m_every_records = every_records;
+            m_interval_ms = interval_ms;
+        }
+
+        /// \brief Returns true if files are indexed.
+        bool enabled() const { return m_enabled; }
+
+        /// \brief Opens the index of a newly opened log file.
+        /// \param log_path Path of the log file (UTF-8).
+        /// \param content_size Current size of the uncompressed log content.
+        /// \param offsets_known False if record offsets in the file cannot be determined,
+        /// e.g. when appending to a compressed file of a crashed process; the file is not
+        /// indexed then.
+        /// \return False if the index should have been opened but could not be.
+        bool open(const std::string& log_path, uint64_t content_size, bool offsets_known) {
+            if (!m_enabled || !offsets_known) return true;
+            return m_writer.open(log_path, content_size, m_every_records, m_interval_ms);
+        }
+
+        /// \brief Indexes a record if an entry is due.
+        void add(int64_t timestamp_ms, uint64_t offset) { m_writer.add(timestamp_ms, offset); }
+
+        /// \brief Closes the index of the current file.
+        void close() { m_writer.close(); }
+
+        /// \brief Moves the index of a rotated log file beside its new name; offsets do not change.
+        /// \param from Old path of the log file (UTF-8).
+        /// \param to New path of the log file (UTF-8).
+        void rotated(const std::string& from, const std::string& to) const {
+            if (!m_enabled) return;
+#           if defined(_WIN32)
+            std::rename(utf8_to_ansi(time_index_path(from)).c_str(), utf8_to_ansi(time_index_path(to)).c_str());
+#           else
+            std::rename(time_index_path(from).c_str(), time_index_path(to).c_str());
+#           endif
+        }
+
+    private:
+        TimeIndexWriter m_writer;          ///< Index of the current file.
+        bool            m_enabled = false; ///< Files are indexed.
+        uint32_t        m_every_records = 0; ///< Records between entries.
+        uint32_t        m_interval_ms = 0;   ///< Time between entries.
+    }; // class FileTimeIndex
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_TIME_INDEX_HPP_INCLUDED
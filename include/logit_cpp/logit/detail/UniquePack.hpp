@@ -0,0 +1,111 @@
+#pragma once
+#ifndef _LOGIT_UNIQUE_PACK_HPP_INCLUDED
+#define _LOGIT_UNIQUE_PACK_HPP_INCLUDED
+
+/// \file UniquePack.hpp
+/// \brief Segment files that hold the messages of `UniqueFileLogger` in pack mode.
+///
+/// A segment `2024-05-01_10-00-00-000-AbCdEfGh.pack` is the concatenation of the message
+/// payloads, each compressed on its own (one gzip member or zstd frame) if the logger
+/// compresses. Its index `2024-05-01_10-00-00-000-AbCdEfGh.pack.idx` is:
+///
+/// \code
+/// [u32 0x5055474C "LGUP"][u32 version][u32 compress type][u32 reserved]
+/// [u64 id][i64 timestamp ms][u64 offset][u64 length] x N
+/// \endcode
+///
+/// All integers are little-endian. Ids grow by one from 0 within a segment. An entry is
+/// appended after its payload is written, so a partial entry or one that points past the
+/// end of the segment after a crash is ignored.
+
+#include "../utils/binary_codec.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \struct UniquePackEntry
+    /// \brief Location of one message in a segment.
+    struct UniquePackEntry {
+        uint64_t id = 0;           ///< Id of the message within the segment.
+        int64_t  timestamp_ms = 0; ///< Timestamp of the record.
+        uint64_t offset = 0;       ///< Offset of the payload in the segment.
+        uint64_t length = 0;       ///< Stored (possibly compressed) size of the payload.
+    };
+
+namespace detail {
+
+    const uint32_t kUniquePackMagic      = 0x5055474CU; ///< Magic of a segment index ("LGUP").
+    const uint32_t kUniquePackVersion    = 1;           ///< Version of the index layout.
+    const size_t   kUniquePackHeaderSize = 16;          ///< Bytes before the first entry.
+    const size_t   kUniquePackEntrySize  = 32;          ///< Bytes per entry.
+
+    /// \brief Returns the index path of a segment.
+    inline std::string unique_pack_index_path(const std::string& segment_path) {
+        return segment_path + ".idx";
+    }
+
+    /// \brief Encodes the header of a segment index.
+    inline std::string encode_unique_pack_header(CompressType compress) {
+        std::string data;
+        put_fixed(data, kUniquePackMagic, 4);
+        put_fixed(data, kUniquePackVersion, 4);
+        put_fixed(data, static_cast<uint64_t>(compress), 4);
+        put_fixed(data, 0, 4);
+        return data;
+    }
+
+    /// \brief Appends an encoded index entry to `out`.
+    inline void encode_unique_pack_entry(std::string& out, const UniquePackEntry& entry) {
+        put_fixed(out, entry.id, 8);
+        put_fixed(out, static_cast<uint64_t>(entry.timestamp_ms), 8);
+        put_fixed(out, entry.offset, 8);
+        put_fixed(out, entry.length, 8);
+    }
+
+    /// \brief Reads a segment index.
+    /// \param path Index path (UTF-8).
+    /// \param compress Receives the compression of the payloads.
+    /// \param entries Receives the entries in id order.
+    /// \return False if the file is missing or is not a segment index.
+    inline bool read_unique_pack_index(const std::string& path, CompressType& compress,
+                                       std::vector<UniquePackEntry>& entries) {
+        entries.clear();
+        compress = CompressType::NONE;
+#       if defined(_WIN32)
+        std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary);
+#       else
+        std::ifstream file(path.c_str(), std::ios::binary);
+#       endif
+        if (!file) return false;
+        char header[kUniquePackHeaderSize];
+        if (!file.read(header, sizeof(header))) return false;
+        BinaryCursor header_cursor(header, sizeof(header));
+        uint64_t magic = 0;
+        uint64_t version = 0;
+        uint64_t type = 0;
+        header_cursor.get_fixed(magic, 4);
+        header_cursor.get_fixed(version, 4);
+        header_cursor.get_fixed(type, 4);
+        if (magic != kUniquePackMagic || version > kUniquePackVersion) return false;
+        compress = static_cast<CompressType>(type);
+        char raw[kUniquePackEntrySize];
+        while (file.read(raw, sizeof(raw))) {
+            BinaryCursor cursor(raw, sizeof(raw));
+            UniquePackEntry entry;
+            uint64_t ts = 0;
+            cursor.get_fixed(entry.id, 8);
+            cursor.get_fixed(ts, 8);
+            cursor.get_fixed(entry.offset, 8);
+            cursor.get_fixed(entry.length, 8);
+            entry.timestamp_ms = static_cast<int64_t>(ts);
+            entries.push_back(entry);
+        }
+        return true;
+    }
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_UNIQUE_PACK_HPP_INCLUDED
@@ -0,0 +1,195 @@
+#pragma once
+#ifndef _LOGIT_ZSTD_DICTIONARY_HPP_INCLUDED
+#define _LOGIT_ZSTD_DICTIONARY_HPP_INCLUDED
+
+/// \file ZstdDictionary.hpp
+/// \brief Trained zstd dictionaries for small log files.
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#   include <zdict.h>
+#endif
+
+namespace logit {
+
+    /// \brief Default dictionary size, the same as `zstd --train` uses.
+    const size_t kZstdDictionaryDefaultSize = 112640;
+
+    /// \class ZstdDictionary
+    /// \brief Digested zstd dictionary shared by compressors and decompressors.
+    ///
+    /// Log records repeat the same prefixes, field names and messages. A dictionary trained
+    /// on earlier output lets zstd compress a small file as if it had already seen that
+    /// text, which matters most for files of a few kilobytes. The dictionary is digested
+    /// once and may be used by several threads at the same time.
+    ///
+    /// Frames store the dictionary ID, and the same dictionary is needed to read them,
+    /// e.g. `zstd -d -D logit.zdict file.log.zst`.
+    class ZstdDictionary {
+    public:
+        /// \brief Digests dictionary content.
+        /// \param content Dictionary from `train_zstd_dictionary()` or `zstd --train`.
+        /// \param level Compression level the dictionary is prepared for.
+        /// \throws std::runtime_error if zstd support is disabled or the content is unusable.
+        ZstdDictionary(std::string content, int level) : m_content(std::move(content)) {
+#           if defined(LOGIT_HAS_ZSTD)
+            if (m_content.empty()) throw std::runtime_error("Empty zstd dictionary");
+            m_cdict = ZSTD_createCDict(m_content.data(), m_content.size(), level);
+            m_ddict = ZSTD_createDDict(m_content.data(), m_content.size());
+            if (!m_cdict || !m_ddict) {
+                release();
+                throw std::runtime_error("Invalid zstd dictionary");
+            }
+#           else
+            (void)level;
+            throw std::runtime_error("zstd support is disabled");
+#           endif
+        }
+
+        ZstdDictionary(const ZstdDictionary&) = delete;
+        ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+        ~ZstdDictionary() {
+            release();
+        }
+
+        /// \brief Loads a dictionary file.
+        /// \param path File path (UTF-8).
+        /// \param level Compression level the dictionary is prepared for.
+        /// \throws std::runtime_error if the file cannot be read or is not a usable dictionary.
+        static std::shared_ptr<const ZstdDictionary> load(const std::string& path, int level) {
+#           if defined(_WIN32)
+            std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary);
+#           else
+            std::ifstream file(path.c_str(), std::ios::binary);
+#           endif
+            if (!file) throw std::runtime_error("Failed to open zstd dictionary: " + path);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return std::make_shared<const ZstdDictionary>(std::move(content), level);
+        }
+
+        /// \brief Returns the dictionary content.
+        const std::string& content() const { return m_content; }
+
+        /// \brief Returns the dictionary ID, or 0 for a raw content dictionary.
+        uint32_t id() const {
+#           if defined(LOGIT_HAS_ZSTD)
+            return static_cast<uint32_t>(ZSTD_getDictID_fromDict(m_content.data(), m_content.size()));
+#           else
+            return 0;
+#           endif
+        }
+
+#       if defined(LOGIT_HAS_ZSTD)
+        /// \brief Makes a compression context use the dictionary for all following frames.
+        /// \return True on success.
+        bool attach(ZSTD_CCtx* cctx) const {
+            return !ZSTD_isError(ZSTD_CCtx_refCDict(cctx, m_cdict));
+        }
+
+        /// \brief Makes a decompression context use the dictionary for all following frames.
+        /// \return True on success.
+        bool attach(ZSTD_DCtx* dctx) const {
+            return !ZSTD_isError(ZSTD_DCtx_refDDict(dctx, m_ddict));
+        }
+#       endif
+
+    private:
+        std::string m_content;          ///< Dictionary content.
+#       if defined(LOGIT_HAS_ZSTD)
+        ZSTD_CDict* m_cdict = nullptr;  ///< Digested dictionary for compression.
+        ZSTD_DDict* m_ddict = nullptr;  ///< Digested dictionary for decompression.
+#       endif
+
+        void release() {
+#           if defined(LOGIT_HAS_ZSTD)
+            if (m_cdict) ZSTD_freeCDict(m_cdict);
+            if (m_ddict) ZSTD_freeDDict(m_ddict);
+            m_cdict = nullptr;
+            m_ddict = nullptr;
+#           endif
+        }
+    }; // class ZstdDictionary
+
+    /// \brief Splits log output into dictionary training samples.
+    ///
+    /// Samples end at line breaks and hold up to `sample_bytes` bytes; a longer line
+    /// becomes a sample of its own. Text shorter than `sample_bytes`, such as the content
+    /// of one `UniqueFileLogger` file, becomes a single sample.
+    /// \param text Log output.
+    /// \param sample_bytes Target sample size.
+    /// \param samples Receives the samples.
+    inline void split_dictionary_samples(const std::string& text, size_t sample_bytes,
+                                         std::vector<std::string>& samples) {
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.size();
+            if (end - start > sample_bytes) {
+                const size_t limit = start + sample_bytes;
+                const size_t line_end = text.rfind('\n', limit - 1);
+                if (line_end != std::string::npos && line_end >= start) {
+                    end = line_end + 1;
+                } else {
+                    const size_t next = text.find('\n', limit);
+                    end = next == std::string::npos ? text.size() : next + 1;
+                }
+            }
+            samples.push_back(text.substr(start, end - start));
+            start = end;
+        }
+    }
+
+    /// \brief Trains a zstd dictionary on log output.
+    /// \param samples Training samples, e.g. from `split_dictionary_samples()`.
+    /// \param capacity Maximal dictionary size in bytes.
+    /// \return Dictionary content, ready to be saved or passed to `ZstdDictionary`.
+    /// \throws std::runtime_error if zstd support is disabled or training fails,
+    /// typically because there are too few samples.
+    inline std::string train_zstd_dictionary(const std::vector<std::string>& samples,
+                                             size_t capacity = kZstdDictionaryDefaultSize) {
+#       if defined(LOGIT_HAS_ZSTD)
+        std::string buffer;
+        std::vector<size_t> sizes;
+        sizes.reserve(samples.size());
+        for (const auto& sample : samples) {
+            if (sample.empty()) continue;
+            buffer += sample;
+            sizes.push_back(sample.size());
+        }
+        if (sizes.empty()) throw std::runtime_error("No samples to train a zstd dictionary");
+        std::string dictionary(capacity, '\0');
+        const size_t size = ZDICT_trainFromBuffer(&dictionary[0], dictionary.size(), buffer.data(),
+                                                  sizes.data(), static_cast<unsigned>(sizes.size()));
+        if (ZDICT_isError(size)) {
+            throw std::runtime_error(std::string("zstd dictionary training failed: ") + ZDICT_getErrorName(size));
+        }
+        dictionary.resize(size);
+        return dictionary;
+#       else
+        (void)samples; (void)capacity;
+        throw std::runtime_error("zstd support is disabled");
+#       endif
+    }
+
+namespace detail {
+
+    /// \brief Resolves a dictionary path against a log directory.
+    /// \return `path` if it is absolute, otherwise `directory/path`.
+    inline std::string resolve_dictionary_path(const std::string& directory, const std::string& path) {
+        const bool absolute = (!path.empty() && (path[0] == '/' || path[0] == '\\')) ||
+                              (path.size() > 1 && path[1] == ':');
+        if (absolute) return path;
+        return directory + "/" + path;
+    }
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_ZSTD_DICTIONARY_HPP_INCLUDED
@@ -0,0 +1,140 @@
+#pragma once
+#ifndef _LOGIT_ZSTD_SEEK_TABLE_HPP_INCLUDED
+#define _LOGIT_ZSTD_SEEK_TABLE_HPP_INCLUDED
+
+/// \file ZstdSeekTable.hpp
+/// \brief Frame index stored at the end of seekable zstd log files.
+///
+/// The table is a zstd skippable frame, so any zstd decoder still reads the file as a
+/// plain stream:
+///
+/// \code
+/// [u32 0x184D2A5E][u32 payload size]
+/// [i64 first timestamp ms][u32 compressed size][u32 decompressed size] x N
+/// [u32 N][u32 0x4B53474C "LGSK"]
+/// \endcode
+///
+/// All integers are little-endian. Entry `i` describes the `i`-th zstd frame of the file;
+/// frames follow each other without gaps, starting at offset 0.
+
+#include "../utils/binary_codec.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#if defined(_WIN32)
+#   include <fcntl.h>
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+namespace logit { namespace detail {
+
+    const uint32_t kZstdSkippableMagic = 0x184D2A5EU; ///< Magic of a zstd skippable frame.
+    const uint32_t kSeekTableMagic     = 0x4B53474CU; ///< Footer magic of the seek table.
+    const size_t   kSeekTableEntrySize = 16;          ///< Bytes per table entry.
+
+    /// \struct SeekTableEntry
+    /// \brief Description of one zstd frame.
+    struct SeekTableEntry {
+        int64_t  first_ts_ms       = 0; ///< Timestamp of the first record in the frame.
+        uint32_t compressed_size   = 0; ///< Size of the frame in the file.
+        uint32_t decompressed_size = 0; ///< Size of the frame content.
+    };
+
+    /// \brief Returns the size of a seek table with `count` entries, including its frame header.
+    inline uint64_t seek_table_size(size_t count) {
+        return 8 + static_cast<uint64_t>(count) * kSeekTableEntrySize + 8;
+    }
+
+    /// \brief Encodes a seek table.
+    inline std::string encode_seek_table(const std::vector<SeekTableEntry>& entries) {
+        std::string out;
+        out.reserve(static_cast<size_t>(seek_table_size(entries.size())));
+        put_fixed(out, kZstdSkippableMagic, 4);
+        put_fixed(out, seek_table_size(entries.size()) - 8, 4);
+        for (const auto& entry : entries) {
+            put_fixed(out, static_cast<uint64_t>(entry.first_ts_ms), 8);
+            put_fixed(out, entry.compressed_size, 4);
+            put_fixed(out, entry.decompressed_size, 4);
+        }
+        put_fixed(out, entries.size(), 4);
+        put_fixed(out, kSeekTableMagic, 4);
+        return out;
+    }
+
+    /// \brief Reads the seek table at the end of a file.
+    /// \param path File path (UTF-8).
+    /// \param entries Receives the table entries.
+    /// \param file_size Receives the size of the file.
+    /// \return Size of the table in bytes, or 0 if the file does not end with a table.
+    inline uint64_t read_seek_table(const std::string& path, std::vector<SeekTableEntry>& entries, uint64_t& file_size) {
+        entries.clear();
+        file_size = 0;
+#       if defined(_WIN32)
+        std::ifstream file(utf8_to_ansi(path).c_str(), std::ios::binary);
+#       else
+        std::ifstream file(path.c_str(), std::ios::binary);
+#       endif
+        if (!file) return 0;
+        file.seekg(0, std::ios::end);
+        file_size = static_cast<uint64_t>(file.tellg());
+        if (file_size < seek_table_size(0)) return 0;
+        char footer[8];
+        file.seekg(static_cast<std::streamoff>(file_size - 8));
+        if (!file.read(footer, sizeof(footer))) return 0;
+        uint64_t count = 0;
+        uint64_t magic = 0;
+        BinaryCursor footer_cursor(footer, sizeof(footer));
+        footer_cursor.get_fixed(count, 4);
+        footer_cursor.get_fixed(magic, 4);
+        if (magic != kSeekTableMagic || seek_table_size(static_cast<size_t>(count)) > file_size) return 0;
+
+        const uint64_t table_size = seek_table_size(static_cast<size_t>(count));
+        std::string table(static_cast<size_t>(table_size), '\0');
+        file.seekg(static_cast<std::streamoff>(file_size - table_size));
+        if (!file.read(&table[0], static_cast<std::streamsize>(table.size()))) return 0;
+        BinaryCursor cursor(table.data(), table.size());
+        uint64_t frame_magic = 0;
+        uint64_t payload = 0;
+        if (!cursor.get_fixed(frame_magic, 4) || !cursor.get_fixed(payload, 4) ||
+            frame_magic != kZstdSkippableMagic || payload != table_size - 8) {
+            return 0;
+        }
+        entries.resize(static_cast<size_t>(count));
+        uint64_t frames_size = 0;
+        for (auto& entry : entries) {
+            uint64_t ts = 0, compressed = 0, decompressed = 0;
+            cursor.get_fixed(ts, 8);
+            cursor.get_fixed(compressed, 4);
+            cursor.get_fixed(decompressed, 4);
+            entry.first_ts_ms = static_cast<int64_t>(ts);
+            entry.compressed_size = static_cast<uint32_t>(compressed);
+            entry.decompressed_size = static_cast<uint32_t>(decompressed);
+            frames_size += compressed;
+        }
+        if (frames_size != file_size - table_size) {
+            entries.clear();
+            return 0;
+        }
+        return table_size;
+    }
+
+    /// \brief Truncates a file to the given size.
+    /// \return True on success.
+    inline bool truncate_file(const std::string& path, uint64_t size) {
+#       if defined(_WIN32)
+        const int fd = ::_open(utf8_to_ansi(path).c_str(), _O_WRONLY | _O_BINARY);
+        if (fd < 0) return false;
+        const bool ok = ::_chsize_s(fd, static_cast<__int64>(size)) == 0;
+        ::_close(fd);
+        return ok;
+#       else
+        return ::truncate(path.c_str(), static_cast<off_t>(size)) == 0;
+#       endif
+    }
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_ZSTD_SEEK_TABLE_HPP_INCLUDED
@@ -48,7 +48,14 @@ namespace logit {
         LastFileName,          ///< The name of the last file written to.
         LastFilePath,          ///< The full path of the last file written to.
         LastLogTimestamp,      ///< The timestamp of the last log.
-        TimeSinceLastLog       ///< The time elapsed since the last log in seconds.
+        TimeSinceLastLog,      ///< The time elapsed since the last log in seconds.
+        FlushCount,            ///< Number of times buffered data was submitted to the file.
+        WriteCallCount,        ///< Number of write system calls.
+        BytesWritten,          ///< Bytes handed to the operating system.
+        BytesPerWrite,         ///< Average number of bytes per write system call.
+        CompressionQueueDepth, ///< Rotated files waiting for or undergoing compression.
+        CompressionBytesPerSec, ///< Average compression rate of one worker in source bytes per second.
+        DroppedRecords         ///< Records discarded because the output could not keep up.
     };
 
     /// \enum CompressType
@@ -60,6 +67,15 @@ namespace logit {
         EXTERNAL_CMD ///< Use an external command for compression.
     };
 
+    /// \enum FileWriteMode
+    /// \brief Output backend of the file logger.
+    enum class FileWriteMode {
+        Stream,     ///< Write through `std::ofstream`.
+        BufferedFd, ///< Write through a raw descriptor with a user-space buffer and a flush policy.
+        IoUring,    ///< Submit buffered writes through io_uring; Linux with `LOGIT_WITH_IO_URING` only.
+        Mmap        ///< Copy records into a memory-mapped, preallocated file; not available on Windows.
+    };
+
     /// \enum RotationNaming
     /// \brief Naming policy for rotated log files.
     enum class RotationNaming {
@@ -68,6 +84,22 @@ namespace logit {
         TimestampMs  ///< Append HHMMSSmmm timestamp: YYYY-MM-DD_HHMMSSmmm.log
     };
 
+    /// \enum RecordField
+    /// \brief Record attributes emitted by the structured formatters (JSON, logfmt, MessagePack).
+    enum class RecordField {
+        TimestampMs, ///< Timestamp in milliseconds (number).
+        Level,       ///< Log level name, e.g. "INFO" (string).
+        LevelValue,  ///< Numeric log level (number).
+        File,        ///< Source file path (string).
+        FileName,    ///< Basename of the source file (string).
+        Line,        ///< Line number (number).
+        Function,    ///< Function name (string).
+        ThreadId,    ///< Thread identifier (string).
+        Message,     ///< Rendered message, same text as the `%v` flag (string).
+        Format,      ///< Raw format string (string).
+        Args         ///< Named arguments with their native types.
+    };
+
     /// \brief Convert LogLevel to a C-style string representation.
     /// \param level The log level.
     /// \param mode The output mode (0 for full name, 1 for abbreviation).
@@ -11,6 +11,12 @@
 #include "utils.hpp"
 #include "formatter/ILogFormatter.hpp"
 #include "formatter/SimpleLogFormatter.hpp"
+#include "formatter/StructuredLogFormatter.hpp"
+#include "formatter/JsonLogFormatter.hpp"
+#include "formatter/LogfmtFormatter.hpp"
+#include "formatter/MsgpackFormatter.hpp"
+#include "formatter/BinaryLogFormatter.hpp"
+#include "formatter/BinaryLogReader.hpp"
 #include "formatter/compiler/PatternCompiler.hpp"
 
 #endif // _LOGIT_FORMATTER_HPP_INCLUDED
@@ -0,0 +1,169 @@
+#pragma once
+#ifndef _LOGIT_BINARY_LOG_FORMATTER_HPP_INCLUDED
+#define _LOGIT_BINARY_LOG_FORMATTER_HPP_INCLUDED
+
+/// \file BinaryLogFormatter.hpp
+/// \brief Defines the BinaryLogFormatter class that encodes records in the LogIt binary format.
+
+#include "ILogFormatter.hpp"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace logit {
+
+    /// \class BinaryLogFormatter
+    /// \brief Encodes log records as compact binary records instead of text.
+    ///
+    /// Each formatted message holds the event (see binary_codec.hpp): the call-site ID,
+    /// timestamp, thread index, level and the typed argument values; no text formatting
+    /// happens on the logging thread. The formatter keeps no state, so one instance may
+    /// serve several loggers and threads.
+    ///
+    /// Use it with a `FileLogger` whose `Config::binary` flag is set. The logger encodes
+    /// the call-site and thread definitions (`encode_call_site()`, `encode_thread()`) the
+    /// first time an event needs them, writes the file header and repeats the definitions
+    /// in every new file before their first event. Files can be rendered back to text with
+    /// `BinaryLogReader` or the `logit-decode` tool. `long double` values are stored with
+    /// double precision.
+    class BinaryLogFormatter : public ILogFormatter {
+    public:
+        BinaryLogFormatter() = default;
+
+        /// \brief Timestamps are stored in UTC; the offset is applied when decoding.
+        void set_timestamp_offset(int64_t offset_ms) override {
+            (void)offset_ms;
+        }
+
+        /// \brief Encodes a log record.
+        /// \param record The log record to encode.
+        /// \return The encoded event.
+        std::string format(const LogRecord& record) const override {
+            std::string out;
+            out.reserve(128 + record.file.size() + record.function.size() +
+                        record.format.size() + record.arg_names.size() +
+                        record.args_array.size() * 12);
+            format_to(record, out);
+            return out;
+        }
+
+        /// \brief Appends the encoded event to a buffer.
+        /// \param record The log record to encode.
+        /// \param out Buffer receiving the encoded bytes.
+        void format_to(const LogRecord& record, std::string& out) const override {
+            const size_t start = detail::begin_record(out, detail::BinaryRecordKind::Event);
+            detail::put_fixed(out, call_site_id(record), 8);
+            detail::put_svarint(out, record.timestamp_ms);
+            detail::put_varint(out, get_thread_index(record.thread_id));
+            out.push_back(static_cast<char>(record.log_level));
+            detail::put_varint(out, record.args_array.size());
+            for (size_t i = 0; i < record.args_array.size(); ++i) {
+                encode_value(record.args_array[i], out);
+            }
+            detail::end_record(out, start);
+        }
+
+        /// \brief Computes the call-site ID of a record.
+        ///
+        /// The ID is the FNV-1a hash of the static parts of the record: file, line,
+        /// function, format string, argument names and mode flags.
+        static uint64_t call_site_id(const LogRecord& record) {
+            uint64_t hash = detail::fnv1a64(record.file.data(), record.file.size());
+            const int32_t line = record.line;
+            hash = detail::fnv1a64(reinterpret_cast<const char*>(&line), sizeof(line), hash);
+            hash = detail::fnv1a64(record.function.data(), record.function.size(), hash);
+            hash = detail::fnv1a64("\0", 1, hash);
+            hash = detail::fnv1a64(record.format.data(), record.format.size(), hash);
+            hash = detail::fnv1a64("\0", 1, hash);
+            hash = detail::fnv1a64(record.arg_names.data(), record.arg_names.size(), hash);
+            const char flags = static_cast<char>((record.print_mode ? 1 : 0) | (record.fmt_mode ? 2 : 0));
+            return detail::fnv1a64(&flags, 1, hash);
+        }
+
+        /// \brief Appends the call-site definition of a record.
+        static void encode_call_site(const LogRecord& record, uint64_t site_id, std::string& out) {
+            const size_t start = detail::begin_record(out, detail::BinaryRecordKind::CallSite);
+            detail::put_fixed(out, site_id, 8);
+            detail::put_string(out, record.file);
+            detail::put_svarint(out, record.line);
+            detail::put_string(out, record.function);
+            detail::put_string(out, record.format);
+            detail::put_string(out, record.arg_names);
+            out.push_back(static_cast<char>((record.print_mode ? 1 : 0) | (record.fmt_mode ? 2 : 0)));
+            detail::end_record(out, start);
+        }
+
+        /// \brief Appends the definition of the thread of a record.
+        static void encode_thread(const LogRecord& record, uint64_t thread_index, std::string& out) {
+            const size_t start = detail::begin_record(out, detail::BinaryRecordKind::Thread);
+            detail::put_varint(out, thread_index);
+            detail::put_string(out, record.thread_label.empty()
+                ? thread_id_to_string(record.thread_id) : record.thread_label);
+            detail::end_record(out, start);
+        }
+
+        /// \brief Encodes a single argument value.
+        /// \param arg The argument to encode.
+        /// \param out Buffer receiving the encoded bytes.
+        static void encode_value(const VariableValue& arg, std::string& out) {
+            using ValueType = VariableValue::ValueType;
+            out.push_back(static_cast<char>(arg.type));
+            switch (arg.type) {
+                case ValueType::INT8_VAL:   detail::put_svarint(out, arg.pod_value.int8_value); break;
+                case ValueType::INT16_VAL:  detail::put_svarint(out, arg.pod_value.int16_value); break;
+                case ValueType::INT32_VAL:  detail::put_svarint(out, arg.pod_value.int32_value); break;
+                case ValueType::INT64_VAL:  detail::put_svarint(out, arg.pod_value.int64_value); break;
+                case ValueType::UINT8_VAL:  detail::put_varint(out, arg.pod_value.uint8_value); break;
+                case ValueType::UINT16_VAL: detail::put_varint(out, arg.pod_value.uint16_value); break;
+                case ValueType::UINT32_VAL: detail::put_varint(out, arg.pod_value.uint32_value); break;
+                case ValueType::UINT64_VAL: detail::put_varint(out, arg.pod_value.uint64_value); break;
+                case ValueType::BOOL_VAL:   out.push_back(arg.pod_value.bool_value ? 1 : 0); break;
+                case ValueType::CHAR_VAL:   out.push_back(arg.pod_value.char_value); break;
+                case ValueType::FLOAT_VAL: {
+                    uint32_t bits = 0;
+                    std::memcpy(&bits, &arg.pod_value.float_value, sizeof(bits));
+                    detail::put_fixed(out, bits, 4);
+                    break;
+                }
+                case ValueType::DOUBLE_VAL:
+                case ValueType::LONG_DOUBLE_VAL: {
+                    // `long double` keeps its tag but is stored with double precision;
+                    // digits beyond a double are lost.
+                    const double value = arg.type == ValueType::DOUBLE_VAL
+                        ? arg.pod_value.double_value
+                        : static_cast<double>(arg.pod_value.long_double_value);
+                    uint64_t bits = 0;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    detail::put_fixed(out, bits, 8);
+                    break;
+                }
+                case ValueType::ERROR_CODE_VAL:
+                    detail::put_string(out, arg.to_string());
+                    break;
+                default:
+                    detail::put_string(out, arg.string_data(), arg.string_size());
+                    break;
+            }
+        }
+
+    private:
+        /// \brief Returns a small process-wide index for a thread.
+        static uint64_t get_thread_index(const std::thread::id& thread_id) {
+            static std::atomic<uint64_t> counter = ATOMIC_VAR_INIT(0);
+            struct Cache {
+                std::thread::id id;
+                uint64_t index = 0;
+            };
+            static thread_local Cache cache;
+            if (cache.index == 0 || cache.id != thread_id) {
+                cache.id = thread_id;
+                cache.index = ++counter;
+            }
+            return cache.index;
+        }
+    }; // class BinaryLogFormatter
+
+}; // namespace logit
+
+#endif // _LOGIT_BINARY_LOG_FORMATTER_HPP_INCLUDED
@@ -0,0 +1,263 @@
+#pragma once
+#ifndef _LOGIT_BINARY_LOG_READER_HPP_INCLUDED
+#define _LOGIT_BINARY_LOG_READER_HPP_INCLUDED
+
+/// \file BinaryLogReader.hpp
+/// \brief Defines the BinaryLogReader class that decodes files written with BinaryLogFormatter.
+
+#include "ILogFormatter.hpp"
+#include "../detail/FramedLog.hpp"
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \class BinaryLogReader
+    /// \brief Decodes binary log files back into `LogRecord` objects.
+    ///
+    /// The reader rebuilds every event from the call-site and thread definitions stored in
+    /// the file. Decoded records carry the original thread ID text in `thread_label`, so any
+    /// formatter (for example `SimpleLogFormatter` with the pattern used in production) can
+    /// render them exactly as a text logger would have.
+    ///
+    /// A truncated record at the end of a file, e.g. after a crash, ends decoding without
+    /// an error.
+    class BinaryLogReader {
+    public:
+        /// \brief Loads a binary log file.
+        ///
+        /// Files written with `FileLogger::Config::framed` are unwrapped; damaged frames
+        /// are skipped.
+        /// \param path Path to the file.
+        /// \throws std::runtime_error if the file cannot be read or is not a binary log.
+        explicit BinaryLogReader(const std::string& path) {
+#           if defined(_WIN32)
+            std::ifstream file(utf8_to_ansi(path), std::ios_base::binary);
+#           else
+            std::ifstream file(path, std::ios_base::binary);
+#           endif
+            if (!file) {
+                throw std::runtime_error("Failed to open binary log: " + path);
+            }
+            m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            if (m_data.size() >= sizeof(detail::kFramedLogMagic) &&
+                std::memcmp(m_data.data(), detail::kFramedLogMagic, sizeof(detail::kFramedLogMagic)) == 0) {
+                const std::string payload = read_framed_log(path);
+                m_data.assign(payload.begin(), payload.end());
+            }
+            if (!has_binary_header(m_data.data(), m_data.size())) {
+                throw std::runtime_error("Not a LogIt binary log: " + path);
+            }
+        }
+
+        /// \brief Checks whether a buffer starts with the binary log magic.
+        static bool has_binary_header(const char* data, size_t size) {
+            return size >= sizeof(detail::kBinaryLogMagic) &&
+                   std::memcmp(data, detail::kBinaryLogMagic, sizeof(detail::kBinaryLogMagic)) == 0;
+        }
+
+        /// \brief Decodes all events and passes them to a callback.
+        /// \tparam Callback Callable accepting `const LogRecord&`.
+        /// \param callback Function invoked for each decoded event, in file order.
+        /// \return Number of decoded events.
+        template <typename Callback>
+        size_t for_each(Callback callback) {
+            detail::BinaryCursor cursor(m_data.data(), m_data.size());
+            uint64_t version = 0;
+            if (!cursor.skip(sizeof(detail::kBinaryLogMagic)) || !cursor.get_varint(version) ||
+                version > detail::kBinaryLogVersion) {
+                return 0;
+            }
+            size_t count = 0;
+            uint8_t kind = 0;
+            const char* payload = nullptr;
+            size_t payload_size = 0;
+            while (cursor.get_record(kind, payload, payload_size)) {
+                detail::BinaryCursor rec(payload, payload_size);
+                switch (static_cast<detail::BinaryRecordKind>(kind)) {
+                    case detail::BinaryRecordKind::CallSite:
+                        read_call_site(rec);
+                        break;
+                    case detail::BinaryRecordKind::Thread: {
+                        uint64_t index = 0;
+                        std::string text;
+                        if (rec.get_varint(index) && rec.get_string(text)) {
+                            m_threads[index] = text;
+                        }
+                        break;
+                    }
+                    case detail::BinaryRecordKind::Event: {
+                        std::unique_ptr<LogRecord> record = read_event(rec);
+                        if (record) {
+                            callback(static_cast<const LogRecord&>(*record));
+                            ++count;
+                        }
+                        break;
+                    }
+                    default:
+                        break; // Unknown record kinds are skipped for forward compatibility.
+                }
+            }
+            return count;
+        }
+
+        /// \brief Renders all events as text, one line per event.
+        /// \param formatter Formatter used to render each record.
+        /// \param out Output stream.
+        /// \return Number of decoded events.
+        size_t render(const ILogFormatter& formatter, std::ostream& out) {
+            std::string line;
+            return for_each([&](const LogRecord& record) {
+                line.clear();
+                formatter.format_to(record, line);
+                line.push_back('\n');
+                out.write(line.data(), static_cast<std::streamsize>(line.size()));
+            });
+        }
+
+    private:
+        /// \struct CallSite
+        /// \brief Static part of the events emitted by one logging statement.
+        struct CallSite {
+            std::string file;
+            int         line = 0;
+            std::string function;
+            std::string format;
+            std::string arg_names;
+            std::vector<ArgumentName> names; ///< Argument names split once per call site.
+            bool        print_mode = false;
+            bool        fmt_mode = false;
+        };
+
+        std::vector<char> m_data;                  ///< Raw file contents.
+        std::map<uint64_t, CallSite> m_sites;      ///< Call sites by ID.
+        std::map<uint64_t, std::string> m_threads; ///< Thread ID text by index.
+
+        void read_call_site(detail::BinaryCursor& rec) {
+            uint64_t id = 0;
+            int64_t line = 0;
+            uint8_t flags = 0;
+            CallSite site;
+            if (!rec.get_fixed(id, 8) || !rec.get_string(site.file) || !rec.get_svarint(line) ||
+                !rec.get_string(site.function) || !rec.get_string(site.format) ||
+                !rec.get_string(site.arg_names) || !rec.get_u8(flags)) {
+                return;
+            }
+            site.line = static_cast<int>(line);
+            site.print_mode = (flags & 1) != 0;
+            site.fmt_mode = (flags & 2) != 0;
+            site.names = argument_names(site.arg_names);
+            m_sites[id] = site;
+        }
+
+        std::unique_ptr<LogRecord> read_event(detail::BinaryCursor& rec) {
+            uint64_t site_id = 0;
+            int64_t timestamp_ms = 0;
+            uint64_t thread_index = 0;
+            uint8_t level = 0;
+            uint64_t argc = 0;
+            if (!rec.get_fixed(site_id, 8) || !rec.get_svarint(timestamp_ms) ||
+                !rec.get_varint(thread_index) || !rec.get_u8(level) || !rec.get_varint(argc)) {
+                return std::unique_ptr<LogRecord>();
+            }
+            auto it = m_sites.find(site_id);
+            if (it == m_sites.end()) return std::unique_ptr<LogRecord>();
+            const CallSite& site = it->second;
+            std::unique_ptr<LogRecord> record(new LogRecord(
+                static_cast<LogLevel>(level), timestamp_ms, site.file, site.line,
+                site.function, site.format, site.arg_names, -1, site.print_mode, site.fmt_mode));
+            auto thread = m_threads.find(thread_index);
+            record->thread_label = thread != m_threads.end() ? thread->second : std::to_string(thread_index);
+            record->args_array.reserve(static_cast<size_t>(argc));
+            for (uint64_t i = 0; i < argc; ++i) {
+                const ArgumentName name = i < site.names.size() ? site.names[static_cast<size_t>(i)] : ArgumentName();
+                if (!read_value(rec, name, record->args_array)) return std::unique_ptr<LogRecord>();
+            }
+            return record;
+        }
+
+        static bool read_value(detail::BinaryCursor& rec, const ArgumentName& name, ArgsArray& out) {
+            using ValueType = VariableValue::ValueType;
+            uint8_t tag = 0;
+            if (!rec.get_u8(tag)) return false;
+            const ValueType type = static_cast<ValueType>(tag);
+            switch (type) {
+                case ValueType::INT8_VAL:
+                case ValueType::INT16_VAL:
+                case ValueType::INT32_VAL:
+                case ValueType::INT64_VAL: {
+                    int64_t value = 0;
+                    if (!rec.get_svarint(value)) return false;
+                    if (type == ValueType::INT8_VAL) out.emplace_back(name, static_cast<int8_t>(value));
+                    else if (type == ValueType::INT16_VAL) out.emplace_back(name, static_cast<int16_t>(value));
+                    else if (type == ValueType::INT32_VAL) out.emplace_back(name, static_cast<int32_t>(value));
+                    else out.emplace_back(name, value);
+                    return true;
+                }
+                case ValueType::UINT8_VAL:
+                case ValueType::UINT16_VAL:
+                case ValueType::UINT32_VAL:
+                case ValueType::UINT64_VAL: {
+                    uint64_t value = 0;
+                    if (!rec.get_varint(value)) return false;
+                    if (type == ValueType::UINT8_VAL) out.emplace_back(name, static_cast<uint8_t>(value));
+                    else if (type == ValueType::UINT16_VAL) out.emplace_back(name, static_cast<uint16_t>(value));
+                    else if (type == ValueType::UINT32_VAL) out.emplace_back(name, static_cast<uint32_t>(value));
+                    else out.emplace_back(name, value);
+                    return true;
+                }
+                case ValueType::BOOL_VAL: {
+                    uint8_t value = 0;
+                    if (!rec.get_u8(value)) return false;
+                    out.emplace_back(name, value != 0);
+                    return true;
+                }
+                case ValueType::CHAR_VAL: {
+                    uint8_t value = 0;
+                    if (!rec.get_u8(value)) return false;
+                    out.emplace_back(name, static_cast<char>(value));
+                    return true;
+                }
+                case ValueType::FLOAT_VAL: {
+                    uint64_t bits = 0;
+                    if (!rec.get_fixed(bits, 4)) return false;
+                    const uint32_t bits32 = static_cast<uint32_t>(bits);
+                    float value = 0;
+                    std::memcpy(&value, &bits32, sizeof(value));
+                    out.emplace_back(name, value);
+                    return true;
+                }
+                case ValueType::DOUBLE_VAL:
+                case ValueType::LONG_DOUBLE_VAL: {
+                    uint64_t bits = 0;
+                    if (!rec.get_fixed(bits, 8)) return false;
+                    double value = 0;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    if (type == ValueType::DOUBLE_VAL) out.emplace_back(name, value);
+                    else out.emplace_back(name, static_cast<long double>(value));
+                    return true;
+                }
+                default: {
+                    std::string text;
+                    if (!rec.get_string(text)) return false;
+                    out.emplace_back(name, text);
+                    // Keep the original kind so the message renders with the same decorations.
+                    // Error codes stay plain strings: their category cannot be restored.
+                    if (type != ValueType::ERROR_CODE_VAL && tag <= static_cast<uint8_t>(ValueType::UNKNOWN_VAL)) {
+                        out.back().set_string_type(type);
+                    }
+                    return true;
+                }
+            }
+        }
+    }; // class BinaryLogReader
+
+}; // namespace logit
+
+#endif // _LOGIT_BINARY_LOG_READER_HPP_INCLUDED
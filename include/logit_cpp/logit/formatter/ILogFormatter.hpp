@@ -35,6 +35,18 @@ namespace logit {
         /// \param record The log record to be formatted.
         /// \return A string representing the formatted log message.
         virtual std::string format(const LogRecord& record) const = 0;
+
+        /// \brief Appends a formatted log record to an existing buffer.
+        ///
+        /// Formatters that build their output incrementally can override this method to
+        /// write straight into a caller-owned buffer and avoid a temporary string.
+        /// The default implementation appends the result of `format()`.
+        ///
+        /// \param record The log record to be formatted.
+        /// \param out Buffer receiving the formatted message.
+        virtual void format_to(const LogRecord& record, std::string& out) const {
+            out += format(record);
+        }
     }; // ILogFormatter
 
 }; // namespace logit
@@ -0,0 +1,198 @@
+#pragma once
+#ifndef _LOGIT_JSON_LOG_FORMATTER_HPP_INCLUDED
+#define _LOGIT_JSON_LOG_FORMATTER_HPP_INCLUDED
+
+/// \file JsonLogFormatter.hpp
+/// \brief Defines the JsonLogFormatter class producing one JSON object per log record.
+
+#include "StructuredLogFormatter.hpp"
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \class JsonLogFormatter
+    /// \brief Formats log records as single-line JSON objects.
+    ///
+    /// Unlike the `json_format` mode of `SimpleLogFormatter`, this formatter appends directly
+    /// into a string buffer, writes numeric and boolean arguments as native JSON values,
+    /// uses the argument names as keys and lets the caller choose which fields are emitted
+    /// and under which keys. Unnamed constants such as `"text"` or `42` only appear in the
+    /// rendered message.
+    ///
+    /// Example output with the default schema:
+    /// \code
+    /// {"timestamp_ms":1700000000000,"level":"INFO","file":"main.cpp","line":12,
+    ///  "function":"main","thread_id":"1402","message":"user: 42, ok: true",
+    ///  "args":{"user":42,"ok":true}}
+    /// \endcode
+    class JsonLogFormatter : public StructuredLogFormatter {
+    public:
+        /// \struct Config
+        /// \brief Configuration for the JSON formatter.
+        struct Config {
+            std::vector<Field> fields = default_fields(); ///< Ordered field schema.
+            bool flatten_args = false; ///< Emit arguments as top-level members instead of a nested object.
+        };
+
+        /// \brief Default constructor that uses the default field schema.
+        JsonLogFormatter() : JsonLogFormatter(Config()) {}
+
+        /// \brief Constructor with custom configuration.
+        /// \param config Formatter configuration.
+        explicit JsonLogFormatter(const Config& config) {
+            set_config(config);
+        }
+
+        /// \brief Replaces the formatter configuration.
+        /// \param config Formatter configuration.
+        void set_config(const Config& config) {
+            m_config = config;
+            m_prefixes.clear();
+            m_prefixes.reserve(m_config.fields.size());
+            for (const auto& field : m_config.fields) {
+                std::string prefix;
+                append_json_string(prefix, field.key);
+                prefix.push_back(':');
+                m_prefixes.push_back(prefix);
+            }
+        }
+
+        /// \brief Appends the JSON object for a record to an existing buffer.
+        /// \param record The log record to be formatted.
+        /// \param out Buffer receiving the JSON text.
+        void format_to(const LogRecord& record, std::string& out) const override {
+            out.push_back('{');
+            bool first = true;
+            for (size_t i = 0; i < m_config.fields.size(); ++i) {
+                const RecordField field = m_config.fields[i].field;
+                if (field == RecordField::Args) {
+                    append_args(record, i, out, first);
+                    continue;
+                }
+                if (!first) out.push_back(',');
+                first = false;
+                out += m_prefixes[i];
+                switch (field) {
+                    case RecordField::TimestampMs:
+                        append_int(out, record.timestamp_ms);
+                        break;
+                    case RecordField::Level:
+                        out.push_back('"');
+                        out += to_c_str(record.log_level);
+                        out.push_back('"');
+                        break;
+                    case RecordField::LevelValue:
+                        append_int(out, static_cast<int64_t>(record.log_level));
+                        break;
+                    case RecordField::File:
+                        append_json_string(out, record.file);
+                        break;
+                    case RecordField::FileName: {
+                        const size_t start = file_name_offset(record);
+                        append_json_string(out, record.file.data() + start, record.file.size() - start);
+                        break;
+                    }
+                    case RecordField::Line:
+                        append_int(out, record.line);
+                        break;
+                    case RecordField::Function:
+                        append_json_string(out, record.function);
+                        break;
+                    case RecordField::ThreadId:
+                        append_json_string(out, thread_text(record));
+                        break;
+                    case RecordField::Message: {
+                        // Rendered straight into the buffer; escaped through a copy only if needed.
+                        out.push_back('"');
+                        const size_t start = append_message(out, record);
+                        bool escape = false;
+                        for (size_t i = start; i < out.size() && !escape; ++i) {
+                            escape = detail::json_needs_escape(static_cast<unsigned char>(out[i]));
+                        }
+                        if (escape) append_json_escaped(out, cut_message(out, start));
+                        out.push_back('"');
+                        break;
+                    }
+                    case RecordField::Format:
+                        append_json_string(out, record.format);
+                        break;
+                    default:
+                        out += "null";
+                        break;
+                }
+            }
+            out.push_back('}');
+        }
+
+        /// \brief Appends a single argument as a native JSON value.
+        /// \param arg Argument to convert.
+        /// \param out Buffer receiving the JSON value.
+        static void append_value(const VariableValue& arg, std::string& out) {
+            using ValueType = VariableValue::ValueType;
+            switch (arg.type) {
+                case ValueType::INT8_VAL:   append_int(out, arg.pod_value.int8_value); break;
+                case ValueType::UINT8_VAL:  append_uint(out, arg.pod_value.uint8_value); break;
+                case ValueType::INT16_VAL:  append_int(out, arg.pod_value.int16_value); break;
+                case ValueType::UINT16_VAL: append_uint(out, arg.pod_value.uint16_value); break;
+                case ValueType::INT32_VAL:  append_int(out, arg.pod_value.int32_value); break;
+                case ValueType::UINT32_VAL: append_uint(out, arg.pod_value.uint32_value); break;
+                case ValueType::INT64_VAL:  append_int(out, arg.pod_value.int64_value); break;
+                case ValueType::UINT64_VAL: append_uint(out, arg.pod_value.uint64_value); break;
+                case ValueType::BOOL_VAL:
+                    out += arg.pod_value.bool_value ? "true" : "false";
+                    break;
+                case ValueType::CHAR_VAL:
+                    append_json_string(out, &arg.pod_value.char_value, 1);
+                    break;
+                case ValueType::FLOAT_VAL:
+                    if (!append_real(out, arg.pod_value.float_value)) out += "null";
+                    break;
+                case ValueType::DOUBLE_VAL:
+                    if (!append_real(out, arg.pod_value.double_value)) out += "null";
+                    break;
+                case ValueType::LONG_DOUBLE_VAL:
+                    if (!append_real(out, static_cast<double>(arg.pod_value.long_double_value))) out += "null";
+                    break;
+                case ValueType::ERROR_CODE_VAL:
+                    append_json_string(out, arg.to_string());
+                    break;
+                default:
+                    append_json_string(out, arg.string_data(), arg.string_size());
+                    break;
+            }
+        }
+
+    private:
+        Config m_config;                    ///< Formatter configuration.
+        std::vector<std::string> m_prefixes;///< Pre-escaped `"key":` prefixes, one per field.
+
+        /// \brief Appends the argument members of the record.
+        void append_args(const LogRecord& record, size_t field_index, std::string& out, bool& first) const {
+            if (!m_config.flatten_args) {
+                if (!first) out.push_back(',');
+                first = false;
+                out += m_prefixes[field_index];
+                out.push_back('{');
+            }
+            bool first_arg = m_config.flatten_args ? first : true;
+            for (size_t i = 0; i < record.args_array.size(); ++i) {
+                const VariableValue& arg = record.args_array[i];
+                if (!is_named(arg)) continue;
+                if (!first_arg) out.push_back(',');
+                first_arg = false;
+                append_json_string(out, arg.name);
+                out.push_back(':');
+                append_value(arg, out);
+            }
+            if (m_config.flatten_args) {
+                first = first_arg;
+            } else {
+                out.push_back('}');
+            }
+        }
+    }; // class JsonLogFormatter
+
+}; // namespace logit
+
+#endif // _LOGIT_JSON_LOG_FORMATTER_HPP_INCLUDED
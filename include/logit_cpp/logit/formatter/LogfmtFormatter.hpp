@@ -0,0 +1,216 @@
+#pragma once
+#ifndef _LOGIT_LOGFMT_FORMATTER_HPP_INCLUDED
+#define _LOGIT_LOGFMT_FORMATTER_HPP_INCLUDED
+
+/// \file LogfmtFormatter.hpp
+/// \brief Formatter that renders log records as logfmt `key=value` lines.
+
+#include "StructuredLogFormatter.hpp"
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \class LogfmtFormatter
+    /// \brief Formats log records as logfmt lines.
+    ///
+    /// Every field of the schema becomes a `key=value` pair separated by spaces. Named
+    /// arguments are emitted as top-level pairs with their native values: numbers and
+    /// booleans are written bare, strings are quoted only when they contain spaces, quotes,
+    /// `=` or control characters.
+    ///
+    /// Example output with the default schema:
+    /// \code
+    /// timestamp_ms=1700000000000 level=info file=main.cpp line=12 function=main
+    ///  thread_id=1402 message="user: 42, ok: true" user=42 ok=true
+    /// \endcode
+    class LogfmtFormatter : public StructuredLogFormatter {
+    public:
+        /// \struct Config
+        /// \brief Configuration for the logfmt formatter.
+        struct Config {
+            std::vector<Field> fields = default_fields(); ///< Ordered field schema.
+            bool lowercase_level = true; ///< Write `level=info` instead of `level=INFO`.
+        };
+
+        /// \brief Default constructor that uses the default field schema.
+        LogfmtFormatter() : LogfmtFormatter(Config()) {}
+
+        /// \brief Constructor with custom configuration.
+        /// \param config Formatter configuration.
+        explicit LogfmtFormatter(const Config& config) {
+            set_config(config);
+        }
+
+        /// \brief Replaces the formatter configuration.
+        /// \param config Formatter configuration.
+        void set_config(const Config& config) {
+            m_config = config;
+            m_prefixes.clear();
+            m_prefixes.reserve(m_config.fields.size());
+            for (const auto& field : m_config.fields) {
+                std::string prefix;
+                append_key(prefix, field.key);
+                prefix.push_back('=');
+                m_prefixes.push_back(prefix);
+            }
+        }
+
+        /// \brief Appends the logfmt line for a record to an existing buffer.
+        /// \param record The log record to be formatted.
+        /// \param out Buffer receiving the line (without a trailing line break).
+        void format_to(const LogRecord& record, std::string& out) const override {
+            bool first = true;
+            for (size_t i = 0; i < m_config.fields.size(); ++i) {
+                const RecordField field = m_config.fields[i].field;
+                if (field == RecordField::Args) {
+                    append_args(record, out, first);
+                    continue;
+                }
+                if (!first) out.push_back(' ');
+                first = false;
+                out += m_prefixes[i];
+                switch (field) {
+                    case RecordField::TimestampMs:
+                        append_int(out, record.timestamp_ms);
+                        break;
+                    case RecordField::Level: {
+                        const char* level = to_c_str(record.log_level);
+                        for (; *level; ++level) {
+                            out.push_back(m_config.lowercase_level
+                                ? static_cast<char>(*level - 'A' + 'a') : *level);
+                        }
+                        break;
+                    }
+                    case RecordField::LevelValue:
+                        append_int(out, static_cast<int64_t>(record.log_level));
+                        break;
+                    case RecordField::File:
+                        append_text(out, record.file.data(), record.file.size());
+                        break;
+                    case RecordField::FileName: {
+                        const size_t start = file_name_offset(record);
+                        append_text(out, record.file.data() + start, record.file.size() - start);
+                        break;
+                    }
+                    case RecordField::Line:
+                        append_int(out, record.line);
+                        break;
+                    case RecordField::Function:
+                        append_text(out, record.function.data(), record.function.size());
+                        break;
+                    case RecordField::ThreadId: {
+                        const std::string& text = thread_text(record);
+                        append_text(out, text.data(), text.size());
+                        break;
+                    }
+                    case RecordField::Message: {
+                        // Rendered straight into the buffer; quoted through a copy only if needed.
+                        const size_t start = append_message(out, record);
+                        if (needs_quotes(out.data() + start, out.size() - start)) {
+                            const std::string& text = cut_message(out, start);
+                            append_json_string(out, text.data(), text.size());
+                        }
+                        break;
+                    }
+                    case RecordField::Format:
+                        append_text(out, record.format.data(), record.format.size());
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        /// \brief Appends a single argument as a logfmt value.
+        /// \param arg Argument to convert.
+        /// \param out Buffer receiving the value.
+        static void append_value(const VariableValue& arg, std::string& out) {
+            using ValueType = VariableValue::ValueType;
+            switch (arg.type) {
+                case ValueType::INT8_VAL:   append_int(out, arg.pod_value.int8_value); break;
+                case ValueType::UINT8_VAL:  append_uint(out, arg.pod_value.uint8_value); break;
+                case ValueType::INT16_VAL:  append_int(out, arg.pod_value.int16_value); break;
+                case ValueType::UINT16_VAL: append_uint(out, arg.pod_value.uint16_value); break;
+                case ValueType::INT32_VAL:  append_int(out, arg.pod_value.int32_value); break;
+                case ValueType::UINT32_VAL: append_uint(out, arg.pod_value.uint32_value); break;
+                case ValueType::INT64_VAL:  append_int(out, arg.pod_value.int64_value); break;
+                case ValueType::UINT64_VAL: append_uint(out, arg.pod_value.uint64_value); break;
+                case ValueType::BOOL_VAL:
+                    out += arg.pod_value.bool_value ? "true" : "false";
+                    break;
+                case ValueType::CHAR_VAL:
+                    append_text(out, &arg.pod_value.char_value, 1);
+                    break;
+                case ValueType::FLOAT_VAL:
+                    detail::append_float(out, arg.pod_value.float_value);
+                    break;
+                case ValueType::DOUBLE_VAL:
+                    detail::append_double(out, arg.pod_value.double_value);
+                    break;
+                case ValueType::LONG_DOUBLE_VAL:
+                    detail::append_double(out, static_cast<double>(arg.pod_value.long_double_value));
+                    break;
+                case ValueType::ERROR_CODE_VAL: {
+                    const std::string text = arg.to_string();
+                    append_text(out, text.data(), text.size());
+                    break;
+                }
+                default:
+                    append_text(out, arg.string_data(), arg.string_size());
+                    break;
+            }
+        }
+
+        /// \brief Appends a string value, quoting it only when required.
+        ///
+        /// Quoted values use the JSON escape rules, which logfmt parsers accept.
+        /// \param out Buffer receiving the value.
+        /// \param data Pointer to the text.
+        /// \param size Length of the text in bytes.
+        static void append_text(std::string& out, const char* data, size_t size) {
+            if (!needs_quotes(data, size)) {
+                out.append(data, size);
+                return;
+            }
+            append_json_string(out, data, size);
+        }
+
+        /// \brief Checks whether a value has to be quoted.
+        static bool needs_quotes(const char* data, size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                const unsigned char c = static_cast<unsigned char>(data[i]);
+                if (c <= ' ' || c == '"' || c == '=' || c == '\\' || c == 0x7F) return true;
+            }
+            return size == 0;
+        }
+
+    private:
+        Config m_config;                    ///< Formatter configuration.
+        std::vector<std::string> m_prefixes;///< Sanitized `key=` prefixes, one per field.
+
+        /// \brief Appends a key, replacing characters that would break the pair syntax.
+        static void append_key(std::string& out, const std::string& key) {
+            for (size_t i = 0; i < key.size(); ++i) {
+                const unsigned char c = static_cast<unsigned char>(key[i]);
+                out.push_back(c <= ' ' || c == '"' || c == '=' ? '_' : key[i]);
+            }
+        }
+
+        /// \brief Appends the named arguments as top-level pairs.
+        static void append_args(const LogRecord& record, std::string& out, bool& first) {
+            for (size_t i = 0; i < record.args_array.size(); ++i) {
+                const VariableValue& arg = record.args_array[i];
+                if (!is_named(arg)) continue;
+                if (!first) out.push_back(' ');
+                first = false;
+                append_key(out, arg.name);
+                out.push_back('=');
+                append_value(arg, out);
+            }
+        }
+    }; // class LogfmtFormatter
+
+}; // namespace logit
+
+#endif // _LOGIT_LOGFMT_FORMATTER_HPP_INCLUDED
@@ -0,0 +1,285 @@
+#pragma once
+#ifndef _LOGIT_MSGPACK_FORMATTER_HPP_INCLUDED
+#define _LOGIT_MSGPACK_FORMATTER_HPP_INCLUDED
+
+/// \file MsgpackFormatter.hpp
+/// \brief Formatter that encodes log records as MessagePack maps.
+
+#include "StructuredLogFormatter.hpp"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \class MsgpackFormatter
+    /// \brief Encodes every log record as one MessagePack map.
+    ///
+    /// Keys are the field names of the schema. Integers use the smallest MessagePack
+    /// encoding, `float` and `double` arguments keep their width, booleans and strings map
+    /// to their native types. Named arguments form a nested map under the `Args` field key
+    /// or, with `flatten_args`, become members of the top-level map.
+    ///
+    /// Records are concatenated without separators, so the output is a plain MessagePack
+    /// stream. Use it with `FileLogger::Config::binary` so no line breaks are inserted.
+    class MsgpackFormatter : public StructuredLogFormatter {
+    public:
+        /// \struct Config
+        /// \brief Configuration for the MessagePack formatter.
+        struct Config {
+            std::vector<Field> fields = default_fields(); ///< Ordered field schema.
+            bool flatten_args = false; ///< Emit arguments as top-level members instead of a nested map.
+        };
+
+        /// \brief Default constructor that uses the default field schema.
+        MsgpackFormatter() : MsgpackFormatter(Config()) {}
+
+        /// \brief Constructor with custom configuration.
+        /// \param config Formatter configuration.
+        explicit MsgpackFormatter(const Config& config) {
+            set_config(config);
+        }
+
+        /// \brief Replaces the formatter configuration.
+        /// \param config Formatter configuration.
+        void set_config(const Config& config) {
+            m_config = config;
+            m_keys.clear();
+            m_keys.reserve(m_config.fields.size());
+            for (const auto& field : m_config.fields) {
+                std::string key;
+                append_str(key, field.key.data(), field.key.size());
+                m_keys.push_back(key);
+            }
+        }
+
+        /// \brief Appends the MessagePack map for a record to an existing buffer.
+        /// \param record The log record to be formatted.
+        /// \param out Buffer receiving the encoded bytes.
+        void format_to(const LogRecord& record, std::string& out) const override {
+            const size_t named = count_named(record);
+            size_t entries = 0;
+            for (const auto& field : m_config.fields) {
+                entries += field.field == RecordField::Args && m_config.flatten_args ? named : 1;
+            }
+            append_map_header(out, entries);
+            for (size_t i = 0; i < m_config.fields.size(); ++i) {
+                const RecordField field = m_config.fields[i].field;
+                if (field == RecordField::Args) {
+                    if (!m_config.flatten_args) {
+                        out += m_keys[i];
+                        append_map_header(out, named);
+                    }
+                    append_args(record, out);
+                    continue;
+                }
+                out += m_keys[i];
+                switch (field) {
+                    case RecordField::TimestampMs:
+                        append_int(out, record.timestamp_ms);
+                        break;
+                    case RecordField::Level: {
+                        const char* level = to_c_str(record.log_level);
+                        append_str(out, level, std::strlen(level));
+                        break;
+                    }
+                    case RecordField::LevelValue:
+                        append_int(out, static_cast<int64_t>(record.log_level));
+                        break;
+                    case RecordField::File:
+                        append_str(out, record.file.data(), record.file.size());
+                        break;
+                    case RecordField::FileName: {
+                        const size_t start = file_name_offset(record);
+                        append_str(out, record.file.data() + start, record.file.size() - start);
+                        break;
+                    }
+                    case RecordField::Line:
+                        append_int(out, record.line);
+                        break;
+                    case RecordField::Function:
+                        append_str(out, record.function.data(), record.function.size());
+                        break;
+                    case RecordField::ThreadId: {
+                        const std::string& text = thread_text(record);
+                        append_str(out, text.data(), text.size());
+                        break;
+                    }
+                    case RecordField::Message: {
+                        // Rendered straight into the buffer; the length header is inserted before it.
+                        const size_t start = append_message(out, record);
+                        char header[5];
+                        out.insert(start, header, str_header(header, out.size() - start));
+                        break;
+                    }
+                    case RecordField::Format:
+                        append_str(out, record.format.data(), record.format.size());
+                        break;
+                    default:
+                        out.push_back(static_cast<char>(0xC0));
+                        break;
+                }
+            }
+        }
+
+        /// \brief Appends a single argument as a MessagePack value.
+        /// \param arg Argument to convert.
+        /// \param out Buffer receiving the encoded value.
+        static void append_value(const VariableValue& arg, std::string& out) {
+            using ValueType = VariableValue::ValueType;
+            switch (arg.type) {
+                case ValueType::INT8_VAL:   append_int(out, arg.pod_value.int8_value); break;
+                case ValueType::UINT8_VAL:  append_uint(out, arg.pod_value.uint8_value); break;
+                case ValueType::INT16_VAL:  append_int(out, arg.pod_value.int16_value); break;
+                case ValueType::UINT16_VAL: append_uint(out, arg.pod_value.uint16_value); break;
+                case ValueType::INT32_VAL:  append_int(out, arg.pod_value.int32_value); break;
+                case ValueType::UINT32_VAL: append_uint(out, arg.pod_value.uint32_value); break;
+                case ValueType::INT64_VAL:  append_int(out, arg.pod_value.int64_value); break;
+                case ValueType::UINT64_VAL: append_uint(out, arg.pod_value.uint64_value); break;
+                case ValueType::BOOL_VAL:
+                    out.push_back(static_cast<char>(arg.pod_value.bool_value ? 0xC3 : 0xC2));
+                    break;
+                case ValueType::CHAR_VAL:
+                    append_str(out, &arg.pod_value.char_value, 1);
+                    break;
+                case ValueType::FLOAT_VAL: {
+                    uint32_t bits = 0;
+                    std::memcpy(&bits, &arg.pod_value.float_value, sizeof(bits));
+                    out.push_back(static_cast<char>(0xCA));
+                    append_be(out, bits, 4);
+                    break;
+                }
+                case ValueType::DOUBLE_VAL:
+                    append_float64(out, arg.pod_value.double_value);
+                    break;
+                case ValueType::LONG_DOUBLE_VAL:
+                    append_float64(out, static_cast<double>(arg.pod_value.long_double_value));
+                    break;
+                case ValueType::ERROR_CODE_VAL: {
+                    const std::string text = arg.to_string();
+                    append_str(out, text.data(), text.size());
+                    break;
+                }
+                default:
+                    append_str(out, arg.string_data(), arg.string_size());
+                    break;
+            }
+        }
+
+        /// \brief Appends a signed integer using the smallest MessagePack encoding.
+        static void append_int(std::string& out, int64_t value) {
+            if (value >= 0) {
+                append_uint(out, static_cast<uint64_t>(value));
+            } else if (value >= -32) {
+                out.push_back(static_cast<char>(value));
+            } else if (value >= INT8_MIN) {
+                out.push_back(static_cast<char>(0xD0));
+                append_be(out, static_cast<uint8_t>(value), 1);
+            } else if (value >= INT16_MIN) {
+                out.push_back(static_cast<char>(0xD1));
+                append_be(out, static_cast<uint16_t>(value), 2);
+            } else if (value >= INT32_MIN) {
+                out.push_back(static_cast<char>(0xD2));
+                append_be(out, static_cast<uint32_t>(value), 4);
+            } else {
+                out.push_back(static_cast<char>(0xD3));
+                append_be(out, static_cast<uint64_t>(value), 8);
+            }
+        }
+
+        /// \brief Appends an unsigned integer using the smallest MessagePack encoding.
+        static void append_uint(std::string& out, uint64_t value) {
+            if (value < 0x80) {
+                out.push_back(static_cast<char>(value));
+            } else if (value <= UINT8_MAX) {
+                out.push_back(static_cast<char>(0xCC));
+                append_be(out, value, 1);
+            } else if (value <= UINT16_MAX) {
+                out.push_back(static_cast<char>(0xCD));
+                append_be(out, value, 2);
+            } else if (value <= UINT32_MAX) {
+                out.push_back(static_cast<char>(0xCE));
+                append_be(out, value, 4);
+            } else {
+                out.push_back(static_cast<char>(0xCF));
+                append_be(out, value, 8);
+            }
+        }
+
+        /// \brief Appends a UTF-8 string with its length prefix.
+        static void append_str(std::string& out, const char* data, size_t size) {
+            char header[5];
+            out.append(header, str_header(header, size));
+            out.append(data, size);
+        }
+
+        /// \brief Writes the header of a string of `size` bytes.
+        /// \param header Receives up to 5 bytes.
+        /// \return Bytes written.
+        static size_t str_header(char* header, size_t size) {
+            if (size < 32) {
+                header[0] = static_cast<char>(0xA0 | size);
+                return 1;
+            }
+            int bytes = 4;
+            header[0] = static_cast<char>(0xDB);
+            if (size <= UINT8_MAX) {
+                bytes = 1;
+                header[0] = static_cast<char>(0xD9);
+            } else if (size <= UINT16_MAX) {
+                bytes = 2;
+                header[0] = static_cast<char>(0xDA);
+            }
+            for (int i = 0; i < bytes; ++i) {
+                header[1 + i] = static_cast<char>((size >> ((bytes - 1 - i) * 8)) & 0xFF);
+            }
+            return static_cast<size_t>(bytes) + 1;
+        }
+
+    private:
+        Config m_config;                ///< Formatter configuration.
+        std::vector<std::string> m_keys;///< Pre-encoded field keys, one per field.
+
+        /// \brief Appends the low `bytes` bytes of a value in big-endian order.
+        static void append_be(std::string& out, uint64_t value, int bytes) {
+            for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+                out.push_back(static_cast<char>((value >> shift) & 0xFF));
+            }
+        }
+
+        /// \brief Appends a 64-bit floating-point value.
+        static void append_float64(std::string& out, double value) {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            out.push_back(static_cast<char>(0xCB));
+            append_be(out, bits, 8);
+        }
+
+        /// \brief Appends a map header for the given number of entries.
+        static void append_map_header(std::string& out, size_t entries) {
+            if (entries < 16) {
+                out.push_back(static_cast<char>(0x80 | entries));
+            } else if (entries <= UINT16_MAX) {
+                out.push_back(static_cast<char>(0xDE));
+                append_be(out, entries, 2);
+            } else {
+                out.push_back(static_cast<char>(0xDF));
+                append_be(out, entries, 4);
+            }
+        }
+
+        /// \brief Appends the named arguments as key/value pairs.
+        static void append_args(const LogRecord& record, std::string& out) {
+            for (size_t i = 0; i < record.args_array.size(); ++i) {
+                const VariableValue& arg = record.args_array[i];
+                if (!is_named(arg)) continue;
+                append_str(out, arg.name.data(), arg.name.size());
+                append_value(arg, out);
+            }
+        }
+    }; // class MsgpackFormatter
+
+}; // namespace logit
+
+#endif // _LOGIT_MSGPACK_FORMATTER_HPP_INCLUDED
@@ -129,7 +129,7 @@ namespace logit {
             }
 
             oss << "], "
-                << "\"thread_id\": \"" << escape_json_string(thread_id_to_string(record.thread_id)) << "\""
+                << "\"thread_id\": \"" << escape_json_string(record.thread_label.empty() ? logit::thread_id_to_string(record.thread_id) : record.thread_label) << "\""
                 << "}";
 
             return oss.str();
@@ -143,38 +143,7 @@ namespace logit {
         /// \param input The input string that may contain special characters.
         /// \return A properly escaped JSON string.
         std::string escape_json_string(const std::string& input) const {
-            std::ostringstream oss;
-            for (char c : input) {
-                switch (c) {
-                    case '"': oss << "\\\""; break;
-                    case '\\': oss << "\\\\"; break;
-                    case '\b': oss << "\\b"; break;
-                    case '\f': oss << "\\f"; break;
-                    case '\n': oss << "\\n"; break;
-                    case '\r': oss << "\\r"; break;
-                    case '\t': oss << "\\t"; break;
-                    default:
-                        if ('\x00' <= c && c <= '\x1f') {
-                            oss << "\\u"
-                                << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
-                        } else {
-                            oss << c;
-                        }
-                }
-            }
-            return oss.str();
-        }
-
-        /// \brief Helper function to convert a thread ID to a string.
-        ///
-        /// Converts the thread ID to a string format that can be used in the JSON output.
-        ///
-        /// \param thread_id The thread ID to be converted.
-        /// \return A string representation of the thread ID.
-        std::string thread_id_to_string(const std::thread::id& thread_id) const {
-            std::ostringstream oss;
-            oss << thread_id;
-            return oss.str();
+            return escape_json(input);
         }
     }; // class SimpleLogFormatter
 
@@ -0,0 +1,170 @@
+#pragma once
+#ifndef _LOGIT_STRUCTURED_LOG_FORMATTER_HPP_INCLUDED
+#define _LOGIT_STRUCTURED_LOG_FORMATTER_HPP_INCLUDED
+
+/// \file StructuredLogFormatter.hpp
+/// \brief Common base of the formatters that emit records as key/value fields.
+
+#include "ILogFormatter.hpp"
+#include "compiler/PatternCompiler.hpp"
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace logit {
+
+    /// \class StructuredLogFormatter
+    /// \brief Shared pieces of the JSON, logfmt and MessagePack formatters.
+    ///
+    /// Provides the field schema type, the default schema and helpers that work directly on
+    /// the typed `LogRecord::args_array` values and append into a caller-owned buffer.
+    class StructuredLogFormatter : public ILogFormatter {
+    public:
+        /// \struct Field
+        /// \brief Describes one field of the output record.
+        struct Field {
+            RecordField field; ///< Record attribute to emit.
+            std::string key;   ///< Key used for the attribute.
+
+            /// \brief Constructs a field description.
+            /// \param field Record attribute to emit.
+            /// \param key Key used for the attribute.
+            Field(RecordField field, const std::string& key) : field(field), key(key) {}
+        };
+
+        /// \brief Returns the default field schema.
+        /// \return Timestamp, level, file, line, function, thread ID, message and arguments.
+        static std::vector<Field> default_fields() {
+            std::vector<Field> fields;
+            fields.emplace_back(RecordField::TimestampMs, "timestamp_ms");
+            fields.emplace_back(RecordField::Level, "level");
+            fields.emplace_back(RecordField::File, "file");
+            fields.emplace_back(RecordField::Line, "line");
+            fields.emplace_back(RecordField::Function, "function");
+            fields.emplace_back(RecordField::ThreadId, "thread_id");
+            fields.emplace_back(RecordField::Message, "message");
+            fields.emplace_back(RecordField::Args, "args");
+            return fields;
+        }
+
+        /// \brief Sets the timestamp offset.
+        ///
+        /// Structured output always carries the UTC timestamp in milliseconds, so the offset
+        /// is stored only for interface compatibility.
+        /// \param offset_ms Timezone offset in milliseconds.
+        void set_timestamp_offset(int64_t offset_ms) override {
+            m_offset_ms = offset_ms;
+        }
+
+        /// \brief Formats a log record into a new string.
+        /// \param record The log record to be formatted.
+        /// \return The formatted record.
+        std::string format(const LogRecord& record) const override {
+            std::string out;
+            out.reserve(estimate_size(record));
+            format_to(record, out);
+            return out;
+        }
+
+        /// \brief Checks whether an argument carries a usable key.
+        ///
+        /// Constants such as `42` or `"text"` have no variable name; they are part of the
+        /// message text and are not repeated among the argument fields.
+        static bool is_named(const VariableValue& arg) {
+            return arg.is_literal && arg.name[0] != '"' && arg.name[0] != '\'';
+        }
+
+        /// \brief Counts the arguments that are emitted as fields.
+        static size_t count_named(const LogRecord& record) {
+            size_t count = 0;
+            for (size_t i = 0; i < record.args_array.size(); ++i) {
+                if (is_named(record.args_array[i])) ++count;
+            }
+            return count;
+        }
+
+    protected:
+        std::atomic<int64_t> m_offset_ms = ATOMIC_VAR_INIT(0); ///< Timestamp offset in milliseconds.
+
+        /// \brief Estimates the output size to reserve the buffer once.
+        static size_t estimate_size(const LogRecord& record) {
+            return 160 + record.file.size() + record.function.size() +
+                   record.format.size() + record.args_array.size() * 48;
+        }
+
+        /// \class MessageAppender
+        /// \brief Stream for `FormatInstruction::write_message()` that appends to a string.
+        class MessageAppender {
+        public:
+            explicit MessageAppender(std::string& out) : m_out(out) {}
+            MessageAppender& operator<<(const std::string& text) { m_out.append(text); return *this; }
+            MessageAppender& operator<<(const char* text) { m_out.append(text); return *this; }
+
+        private:
+            std::string& m_out; ///< Buffer receiving the text.
+        };
+
+        /// \brief Appends the raw text of the `%v` message to a buffer.
+        /// \return Offset of the message text in `out`.
+        static size_t append_message(std::string& out, const LogRecord& record) {
+            const size_t start = out.size();
+            if (record.args_array.empty()) {
+                out.append(record.format);
+            } else {
+                MessageAppender appender(out);
+                FormatInstruction::write_message(appender, record);
+            }
+            return start;
+        }
+
+        /// \brief Cuts raw text appended by `append_message()` off a buffer to encode it again.
+        /// \return Copy of the text in a thread-local buffer that stays valid until the next call.
+        static const std::string& cut_message(std::string& out, size_t start) {
+            static thread_local std::string text;
+            text.assign(out, start, std::string::npos);
+            out.resize(start);
+            return text;
+        }
+
+        /// \brief Returns the thread ID text of a record.
+        static const std::string& thread_text(const LogRecord& record) {
+            return record.thread_label.empty() ? thread_id_to_string(record.thread_id) : record.thread_label;
+        }
+
+        /// \brief Returns the offset of the basename inside the record file path.
+        static size_t file_name_offset(const LogRecord& record) {
+            const size_t pos = record.file.find_last_of("/\\");
+            return pos == std::string::npos ? 0 : pos + 1;
+        }
+
+        /// \brief Appends a signed integer in decimal form.
+        static void append_int(std::string& out, int64_t value) {
+            detail::append_int(out, value);
+        }
+
+        /// \brief Appends an unsigned integer in decimal form.
+        static void append_uint(std::string& out, uint64_t value) {
+            detail::append_uint(out, value);
+        }
+
+        /// \brief Appends a finite double in its shortest round-trip form.
+        /// \return False if the value is NaN or infinite and nothing was written.
+        static bool append_real(std::string& out, double value) {
+            if (std::isnan(value) || std::isinf(value)) return false;
+            detail::append_double(out, value);
+            return true;
+        }
+
+        /// \brief Appends a finite float in its shortest round-trip form.
+        /// \return False if the value is NaN or infinite and nothing was written.
+        static bool append_real(std::string& out, float value) {
+            if (std::isnan(value) || std::isinf(value)) return false;
+            detail::append_float(out, value);
+            return true;
+        }
+    }; // class StructuredLogFormatter
+
+}; // namespace logit
+
+#endif // _LOGIT_STRUCTURED_LOG_FORMATTER_HPP_INCLUDED
@@ -254,7 +254,8 @@ namespace logit {
 
                 // Thread
                 case FormatType::ThreadId:
-                    temp_stream << record.thread_id;
+                    if (record.thread_label.empty()) temp_stream << record.thread_id;
+                    else temp_stream << record.thread_label;
                     break;
 
                 // Color
@@ -271,90 +272,7 @@ namespace logit {
 
                 // Message
                 case FormatType::Message:
-                    if (!record.format.empty()) {
-                        if (record.args_array.empty()) {
-                            temp_stream << record.format;
-                            break;
-                        }
-                        using ValueType = VariableValue::ValueType;
-                        for (size_t i = 0; i < record.args_array.size(); ++i) {
-                            if (!record.print_mode && i) temp_stream << ", ";
-                            const auto& arg = record.args_array[i];
-                            switch (arg.type) {
-                            case ValueType::STRING_VAL:
-                            case ValueType::EXCEPTION_VAL:
-                            case ValueType::ERROR_CODE_VAL:
-                            case ValueType::ENUM_VAL:
-                            case ValueType::DURATION_VAL:
-                            case ValueType::TIME_POINT_VAL:
-                            case ValueType::POINTER_VAL:
-                            case ValueType::SMART_POINTER_VAL:
-                            case ValueType::VARIANT_VAL:
-                            case ValueType::OPTIONAL_VAL:
-#ifdef LOGIT_WITH_FMT
-                                temp_stream << (record.fmt_mode ? arg.to_string_fmt(record.format.c_str()) : arg.to_string(record.format.c_str()));
-#else
-                                temp_stream << arg.to_string(record.format.c_str());
-#endif
-                                break;
-                            default:
-#ifdef LOGIT_WITH_FMT
-                                if (arg.is_literal) {
-                                    temp_stream << arg.name << ": " << (record.fmt_mode ? arg.to_string_fmt(record.format.c_str()) : arg.to_string(record.format.c_str()));
-                                } else {
-                                    temp_stream << (record.fmt_mode ? arg.to_string_fmt(record.format.c_str()) : arg.to_string(record.format.c_str()));
-                                }
-#else
-                                if (arg.is_literal) {
-                                    temp_stream << arg.name << ": " << arg.to_string(record.format.c_str());
-                                } else {
-                                    temp_stream << arg.to_string(record.format.c_str());
-                                }
-#endif
-                                break;
-                            };
-                        }
-                    } else
-                    if (!record.args_array.empty()) {
-                        using ValueType = VariableValue::ValueType;
-                        for (size_t i = 0; i < record.args_array.size(); ++i) {
-                            if (!record.print_mode && i) temp_stream << ", ";
-                            const auto& arg = record.args_array[i];
-                            switch (arg.type) {
-                            case ValueType::STRING_VAL:
-                            case ValueType::EXCEPTION_VAL:
-                            case ValueType::ERROR_CODE_VAL:
-                                temp_stream << arg.to_string();
-                                break;
-                            case ValueType::ENUM_VAL:
-                                if (arg.is_literal) {
-                                    if (record.print_mode) temp_stream << arg.to_string();
-                                    else temp_stream << arg.name << ": " << arg.to_string();
-                                    break;
-                                }
-                                temp_stream << arg.to_string();
-                                break;
-                            case ValueType::PATH_VAL:
-                            case ValueType::DURATION_VAL:
-                            case ValueType::TIME_POINT_VAL:
-                            case ValueType::POINTER_VAL:
-                            case ValueType::SMART_POINTER_VAL:
-                            case ValueType::VARIANT_VAL:
-                            case ValueType::OPTIONAL_VAL:
-                                if (record.print_mode) temp_stream << arg.to_string();
-                                else temp_stream << arg.name << ": " << arg.to_string();
-                                break;
-                            default:
-                                if (arg.is_literal) {
-                                    if (record.print_mode) temp_stream << arg.to_string();
-                                    else temp_stream << arg.name << ": " << arg.to_string();
-                                    break;
-                                }
-                                temp_stream << arg.to_string();
-                                break;
-                            };
-                        }
-                    }
+                    write_message(temp_stream, record);
                     break;
             };
 
@@ -419,6 +337,98 @@ namespace logit {
             }
         }
 
+        /// \brief Writes the message part of a record (the `%v` flag) to a stream.
+        /// \tparam StreamType The type of the output stream.
+        /// \param os The output stream.
+        /// \param record The log record.
+        template<class StreamType>
+        static void write_message(StreamType& os, const LogRecord& record) {
+            if (!record.format.empty()) {
+                if (record.args_array.empty()) {
+                    os << record.format;
+                    return;
+                }
+                using ValueType = VariableValue::ValueType;
+                for (size_t i = 0; i < record.args_array.size(); ++i) {
+                    if (!record.print_mode && i) os << ", ";
+                    const auto& arg = record.args_array[i];
+                    switch (arg.type) {
+                    case ValueType::STRING_VAL:
+                    case ValueType::EXCEPTION_VAL:
+                    case ValueType::ERROR_CODE_VAL:
+                    case ValueType::ENUM_VAL:
+                    case ValueType::DURATION_VAL:
+                    case ValueType::TIME_POINT_VAL:
+                    case ValueType::POINTER_VAL:
+                    case ValueType::SMART_POINTER_VAL:
+                    case ValueType::VARIANT_VAL:
+                    case ValueType::OPTIONAL_VAL:
+#ifdef LOGIT_WITH_FMT
+                        os << (record.fmt_mode ? arg.to_string_fmt(record.format.c_str()) : arg.to_string(record.format.c_str()));
+#else
+                        os << arg.to_string(record.format.c_str());
+#endif
+                        break;
+                    default:
+#ifdef LOGIT_WITH_FMT
+                        if (arg.is_literal) {
+                            os << arg.name << ": " << (record.fmt_mode ? arg.to_string_fmt(record.format.c_str()) : arg.to_string(record.format.c_str()));
+                        } else {
+                            os << (record.fmt_mode ? arg.to_string_fmt(record.format.c_str()) : arg.to_string(record.format.c_str()));
+                        }
+#else
+                        if (arg.is_literal) {
+                            os << arg.name << ": " << arg.to_string(record.format.c_str());
+                        } else {
+                            os << arg.to_string(record.format.c_str());
+                        }
+#endif
+                        break;
+                    };
+                }
+            } else
+            if (!record.args_array.empty()) {
+                using ValueType = VariableValue::ValueType;
+                for (size_t i = 0; i < record.args_array.size(); ++i) {
+                    if (!record.print_mode && i) os << ", ";
+                    const auto& arg = record.args_array[i];
+                    switch (arg.type) {
+                    case ValueType::STRING_VAL:
+                    case ValueType::EXCEPTION_VAL:
+                    case ValueType::ERROR_CODE_VAL:
+                        os << arg.to_string();
+                        break;
+                    case ValueType::ENUM_VAL:
+                        if (arg.is_literal) {
+                            if (record.print_mode) os << arg.to_string();
+                            else os << arg.name << ": " << arg.to_string();
+                            break;
+                        }
+                        os << arg.to_string();
+                        break;
+                    case ValueType::PATH_VAL:
+                    case ValueType::DURATION_VAL:
+                    case ValueType::TIME_POINT_VAL:
+                    case ValueType::POINTER_VAL:
+                    case ValueType::SMART_POINTER_VAL:
+                    case ValueType::VARIANT_VAL:
+                    case ValueType::OPTIONAL_VAL:
+                        if (record.print_mode) os << arg.to_string();
+                        else os << arg.name << ": " << arg.to_string();
+                        break;
+                    default:
+                        if (arg.is_literal) {
+                            if (record.print_mode) os << arg.to_string();
+                            else os << arg.name << ": " << arg.to_string();
+                            break;
+                        }
+                        os << arg.to_string();
+                        break;
+                    };
+                }
+            }
+        }
+
     private:
 
         /// \brief Removes ANSI escape codes (including color codes and cursor movement) from a string.
@@ -11,15 +11,30 @@
 
 #include "config.hpp"
 #include "utils.hpp"
+#include "formatter/BinaryLogFormatter.hpp"
 #include "detail/TaskExecutor.hpp"
 #ifndef __EMSCRIPTEN__
 #include "detail/CompressionWorker.hpp"
+#include "detail/FdFileWriter.hpp"
+#include "detail/ConsoleWriter.hpp"
+#include "detail/IoUringFileWriter.hpp"
+#include "detail/MmapFileWriter.hpp"
+#include "detail/CompressedFileWriter.hpp"
+#include "detail/FileWriterFactory.hpp"
+#include "detail/TimeIndex.hpp"
+#include "detail/UniquePack.hpp"
+#include "detail/FramedLog.hpp"
+#include "detail/RecordFramer.hpp"
+#include "detail/SharedLogState.hpp"
+#include "detail/RingLog.hpp"
 #endif
 
 #include "loggers/ILogger.hpp"
 #include "loggers/ConsoleLogger.hpp"
 #include "loggers/FileLogger.hpp"
+#include "loggers/IoUringFileLogger.hpp"
 #include "loggers/UniqueFileLogger.hpp"
+#include "loggers/RingFileLogger.hpp"
 #include "loggers/SyslogLogger.hpp"
 #include "loggers/EventLogLogger.hpp"
 #include "loggers/SystemLogger.hpp"
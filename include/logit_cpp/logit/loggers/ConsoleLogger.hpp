@@ -43,6 +43,7 @@ EM_JS(void, log_level, (int lvl, const char* msg), {
 #endif
 #include <mutex>
 #include <atomic>
+#include <chrono>
 
 namespace logit {
 
@@ -57,6 +58,19 @@ namespace logit {
     /// - Cross-platform color support (ANSI on Linux/macOS, Windows-specific handling).
     /// - Thread-safe logging.
     /// - Synchronous or asynchronous operation.
+    /// - Optional buffered output straight to descriptors 1 and 2 (`Config::direct_fd`).
+    ///
+    /// With `direct_fd` records bypass `std::cout` and are collected in one buffer per
+    /// descriptor. The buffer is written out when the records queued for the worker have
+    /// been processed, when it is full, when a record reaches `flush_level`, or when the
+    /// oldest record has waited `flush_interval_ms` while the queue stays busy. Terminals
+    /// get every record at once. Synchronous loggers write each record with one call.
+    ///
+    /// With `non_blocking` a stalled reader, such as a full pipe to a container log
+    /// driver, never blocks the worker: bytes the descriptor does not take wait in a
+    /// pending buffer of `pending_limit` bytes, further records are dropped and counted
+    /// (`LoggerParam::DroppedRecords`), and a line with their number is written once the
+    /// reader catches up.
     class ConsoleLogger : public ILogger {
     public:
 
@@ -69,16 +83,27 @@ namespace logit {
 #else
             bool async = true;  ///< Flag indicating whether logging should be asynchronous.
 #endif
+            bool     direct_fd = false;         ///< Write to descriptors 1 and 2 through buffers instead of `std::cout` (POSIX).
+            bool     split_stderr = false;      ///< Send records at `stderr_level` and above to stderr.
+            LogLevel stderr_level = LogLevel::LOG_LVL_WARN; ///< Lowest level sent to stderr with `split_stderr`.
+            size_t   buffer_size = 64 * 1024;   ///< Buffer of each descriptor with `direct_fd`.
+            uint32_t flush_interval_ms = 100;   ///< Longest time a record stays buffered while the worker is busy (0 = no limit).
+            LogLevel flush_level = LogLevel::LOG_LVL_ERROR; ///< Records at or above this level are written out at once.
+            bool     non_blocking = false;      ///< Never wait for a stalled reader of stdout/stderr; implies `direct_fd` (POSIX).
+            size_t   pending_limit = 1024 * 1024; ///< Bytes per descriptor kept for a stalled reader with `non_blocking`; later records are dropped.
+            uint32_t drain_timeout_ms = 1000;   ///< Time `wait()` gives a stalled reader before pending records are dropped.
         };
 
         /// \brief Default constructor that uses default configuration.
         ConsoleLogger() {
+            open_writers();
             reset_color();
         }
 
         /// \brief Constructor with custom configuration.
         /// \param config The configuration for the logger.
         ConsoleLogger(const Config& config) : m_config(config) {
+            open_writers();
             reset_color();
         }
 
@@ -86,17 +111,23 @@ namespace logit {
         /// \param async Boolean flag for asynchronous logging.
         ConsoleLogger(const bool async) {
             m_config.async = async;
+            open_writers();
             reset_color();
         }
 
-        virtual ~ConsoleLogger() = default;
+        /// \brief Waits for queued records and writes out the buffers.
+        virtual ~ConsoleLogger() {
+            wait();
+        }
 
         /// \brief Sets the logger configuration.
         /// This method sets the logger's configuration and ensures thread safety with a mutex lock.
         /// \param config The new configuration.
         void set_config(const Config& config) {
             std::lock_guard<std::mutex> lock(m_mutex);
+            flush_writers();
             m_config = config;
+            open_writers();
         }
 
         /// \brief Gets the current logger configuration.
@@ -141,26 +172,18 @@ namespace logit {
             return;
 #else
             std::unique_lock<std::mutex> lock(m_mutex);
+            const LogLevel level = record.log_level;
             if (!m_config.async) {
-#               if defined(_WIN32)
-                // For Windows, parse the message for ANSI color codes and apply them
-                handle_ansi_colors_windows(message);
-#               else
-                // For other systems, output the message as is
-                std::cout << message << std::endl;
-#               endif
+                write_message(message, level, true);
                 return;
             }
             lock.unlock();
-            detail::TaskExecutor::get_instance().add_task([this, message](){
+            // A task dropped by the queue policy or after shutdown releases its count too.
+            std::shared_ptr<PendingRecord> pending = std::make_shared<PendingRecord>(m_pending);
+            detail::TaskExecutor::get_instance().add_task([this, message, level, pending](){
                 std::lock_guard<std::mutex> lock(m_mutex);
-#               if defined(_WIN32)
-                // For Windows, parse the message for ANSI color codes and apply them
-                handle_ansi_colors_windows(message);
-#               else
-                // For other systems, output the message as is
-                std::cout << message << std::endl;
-#               endif
+                // The last queued record of this logger ends the batch of the worker.
+                write_message(message, level, pending->finish());
             });
 #endif
         }
@@ -189,6 +212,16 @@ namespace logit {
             switch (param) {
             case LoggerParam::LastLogTimestamp: return get_last_log_ts();
             case LoggerParam::TimeSinceLastLog: return get_time_since_last_log();
+#           ifndef __EMSCRIPTEN__
+            case LoggerParam::FlushCount: return static_cast<int64_t>(m_out.flush_count() + m_err.flush_count());
+            case LoggerParam::WriteCallCount: return static_cast<int64_t>(m_out.write_calls() + m_err.write_calls());
+            case LoggerParam::BytesWritten: return static_cast<int64_t>(m_out.bytes_written() + m_err.bytes_written());
+            case LoggerParam::BytesPerWrite: {
+                const uint64_t calls = m_out.write_calls() + m_err.write_calls();
+                return calls ? static_cast<int64_t>((m_out.bytes_written() + m_err.bytes_written()) / calls) : 0;
+            }
+            case LoggerParam::DroppedRecords: return static_cast<int64_t>(m_out.dropped_records() + m_err.dropped_records());
+#           endif
             default:
                 break;
             };
@@ -222,16 +255,125 @@ namespace logit {
         /// If asynchronous logging is enabled, waits for all pending log messages to be written.
         void wait() override {
             std::unique_lock<std::mutex> lock(m_mutex);
-            if (!m_config.async) return;
-            lock.unlock();
-            detail::TaskExecutor::get_instance().wait();
+            if (m_config.async) {
+                lock.unlock();
+                detail::TaskExecutor::get_instance().wait();
+                lock.lock();
+            }
+            flush_writers();
         }
 
     private:
+#       ifndef __EMSCRIPTEN__
+        /// \class PendingRecord
+        /// \brief Counts a queued record until its task runs or is destroyed unrun.
+        class PendingRecord {
+        public:
+            explicit PendingRecord(std::atomic<uint64_t>& pending) : m_pending(pending) {
+                m_pending.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            PendingRecord(const PendingRecord&) = delete;
+            PendingRecord& operator=(const PendingRecord&) = delete;
+
+            ~PendingRecord() {
+                if (!m_finished) m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            /// \brief Releases the count of a written record.
+            /// \return True if no further record of the logger is queued.
+            bool finish() {
+                m_finished = true;
+                return m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            }
+
+        private:
+            std::atomic<uint64_t>& m_pending; ///< Counter of the logger.
+            bool m_finished = false;          ///< True once the record was written.
+        };
+#       endif
+
         mutable std::mutex m_mutex;     ///< Mutex to protect console output
         Config             m_config;    ///< Configuration for the console logger.
         std::atomic<int64_t> m_last_log_ts = ATOMIC_VAR_INIT(0);
         std::atomic<int>    m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
+        std::atomic<uint64_t> m_pending = ATOMIC_VAR_INIT(0); ///< Records queued for the worker but not yet written.
+#       ifndef __EMSCRIPTEN__
+        detail::ConsoleWriter m_out;    ///< Buffer for descriptor 1 with `direct_fd`.
+        detail::ConsoleWriter m_err;    ///< Buffer for descriptor 2 with `direct_fd`.
+#       endif
+
+        /// \brief Returns true if records go through the descriptor buffers.
+        bool use_fd() const {
+#           if defined(_WIN32) || defined(__EMSCRIPTEN__)
+            return false;
+#           else
+            return m_config.direct_fd || m_config.non_blocking;
+#           endif
+        }
+
+        /// \brief Attaches the buffers to the standard descriptors if `direct_fd` is set.
+        void open_writers() {
+#           ifndef __EMSCRIPTEN__
+            if (!use_fd()) {
+                m_out.close();
+                m_err.close();
+                return;
+            }
+            // Text already in the stream buffer must come first.
+            std::cout.flush();
+            m_out.open(1, m_config.buffer_size);
+            m_err.open(2, m_config.buffer_size);
+            if (m_config.non_blocking) {
+                m_out.set_non_blocking(m_config.pending_limit);
+                m_err.set_non_blocking(m_config.pending_limit);
+            }
+#           endif
+        }
+
+        /// \brief Writes out both descriptor buffers, giving a stalled reader `drain_timeout_ms`.
+        void flush_writers() {
+#           ifndef __EMSCRIPTEN__
+            m_out.flush();
+            m_err.flush();
+            if (m_config.non_blocking) {
+                m_out.drain_pending(m_config.drain_timeout_ms);
+                m_err.drain_pending(m_config.drain_timeout_ms);
+            }
+#           endif
+        }
+
+#       ifndef __EMSCRIPTEN__
+        /// \brief Outputs one record to the stream or to a descriptor buffer.
+        /// \param batch_end True if no further record of this logger is queued.
+        void write_message(const std::string& message, LogLevel level, bool batch_end) {
+            const bool to_stderr = m_config.split_stderr && level >= m_config.stderr_level;
+            if (use_fd()) {
+                detail::ConsoleWriter& writer = to_stderr ? m_err : m_out;
+                // Keep the order of records split between the two descriptors.
+                (to_stderr ? m_out : m_err).flush();
+                writer.write_line(message.data(), message.size());
+                if (batch_end || writer.is_tty() || level >= m_config.flush_level ||
+                    (m_config.flush_interval_ms > 0 &&
+                     detail::ConsoleWriter::clock::now() - writer.oldest() >=
+                        std::chrono::milliseconds(m_config.flush_interval_ms))) {
+                    writer.flush();
+                }
+                return;
+            }
+#           if defined(_WIN32)
+            // For Windows, parse the message for ANSI color codes and apply them
+            if (to_stderr) {
+                handle_ansi_colors_windows(message, std::cerr, STD_ERROR_HANDLE);
+            } else {
+                handle_ansi_colors_windows(message, std::cout, STD_OUTPUT_HANDLE);
+            }
+#           else
+            // For other systems, output the message as is
+            (to_stderr ? std::cerr : std::cout) << message << std::endl;
+#           endif
+        }
+#       endif
 
 #       ifdef __EMSCRIPTEN__
         /// \brief Convert TextColor to a CSS color name.
@@ -282,16 +424,20 @@ namespace logit {
 
         /// \brief Handle ANSI color codes in the message for Windows console.
         /// \param message The message containing ANSI color codes.
-        void handle_ansi_colors_windows(const std::string& message) const {
+        /// \param out Stream to write to.
+        /// \param std_handle `STD_OUTPUT_HANDLE` or `STD_ERROR_HANDLE`, matching `out`.
+        void handle_ansi_colors_windows(const std::string& message,
+                                        std::ostream& out = std::cout,
+                                        DWORD std_handle = STD_OUTPUT_HANDLE) const {
             std::string::size_type start = 0;
             std::string::size_type pos = 0;
 
-            HANDLE handle_stdout = GetStdHandle(STD_OUTPUT_HANDLE);
+            HANDLE handle_stdout = GetStdHandle(std_handle);
 
             while ((pos = message.find("\033[", start)) != std::string::npos) {
                 // Output the part of the string before the ANSI code
                 if (pos > start) {
-                    std::cout << message.substr(start, pos - start);
+                    out << message.substr(start, pos - start);
                 }
 
                 // Find the end of the ANSI code
@@ -310,9 +456,9 @@ namespace logit {
 
             // Output any remaining part of the message
             if (start < message.size()) {
-                std::cout << message.substr(start);
+                out << message.substr(start);
             }
-            if (!message.empty()) std::cout << std::endl;
+            if (!message.empty()) out << std::endl;
 
             // Reset the console color to default
             SetConsoleTextAttribute(handle_stdout, static_cast<WORD>(text_color_to_win_color(m_config.default_color)));
@@ -384,6 +530,14 @@ namespace logit {
 #           elif defined(_WIN32)
             handle_ansi_colors_windows(std::string());
 #           else
+            if (use_fd()) {
+                const std::string color = to_string(m_config.default_color);
+                if (!color.empty()) {
+                    m_out.write(color.data(), color.size());
+                    m_out.flush();
+                }
+                return;
+            }
             std::cout << to_string(m_config.default_color);
 #           endif
         }
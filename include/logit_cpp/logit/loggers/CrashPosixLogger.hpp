@@ -8,18 +8,31 @@
 #include "ILogger.hpp"
 
 #include <atomic>
-#include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #if defined(__unix__) || defined(__APPLE__) || defined(__linux__)
 #include <cerrno>
 #include <fcntl.h>
 #include <signal.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <ucontext.h>
+#endif
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define LOGIT_CRASH_HAS_EXECINFO 1
+#endif
 #endif
 
 namespace logit {
@@ -29,19 +42,55 @@ namespace logit {
     /// \class CrashPosixLogger
     /// \ingroup LogBackends
     /// \brief Maintains an in-memory ring buffer of recent messages and dumps it on crashes.
+    ///
+    /// The buffer is allocated once at construction. On a caught signal the handler
+    /// appends its contents to `Config::log_path`. With `Config::map_path` the buffer is
+    /// a `MAP_SHARED` mapping of that file instead, so the messages are in the page cache
+    /// at every moment and also survive `SIGKILL` or the OOM killer; the handler then
+    /// only marks the header. A mapped file left by a process that did not exit cleanly
+    /// is renamed to `<map_path>.prev` on start, and `read_map_file()` renders it.
+    ///
+    /// By default all threads append to one ring through a shared atomic offset. With
+    /// `Config::thread_rings` the buffer is split into that many sub-rings instead; a
+    /// thread claims one on its first message, so writers no longer contend on a cache
+    /// line or overwrite each other's records when a ring wraps. Records then carry a
+    /// steady-clock timestamp, and the dump merges the sub-rings in time order using
+    /// memory allocated at construction. A thread keeps its sub-ring until it exits, also
+    /// while it logs to other loggers, and the records it left stay in the dump. While
+    /// every sub-ring is claimed, new threads share them; `shared_threads()` counts those
+    /// threads and the crash dump reports them after the marker.
+    ///
+    /// With `Config::dump_context` the handler also appends the fault address, the
+    /// registers from the signal's `ucontext` (Linux on x86-64 and AArch64), the raw
+    /// return addresses of the crashing thread and a copy of `/proc/self/maps`. Stack
+    /// capture uses `backtrace()`, loaded at construction so that it does not allocate
+    /// in the handler, or a frame-pointer walk where it is missing. `logit-symbolize`
+    /// resolves the addresses offline.
     class CrashPosixLogger : public ILogger {
     public:
         /// \brief Maximum storage reserved for the ring buffer.
-        static constexpr std::size_t kMaxBufferSize = 64 * 1024; // 64 KiB
+        static constexpr std::size_t kMaxBufferSize = std::size_t(1) << 30; // 1 GiB
 
         /// \brief Default amount of bytes stored from the most recent messages.
-        static constexpr std::size_t kDefaultBufferSize = kMaxBufferSize;
+        static constexpr std::size_t kDefaultBufferSize = 64 * 1024; // 64 KiB
+
+        /// \brief Bytes before the buffer in a mapped file; one page.
+        static constexpr std::size_t kMapHeaderSize = 4096;
+
+        /// \brief Maximum number of per-thread sub-rings; their counters fit in the map header.
+        static constexpr unsigned kMaxThreadRings = 63;
+
+        /// \brief Maximum number of stack frames written on a crash.
+        static constexpr int kMaxBacktraceFrames = 64;
 
         /// \struct Config
         /// \brief Runtime configuration for the crash logger.
         struct Config {
             std::string log_path = "crash.log";          ///< Path to the crash log file.
-            std::size_t buffer_size = kDefaultBufferSize; ///< Bytes kept in the in-memory buffer.
+            std::size_t buffer_size = kDefaultBufferSize; ///< Bytes kept in the buffer, up to `kMaxBufferSize`.
+            std::string map_path;                         ///< File backing the buffer through `MAP_SHARED` (empty = heap memory).
+            unsigned    thread_rings = 0;                 ///< Per-thread sub-rings sharing `buffer_size`, up to `kMaxThreadRings` (0 = one ring).
+            bool        dump_context = true;              ///< Append registers, a backtrace and the memory map after the crash marker.
         };
 
         /// \brief Construct with default configuration.
@@ -51,10 +100,39 @@ namespace logit {
         /// \param config Configuration parameters.
         explicit CrashPosixLogger(const Config& config) :
                 m_log_path(config.log_path),
+                m_map_path(config.map_path),
+                m_dump_context(config.dump_context),
                 m_capacity(config.buffer_size > kMaxBufferSize ? kMaxBufferSize : config.buffer_size) {
             if (m_capacity == 0) {
                 m_capacity = 1;
             }
+            m_slot_count = config.thread_rings > kMaxThreadRings ? kMaxThreadRings : config.thread_rings;
+            if (m_slot_count > 0 && m_capacity / m_slot_count < kMinSlotSize) {
+                m_slot_count = static_cast<uint32_t>(m_capacity / kMinSlotSize);
+            }
+            if (m_slot_count > 0) {
+                m_slot_capacity = m_capacity / m_slot_count;
+                m_capacity = m_slot_capacity * m_slot_count;
+            }
+            if (!m_map_path.empty()) {
+                map_buffer();
+            }
+            if (m_buffer == nullptr) {
+                // Without a mapping the messages only reach the disk from the signal handler.
+                m_storage.reset(new char[m_capacity]());
+                m_buffer = m_storage.get();
+            }
+            if (m_slot_count > 0) {
+                if (m_slots == nullptr) {
+                    m_slot_storage.reset(new SlotControl[m_slot_count]());
+                    m_slots = m_slot_storage.get();
+                }
+                m_slot_pool = std::make_shared<SlotPool>(m_slot_count);
+                // Everything the signal handler needs for merging is allocated here.
+                m_merge_positions.reset(new uint64_t[2 * m_slot_count]());
+                m_dump_buffer.reset(new char[kDumpBufferSize]);
+            }
+            m_committed = m_header ? &m_header->committed : &m_local_committed;
             int flags = O_WRONLY | O_CREAT | O_APPEND;
 #ifdef O_CLOEXEC
             flags |= O_CLOEXEC;
@@ -65,6 +143,13 @@ namespace logit {
                 flags &= ~O_CLOEXEC;
                 m_fd = ::open(m_log_path.c_str(), flags, static_cast<mode_t>(S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH));
             }
+#endif
+#if defined(LOGIT_CRASH_HAS_EXECINFO)
+            if (m_dump_context) {
+                // The first call loads the unwinder, which allocates; do it outside the handler.
+                void* frame[1];
+                (void)::backtrace(frame, 1);
+            }
 #endif
             s_active_logger.store(this, std::memory_order_release);
         }
@@ -80,6 +165,7 @@ namespace logit {
             if (m_fd >= 0) {
                 ::close(m_fd);
             }
+            unmap_buffer();
         }
 
         /// \brief Store the message in the lock-free ring buffer.
@@ -97,6 +183,10 @@ namespace logit {
 
             const char* data = message.data();
             std::size_t length = message.size();
+            if (m_slot_count > 0) {
+                log_to_slot(data, length);
+                return;
+            }
 
             std::size_t copy_len = length;
             if (copy_len >= capacity) {
@@ -110,32 +200,70 @@ namespace logit {
             }
 
             const std::size_t total = copy_len + 1; // extra byte for newline marker
-            const std::size_t start = m_next_offset.fetch_add(total, std::memory_order_acq_rel);
-            const std::size_t index = capacity ? (start % capacity) : 0;
+            const uint64_t start = m_next_offset.fetch_add(total, std::memory_order_acq_rel);
+            const std::size_t index = static_cast<std::size_t>(start % capacity);
 
             if (copy_len > 0) {
                 std::size_t first = capacity - index;
                 if (first > copy_len) {
                     first = copy_len;
                 }
-                std::memcpy(m_buffer.data() + index, data, first);
+                std::memcpy(m_buffer + index, data, first);
                 const std::size_t remaining = copy_len - first;
                 if (remaining > 0) {
-                    std::memcpy(m_buffer.data(), data + first, remaining);
+                    std::memcpy(m_buffer, data + first, remaining);
                 }
             }
 
-            const std::size_t newline_index = capacity ? ((index + copy_len) % capacity) : 0;
+            const std::size_t newline_index = (index + copy_len) % capacity;
             m_buffer[newline_index] = '\n';
 
-            const std::size_t desired = start + total;
-            std::size_t expected = m_committed.load(std::memory_order_relaxed);
+            const uint64_t desired = start + total;
+            uint64_t expected = m_committed->load(std::memory_order_relaxed);
             while (expected < desired &&
-                   !m_committed.compare_exchange_weak(
+                   !m_committed->compare_exchange_weak(
                            expected, desired, std::memory_order_release, std::memory_order_relaxed)) {
             }
         }
 
+        /// \brief Renders a file written with `Config::map_path`.
+        /// \param path Path of the mapped file or of its `.prev` copy.
+        /// \return The buffered messages, oldest first, followed by the crash marker if a
+        /// signal was caught; empty if the file is not a crash buffer.
+        static std::string read_map_file(const std::string& path) {
+            std::ifstream file(path.c_str(), std::ios::binary);
+            std::vector<char> page(kMapHeaderSize);
+            if (!file.read(page.data(), static_cast<std::streamsize>(page.size()))) {
+                return std::string();
+            }
+            const MapHeader& header = *reinterpret_cast<const MapHeader*>(page.data());
+            if (!is_map_header(header)) {
+                return std::string();
+            }
+            std::vector<char> data(static_cast<std::size_t>(header.capacity));
+            file.read(data.data(), static_cast<std::streamsize>(data.size()));
+            std::string out;
+            if (header.slot_count > 0) {
+                std::vector<uint64_t> positions(2 * header.slot_count);
+                auto append = [&out](const char* text, std::size_t size) { out.append(text, size); };
+                merge_slots(reinterpret_cast<const SlotControl*>(page.data() + kMapSlotOffset), header.slot_count,
+                            data.data(), static_cast<std::size_t>(header.capacity / header.slot_count),
+                            positions.data(), append);
+            } else {
+                const uint64_t committed = header.committed.load();
+                const uint64_t available = committed < header.capacity ? committed : header.capacity;
+                const std::size_t start = static_cast<std::size_t>((committed - available) % header.capacity);
+                const std::size_t chunk = static_cast<std::size_t>(
+                        available < header.capacity - start ? available : header.capacity - start);
+                out.assign(data.data() + start, chunk);
+                out.append(data.data(), static_cast<std::size_t>(available - chunk));
+            }
+            if (header.state.load() == kMapCrashed) {
+                out += "\n== CRASH SIGNAL " + std::to_string(header.signal.load()) + " ==\n";
+            }
+            return out;
+        }
+
         /// \brief Return path to the crash log when requested.
         std::string get_string_param(const LoggerParam& param) const override {
             switch (param) {
@@ -172,6 +300,11 @@ namespace logit {
         /// \brief Crash logger operates synchronously.
         void wait() override {}
 
+        /// \brief Returns the number of threads that found every sub-ring claimed and share one.
+        uint32_t shared_threads() const noexcept {
+            return m_shared_threads.load(std::memory_order_relaxed);
+        }
+
         /// \brief Install sigaction handler dumping the buffer before exiting.
         /// \param signo Signal number.
         static void install_signal_handler(int signo) {
@@ -184,43 +317,418 @@ namespace logit {
         }
 
     private:
+        /// \brief Offset of the sub-ring counters in the map header.
+        static constexpr std::size_t kMapSlotOffset = 64;
+
+        /// \brief Smallest sub-ring; fewer sub-rings are used if `buffer_size` is too small.
+        static constexpr std::size_t kMinSlotSize = 256;
+
+        /// \brief Loggers whose sub-ring a thread remembers at once.
+        static constexpr std::size_t kMaxThreadClaims = 8;
+
+        /// \brief Bytes a sub-ring record adds to the message: timestamp, and size before and after it.
+        static constexpr std::size_t kSlotRecordOverhead = 16;
+
+        /// \brief Size of the buffer the signal handler collects merged records in.
+        static constexpr std::size_t kDumpBufferSize = 64 * 1024;
+
+        /// \struct SlotControl
+        /// \brief Counters of one sub-ring, padded to a cache line.
+        struct SlotControl {
+            std::atomic<uint64_t> next;      ///< Bytes reserved by writers since start.
+            std::atomic<uint64_t> committed; ///< End of the newest complete record.
+            char padding[48];
+        };
+
+        /// \struct SlotPool
+        /// \brief Unclaimed sub-rings of a logger, shared with the threads holding claims.
+        struct SlotPool {
+            std::atomic<uint64_t> free; ///< Bit `i` is set while sub-ring `i` is unclaimed.
+
+            explicit SlotPool(uint32_t count) : free(count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1) {}
+
+            /// \brief Claims the lowest unclaimed sub-ring.
+            /// \return False if every sub-ring is claimed.
+            bool claim(uint32_t& slot) noexcept {
+                uint64_t mask = free.load(std::memory_order_relaxed);
+                while (mask != 0) {
+                    uint32_t index = 0;
+                    while ((mask & (uint64_t(1) << index)) == 0) {
+                        ++index;
+                    }
+                    if (free.compare_exchange_weak(mask, mask & ~(uint64_t(1) << index),
+                                                   std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                        slot = index;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// \brief Returns a sub-ring to the pool.
+            void release(uint32_t slot) noexcept {
+                free.fetch_or(uint64_t(1) << slot, std::memory_order_acq_rel);
+            }
+        };
+
+        /// \struct ThreadClaims
+        /// \brief Sub-rings claimed by one thread; released when the thread exits.
+        struct ThreadClaims {
+            struct Claim {
+                std::shared_ptr<SlotPool> pool; ///< Pool of the logger the sub-ring belongs to.
+                uint32_t slot = 0;              ///< Index of the sub-ring.
+                bool owned = false;             ///< The sub-ring was claimed, not shared.
+
+                void release() noexcept {
+                    if (pool && owned) {
+                        pool->release(slot);
+                    }
+                    pool.reset();
+                    owned = false;
+                }
+            };
+
+            Claim entries[kMaxThreadClaims];
+            std::size_t next = 0; ///< Entry replaced when all are in use.
+
+            ~ThreadClaims() {
+                for (auto& claim : entries) {
+                    claim.release();
+                }
+            }
+        };
+
+        /// \brief Life cycle of a mapped buffer, stored in its header.
+        enum MapState : int32_t {
+            kMapRunning = 1, ///< A process is writing or was killed.
+            kMapClosed  = 2, ///< The logger was destroyed normally.
+            kMapCrashed = 3  ///< The signal handler ran.
+        };
+
+        /// \struct MapHeader
+        /// \brief Header at the start of a file written with `Config::map_path`.
+        struct MapHeader {
+            char     magic[8];                 ///< "LOGITCRS".
+            uint32_t version;                  ///< Layout version.
+            uint32_t header_size;              ///< `kMapHeaderSize`.
+            uint64_t capacity;                 ///< Size of the buffer.
+            std::atomic<uint64_t> committed;   ///< Bytes written since start; the buffer holds the last `capacity`.
+            std::atomic<int32_t>  state;       ///< `MapState`.
+            std::atomic<int32_t>  signal;      ///< Signal caught by the handler.
+            uint32_t slot_count;               ///< Sub-rings of `capacity / slot_count` bytes; 0 for one plain ring.
+            uint32_t reserved;
+        };
+
+        static bool is_map_header(const MapHeader& header) {
+            return std::memcmp(header.magic, "LOGITCRS", 8) == 0 && header.version == 1 &&
+                   header.header_size == kMapHeaderSize && header.capacity > 0 &&
+                   header.slot_count <= kMaxThreadRings &&
+                   (header.slot_count == 0 || header.capacity % header.slot_count == 0);
+        }
+
+        /// \brief Maps `m_map_path` as the buffer, keeping the file of an unclean exit.
+        void map_buffer() noexcept {
+            {
+                std::ifstream previous(m_map_path.c_str(), std::ios::binary);
+                MapHeader header;
+                if (previous.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+                    is_map_header(header) && header.state.load() != kMapClosed && header.committed.load() > 0) {
+                    previous.close();
+                    std::rename(m_map_path.c_str(), (m_map_path + ".prev").c_str());
+                }
+            }
+            int flags = O_RDWR | O_CREAT | O_TRUNC;
+#ifdef O_CLOEXEC
+            flags |= O_CLOEXEC;
+#endif
+            const int fd = ::open(m_map_path.c_str(), flags, static_cast<mode_t>(S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH));
+            if (fd < 0) {
+                return;
+            }
+            const std::size_t size = kMapHeaderSize + m_capacity;
+            // Allocate all blocks up front; writing to a page that cannot be allocated
+            // later would raise SIGBUS.
+            int res = -1;
+#if defined(__linux__)
+            res = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+#endif
+            if (res != 0 && ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                ::close(fd);
+                return;
+            }
+            void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED) {
+                return;
+            }
+            m_map = static_cast<char*>(map);
+            m_map_size = size;
+            m_header = reinterpret_cast<MapHeader*>(m_map);
+            std::memcpy(m_header->magic, "LOGITCRS", 8);
+            m_header->version = 1;
+            m_header->header_size = static_cast<uint32_t>(kMapHeaderSize);
+            m_header->capacity = m_capacity;
+            m_header->slot_count = m_slot_count;
+            if (m_slot_count > 0) {
+                m_slots = reinterpret_cast<SlotControl*>(m_map + kMapSlotOffset);
+            }
+            m_header->committed.store(0);
+            m_header->signal.store(0);
+            m_header->state.store(kMapRunning);
+            m_buffer = m_map + kMapHeaderSize;
+        }
+
+        /// \brief Marks a mapped buffer as closed and unmaps it.
+        void unmap_buffer() noexcept {
+            if (m_map == nullptr) {
+                return;
+            }
+            m_header->state.store(kMapClosed);
+            ::munmap(m_map, m_map_size);
+            m_map = nullptr;
+            m_header = nullptr;
+            m_buffer = nullptr;
+            if (m_slot_storage == nullptr) {
+                m_slots = nullptr;
+            }
+        }
+
+        /// \brief Returns the sub-ring of the calling thread, claiming one on first use.
+        ///
+        /// A thread remembers its sub-rings of the last `kMaxThreadClaims` loggers and
+        /// returns them when it exits. A logger that is destroyed first leaves its pool
+        /// to the threads that still hold claims.
+        uint32_t thread_slot() noexcept {
+            static thread_local ThreadClaims claims;
+            SlotPool* const pool = m_slot_pool.get();
+            ThreadClaims::Claim* entry = nullptr;
+            for (auto& claim : claims.entries) {
+                if (claim.pool.get() == pool) {
+                    return claim.slot;
+                }
+                if (entry == nullptr && (!claim.pool || claim.pool.use_count() == 1)) {
+                    // Empty, or the logger is gone and only this thread refers to its pool.
+                    entry = &claim;
+                }
+            }
+            if (entry == nullptr) {
+                entry = &claims.entries[claims.next++ % kMaxThreadClaims];
+            }
+            entry->release();
+            entry->pool = m_slot_pool;
+            entry->owned = pool->claim(entry->slot);
+            if (!entry->owned) {
+                entry->slot = m_shared_threads.fetch_add(1, std::memory_order_relaxed) % m_slot_count;
+            }
+            return entry->slot;
+        }
+
+        /// \brief Appends `[timestamp][size][message][size]` to the sub-ring of the calling thread.
+        void log_to_slot(const char* data, std::size_t length) noexcept {
+            const std::size_t capacity = m_slot_capacity;
+            const std::size_t limit = capacity - kSlotRecordOverhead;
+            if (length > limit) {
+                data += length - limit;
+                length = limit;
+            }
+            const uint32_t size = static_cast<uint32_t>(length);
+            const uint64_t key = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            const uint32_t index = thread_slot();
+            SlotControl& slot = m_slots[index];
+            char* base = m_buffer + static_cast<std::size_t>(index) * capacity;
+
+            const uint64_t start = slot.next.fetch_add(length + kSlotRecordOverhead, std::memory_order_acq_rel);
+            copy_to_ring(base, capacity, start, &key, 8);
+            copy_to_ring(base, capacity, start + 8, &size, 4);
+            copy_to_ring(base, capacity, start + 12, data, length);
+            copy_to_ring(base, capacity, start + 12 + length, &size, 4);
+
+            const uint64_t desired = start + length + kSlotRecordOverhead;
+            uint64_t expected = slot.committed.load(std::memory_order_relaxed);
+            while (expected < desired &&
+                   !slot.committed.compare_exchange_weak(
+                           expected, desired, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        static void copy_to_ring(char* base, std::size_t capacity, uint64_t offset, const void* data, std::size_t size) noexcept {
+            const std::size_t index = static_cast<std::size_t>(offset % capacity);
+            std::size_t first = capacity - index;
+            if (first > size) {
+                first = size;
+            }
+            std::memcpy(base + index, data, first);
+            if (size > first) {
+                std::memcpy(base, static_cast<const char*>(data) + first, size - first);
+            }
+        }
+
+        static void copy_from_ring(const char* base, std::size_t capacity, uint64_t offset, void* out, std::size_t size) noexcept {
+            const std::size_t index = static_cast<std::size_t>(offset % capacity);
+            std::size_t first = capacity - index;
+            if (first > size) {
+                first = size;
+            }
+            std::memcpy(out, base + index, first);
+            if (size > first) {
+                std::memcpy(static_cast<char*>(out) + first, base, size - first);
+            }
+        }
+
+        /// \brief Passes the records of all sub-rings to `sink`, oldest first, each followed by a newline.
+        ///
+        /// Each sub-ring is walked back from its committed end through the trailing sizes
+        /// until a record is incomplete or was overwritten, then the sub-rings are merged
+        /// by timestamp. Allocates nothing, so the signal handler can use it.
+        /// \param positions Scratch space for `2 * count` offsets.
+        /// \param sink Callable accepting `(const char* data, std::size_t size)`.
+        template <typename Sink>
+        static void merge_slots(const SlotControl* slots, uint32_t count, const char* data, std::size_t capacity,
+                                uint64_t* positions, Sink& sink) {
+            for (uint32_t i = 0; i < count; ++i) {
+                const char* base = data + static_cast<std::size_t>(i) * capacity;
+                const uint64_t end = slots[i].committed.load(std::memory_order_acquire);
+                const uint64_t next = slots[i].next.load(std::memory_order_acquire);
+                // Bytes before `floor` may already be overwritten by a writer still in progress.
+                const uint64_t floor = next > capacity ? next - capacity : 0;
+                uint64_t pos = end;
+                while (pos >= floor + kSlotRecordOverhead) {
+                    uint32_t size = 0;
+                    copy_from_ring(base, capacity, pos - 4, &size, 4);
+                    const uint64_t record = static_cast<uint64_t>(size) + kSlotRecordOverhead;
+                    if (size > capacity - kSlotRecordOverhead || record > pos - floor) {
+                        break;
+                    }
+                    uint32_t leading = 0;
+                    copy_from_ring(base, capacity, pos - record + 8, &leading, 4);
+                    if (leading != size) {
+                        break;
+                    }
+                    pos -= record;
+                }
+                positions[2 * i] = pos;
+                positions[2 * i + 1] = end;
+            }
+
+            for (;;) {
+                uint32_t best = count;
+                uint64_t best_key = 0;
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (positions[2 * i] >= positions[2 * i + 1]) {
+                        continue;
+                    }
+                    uint64_t key = 0;
+                    copy_from_ring(data + static_cast<std::size_t>(i) * capacity, capacity, positions[2 * i], &key, 8);
+                    if (best == count || key < best_key) {
+                        best = i;
+                        best_key = key;
+                    }
+                }
+                if (best == count) {
+                    break;
+                }
+                const char* base = data + static_cast<std::size_t>(best) * capacity;
+                uint32_t size = 0;
+                copy_from_ring(base, capacity, positions[2 * best] + 8, &size, 4);
+                const std::size_t index = static_cast<std::size_t>((positions[2 * best] + 12) % capacity);
+                std::size_t first = capacity - index;
+                if (first > size) {
+                    first = size;
+                }
+                sink(base + index, first);
+                if (size > first) {
+                    sink(base, size - first);
+                }
+                sink("\n", 1);
+                positions[2 * best] += static_cast<uint64_t>(size) + kSlotRecordOverhead;
+            }
+        }
+
+        /// \struct DumpSink
+        /// \brief Collects merged records in the preallocated dump buffer and writes them to the crash log.
+        struct DumpSink {
+            const CrashPosixLogger* logger;
+            char* buffer;
+            std::size_t used;
+
+            void operator()(const char* data, std::size_t size) noexcept {
+                while (size > 0) {
+                    if (used == kDumpBufferSize) {
+                        flush();
+                    }
+                    std::size_t chunk = kDumpBufferSize - used;
+                    if (chunk > size) {
+                        chunk = size;
+                    }
+                    std::memcpy(buffer + used, data, chunk);
+                    used += chunk;
+                    data += chunk;
+                    size -= chunk;
+                }
+            }
+
+            void flush() noexcept {
+                logger->safe_write(buffer, used);
+                used = 0;
+            }
+        };
+
         static void signal_handler(int signo, siginfo_t* info, void* context) {
-            (void)info;
-            (void)context;
             CrashPosixLogger* logger = s_active_logger.load(std::memory_order_acquire);
             if (logger != nullptr) {
-                logger->write_snapshot(signo);
+                logger->write_snapshot(signo, info, context);
             }
             _exit(128 + signo);
         }
 
-        void write_snapshot(int signo) const noexcept {
+        void write_snapshot(int signo, const siginfo_t* info = nullptr, const void* context = nullptr) const noexcept {
+            if (m_header != nullptr) {
+                // The mapped buffer is already in the page cache; only mark the crash.
+                m_header->signal.store(signo);
+                m_header->state.store(kMapCrashed);
+            }
             if (m_fd < 0) {
                 return;
             }
 
-            const std::size_t capacity = m_capacity;
-            const std::size_t committed = m_committed.load(std::memory_order_acquire);
-            std::size_t available = committed;
-            if (available > capacity) {
-                available = capacity;
+            if (m_slot_count > 0) {
+                DumpSink sink = {this, m_dump_buffer.get(), 0};
+                merge_slots(m_slots, m_slot_count, m_buffer, m_slot_capacity, m_merge_positions.get(), sink);
+                sink.flush();
+                write_marker(signo);
+                const uint32_t shared = m_shared_threads.load(std::memory_order_relaxed);
+                if (shared > 0) {
+                    TextWriter text = {this, {}, 0};
+                    text.put("== ");
+                    text.put_dec(shared);
+                    text.put(" threads shared sub-rings ==\n");
+                    text.flush();
+                }
+                write_context(info, context);
+                return;
             }
-            const std::size_t start_offset = committed - available;
-            const std::size_t start_index = capacity ? (start_offset % capacity) : 0;
+
+            const std::size_t capacity = m_capacity;
+            const uint64_t committed = m_committed->load(std::memory_order_acquire);
+            const std::size_t available = committed > capacity ? capacity : static_cast<std::size_t>(committed);
+            const uint64_t start_offset = committed - available;
+            const std::size_t start_index = static_cast<std::size_t>(start_offset % capacity);
 
             if (available > 0) {
                 std::size_t chunk = capacity - start_index;
                 if (chunk > available) {
                     chunk = available;
                 }
-                safe_write(m_buffer.data() + start_index, chunk);
+                safe_write(m_buffer + start_index, chunk);
                 const std::size_t remaining = available - chunk;
                 if (remaining > 0) {
-                    safe_write(m_buffer.data(), remaining);
+                    safe_write(m_buffer, remaining);
                 }
             }
 
             write_marker(signo);
+            write_context(info, context);
         }
 
         void safe_write(const char* data, std::size_t size) const noexcept {
@@ -277,13 +785,196 @@ namespace logit {
             safe_write(marker, idx);
         }
 
+        /// \struct TextWriter
+        /// \brief Formats text and numbers into a stack buffer without allocating.
+        struct TextWriter {
+            const CrashPosixLogger* logger;
+            char data[256];
+            std::size_t size;
+
+            void put(const char* text) noexcept {
+                while (*text != '\0') {
+                    if (size == sizeof(data)) {
+                        flush();
+                    }
+                    data[size++] = *text++;
+                }
+            }
+
+            void put_hex(uint64_t value) noexcept {
+                char digits[19] = {'0', 'x'};
+                for (int i = 17; i >= 2; --i) {
+                    digits[i] = "0123456789abcdef"[value & 0xF];
+                    value >>= 4;
+                }
+                digits[18] = '\0';
+                put(digits);
+            }
+
+            void put_dec(uint64_t value) noexcept {
+                char digits[21];
+                std::size_t pos = sizeof(digits) - 1;
+                digits[pos] = '\0';
+                do {
+                    digits[--pos] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value > 0);
+                put(digits + pos);
+            }
+
+            void flush() noexcept {
+                logger->safe_write(data, size);
+                size = 0;
+            }
+        };
+
+        /// \brief Collects return addresses of the calling thread without allocating.
+        static int capture_frames(void** frames, int max_frames) noexcept {
+#if defined(LOGIT_CRASH_HAS_EXECINFO)
+            return ::backtrace(frames, max_frames);
+#elif defined(__GNUC__)
+            // Follows saved frame pointers; stops at anything that does not look like a
+            // frame further up the same stack.
+            int count = 0;
+            void** frame = static_cast<void**>(__builtin_frame_address(0));
+            while (frame != nullptr && count < max_frames) {
+                void** next = static_cast<void**>(frame[0]);
+                if (frame[1] == nullptr) {
+                    break;
+                }
+                frames[count++] = frame[1];
+                if (next <= frame || reinterpret_cast<uintptr_t>(next) - reinterpret_cast<uintptr_t>(frame) > (1u << 20) ||
+                    (reinterpret_cast<uintptr_t>(next) & (sizeof(void*) - 1)) != 0) {
+                    break;
+                }
+                frame = next;
+            }
+            return count;
+#else
+            (void)frames;
+            (void)max_frames;
+            return 0;
+#endif
+        }
+
+        /// \brief Appends registers, the backtrace and the memory map to the crash log.
+        void write_context(const siginfo_t* info, const void* context) const noexcept {
+            if (!m_dump_context) {
+                return;
+            }
+            TextWriter out = {this, {}, 0};
+            out.put("== CONTEXT ==\n");
+            if (info != nullptr) {
+                out.put("fault_addr ");
+                out.put_hex(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(info->si_addr)));
+                out.put(" code ");
+                out.put_dec(static_cast<uint64_t>(static_cast<uint32_t>(info->si_code)));
+                out.put("\n");
+            }
+            if (context != nullptr) {
+                write_registers(out, static_cast<const ucontext_t*>(context));
+            }
+
+            out.put("== BACKTRACE ==\n");
+            void* frames[kMaxBacktraceFrames];
+            const int count = capture_frames(frames, kMaxBacktraceFrames);
+            for (int i = 0; i < count; ++i) {
+                out.put("#");
+                out.put_dec(static_cast<uint64_t>(i));
+                out.put(" ");
+                out.put_hex(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i])));
+                out.put("\n");
+            }
+
+#if defined(__linux__)
+            out.put("== MAPS ==\n");
+            out.flush();
+            const int maps = ::open("/proc/self/maps", O_RDONLY);
+            if (maps >= 0) {
+                char chunk[4096];
+                for (;;) {
+                    const ssize_t got = ::read(maps, chunk, sizeof(chunk));
+                    if (got < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (got <= 0) {
+                        break;
+                    }
+                    safe_write(chunk, static_cast<std::size_t>(got));
+                }
+                ::close(maps);
+            }
+#endif
+            out.put("== END ==\n");
+            out.flush();
+        }
+
+        /// \brief Writes the program counter and general-purpose registers of `context`.
+        static void write_registers(TextWriter& out, const ucontext_t* context) noexcept {
+#if defined(__linux__) && defined(__x86_64__) && defined(REG_RIP)
+            static const struct {
+                const char* name;
+                int index;
+            } registers[] = {
+                {"rax", REG_RAX}, {"rbx", REG_RBX}, {"rcx", REG_RCX}, {"rdx", REG_RDX},
+                {"rsi", REG_RSI}, {"rdi", REG_RDI}, {"rbp", REG_RBP}, {"rsp", REG_RSP},
+                {"r8", REG_R8},   {"r9", REG_R9},   {"r10", REG_R10}, {"r11", REG_R11},
+                {"r12", REG_R12}, {"r13", REG_R13}, {"r14", REG_R14}, {"r15", REG_R15},
+                {"eflags", REG_EFL},
+            };
+            const greg_t* gregs = context->uc_mcontext.gregs;
+            out.put("pc ");
+            out.put_hex(static_cast<uint64_t>(gregs[REG_RIP]));
+            out.put("\n");
+            for (std::size_t i = 0; i < sizeof(registers) / sizeof(registers[0]); ++i) {
+                out.put(registers[i].name);
+                out.put(" ");
+                out.put_hex(static_cast<uint64_t>(gregs[registers[i].index]));
+                out.put(i % 4 == 3 ? "\n" : " ");
+            }
+            out.put("\n");
+#elif defined(__linux__) && defined(__aarch64__)
+            const mcontext_t& mc = context->uc_mcontext;
+            out.put("pc ");
+            out.put_hex(static_cast<uint64_t>(mc.pc));
+            out.put("\nsp ");
+            out.put_hex(static_cast<uint64_t>(mc.sp));
+            out.put("\n");
+            for (int i = 0; i < 31; ++i) {
+                out.put("x");
+                out.put_dec(static_cast<uint64_t>(i));
+                out.put(" ");
+                out.put_hex(static_cast<uint64_t>(mc.regs[i]));
+                out.put(i % 4 == 3 || i == 30 ? "\n" : " ");
+            }
+#else
+            (void)out;
+            (void)context;
+#endif
+        }
+
         std::string m_log_path;
+        std::string m_map_path;
+        bool m_dump_context{true};
         int m_fd{-1};
         std::size_t m_capacity{0};
-        std::atomic<std::size_t> m_next_offset{0};
-        std::atomic<std::size_t> m_committed{0};
+        std::atomic<uint64_t> m_next_offset{0};
+        std::atomic<uint64_t> m_local_committed{0};
+        std::atomic<uint64_t>* m_committed{nullptr};
         std::atomic<int> m_log_level{static_cast<int>(LogLevel::LOG_LVL_TRACE)};
-        std::array<char, kMaxBufferSize> m_buffer{};
+        std::unique_ptr<char[]> m_storage;
+        char* m_map{nullptr};
+        std::size_t m_map_size{0};
+        MapHeader* m_header{nullptr};
+        char* m_buffer{nullptr};
+        uint32_t m_slot_count{0};                         ///< Sub-rings in use; 0 for one shared ring.
+        std::size_t m_slot_capacity{0};                   ///< Bytes per sub-ring.
+        SlotControl* m_slots{nullptr};                    ///< Sub-ring counters, in the map header or `m_slot_storage`.
+        std::unique_ptr<SlotControl[]> m_slot_storage;
+        std::shared_ptr<SlotPool> m_slot_pool;            ///< Unclaimed sub-rings.
+        std::atomic<uint32_t> m_shared_threads{0};        ///< Threads that found every sub-ring claimed.
+        std::unique_ptr<uint64_t[]> m_merge_positions;    ///< Scratch space of `merge_slots()` for the signal handler.
+        std::unique_ptr<char[]> m_dump_buffer;            ///< Output buffer of the signal handler.
 
         inline static std::atomic<CrashPosixLogger*> s_active_logger{nullptr};
     };
@@ -296,12 +987,23 @@ namespace logit {
     public:
         static constexpr std::size_t kMaxBufferSize = 0;
         static constexpr std::size_t kDefaultBufferSize = 0;
+        static constexpr std::size_t kMapHeaderSize = 0;
+        static constexpr unsigned kMaxThreadRings = 0;
+        static constexpr int kMaxBacktraceFrames = 0;
 
         struct Config {
             std::string log_path{};
             std::size_t buffer_size = 0;
+            std::string map_path{};
+            unsigned thread_rings = 0;
+            bool dump_context = true;
         };
 
+        static std::string read_map_file(const std::string& path) {
+            (void)path;
+            return std::string();
+        }
+
         CrashPosixLogger() = default;
         explicit CrashPosixLogger(const Config&) {}
 
@@ -335,6 +1037,10 @@ namespace logit {
 
         void wait() override {}
 
+        uint32_t shared_threads() const noexcept {
+            return 0;
+        }
+
         static void install_signal_handler(int signo) {
             (void)signo;
         }
@@ -20,6 +20,15 @@
 #include <memory>
 #include <sstream>
 #include <iomanip>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <future>
+#include <stdexcept>
 #include <time_shield/time_parser.hpp>
 
 namespace logit {
@@ -34,12 +43,40 @@ namespace logit {
             int         auto_delete_days = 30;
             uint64_t    max_file_size_bytes = 0;
             uint32_t    max_rotated_files   = 0;
+            uint32_t    rotation_interval_minutes = 0;
             CompressType compress       = CompressType::NONE;
             int         compress_level  = 1;
             bool        compress_async  = true;
+            unsigned    compress_threads = 1;
+            int         compress_zstd_workers = 0;
+            uint64_t    compress_zstd_mt_min_bytes = 64ULL * 1024 * 1024;
+            int         compress_nice   = 0;
+            std::string compress_dictionary;
             std::string external_cmd;
             RotationNaming naming      = RotationNaming::Sequence;
             uint32_t    seq_width       = 3;
+            bool        binary          = false;
+            uint32_t    retention_interval_ms = 3600000;
+            FileWriteMode write_mode    = FileWriteMode::Stream;
+            size_t      write_buffer_size = 256 * 1024;
+            uint32_t    flush_interval_ms = 5;
+            LogLevel    flush_level     = LogLevel::LOG_LVL_ERROR;
+            bool        group_commit    = false;
+            LogLevel    durable_level   = LogLevel::LOG_LVL_WARN;
+            uint32_t    group_commit_delay_us = 0;
+            unsigned    uring_queue_depth = 8;
+            uint32_t    uring_sync_interval_ms = 1000;
+            uint64_t    mmap_extent_bytes = 16 * 1024 * 1024;
+            size_t      mmap_window_bytes = 1024 * 1024;
+            bool        compress_live   = false;
+            uint64_t    compress_frame_bytes = 4 * 1024 * 1024;
+            bool        compress_seekable = false;
+            uint32_t    compress_frame_interval_ms = 0;
+            bool        time_index      = false;
+            uint32_t    time_index_records = 4096;
+            uint32_t    time_index_interval_ms = 1000;
+            bool        framed          = false;
+            bool        shared          = false;
         };
 
         FileLogger() { warn(); }
@@ -54,6 +91,7 @@ namespace logit {
         void set_log_level(LogLevel) override {}
         LogLevel get_log_level() const override { return LogLevel::LOG_LVL_TRACE; }
         void wait() override {}
+        static void validate_config(const Config&) {}
 
     private:
         void warn() const {
@@ -75,10 +113,27 @@ namespace logit {
     /// This logger writes logs to files organized by date. It supports asynchronous logging
     /// and manages old files based on a configurable retention period.
     ///
+    /// Retention keeps an in-memory index of known log files, built by one directory scan
+    /// on startup and updated when the logger opens or rotates a file. After the startup
+    /// pass, a maintenance thread runs further passes on day change, after rotation, at
+    /// `Config::retention_interval_ms` and after `wait()`. Neither writing a message nor
+    /// `wait()` touches the directory on the calling thread.
+    ///
     /// **Key Features:**
-    /// - Date-based file rotation.
-    /// - Automatic cleanup of old files.
+    /// - Date-based file rotation, optionally also by size or every N minutes.
+    /// - Automatic cleanup of old files by a background retention scheduler.
     /// - Synchronous or asynchronous operation.
+    /// - Optional binary output together with `BinaryLogFormatter` or `MsgpackFormatter`.
+    /// - Optional descriptor-based writer with a user-space buffer and a flush policy
+    ///   (`FileWriteMode::BufferedFd`), io_uring submission (`FileWriteMode::IoUring`) or
+    ///   appends into a memory-mapped, preallocated file (`FileWriteMode::Mmap`).
+    /// - Optional group commit: durable records share one `fdatasync` per batch.
+    /// - Optional streaming gzip/zstd compression of the live file (`Config::compress_live`).
+    /// - Optional trained zstd dictionary for small files (`Config::compress_dictionary`).
+    /// - Optional sparse time index beside each file for time-range reads (`Config::time_index`).
+    /// - Optional checksummed record frames with crash recovery on open (`Config::framed`).
+    /// - Optional multi-process mode: several processes append to the same files and
+    ///   rotate them once, coordinated through `LOGIT_SHARED_STATE_NAME` (`Config::shared`).
     class FileLogger : public ILogger {
     public:
 
@@ -90,12 +145,40 @@ namespace logit {
             int         auto_delete_days = 30;     ///< Number of days after which old log files are deleted.
             uint64_t    max_file_size_bytes = 0;   ///< Max size for log file before rotation (0 = off).
             uint32_t    max_rotated_files   = 0;   ///< Number of rotated files to keep (0 = unlimited).
+            uint32_t    rotation_interval_minutes = 0; ///< Also rotate at UTC boundaries every N minutes, e.g. 60 for hourly (0 = daily files only).
             CompressType compress       = CompressType::NONE; ///< Compression algorithm for rotated files.
             int         compress_level  = 1;       ///< Compression level.
-            bool        compress_async  = true;    ///< Run compression in background thread.
+            bool        compress_async  = true;    ///< Run compression in background threads.
+            unsigned    compress_threads = 1;      ///< Threads compressing rotated files in parallel.
+            int         compress_zstd_workers = 0; ///< `ZSTD_c_nbWorkers` for large rotated files (0 = single-threaded).
+            uint64_t    compress_zstd_mt_min_bytes = 64ULL * 1024 * 1024; ///< Minimal file size that uses `compress_zstd_workers`.
+            int         compress_nice   = 0;       ///< Niceness added to compression threads (0 = unchanged).
+            std::string compress_dictionary;       ///< zstd dictionary file, e.g. `LOGIT_ZSTD_DICTIONARY_NAME`; relative paths are resolved against `directory` (empty = none).
             std::string external_cmd;             ///< External command template.
             RotationNaming naming      = RotationNaming::Sequence; ///< Naming policy for rotated files.
             uint32_t    seq_width       = 3;       ///< Width of sequence index.
+            bool        binary          = false;   ///< Write messages without line breaks; `BinaryLogFormatter` definitions are stored once per file.
+            uint32_t    retention_interval_ms = 3600000; ///< Interval of periodic retention passes that rescan the directory (0 = off).
+            FileWriteMode write_mode    = FileWriteMode::Stream; ///< Output backend: `std::ofstream` or a descriptor writer.
+            size_t      write_buffer_size = 256 * 1024; ///< Buffer size of `FileWriteMode::BufferedFd`; a full buffer is flushed.
+            uint32_t    flush_interval_ms = 5;     ///< Longest time data stays in the `BufferedFd` buffer (0 = flush only when full).
+            LogLevel    flush_level     = LogLevel::LOG_LVL_ERROR; ///< `BufferedFd` flushes records at or above this level immediately.
+            bool        group_commit    = false;   ///< Records at or above `durable_level` return only once on disk; needs a descriptor `write_mode`.
+            LogLevel    durable_level   = LogLevel::LOG_LVL_WARN; ///< Minimal level of records waiting for durability.
+            uint32_t    group_commit_delay_us = 0; ///< Time a batch stays open for more records before `fdatasync` (0 = none).
+            unsigned    uring_queue_depth = 8;     ///< Registered buffers of `FileWriteMode::IoUring`, each `write_buffer_size` bytes.
+            uint32_t    uring_sync_interval_ms = 1000; ///< Interval of data syncs queued by `FileWriteMode::IoUring` (0 = off).
+            uint64_t    mmap_extent_bytes = 16 * 1024 * 1024; ///< Preallocation step of `FileWriteMode::Mmap`; capped by `max_file_size_bytes`.
+            size_t      mmap_window_bytes = 1024 * 1024; ///< Size of the mapped window of `FileWriteMode::Mmap`.
+            bool        compress_live   = false;   ///< Compress with `compress` (GZIP or ZSTD) while writing instead of after rotation; files get a `.gz`/`.zst` suffix. Needs a descriptor `write_mode`.
+            uint64_t    compress_frame_bytes = 4 * 1024 * 1024; ///< Uncompressed bytes per gzip member or zstd frame with `compress_live` (0 = one per file).
+            bool        compress_seekable = false; ///< With `compress_live` and ZSTD, align frames with records and append a seek table for `SeekableZstdReader`.
+            uint32_t    compress_frame_interval_ms = 0; ///< Seekable frames also end once their first record is this old (0 = size only).
+            bool        time_index      = false;   ///< Write a sparse `.idx` time index beside each log file for `LogReader`.
+            uint32_t    time_index_records = 4096; ///< Records between time index entries (0 = time only).
+            uint32_t    time_index_interval_ms = 1000; ///< Milliseconds between time index entries (0 = count only).
+            bool        framed          = false;   ///< Wrap each record in a frame with size, sequence number and CRC-32C; a torn tail of the current file is cut off on open.
+            bool        shared          = false;   ///< Several processes write this directory: one `O_APPEND` write per record and rotation coordinated through a lock file (POSIX, text logs, `BufferedFd` with `flush_level` TRACE).
         };
 
         /// \brief Default constructor that uses default configuration.
@@ -105,6 +188,7 @@ namespace logit {
 
         /// \brief Constructor with custom configuration.
         /// \param config The configuration for the logger.
+        /// \throws std::invalid_argument if `validate_config()` rejects the configuration.
         FileLogger(const Config& config) : m_config(config) {
             start_logging();
         }
@@ -142,36 +226,84 @@ namespace logit {
         virtual ~FileLogger() {
             stop_logging();
             if (m_compressor) m_compressor->wait();
+            stop_maintenance();
         }
 
         /// \brief Logs a message to a file with thread safety.
         ///
         /// If asynchronous logging is enabled, the message is added to the task queue;
-        /// otherwise, it is logged directly.
+        /// otherwise, it is logged directly. Durable records return once on disk.
         ///
         /// \param record The log record containing log information.
         /// \param message The formatted log message.
         void log(const LogRecord& record, const std::string& message) override {
+            const std::function<void()> completion = log_deferred(record, message);
+            if (completion) completion();
+        }
+
+        /// \brief Logs a message and returns the wait for its group commit.
+        ///
+        /// Records below `durable_level`, or without `group_commit`, complete at once. For
+        /// durable records the returned function waits until the record is written and on
+        /// disk; `Logger` runs it after releasing its lock, so producers of other threads
+        /// can join the same batch.
+        ///
+        /// \param record The log record containing log information.
+        /// \param message The formatted log message.
+        /// \return Function that waits for durability, or an empty function.
+        std::function<void()> log_deferred(const LogRecord& record, const std::string& message) override {
             m_last_log_ts = record.timestamp_ms;
             m_last_log_mono_ts = LOGIT_MONOTONIC_MS();
+            std::string defined_message;
+            const std::string& payload = m_config.binary && add_binary_definitions(record, message, defined_message)
+                ? defined_message : message;
+            const bool durable = m_config.group_commit && record.log_level >= m_config.durable_level;
             if (!m_config.async) {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                try {
-                    write_log(message, record.timestamp_ms);
-                } catch (const std::exception& e) {
-                    std::cerr << "Log error: " << e.what() << std::endl;
+                uint64_t sequence = 0;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    try {
+                        write_log(payload, record.timestamp_ms, record.log_level);
+                        sequence = m_written_seq;
+                    } catch (const std::exception& e) {
+                        std::cerr << "Log error: " << e.what() << std::endl;
+                    }
                 }
-                return;
+                if (!durable || !sequence) return std::function<void()>();
+                return [this, sequence]() { commit(sequence); };
             }
             auto timestamp_ms = record.timestamp_ms;
-            detail::TaskExecutor::get_instance().add_task([this, message, timestamp_ms]() {
+            auto level = record.log_level;
+            if (!durable) {
+                detail::TaskExecutor::get_instance().add_task([this, payload, timestamp_ms, level]() {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    try {
+                        write_log(payload, timestamp_ms, level);
+                    } catch (const std::exception& e) {
+                        std::cerr << "Log async log error: " << e.what() << std::endl;
+                    }
+                });
+                return std::function<void()>();
+            }
+            // The caller waits until the worker has written the record, then joins a batch.
+            std::shared_ptr<std::promise<uint64_t>> written = std::make_shared<std::promise<uint64_t>>();
+            std::shared_future<uint64_t> sequence = written->get_future().share();
+            detail::TaskExecutor::get_instance().add_task([this, payload, timestamp_ms, level, written]() {
                 std::lock_guard<std::mutex> lock(m_mutex);
                 try {
-                    write_log(message, timestamp_ms);
+                    write_log(payload, timestamp_ms, level);
+                    written->set_value(m_written_seq);
                 } catch (const std::exception& e) {
                     std::cerr << "Log async log error: " << e.what() << std::endl;
                 }
             });
+            return [this, sequence]() {
+                try {
+                    commit(sequence.get());
+                } catch (const std::future_error&) {
+                    // The task was dropped or failed; there is nothing to make durable.
+                }
+            };
         }
 
         /// \brief Retrieves a string parameter from the logger.
@@ -196,6 +328,12 @@ namespace logit {
             switch (param) {
             case LoggerParam::LastLogTimestamp: return get_last_log_ts();
             case LoggerParam::TimeSinceLastLog: return get_time_since_last_log();
+            case LoggerParam::FlushCount: return static_cast<int64_t>(write_stats().flushes);
+            case LoggerParam::WriteCallCount: return static_cast<int64_t>(write_stats().write_calls);
+            case LoggerParam::BytesWritten: return static_cast<int64_t>(write_stats().bytes_written);
+            case LoggerParam::BytesPerWrite: return static_cast<int64_t>(write_stats().bytes_per_write());
+            case LoggerParam::CompressionQueueDepth: return static_cast<int64_t>(compression_stats().queue_depth);
+            case LoggerParam::CompressionBytesPerSec: return static_cast<int64_t>(compression_stats().bytes_per_sec());
             default:
                 break;
             };
@@ -209,6 +347,9 @@ namespace logit {
             switch (param) {
             case LoggerParam::LastLogTimestamp: return (double)get_last_log_ts() / 1000.0;
             case LoggerParam::TimeSinceLastLog: return (double)get_time_since_last_log() / 1000.0;
+            case LoggerParam::BytesPerWrite: return write_stats().bytes_per_write();
+            case LoggerParam::CompressionQueueDepth: return static_cast<double>(compression_stats().queue_depth);
+            case LoggerParam::CompressionBytesPerSec: return compression_stats().bytes_per_sec();
             default:
                 break;
             };
@@ -225,50 +366,498 @@ namespace logit {
             return static_cast<LogLevel>(m_log_level.load());
         }
 
-        /// \brief Waits for all asynchronous tasks to complete.
+        /// \brief Waits for all asynchronous tasks to complete and requests a retention pass.
+        ///
+        /// The pass rescans the directory on the maintenance thread; destroying the logger
+        /// completes a pass that is still pending.
         void wait() override {
-            if (!m_config.async) return;
-            detail::TaskExecutor::get_instance().wait();
+            if (m_config.async) {
+                detail::TaskExecutor::get_instance().wait();
+            }
+            try {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                flush_file();
+            } catch (const std::exception& e) {
+                std::cerr << "Log flush error: " << e.what() << std::endl;
+            }
+            schedule_retention(true);
+        }
+
+        /// \brief Blocks until the maintenance thread has done the work that is due.
+        ///
+        /// Waits for the running job, a pending retention pass or timed flush, or the next
+        /// periodic retention pass with `Config::retention_interval_ms`; returns at once if
+        /// there is none. `wait()` followed by this call completes the retention pass
+        /// `wait()` requests.
+        void wait_maintenance() {
+            std::unique_lock<std::mutex> lock(m_maintenance_mutex);
+            if (!m_maintenance_thread.joinable()) return;
+            const bool due = m_retention_pending || m_flush_armed || m_config.retention_interval_ms > 0;
+            const uint64_t target = m_maintenance_started + (due ? 1 : 0);
+            m_maintenance_done_cv.wait(lock, [this, target] {
+                return m_maintenance_done >= target || m_maintenance_stop;
+            });
+        }
+
+        /// \brief Returns the counters of the descriptor writer.
+        /// \return Flush and system call statistics; all zero in `FileWriteMode::Stream`.
+        FileWriteStats write_stats() const {
+            FileWriteStats stats = m_writer ? m_writer->stats() : FileWriteStats();
+            stats.syncs += m_sync_count.load(std::memory_order_relaxed);
+            stats.sync_failures += m_sync_failures.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        /// \brief Blocks until the rotated files queued for background compression are compressed.
+        void wait_compression() {
+            detail::CompressionWorker* compressor = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                compressor = m_compressor.get();
+            }
+            // The worker lives as long as the logger once created.
+            if (compressor) compressor->wait();
+        }
+
+        /// \brief Returns the counters of the background compressor.
+        /// \return Queue depth, processed files and compression rate; all zero before the first asynchronous compression.
+        CompressionStats compression_stats() const {
             std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_file.is_open()) m_file.flush();
+            return m_compressor ? m_compressor->stats() : CompressionStats();
+        }
+
+        /// \brief Checks a configuration for option combinations the logger does not support.
+        ///
+        /// The logger does not adjust its configuration; the constructors reject these
+        /// combinations instead:
+        /// - a write mode that is not available in this build or on this system;
+        /// - `group_commit` or `compress_live` with `FileWriteMode::Stream`;
+        /// - `compress_live` without GZIP or ZSTD support, `compress_seekable` without
+        ///   live ZSTD compression;
+        /// - `FileWriteMode::Mmap` with unframed binary logs, whose end cannot be found in
+        ///   a preallocated file;
+        /// - `shared` outside POSIX, or with binary logs, live compression, the time index,
+        ///   another write mode than `BufferedFd` or a `flush_level` above TRACE.
+        /// \param config The configuration to check.
+        /// \throws std::invalid_argument naming the first unsupported combination.
+        static void validate_config(const Config& config) {
+            std::string reason;
+            if (!detail::is_write_mode_available(config.write_mode, reason)) {
+                throw std::invalid_argument("Write mode is not available: " + reason);
+            }
+            const bool descriptor = config.write_mode != FileWriteMode::Stream;
+            if (config.group_commit && !descriptor) {
+                throw std::invalid_argument("group_commit requires a descriptor write mode, e.g. FileWriteMode::BufferedFd");
+            }
+            if (config.compress_live) {
+                if (!detail::CompressedFileWriter::is_supported(config.compress)) {
+                    throw std::invalid_argument("compress_live requires GZIP or ZSTD compression support");
+                }
+                if (!descriptor) {
+                    throw std::invalid_argument("compress_live requires a descriptor write mode, e.g. FileWriteMode::BufferedFd");
+                }
+            }
+            if (config.compress_seekable && !(config.compress_live && config.compress == CompressType::ZSTD)) {
+                throw std::invalid_argument("compress_seekable requires compress_live with ZSTD");
+            }
+            if (config.write_mode == FileWriteMode::Mmap && config.binary && !config.framed) {
+                throw std::invalid_argument("FileWriteMode::Mmap requires framed binary logs");
+            }
+            if (!config.shared) return;
+#           if defined(_WIN32)
+            throw std::invalid_argument("Shared mode is not supported on Windows");
+#           else
+            if (config.binary) {
+                throw std::invalid_argument("Shared mode does not support binary logs");
+            }
+            if (config.compress_live || config.time_index) {
+                // Both keep per-file state in one process.
+                throw std::invalid_argument("Shared mode does not support compress_live or time_index");
+            }
+            if (config.write_mode != FileWriteMode::BufferedFd || config.flush_level != LogLevel::LOG_LVL_TRACE) {
+                // Every record has to leave the process in one O_APPEND write.
+                throw std::invalid_argument("Shared mode requires FileWriteMode::BufferedFd and flush_level TRACE");
+            }
+#           endif
         }
 
     private:
         mutable std::mutex m_mutex;    ///< Mutex to protect file operations.
         Config             m_config;   ///< Configuration for the file logger.
         std::ofstream      m_file;     ///< Output file stream for logging.
+        std::unique_ptr<detail::IFileWriter> m_writer; ///< Descriptor writer; null in `FileWriteMode::Stream`.
+        std::shared_ptr<const ZstdDictionary> m_dictionary; ///< Dictionary for zstd compression, if configured.
+        detail::FileTimeIndex m_time_index;    ///< Time index of the current file.
+        detail::RecordFramer m_framer;         ///< Frames of `Config::framed` records.
+        detail::SharedFileCoordinator m_shared; ///< Current file shared with other processes in `Config::shared`.
         mutable std::mutex m_file_path_mutex; ///< Mutex to protect file path operations.
         std::string        m_file_path; ///< Path of the currently open log file.
         std::string        m_file_name; ///< Name of the currently open log file.
         int64_t            m_current_date_ts = 0; ///< Timestamp of the current log file's date.
+        int64_t            m_day_start_ms = 0;    ///< Start of the current file's day in milliseconds.
+        int64_t            m_next_boundary_ms = 0; ///< First timestamp that needs another file: next midnight or end of the rotation period.
+        int64_t            m_rotation_date_ts = -1; ///< Date whose rotated files are listed in `m_rotated_files`.
+        std::deque<std::string> m_rotated_files; ///< Rotated files of that date in name order, oldest first.
+        std::unordered_set<std::string> m_rotated_names; ///< File names of `m_rotated_files` without a compression suffix.
+        uint32_t           m_next_sequence = 1;   ///< Next index of `RotationNaming::Sequence`.
         uint64_t           m_current_file_size = 0; ///< Current size of the log file.
         std::unique_ptr<detail::CompressionWorker> m_compressor; ///< Background compressor.
+        std::unordered_set<uint64_t> m_binary_sites;   ///< Call sites already defined in the current binary file.
+        std::unordered_set<uint64_t> m_binary_threads; ///< Threads already defined in the current binary file.
+        const uint64_t     m_instance_id = next_instance_id(); ///< Key of this logger in the per-thread definition caches.
+        std::mutex         m_definitions_mutex;   ///< Guards the binary definitions below.
+        std::unordered_map<uint64_t, std::string> m_site_definitions;   ///< Encoded call-site definition by ID.
+        std::unordered_map<uint64_t, std::string> m_thread_definitions; ///< Encoded thread definition by index.
         std::atomic<int64_t> m_last_log_ts = ATOMIC_VAR_INIT(0); ///< Timestamp of the last log.
         std::atomic<int64_t> m_last_log_mono_ts = ATOMIC_VAR_INIT(0); ///< Timestamp of the last log.
         std::atomic<int>   m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
 
+        std::thread        m_maintenance_thread;      ///< Maintenance thread enforcing retention.
+        std::mutex         m_maintenance_mutex;       ///< Protects the retention index and requests.
+        std::condition_variable m_maintenance_cv;     ///< Wakes the maintenance thread.
+        std::map<std::string, int64_t> m_log_index; ///< Known log files and their date timestamps.
+        int64_t            m_retention_date_ts = 0; ///< Date of the active file used as retention reference.
+        bool               m_retention_pending = false; ///< A retention pass was requested.
+        bool               m_retention_rescan  = false; ///< The next pass rescans the directory.
+        bool               m_rescan_active = false; ///< A directory scan is running; index changes are recorded.
+        std::map<std::string, int64_t> m_rescan_added; ///< Files added to the index during the scan.
+        std::unordered_set<std::string> m_rescan_removed; ///< Files removed from the index during the scan.
+        bool               m_maintenance_stop    = false; ///< Stops the maintenance thread.
+        bool               m_flush_armed = false; ///< Buffered data waits for a timed flush.
+        uint64_t           m_maintenance_started = 0; ///< Timed flushes and retention passes started.
+        uint64_t           m_maintenance_done = 0;    ///< Timed flushes and retention passes finished.
+        std::condition_variable m_maintenance_done_cv; ///< Signals finished maintenance work.
+        std::chrono::steady_clock::time_point m_flush_deadline; ///< Time of the pending timed flush.
+
+        uint64_t           m_written_seq = 0;   ///< Records written so far, guarded by `m_mutex`.
+        std::mutex         m_sync_mutex;        ///< Protects the group commit state.
+        std::condition_variable m_sync_cv;      ///< Wakes producers waiting for a batch.
+        uint64_t           m_synced_seq = 0;    ///< Records known to be on disk.
+        uint64_t           m_failed_seq = 0;    ///< Records up to here were in a batch whose sync failed.
+        bool               m_sync_running = false; ///< A batch leader is syncing.
+        std::atomic<uint64_t> m_sync_count = ATOMIC_VAR_INIT(0); ///< Number of batch syncs.
+        std::atomic<uint64_t> m_sync_failures = ATOMIC_VAR_INIT(0); ///< Durable records whose sync failed.
+
         /// \brief Starts the logging process by initializing the file and directory.
         void start_logging() {
             // I/O streams (e.g., std::cin, std::cout, std::cerr) may be closed before the program exits.
             // In this case, calls to functions that use I/O streams (for example, the std::regex constructor)
             // can lead to undesirable behavior such as hangs or segmentation faults.
             is_valid_log_filename("2024-01-01.log");
+            validate_config(m_config);
+            load_dictionary();
+            m_writer = detail::create_file_writer(writer_options());
+            if (m_config.time_index) {
+                m_time_index.configure(m_config.time_index_records, m_config.time_index_interval_ms);
+            }
             std::lock_guard<std::mutex> lock(m_mutex);
             try {
                 initialize_directory();
+                if (m_config.shared) {
+                    if (m_shared.open(get_directory_path() + "/" LOGIT_SHARED_STATE_NAME)) {
+                        m_framer.share_sequence(m_shared.sequence());
+                    } else {
+                        std::cerr << "Failed to open shared log state; rotation is not coordinated" << std::endl;
+                    }
+                }
                 open_log_file(get_current_utc_date_ts());
-                remove_old_logs();
+                run_retention(true);
             } catch (const std::exception& e) {
                 std::cerr << "Initialization error: " << e.what() << std::endl;
             }
+            m_maintenance_thread = std::thread(&FileLogger::maintenance_loop, this);
+        }
+
+        /// \brief Loads the configured zstd dictionary; without it files are compressed as usual.
+        void load_dictionary() {
+            if (m_config.compress != CompressType::ZSTD || m_config.compress_dictionary.empty()) return;
+            try {
+                m_dictionary = ZstdDictionary::load(
+                    detail::resolve_dictionary_path(get_directory_path(), m_config.compress_dictionary),
+                    m_config.compress_level);
+            } catch (const std::exception& e) {
+                std::cerr << "Dictionary error: " << e.what() << std::endl;
+            }
         }
 
         /// \brief Stops the logging process by closing the file and waiting for tasks.
         void stop_logging() {
             wait();
             std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_file.is_open()) {
-                m_file.close();
+            try {
+                close_file();
+            } catch (const std::exception& e) {
+                std::cerr << "Log close error: " << e.what() << std::endl;
+            }
+        }
+
+        /// \brief Returns the settings of the writer stack for the configured write mode.
+        detail::FileWriterOptions writer_options() const {
+            detail::FileWriterOptions options;
+            options.mode = m_config.write_mode;
+            options.uring_queue_depth = m_config.uring_queue_depth;
+            options.uring_sync_interval_ms = m_config.uring_sync_interval_ms;
+            // A size limit shorter than one extent is the natural preallocation size.
+            options.mmap_extent_bytes = m_config.mmap_extent_bytes;
+            if (m_config.max_file_size_bytes > 0 && m_config.max_file_size_bytes < options.mmap_extent_bytes) {
+                options.mmap_extent_bytes = m_config.max_file_size_bytes;
+            }
+            options.mmap_window_bytes = m_config.mmap_window_bytes;
+            // Compressed, binary and framed data may legitimately end with zero bytes;
+            // framed and live-compressed logs lose the zero tail with the torn frame
+            // or member on open instead.
+            options.mmap_trim_zero_tail = !m_config.binary && !m_config.framed && !m_config.compress_live;
+            if (m_config.compress_live) {
+                options.live_compress = m_config.compress;
+                options.compress_level = m_config.compress_level;
+                options.compress_frame_bytes = m_config.compress_frame_bytes;
+                options.compress_frame_interval_ms = m_config.compress_frame_interval_ms;
+                options.compress_seekable = m_config.compress_seekable;
+                options.dictionary = m_dictionary;
+            }
+            return options;
+        }
+
+        /// \brief Stops the maintenance thread.
+        void stop_maintenance() {
+            {
+                std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                if (!m_maintenance_thread.joinable()) return;
+                m_maintenance_stop = true;
+            }
+            m_maintenance_cv.notify_one();
+            m_maintenance_thread.join();
+        }
+
+        /// \brief Requests a retention pass from the maintenance thread.
+        /// \param rescan Rebuild the index from the directory before the pass.
+        void schedule_retention(bool rescan) {
+            {
+                std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                m_retention_pending = true;
+                m_retention_rescan = m_retention_rescan || rescan;
+            }
+            m_maintenance_cv.notify_one();
+        }
+
+        /// \brief Adds a log file to the retention index.
+        /// \param path Full path of the file.
+        /// \param date_ts Date timestamp of the file.
+        void track_log_file(const std::string& path, int64_t date_ts) {
+            std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+            index_add(path, date_ts);
+        }
+
+        /// \brief Adds a file to the retention index; `m_maintenance_mutex` must be held.
+        void index_add(const std::string& path, int64_t date_ts) {
+            m_log_index[path] = date_ts;
+            if (!m_rescan_active) return;
+            m_rescan_added[path] = date_ts;
+            m_rescan_removed.erase(path);
+        }
+
+        /// \brief Removes a file from the retention index; `m_maintenance_mutex` must be held.
+        void index_remove(const std::string& path) {
+            m_log_index.erase(path);
+            if (!m_rescan_active) return;
+            m_rescan_removed.insert(path);
+            m_rescan_added.erase(path);
+        }
+
+        /// \brief Waits until the record with the given sequence number is on disk.
+        ///
+        /// The first waiter becomes the batch leader: it optionally keeps the batch open for
+        /// `group_commit_delay_us`, flushes the buffer and calls `fdatasync` once for every
+        /// record written so far. Waiters arriving meanwhile join the next batch.
+        ///
+        /// A failed sync does not mark its records as durable: their waiters return false
+        /// and are counted in `FileWriteStats::sync_failures`, and the next waiter leads a
+        /// new attempt for the records written after them.
+        /// \param sequence Value of `m_written_seq` after the record was written.
+        /// \return True if the record is on disk.
+        bool commit(uint64_t sequence) {
+            std::unique_lock<std::mutex> lock(m_sync_mutex);
+            while (m_synced_seq < sequence) {
+                if (m_failed_seq >= sequence) {
+                    m_sync_failures.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if (m_sync_running) {
+                    m_sync_cv.wait(lock);
+                    continue;
+                }
+                m_sync_running = true;
+                if (m_config.group_commit_delay_us > 0) {
+                    const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(m_config.group_commit_delay_us);
+                    while (std::chrono::steady_clock::now() < deadline) {
+                        m_sync_cv.wait_until(lock, deadline);
+                    }
+                }
+                lock.unlock();
+                uint64_t target = 0;
+                bool ok = true;
+                int fd = -1;
+                try {
+                    {
+                        std::lock_guard<std::mutex> file_lock(m_mutex);
+                        target = m_written_seq;
+                        m_writer->drain();
+                        fd = m_writer->duplicate();
+                    }
+                    // The duplicate keeps the file alive if it is rotated while syncing.
+                    if (fd >= 0) {
+                        const bool synced = detail::sync_descriptor(fd);
+                        detail::close_descriptor(fd);
+                        if (!synced) throw std::runtime_error("Failed to sync log file");
+                    }
+                    m_sync_count.fetch_add(1, std::memory_order_relaxed);
+                } catch (const std::exception& e) {
+                    std::cerr << "Log sync error: " << e.what() << std::endl;
+                    ok = false;
+                    // Records written up to here, including this one, have an unknown state.
+                    if (target < sequence) target = sequence;
+                }
+                lock.lock();
+                m_sync_running = false;
+                if (ok) {
+                    if (target > m_synced_seq) m_synced_seq = target;
+                } else if (target > m_failed_seq) {
+                    m_failed_seq = target;
+                }
+                m_sync_cv.notify_all();
+            }
+            return true;
+        }
+
+        /// \brief Requests a timed flush of data that entered an empty buffer.
+        void arm_flush() {
+            {
+                std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                if (m_flush_armed) return;
+                m_flush_armed = true;
+                m_flush_deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(m_config.flush_interval_ms);
+            }
+            m_maintenance_cv.notify_one();
+        }
+
+        /// \brief Maintenance thread loop running retention passes and timed flushes.
+        void maintenance_loop() {
+            typedef std::chrono::steady_clock clock;
+            const bool periodic = m_config.retention_interval_ms > 0;
+            const clock::duration interval = std::chrono::milliseconds(m_config.retention_interval_ms);
+            clock::time_point next_retention = clock::now() + interval;
+            std::unique_lock<std::mutex> lock(m_maintenance_mutex);
+            // A pass requested before the stop, e.g. by the final `wait()`, still runs.
+            while (!m_maintenance_stop || m_retention_pending) {
+                const clock::time_point now = clock::now();
+                if (periodic && !m_maintenance_stop && now >= next_retention) {
+                    m_retention_pending = true;
+                    m_retention_rescan = true;
+                    next_retention = now + interval;
+                }
+                if (m_flush_armed && !m_maintenance_stop && now >= m_flush_deadline) {
+                    m_flush_armed = false;
+                    const uint64_t job = ++m_maintenance_started;
+                    lock.unlock();
+                    flush_buffered();
+                    lock.lock();
+                    finish_maintenance(job);
+                    continue;
+                }
+                if (m_retention_pending) {
+                    const bool rescan = m_retention_rescan;
+                    m_retention_pending = false;
+                    m_retention_rescan = false;
+                    const uint64_t job = ++m_maintenance_started;
+                    lock.unlock();
+                    try {
+                        run_retention(rescan);
+                    } catch (const std::exception& e) {
+                        std::cerr << "Log retention error: " << e.what() << std::endl;
+                    }
+                    lock.lock();
+                    finish_maintenance(job);
+                    continue;
+                }
+                const bool armed = m_flush_armed;
+                auto wake = [this, armed] {
+                    return m_maintenance_stop || m_retention_pending || m_flush_armed != armed;
+                };
+                if (!periodic && !armed) {
+                    m_maintenance_cv.wait(lock, wake);
+                    continue;
+                }
+                clock::time_point deadline = periodic ? next_retention : m_flush_deadline;
+                if (armed && m_flush_deadline < deadline) deadline = m_flush_deadline;
+                m_maintenance_cv.wait_until(lock, deadline, wake);
+            }
+            m_maintenance_done_cv.notify_all();
+        }
+
+        /// \brief Records finished maintenance work; called with `m_maintenance_mutex` held.
+        void finish_maintenance(uint64_t job) {
+            m_maintenance_done = job;
+            m_maintenance_done_cv.notify_all();
+        }
+
+        /// \brief Flushes the descriptor writer from the maintenance thread.
+        void flush_buffered() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            try {
+                if (m_writer) m_writer->flush();
+            } catch (const std::exception& e) {
+                std::cerr << "Log flush error: " << e.what() << std::endl;
+            }
+        }
+
+        /// \brief Removes indexed log files older than the auto-delete threshold.
+        ///
+        /// Runs on startup, then on the maintenance thread only. Files the logger opens,
+        /// rotates or removes while the directory is scanned override what the scan found.
+        /// \param rescan Rebuild the index from the directory first.
+        void run_retention(bool rescan) {
+            std::map<std::string, int64_t> scanned;
+            if (rescan) {
+                {
+                    std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                    m_rescan_active = true;
+                }
+                try {
+                    scanned = scan_log_files();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                    m_rescan_active = false;
+                    m_rescan_added.clear();
+                    m_rescan_removed.clear();
+                    throw;
+                }
+            }
+            std::vector<std::string> expired;
+            {
+                std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                if (rescan) {
+                    for (const auto& entry : m_rescan_added) scanned[entry.first] = entry.second;
+                    for (const auto& path : m_rescan_removed) scanned.erase(path);
+                    m_log_index.swap(scanned);
+                    m_rescan_active = false;
+                    m_rescan_added.clear();
+                    m_rescan_removed.clear();
+                }
+                const int64_t threshold_ts = m_retention_date_ts -
+                    (time_shield::SEC_PER_DAY * m_config.auto_delete_days);
+                for (auto it = m_log_index.begin(); it != m_log_index.end();) {
+                    if (it->second < threshold_ts) {
+                        expired.push_back(it->first);
+                        it = m_log_index.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            for (const auto& path : expired) {
+                remove_log_file(path);
             }
         }
 
@@ -290,24 +879,84 @@ namespace logit {
         /// \brief Opens a new log file based on the provided date timestamp.
         /// \param date_ts The timestamp representing the date for the log file.
         void open_log_file(const int64_t& date_ts) {
-            if (m_file.is_open()) {
-                m_file.close();
-            }
+            detail::SharedLogLock shared_lock(m_shared.state());
+            close_file();
             m_current_date_ts = date_ts;
+            m_day_start_ms = date_ts * 1000;
             std::unique_lock<std::mutex> lock(m_file_path_mutex);
             m_file_path = create_file_path(date_ts);
             m_file_name = get_file_name(m_file_path);
             lock.unlock();
+            {
+                std::lock_guard<std::mutex> index_lock(m_maintenance_mutex);
+                index_add(m_file_path, date_ts);
+                m_retention_date_ts = date_ts;
+            }
+            if (m_config.framed && !m_config.compress_live && !m_config.shared && !m_framer.recover(m_file_path)) {
+                // Unframed content of an earlier run is moved aside.
+                rotate_current_file();
+                m_next_boundary_ms = first_boundary_ms();
+                return;
+            }
+            if (m_writer) {
+                if (!m_writer->open(m_file_path, m_config.write_buffer_size)) {
+                    throw std::runtime_error("Failed to open log file: " + m_file_path);
+                }
+                uint64_t content_size = 0;
+                const bool content_known = m_writer->content_size(content_size);
+                m_current_file_size = content_known ? content_size : m_writer->file_size();
+                if (m_config.binary) {
+                    m_binary_sites.clear();
+                    m_binary_threads.clear();
+                }
+                if (m_config.framed && m_current_file_size == 0) write_frame_magic();
+                m_shared.publish(m_current_date_ts, m_current_file_size);
+                m_next_boundary_ms = first_boundary_ms();
+                open_time_index(content_known);
+                return;
+            }
+            const std::ios_base::openmode mode = (m_config.binary || m_config.framed)
+                ? (std::ios_base::app | std::ios_base::binary)
+                : std::ios_base::app;
 #           if defined(_WIN32)
-            m_file.open(utf8_to_ansi(m_file_path), std::ios_base::app);
+            m_file.open(utf8_to_ansi(m_file_path), mode);
 #           else
-            m_file.open(m_file_path, std::ios_base::app);
+            m_file.open(m_file_path, mode);
 #           endif
             if (!m_file.is_open()) {
                 throw std::runtime_error("Failed to open log file: " + m_file_path);
             }
             m_file.seekp(0, std::ios::end);
             m_current_file_size = static_cast<uint64_t>(m_file.tellp());
+            if (m_config.binary) {
+                m_binary_sites.clear();
+                m_binary_threads.clear();
+            }
+            if (m_config.framed && m_current_file_size == 0) write_frame_magic();
+            m_next_boundary_ms = first_boundary_ms();
+            open_time_index(true);
+        }
+
+        /// \brief Starts an empty framed log with its magic.
+        void write_frame_magic() {
+            write_bytes(detail::kFramedLogMagic, sizeof(detail::kFramedLogMagic));
+            if (m_config.shared) flush_file();
+            m_current_file_size = sizeof(detail::kFramedLogMagic);
+        }
+
+        /// \brief Returns the size of the current file, counted across processes in `Config::shared`.
+        uint64_t current_file_size() {
+            return m_shared.file_size(m_current_date_ts, m_current_file_size);
+        }
+
+        /// \brief Opens the time index of the current file.
+        /// \param offsets_known False if record offsets in the file cannot be determined,
+        /// e.g. when appending to a compressed file of a crashed process; the file is not
+        /// indexed then.
+        void open_time_index(bool offsets_known) {
+            if (!m_time_index.open(m_file_path, m_current_file_size, offsets_known)) {
+                std::cerr << "Failed to open time index: " << detail::time_index_path(m_file_path) << std::endl;
+            }
         }
 
         /// \brief Creates a file path for the log file based on the date timestamp.
@@ -315,42 +964,362 @@ namespace logit {
         /// \return The path to the log file.
         std::string create_file_path(int64_t date_ts) const {
             std::string date_str = time_shield::to_iso8601_date(date_ts);
-            return get_directory_path() + "/" + date_str + ".log";
+            return get_directory_path() + "/" + date_str + log_extension();
+        }
+
+        /// \brief Returns the extension of log files, including the streaming compression suffix.
+        std::string log_extension() const {
+            if (!m_config.compress_live) return ".log";
+            return std::string(".log") + detail::CompressedFileWriter::extension(m_config.compress);
         }
 
         /// \brief Writes a log message to the file.
         /// \param message The log message to write.
         /// \param timestamp_ms The timestamp of the log message in milliseconds.
-        void write_log(const std::string& message, const int64_t& timestamp_ms) {
+        /// \param level The log level of the message.
+        void write_log(const std::string& message, const int64_t& timestamp_ms, LogLevel level) {
+            // In `Config::shared` no process rotates the file between the check and the write.
+            detail::SharedLogLock shared_lock(m_shared.state(), false);
+            const uint64_t add = static_cast<uint64_t>(message.size() + (m_config.binary ? 0 : 1) +
+                                                       (m_config.framed ? detail::kFrameHeaderSize : 0));
+            for (;;) {
+                if (m_shared.replaced()) {
+                    // Another process has rotated the file or started a new day.
+                    open_log_file(m_current_date_ts);
+                }
+                if (timestamp_ms >= m_next_boundary_ms || timestamp_ms < m_day_start_ms) {
+                    cross_boundary(timestamp_ms);
+                }
+                if (!m_shared.is_open()) break;
+                // Opening and rotating take the exclusive lock, which drops the shared one
+                // for a moment; another process may have rotated the file in between.
+                if (m_shared.replaced()) continue;
+                if (m_shared.reserve(m_current_date_ts, add, m_config.max_file_size_bytes, empty_file_size())) break;
+                rotate_current_file();
+            }
+            if (!m_shared.is_open() && m_config.max_file_size_bytes > 0 &&
+                m_current_file_size + add > m_config.max_file_size_bytes) {
+                rotate_current_file();
+            }
+            ++m_written_seq;
+            if (m_writer) {
+                if (!m_writer->is_open()) return;
+                m_time_index.add(timestamp_ms, m_current_file_size);
+                m_writer->begin_record(timestamp_ms);
+                const bool was_empty = m_writer->empty();
+                if (m_config.framed) {
+                    write_framed(message);
+                } else if (m_config.binary) {
+                    write_binary(message);
+                } else {
+                    m_writer->write_line(message.data(), message.size());
+                    m_current_file_size += static_cast<uint64_t>(message.size() + 1);
+                }
+                if (level >= m_config.flush_level) {
+                    m_writer->flush();
+                } else if (was_empty && !m_writer->empty() && m_config.flush_interval_ms > 0) {
+                    arm_flush();
+                }
+                return;
+            }
+            if (m_file.is_open()) {
+                m_time_index.add(timestamp_ms, m_current_file_size);
+                if (m_config.framed) {
+                    write_framed(message);
+                } else if (m_config.binary) {
+                    write_binary(message);
+                } else {
+                    m_file << message << '\n';
+                    m_current_file_size += static_cast<uint64_t>(message.size() + 1);
+                }
+            }
+        }
+
+        /// \brief Switches files for a record outside the current day or rotation period.
+        ///
+        /// Records of an earlier period of the same day, e.g. reordered by the queue, stay
+        /// in the current file.
+        /// \param timestamp_ms The timestamp of the record.
+        void cross_boundary(int64_t timestamp_ms) {
             const int64_t message_date_ts = time_shield::start_of_day(time_shield::ms_to_sec(timestamp_ms));
             if (message_date_ts != m_current_date_ts) {
                 open_log_file(message_date_ts);
+                schedule_retention(false);
             }
-            if (m_config.max_file_size_bytes > 0) {
-                const uint64_t add = static_cast<uint64_t>(message.size() + 1);
-                if (m_current_file_size + add > m_config.max_file_size_bytes) {
-                    rotate_current_file();
-                }
+            if (m_config.rotation_interval_minutes == 0 || timestamp_ms < m_next_boundary_ms) return;
+            if (current_file_size() > empty_file_size()) {
+                rotate_current_file();
             }
-            if (m_file.is_open()) {
-                m_file << message << '\n';
-                m_current_file_size += static_cast<uint64_t>(message.size() + 1);
+            m_next_boundary_ms = period_end_ms(timestamp_ms);
+        }
+
+        /// \brief Returns the end of the rotation period holding a timestamp of the current day.
+        int64_t period_end_ms(int64_t timestamp_ms) const {
+            const int64_t day_end_ms = m_day_start_ms + time_shield::SEC_PER_DAY * 1000;
+            const int64_t interval_ms = static_cast<int64_t>(m_config.rotation_interval_minutes) * 60000;
+            const int64_t end_ms = m_day_start_ms + ((timestamp_ms - m_day_start_ms) / interval_ms + 1) * interval_ms;
+            return (std::min)(end_ms, day_end_ms);
+        }
+
+        /// \brief Returns the first boundary of a freshly opened file.
+        ///
+        /// Content left by an earlier run belongs to the period of its last modification;
+        /// an empty file takes the period of its first record.
+        int64_t first_boundary_ms() {
+            const int64_t day_end_ms = m_day_start_ms + time_shield::SEC_PER_DAY * 1000;
+            if (m_config.rotation_interval_minutes == 0) return day_end_ms;
+            if (current_file_size() <= empty_file_size()) return m_day_start_ms;
+#           if defined(_WIN32)
+            int64_t modified_ms = detail::file_mtime_ms(utf8_to_ansi(m_file_path));
+#           else
+            int64_t modified_ms = detail::file_mtime_ms(m_file_path);
+#           endif
+            modified_ms = (std::max)(m_day_start_ms, (std::min)(modified_ms, day_end_ms - 1));
+            return period_end_ms(modified_ms);
+        }
+
+        /// \brief Writes a record as one frame.
+        ///
+        /// Text records keep their line break inside the frame; binary records may carry
+        /// the file header and definitions. Payloads longer than `kFrameMaxPayload` are cut.
+        /// Header and payload go out in one write call.
+        /// \param message The formatted record.
+        void write_framed(const std::string& message) {
+            const uint64_t start = m_current_file_size;
+            m_framer.begin();
+            if (m_config.binary) {
+                write_binary(message);
+            } else {
+                m_framer.append(message.data(), message.size());
+                m_framer.append("\n", 1);
+            }
+            if (!m_framer.end()) {
+                m_current_file_size = start;
+                return;
             }
-            remove_old_logs();
+            const std::string& frame = m_framer.frame();
+            write_bytes(frame.data(), frame.size());
+            m_current_file_size = start + frame.size();
         }
 
-        void rotate_current_file() {
+        /// \brief Returns the size of an empty log file: the framed log magic, if any.
+        uint64_t empty_file_size() const {
+            return m_config.framed ? sizeof(detail::kFramedLogMagic) : 0;
+        }
+
+        /// \brief Writes raw bytes to the active backend.
+        void write_bytes(const char* data, size_t size) {
+            if (m_framer.capturing()) {
+                m_framer.append(data, size);
+                return;
+            }
+            if (m_writer) {
+                m_writer->write(data, size);
+            } else {
+                m_file.write(data, static_cast<std::streamsize>(size));
+            }
+        }
+
+        /// \brief Flushes buffered data of the active backend.
+        void flush_file() {
+            if (m_writer && m_writer->is_open()) m_writer->flush();
+            if (m_file.is_open()) m_file.flush();
+        }
+
+        /// \brief Closes the active file, flushing buffered data.
+        void close_file() {
+            // Records of a batch may still be in the file being closed.
+            if (m_writer && m_writer->is_open()) {
+                if (m_config.group_commit) m_writer->sync();
+                m_writer->close();
+            }
             if (m_file.is_open()) m_file.close();
+            m_time_index.close();
+        }
+
+        /// \brief Definitions one thread has handed to one logger.
+        struct BinaryDefinitionCache {
+            std::unordered_set<uint64_t> sites;    ///< Call sites whose definition is kept by the logger.
+            uint64_t    thread_index = 0;          ///< Thread index of the last thread definition (0 = none).
+            std::string thread_label;              ///< Label of the last thread definition.
+        };
+
+        /// \brief Returns the definitions the calling thread has handed to this logger.
+        BinaryDefinitionCache& binary_definition_cache() const {
+            static thread_local std::unordered_map<uint64_t, BinaryDefinitionCache> caches;
+            return caches[m_instance_id];
+        }
+
+        /// \brief Returns a process-wide unique ID for a new logger.
+        static uint64_t next_instance_id() {
+            static std::atomic<uint64_t> counter = ATOMIC_VAR_INIT(0);
+            return ++counter;
+        }
+
+        /// \brief Prepends the definitions a `BinaryLogFormatter` event needs and keeps them for later files.
+        ///
+        /// Each thread remembers which definitions it has handed to this logger, so only the
+        /// first event of a call site, or of a thread after its label changed, takes the
+        /// definitions lock. Definitions are kept when the record is logged; a dropped task
+        /// cannot lose them.
+        /// \param record The log record.
+        /// \param message The formatted event; other messages are left alone.
+        /// \param out Receives the definitions followed by the message.
+        /// \return True if `out` holds the message to write.
+        bool add_binary_definitions(const LogRecord& record, const std::string& message, std::string& out) {
+            if (message.empty() || static_cast<uint8_t>(message[0]) != static_cast<uint8_t>(detail::BinaryRecordKind::Event)) {
+                return false;
+            }
+            detail::BinaryCursor cursor(message.data(), message.size());
+            uint8_t kind = 0;
+            const char* payload = nullptr;
+            size_t payload_size = 0;
+            uint64_t site_id = 0;
+            int64_t timestamp_ms = 0;
+            uint64_t thread_index = 0;
+            if (!cursor.get_record(kind, payload, payload_size)) return false;
+            detail::BinaryCursor rec(payload, payload_size);
+            if (!rec.get_fixed(site_id, 8) || !rec.get_svarint(timestamp_ms) || !rec.get_varint(thread_index)) {
+                return false;
+            }
+            BinaryDefinitionCache& cache = binary_definition_cache();
+            const bool new_site = cache.sites.count(site_id) == 0;
+            const bool new_thread = cache.thread_index != thread_index || cache.thread_label != record.thread_label;
+            if (!new_site && !new_thread) return false;
+            std::string site;
+            std::string thread;
+            if (new_site) BinaryLogFormatter::encode_call_site(record, site_id, site);
+            if (new_thread) BinaryLogFormatter::encode_thread(record, thread_index, thread);
+            {
+                std::lock_guard<std::mutex> lock(m_definitions_mutex);
+                if (new_site) m_site_definitions[site_id] = site;
+                if (new_thread) m_thread_definitions[thread_index] = thread;
+            }
+            if (new_site) cache.sites.insert(site_id);
+            if (new_thread) {
+                cache.thread_index = thread_index;
+                cache.thread_label = record.thread_label;
+            }
+            out.reserve(site.size() + thread.size() + message.size());
+            out.append(site).append(thread).append(message);
+            return true;
+        }
+
+        /// \brief Writes a kept definition if the current file lacks it.
+        /// \param defined Definitions already in the current file.
+        /// \param definitions Kept definitions.
+        /// \param key Call-site ID or thread index.
+        void write_binary_definition(std::unordered_set<uint64_t>& defined,
+                                     const std::unordered_map<uint64_t, std::string>& definitions,
+                                     uint64_t key) {
+            if (defined.count(key)) return;
+            std::string bytes;
+            {
+                std::lock_guard<std::mutex> lock(m_definitions_mutex);
+                auto it = definitions.find(key);
+                if (it == definitions.end()) return;
+                bytes = it->second;
+            }
+            defined.insert(key);
+            write_bytes(bytes.data(), bytes.size());
+            m_current_file_size += bytes.size();
+        }
+
+        /// \brief Writes binary records, adding the definitions the current file lacks.
+        ///
+        /// Messages that do not start with a record kind (e.g. `MsgpackFormatter` output)
+        /// are written verbatim. The `LOGITBIN` header is added before the first record of
+        /// an empty file, and the kept definitions of an event before its first use in the
+        /// file, so every file decodes on its own.
+        /// \param message Records produced by `BinaryLogFormatter` or other binary payload.
+        void write_binary(const std::string& message) {
+            const uint8_t first = message.empty() ? 0 : static_cast<uint8_t>(message[0]);
+            if (first < static_cast<uint8_t>(detail::BinaryRecordKind::CallSite) ||
+                first > static_cast<uint8_t>(detail::BinaryRecordKind::Event)) {
+                write_bytes(message.data(), message.size());
+                m_current_file_size += message.size();
+                return;
+            }
+            if (m_current_file_size == empty_file_size()) {
+                std::string header;
+                detail::put_binary_log_header(header);
+                write_bytes(header.data(), header.size());
+                m_current_file_size = header.size();
+            }
+            detail::BinaryCursor cursor(message.data(), message.size());
+            uint8_t kind = 0;
+            const char* payload = nullptr;
+            size_t payload_size = 0;
+            size_t start = cursor.position();
+            while (cursor.get_record(kind, payload, payload_size)) {
+                bool keep = true;
+                detail::BinaryCursor rec(payload, payload_size);
+                if (kind == static_cast<uint8_t>(detail::BinaryRecordKind::CallSite)) {
+                    uint64_t id = 0;
+                    keep = rec.get_fixed(id, 8) && m_binary_sites.insert(id).second;
+                } else if (kind == static_cast<uint8_t>(detail::BinaryRecordKind::Thread)) {
+                    // Sent again only when the label changed.
+                    uint64_t index = 0;
+                    keep = rec.get_varint(index);
+                    if (keep) m_binary_threads.insert(index);
+                } else if (kind == static_cast<uint8_t>(detail::BinaryRecordKind::Event)) {
+                    uint64_t site_id = 0;
+                    int64_t timestamp_ms = 0;
+                    uint64_t thread_index = 0;
+                    if (rec.get_fixed(site_id, 8) && rec.get_svarint(timestamp_ms) && rec.get_varint(thread_index)) {
+                        write_binary_definition(m_binary_sites, m_site_definitions, site_id);
+                        write_binary_definition(m_binary_threads, m_thread_definitions, thread_index);
+                    }
+                }
+                if (keep) {
+                    const size_t size = cursor.position() - start;
+                    write_bytes(message.data() + start, size);
+                    m_current_file_size += size;
+                }
+                start = cursor.position();
+            }
+        }
+
+        /// \brief Rotates the current file.
+        ///
+        /// In `Config::shared` the rotation happens under the exclusive lock and only if no
+        /// other process has replaced the file meanwhile; otherwise the replacement is
+        /// opened. Taking the exclusive lock releases a held shared lock first, so the
+        /// generation is read only after the lock is taken. The rotated files of the date
+        /// are listed again each time, since other processes add to them.
+        void rotate_current_file() {
+            if (!m_shared.is_open()) {
+                rotate_file();
+                return;
+            }
+            detail::SharedLogLock shared_lock(m_shared.state());
+            const int64_t boundary_ms = m_next_boundary_ms;
+            if (m_shared.replaced()) {
+                open_log_file(m_current_date_ts);
+                m_next_boundary_ms = boundary_ms;
+                return;
+            }
+            m_rotation_date_ts = -1;
+            rotate_file();
+            m_shared.rotated(m_current_date_ts, m_current_file_size);
+        }
+
+        /// \brief Renames the current file to its rotated name, reopens it and schedules compression.
+        void rotate_file() {
+            close_file();
 
             const std::string base = time_shield::to_iso8601_date(m_current_date_ts);
             const std::string dir  = get_directory_path();
+            if (m_rotation_date_ts != m_current_date_ts) {
+                load_rotated_files(base, dir);
+            }
             std::string rotated_str;
 #           if __cplusplus >= 201703L
 #               if defined(_WIN32)
-            fs::path cur = (fs::u8path(dir) / (base + ".log")).lexically_normal();
+            fs::path cur = (fs::u8path(dir) / (base + log_extension())).lexically_normal();
             fs::path rotated = fs::u8path(make_rotated_name(base, dir)).lexically_normal();
 #               else
-            fs::path cur = (fs::path(dir) / (base + ".log")).lexically_normal();
+            fs::path cur = (fs::path(dir) / (base + log_extension())).lexically_normal();
             fs::path rotated = fs::path(make_rotated_name(base, dir)).lexically_normal();
 #               endif
             std::error_code ec;
@@ -365,9 +1334,9 @@ namespace logit {
 #               endif
 #           else
 #               if defined(_WIN32)
-            const std::string cur  = dir + "\\" + base + ".log";
+            const std::string cur  = dir + "\\" + base + log_extension();
 #               else
-            const std::string cur  = dir + "/" + base + ".log";
+            const std::string cur  = dir + "/" + base + log_extension();
 #               endif
             rotated_str = make_rotated_name(base, dir);
 #               if defined(_WIN32)
@@ -378,107 +1347,163 @@ namespace logit {
                 throw std::runtime_error("Failed to rename log file");
             }
 #           endif
+            add_rotated_file(base, rotated_str);
+            if (m_config.naming == RotationNaming::Sequence) ++m_next_sequence;
 
+            m_time_index.rotated(dir + "/" + base + log_extension(), rotated_str);
+
+            // The new file continues the rotation period of the old one.
+            const int64_t boundary_ms = m_next_boundary_ms;
             open_log_file(m_current_date_ts);
-            m_current_file_size = 0;
+            m_next_boundary_ms = boundary_ms;
+            track_log_file(rotated_str, m_current_date_ts);
 
-            if (m_config.compress != CompressType::NONE) {
+            if (m_config.compress != CompressType::NONE && !m_config.compress_live) {
                 if (m_config.compress_async) {
                     if (!m_compressor) {
                         m_compressor.reset(new detail::CompressionWorker(
-                            m_config.compress, m_config.compress_level, m_config.external_cmd));
+                            m_config.compress, m_config.compress_level, m_config.external_cmd,
+                            compression_options(), m_dictionary));
                     }
                     m_compressor->enqueue(rotated_str);
                 } else {
-                    detail::compress_file(m_config.compress, rotated_str, m_config.compress_level, m_config.external_cmd);
+                    const int workers = m_config.compress == CompressType::ZSTD
+                        ? detail::zstd_workers_for(compression_options(), detail::file_size_of(rotated_str))
+                        : 0;
+                    detail::compress_file(m_config.compress, rotated_str, m_config.compress_level,
+                                          m_config.external_cmd, workers, m_dictionary.get());
                 }
             }
 
             if (m_config.max_rotated_files > 0) {
-                enforce_rotation_retention(base, m_config.max_rotated_files, dir);
+                enforce_rotation_retention(m_config.max_rotated_files);
             }
+            schedule_retention(false);
         }
 
-        void enforce_rotation_retention(const std::string& base, uint32_t max_files, const std::string& dir) {
+        /// \brief Returns the scheduling settings of the background compressor.
+        CompressionOptions compression_options() const {
+            CompressionOptions options;
+            options.threads = m_config.compress_threads;
+            options.zstd_workers = m_config.compress_zstd_workers;
+            options.zstd_mt_min_bytes = m_config.compress_zstd_mt_min_bytes;
+            options.nice = m_config.compress_nice;
+            return options;
+        }
+
+        /// \brief Lists the rotated files of a date once, oldest first.
+        ///
+        /// Later rotations of the date update the list in memory, so rotation does not
+        /// touch the directory apart from the rename.
+        /// \param base Date part of the file names.
+        /// \param dir Log directory.
+        void load_rotated_files(const std::string& base, const std::string& dir) {
+            std::vector<std::string> files;
 #           if __cplusplus >= 201703L
-            std::vector<fs::path> files;
-            for (const auto& entry : fs::directory_iterator(dir)) {
+            std::error_code ec;
+#               if defined(_WIN32)
+            for (const auto& entry : fs::directory_iterator(fs::u8path(dir), ec)) {
+#               else
+            for (const auto& entry : fs::directory_iterator(fs::path(dir), ec)) {
+#               endif
                 if (!fs::is_regular_file(entry.status())) continue;
-                std::string name = entry.path().filename().string();
-                if (name.rfind(base, 0) == 0 && name != base + ".log") {
-                    files.emplace_back(entry.path());
-                }
-            }
-            if (files.size() <= max_files) return;
-            // Extract timestamp and optional index for chronological sorting
-            auto extract = [&base](const std::string& name) {
-                int64_t ts = 0;
-                int      idx = 0;
-                std::string rest = name.substr(base.size());
-                if (!rest.empty() && (rest[0] == '_' || rest[0] == '.')) {
-                    rest = rest.substr(1);
-                    size_t dot = rest.find('.');
-                    ts = std::strtoll(rest.substr(0, dot).c_str(), nullptr, 10);
-                    if (dot != std::string::npos) {
-                        size_t dot2 = rest.find('.', dot + 1);
-                        if (dot2 != std::string::npos) {
-                            idx = std::atoi(rest.substr(dot + 1, dot2 - dot - 1).c_str());
-                        }
-                    }
+                const std::string name = entry.path().filename().string();
+                if (is_rotated_name(base, name)) {
+#                   if defined(_WIN32)
+                    files.push_back(entry.path().u8string());
+#                   else
+                    files.push_back(entry.path().string());
+#                   endif
                 }
-                return std::make_pair(ts, idx);
-            };
-            std::sort(files.begin(), files.end(), [&](const fs::path& a, const fs::path& b) {
-                auto pa = extract(a.filename().string());
-                auto pb = extract(b.filename().string());
-                return (pa.first == pb.first) ? (pa.second < pb.second) : (pa.first < pb.first);
-            });
-            size_t to_remove = files.size() - max_files;
-            for (size_t i = 0; i < to_remove; ++i) {
-                fs::remove(files[i]);
             }
 #           else
-            std::vector<std::string> files;
-            std::vector<std::string> file_list = get_list_files(dir);
-            for (const auto& path : file_list) {
-                std::string name = path.substr(path.find_last_of("/\\") + 1);
-                if (name.rfind(base, 0) == 0 && name != base + ".log") {
-                    files.emplace_back(path);
-                }
-            }
-            if (files.size() <= max_files) return;
-            // Extract timestamp and optional index for chronological sorting
-            auto extract = [&base](const std::string& name) {
-                int64_t ts = 0;
-                int      idx = 0;
-                std::string rest = name.substr(base.size());
-                if (!rest.empty() && (rest[0] == '_' || rest[0] == '.')) {
-                    rest = rest.substr(1);
-                    size_t dot = rest.find('.');
-                    ts = std::strtoll(rest.substr(0, dot).c_str(), nullptr, 10);
-                    if (dot != std::string::npos) {
-                        size_t dot2 = rest.find('.', dot + 1);
-                        if (dot2 != std::string::npos) {
-                            idx = std::atoi(rest.substr(dot + 1, dot2 - dot - 1).c_str());
-                        }
-                    }
+            for (const auto& path : get_list_files(dir, false)) {
+                if (is_rotated_name(base, path.substr(path.find_last_of("/\\") + 1))) {
+                    files.push_back(path);
                 }
-                return std::make_pair(ts, idx);
-            };
+            }
+#           endif
             std::sort(files.begin(), files.end(), [&](const std::string& a, const std::string& b) {
-                auto pa = extract(a.substr(a.find_last_of("/\\") + 1));
-                auto pb = extract(b.substr(b.find_last_of("/\\") + 1));
-                return (pa.first == pb.first) ? (pa.second < pb.second) : (pa.first < pb.first);
+                return rotation_order(base, rotated_key(a)) < rotation_order(base, rotated_key(b));
             });
-            size_t to_remove = files.size() - max_files;
-            for (size_t i = 0; i < to_remove; ++i) {
-#               if defined(_WIN32)
-                remove(utf8_to_ansi(files[i]).c_str());
-#               else
-                remove(files[i].c_str());
-#               endif
+            m_rotation_date_ts = m_current_date_ts;
+            m_rotated_files.assign(files.begin(), files.end());
+            m_rotated_names.clear();
+            m_next_sequence = 1;
+            for (const auto& path : files) {
+                const std::string key = rotated_key(path);
+                m_rotated_names.insert(key);
+                if (m_config.naming == RotationNaming::Sequence && key[base.size()] == '.') {
+                    const int64_t index = rotation_order(base, key).first;
+                    if (index >= m_next_sequence) m_next_sequence = static_cast<uint32_t>(index + 1);
+                }
+            }
+        }
+
+        /// \brief Inserts a rotated file of the current date in chronological order.
+        void add_rotated_file(const std::string& base, const std::string& path) {
+            const std::pair<int64_t, int> order = rotation_order(base, rotated_key(path));
+            auto it = std::upper_bound(m_rotated_files.begin(), m_rotated_files.end(), order,
+                [&base](const std::pair<int64_t, int>& value, const std::string& item) {
+                    return value < rotation_order(base, rotated_key(item));
+                });
+            m_rotated_files.insert(it, path);
+            m_rotated_names.insert(rotated_key(path));
+        }
+
+        /// \brief Checks whether a file name belongs to a rotated file of a date.
+        bool is_rotated_name(const std::string& base, const std::string& name) const {
+            return name.size() > base.size() && name.compare(0, base.size(), base) == 0 &&
+                   name != base + log_extension() && !detail::is_time_index_name(name);
+        }
+
+        /// \brief Returns the chronological sort key of a rotated file name.
+        ///
+        /// The key is the sequence number or the time of day, followed by the collision index.
+        static std::pair<int64_t, int> rotation_order(const std::string& base, const std::string& name) {
+            int64_t ts = 0;
+            int      idx = 0;
+            std::string rest = name.substr(base.size());
+            if (!rest.empty() && (rest[0] == '_' || rest[0] == '.')) {
+                rest = rest.substr(1);
+                size_t dot = rest.find('.');
+                ts = std::strtoll(rest.substr(0, dot).c_str(), nullptr, 10);
+                if (dot != std::string::npos) {
+                    size_t dot2 = rest.find('.', dot + 1);
+                    if (dot2 != std::string::npos) {
+                        idx = std::atoi(rest.substr(dot + 1, dot2 - dot - 1).c_str());
+                    }
+                }
+            }
+            return std::make_pair(ts, idx);
+        }
+
+        /// \brief Returns the file name of a rotated file without a `.gz` or `.zst` suffix.
+        static std::string rotated_key(const std::string& path) {
+            const std::string name = path.substr(path.find_last_of("/\\") + 1);
+            static const char* const suffixes[] = { ".gz", ".zst" };
+            for (const char* suffix : suffixes) {
+                const size_t size = std::char_traits<char>::length(suffix);
+                if (name.size() > size && name.compare(name.size() - size, size, suffix) == 0) {
+                    return name.substr(0, name.size() - size);
+                }
+            }
+            return name;
+        }
+
+        /// \brief Removes the oldest rotated files of the current date beyond a limit.
+        /// \param max_files Number of rotated files to keep.
+        void enforce_rotation_retention(uint32_t max_files) {
+            while (m_rotated_files.size() > max_files) {
+                const std::string path = m_rotated_files.front();
+                m_rotated_files.pop_front();
+                m_rotated_names.erase(rotated_key(path));
+                {
+                    std::lock_guard<std::mutex> lock(m_maintenance_mutex);
+                    index_remove(path);
+                }
+                remove_log_file(path);
             }
-#           endif
         }
 
         std::string make_rotated_name(const std::string& base, const std::string& dir) const {
@@ -493,34 +1518,17 @@ namespace logit {
         }
 
         std::string make_sequence_name(const std::string& base, const std::string& dir) const {
-            uint32_t idx = 1;
-            std::string rotated;
-#           if __cplusplus >= 201703L
-            for (;; ++idx) {
-                std::ostringstream oss;
-                oss << dir << "/" << base << '.' << std::setw(m_config.seq_width)
-                    << std::setfill('0') << idx << ".log";
-                rotated = oss.str();
-                if (!fs::exists(rotated)) break;
-            }
-#           else
-            auto file_exists = [](const std::string& path) {
-#               if defined(_WIN32)
-                std::ifstream f(utf8_to_ansi(path).c_str());
-#               else
-                std::ifstream f(path.c_str());
-#               endif
-                return f.good();
-            };
-            for (;; ++idx) {
-                std::ostringstream oss;
-                oss << dir << "/" << base << '.' << std::setw(m_config.seq_width)
-                    << std::setfill('0') << idx << ".log";
-                rotated = oss.str();
-                if (!file_exists(rotated)) break;
-            }
-#           endif
-            return rotated;
+            std::ostringstream oss;
+            oss << dir << "/" << base << '.' << std::setw(m_config.seq_width)
+                << std::setfill('0') << m_next_sequence << log_extension();
+            return oss.str();
+        }
+
+        /// \brief Checks whether a rotated file or its compressed copy is listed.
+        /// \param path Candidate path of a rotated file.
+        /// \return True if the name is in use.
+        bool rotated_name_taken(const std::string& path) const {
+            return m_rotated_names.count(rotated_key(path)) != 0;
         }
 
         std::string make_timestamp_name(const std::string& base, const std::string& dir) const {
@@ -540,37 +1548,22 @@ namespace logit {
                 std::snprintf(msbuf, sizeof(msbuf), "%03d", static_cast<int>(ts_ms % 1000));
                 timepart += msbuf;
             }
-            std::string rotated = dir + "/" + base + "_" + timepart + ".log";
-#           if __cplusplus >= 201703L
-            if (!fs::exists(rotated)) return rotated;
-            uint32_t idx = 1;
-            for (;; ++idx) {
-                std::string candidate = rotated.substr(0, rotated.size() - 4) + "." + std::to_string(idx) + ".log";
-                if (!fs::exists(candidate)) return candidate;
-            }
-#           else
-            auto file_exists = [](const std::string& path) {
-#               if defined(_WIN32)
-                std::ifstream f(utf8_to_ansi(path).c_str());
-#               else
-                std::ifstream f(path.c_str());
-#               endif
-                return f.good();
-            };
-            if (!file_exists(rotated)) return rotated;
+            const std::string ext = log_extension();
+            std::string rotated = dir + "/" + base + "_" + timepart + ext;
+            if (!rotated_name_taken(rotated)) return rotated;
             uint32_t idx = 1;
             for (;; ++idx) {
                 std::ostringstream oss;
-                oss << rotated.substr(0, rotated.size() - 4) << '.' << idx << ".log";
+                oss << rotated.substr(0, rotated.size() - ext.size()) << '.' << idx << ext;
                 std::string candidate = oss.str();
-                if (!file_exists(candidate)) return candidate;
+                if (!rotated_name_taken(candidate)) return candidate;
             }
-#           endif
         }
 
-        /// \brief Removes old log files based on the auto-delete days configuration.
-        void remove_old_logs() {
-            const int64_t threshold_ts = m_current_date_ts - (time_shield::SEC_PER_DAY * m_config.auto_delete_days);
+        /// \brief Scans the log directory for dated log files.
+        /// \return Paths of the files found and their date timestamps.
+        std::map<std::string, int64_t> scan_log_files() const {
+            std::map<std::string, int64_t> files;
 #           if __cplusplus >= 201703L
 #           ifdef _WIN32
             fs::path dir_path = fs::u8path(get_directory_path());
@@ -578,38 +1571,51 @@ namespace logit {
             fs::path dir_path(get_directory_path());
 #           endif
 
-            if (!fs::exists(dir_path) ||
-                !fs::is_directory(dir_path)) {
-                return;
+            std::error_code ec;
+            if (!fs::is_directory(dir_path, ec)) {
+                return files;
             }
 
-            for (const auto& entry : fs::directory_iterator(dir_path)) {
+            for (const auto& entry : fs::directory_iterator(dir_path, ec)) {
                 if (!fs::is_regular_file(entry.status())) continue;
                 std::string filename = entry.path().filename().string();
                 if (is_valid_log_filename(filename)) {
-                    const int64_t file_date_ts = get_date_ts_from_filename(filename);
-                    if (file_date_ts < threshold_ts) {
-                        fs::remove(entry.path());
-                    }
+#                   ifdef _WIN32
+                    files[entry.path().u8string()] = get_date_ts_from_filename(filename);
+#                   else
+                    files[entry.path().string()] = get_date_ts_from_filename(filename);
+#                   endif
                 }
             }
 #           else
-            std::vector<std::string> file_list = get_list_files(get_directory_path());
+            std::vector<std::string> file_list = get_list_files(get_directory_path(), false);
             for (const auto& file_path : file_list) {
                 // Extract the file name
                 std::string filename = file_path.substr(file_path.find_last_of("/\\") + 1);
                 if (is_valid_log_filename(filename)) {
-                    const int64_t file_date_ts = get_date_ts_from_filename(filename);
-                    if (file_date_ts < threshold_ts) {
-#                       if defined(_WIN32)
-                        remove(utf8_to_ansi(file_path).c_str());
-#                       else
-                        remove(file_path.c_str());
-#                       endif
-                    }
+                    files[file_path] = get_date_ts_from_filename(filename);
                 }
             }
 #           endif
+            return files;
+        }
+
+        /// \brief Removes a log file together with its compressed copy and time index.
+        /// \param path Full path of the file.
+        void remove_log_file(const std::string& path) const {
+            std::vector<std::string> paths(1, path);
+            if (m_config.compress == CompressType::GZIP) paths.push_back(path + ".gz");
+            if (m_config.compress == CompressType::ZSTD) paths.push_back(path + ".zst");
+            if (m_config.time_index && !detail::is_time_index_name(path)) {
+                paths.push_back(detail::time_index_path(path));
+            }
+            for (const auto& item : paths) {
+#               if defined(_WIN32)
+                std::remove(utf8_to_ansi(item).c_str());
+#               else
+                std::remove(item.c_str());
+#               endif
+            }
         }
 
         /// \brief Checks if the filename matches the log file naming pattern.
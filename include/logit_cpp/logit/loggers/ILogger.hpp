@@ -8,6 +8,8 @@
 /// \ingroup LogBackends Logging Backends
 /// \{
 
+#include <functional>
+
 namespace logit {
 
     /// \interface ILogger
@@ -25,6 +27,20 @@ namespace logit {
         /// \param message The formatted log message.
         virtual void log(const LogRecord& record, const std::string& message) = 0;
 
+        /// \brief Logs a message and returns the part of the call that may block.
+        ///
+        /// `Logger` calls this while holding its lock and runs the returned function after
+        /// releasing it, so a logger that waits until a message is durable does not stall
+        /// the other threads. The default logs the message and returns an empty function.
+        ///
+        /// \param record The log record containing details about the log event.
+        /// \param message The formatted log message.
+        /// \return Function that completes the call, or an empty function.
+        virtual std::function<void()> log_deferred(const LogRecord& record, const std::string& message) {
+            log(record, message);
+            return std::function<void()>();
+        }
+
         /// \brief Retrieves a string parameter from the logger.
         /// Derived classes should implement this to return specific string-based parameters.
         /// \param param The parameter type to retrieve.
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef _LOGIT_IO_URING_FILE_LOGGER_HPP_INCLUDED
+#define _LOGIT_IO_URING_FILE_LOGGER_HPP_INCLUDED
+
+/// \file IoUringFileLogger.hpp
+/// \brief File logger that submits its writes through io_uring.
+
+#include "FileLogger.hpp"
+
+namespace logit {
+
+    /// \class IoUringFileLogger
+    /// \ingroup LogBackends
+    /// \brief `FileLogger` using `FileWriteMode::IoUring`.
+    ///
+    /// Buffers are registered with the kernel once and full buffers are submitted as
+    /// fixed-buffer writes, so the `TaskExecutor` worker does not block on page-cache
+    /// contention or writeback throttling. Data syncs are queued behind the writes every
+    /// `Config::uring_sync_interval_ms`. Rotation, retention and compression behave as in
+    /// `FileLogger`.
+    ///
+    /// io_uring is used on Linux when the library is configured with `LOGIT_WITH_IO_URING`,
+    /// liburing was found and the kernel lets the process create a ring (`is_available()`).
+    /// Otherwise this class selects `FileWriteMode::BufferedFd`; a `FileLogger` configured
+    /// with `FileWriteMode::IoUring` directly rejects such a system instead.
+    class IoUringFileLogger : public FileLogger {
+    public:
+        /// \brief Default constructor that uses default configuration.
+        IoUringFileLogger() : FileLogger(make_config(Config())) {}
+
+        /// \brief Constructor with custom configuration; `write_mode` is overridden.
+        /// \param config The configuration for the logger.
+        /// \throws std::invalid_argument if `validate_config()` rejects the configuration.
+        explicit IoUringFileLogger(const Config& config) : FileLogger(make_config(config)) {}
+
+        /// \brief Returns true if io_uring support was compiled in and the kernel provides it.
+        static bool is_available() {
+            return detail::io_uring_available();
+        }
+
+    private:
+        static Config make_config(Config config) {
+            config.write_mode = is_available() ? FileWriteMode::IoUring : FileWriteMode::BufferedFd;
+            return config;
+        }
+    }; // IoUringFileLogger
+
+}; // namespace logit
+
+#endif // _LOGIT_IO_URING_FILE_LOGGER_HPP_INCLUDED
@@ -0,0 +1,280 @@
+#pragma once
+#ifndef _LOGIT_RING_FILE_LOGGER_HPP_INCLUDED
+#define _LOGIT_RING_FILE_LOGGER_HPP_INCLUDED
+
+/// \file RingFileLogger.hpp
+/// \brief "Black box" logger that overwrites a fixed-size memory-mapped file.
+
+#include "ILogger.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace logit {
+
+#if defined(_WIN32) || defined(__EMSCRIPTEN__)
+
+    /// \class RingFileLogger
+    /// \brief Stub on platforms without `mmap`; records are dropped.
+    class RingFileLogger : public ILogger {
+    public:
+        struct Config {
+            std::string directory = "logs";
+            std::string file_name = "logit.ring";
+            uint64_t    size_bytes = 64 * 1024 * 1024;
+        };
+
+        RingFileLogger() = default;
+        explicit RingFileLogger(const Config&) {}
+
+        void log(const LogRecord&, const std::string&) override { warn(); }
+        std::string get_string_param(const LoggerParam&) const override { return std::string(); }
+        int64_t get_int_param(const LoggerParam&) const override { return 0; }
+        double get_float_param(const LoggerParam&) const override { return 0.0; }
+        void set_log_level(LogLevel) override {}
+        LogLevel get_log_level() const override { return LogLevel::LOG_LVL_TRACE; }
+        void wait() override {}
+
+    private:
+        void warn() const {
+            static bool warned = false;
+            if (!warned) {
+                warned = true;
+                std::cerr << "RingFileLogger is not supported on this platform" << std::endl;
+            }
+        }
+    };
+
+#else
+
+    /// \class RingFileLogger
+    /// \ingroup LogBackends
+    /// \brief Keeps the most recent records in a preallocated file used as a circular buffer.
+    ///
+    /// The file holds a header and a data area of `Config::size_bytes`. Both are mapped
+    /// with `MAP_SHARED`, so logging a record costs a `memcpy` and a CRC-32C under a mutex
+    /// and no system call. Records are framed with a sequence number (see `RingLog.hpp`)
+    /// and overwrite the oldest ones once the data area is full; the file never grows and
+    /// needs no rotation or retention.
+    ///
+    /// Written data is in the page cache at once and survives a crash of the process,
+    /// including `SIGKILL`; it is lost only if the machine goes down before writeback.
+    /// `read_ring_log()` and `logit-decode` return the records in chronological order. On
+    /// start the logger continues after the newest record of an existing file of the same
+    /// size; a file of another size is started over.
+    class RingFileLogger : public ILogger {
+    public:
+        /// \struct Config
+        /// \brief Configuration for the ring file logger.
+        struct Config {
+            std::string directory = "logs";              ///< Directory of the file, relative to the executable.
+            std::string file_name = "logit.ring";        ///< Name of the file.
+            uint64_t    size_bytes = 64 * 1024 * 1024;   ///< Size of the data area; rounded down to 8 bytes, at least 4 KiB.
+        };
+
+        /// \brief Default constructor that uses default configuration.
+        RingFileLogger() {
+            open_ring();
+        }
+
+        /// \brief Constructor with custom configuration.
+        /// \param config The configuration for the logger.
+        explicit RingFileLogger(const Config& config) : m_config(config) {
+            open_ring();
+        }
+
+        RingFileLogger(const RingFileLogger&) = delete;
+        RingFileLogger& operator=(const RingFileLogger&) = delete;
+
+        /// \brief Unmaps the file; its contents stay in the page cache.
+        ~RingFileLogger() override {
+            close_ring();
+        }
+
+        /// \brief Copies the record into the ring.
+        /// \param record The log record containing log information.
+        /// \param message The formatted log message.
+        void log(const LogRecord& record, const std::string& message) override {
+            m_last_log_ts = record.timestamp_ms;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_data) return;
+            write_record(message.data(), message.size());
+        }
+
+        /// \brief Retrieves a string parameter from the logger.
+        std::string get_string_param(const LoggerParam& param) const override {
+            switch (param) {
+            case LoggerParam::LastFileName: return m_config.file_name;
+            case LoggerParam::LastFilePath: return m_path;
+            case LoggerParam::LastLogTimestamp: return std::to_string(m_last_log_ts.load());
+            default:
+                break;
+            };
+            return std::string();
+        }
+
+        /// \brief Retrieves an integer parameter from the logger.
+        int64_t get_int_param(const LoggerParam& param) const override {
+            switch (param) {
+            case LoggerParam::LastLogTimestamp: return m_last_log_ts.load();
+            case LoggerParam::BytesWritten: return static_cast<int64_t>(m_bytes_written.load(std::memory_order_relaxed));
+            default:
+                break;
+            };
+            return 0;
+        }
+
+        /// \brief Retrieves a floating-point parameter from the logger.
+        double get_float_param(const LoggerParam& param) const override {
+            switch (param) {
+            case LoggerParam::LastLogTimestamp: return (double)m_last_log_ts.load() / 1000.0;
+            default:
+                break;
+            };
+            return 0.0;
+        }
+
+        /// \brief Sets the minimal log level for this logger.
+        void set_log_level(LogLevel level) override {
+            m_log_level = static_cast<int>(level);
+        }
+
+        /// \brief Gets the minimal log level for this logger.
+        LogLevel get_log_level() const override {
+            return static_cast<LogLevel>(m_log_level.load());
+        }
+
+        /// \brief Records are in the page cache as soon as `log()` returns; nothing to wait for.
+        void wait() override {}
+
+    private:
+        Config             m_config;       ///< Configuration of the logger.
+        std::string        m_path;         ///< Path of the ring file.
+        mutable std::mutex m_mutex;        ///< Serializes writers.
+        int                m_fd = -1;      ///< Descriptor of the ring file.
+        char*              m_map = nullptr; ///< Mapping of the whole file.
+        size_t             m_map_size = 0; ///< Size of the mapping.
+        detail::RingLogHeader* m_header = nullptr; ///< Header inside the mapping.
+        char*              m_data = nullptr; ///< Data area inside the mapping.
+        uint64_t           m_capacity = 0; ///< Size of the data area.
+        uint64_t           m_cursor = 0;   ///< Offset of the next record.
+        uint64_t           m_sequence = 0; ///< Sequence number of the last record.
+        std::atomic<uint64_t> m_bytes_written = ATOMIC_VAR_INIT(0); ///< Bytes copied into the ring.
+        std::atomic<int64_t> m_last_log_ts = ATOMIC_VAR_INIT(0); ///< Timestamp of the last log.
+        std::atomic<int>   m_log_level = ATOMIC_VAR_INIT(static_cast<int>(LogLevel::LOG_LVL_TRACE));
+
+        /// \brief Creates or reopens the ring file and maps it.
+        void open_ring() {
+            m_capacity = m_config.size_bytes / detail::kRingAlignment * detail::kRingAlignment;
+            if (m_capacity < 4096) m_capacity = 4096;
+            const std::string dir = get_exec_dir() + "/" + m_config.directory;
+            m_path = dir + "/" + m_config.file_name;
+            try {
+                create_directories(dir);
+                map_file();
+            } catch (const std::exception& e) {
+                std::cerr << "Ring log error: " << e.what() << std::endl;
+                close_ring();
+            }
+        }
+
+        /// \brief Maps the file, preallocating it and restoring the cursor of an earlier run.
+        void map_file() {
+            m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (m_fd < 0) throw std::runtime_error("Failed to open ring log: " + m_path);
+            m_map_size = static_cast<size_t>(detail::kRingHeaderSize + m_capacity);
+            struct stat st;
+            const bool same_size = ::fstat(m_fd, &st) == 0 && static_cast<uint64_t>(st.st_size) == m_map_size;
+            if (!same_size && ::ftruncate(m_fd, 0) != 0) {
+                throw std::runtime_error("Failed to truncate ring log: " + m_path);
+            }
+            // Allocate all blocks up front; a page of a sparse mapping that cannot be
+            // allocated later would raise SIGBUS in the writer. Only a file system
+            // without fallocate gets a sparse file; a full disk fails the open.
+            int error = EOPNOTSUPP;
+#           if defined(__linux__)
+            error = ::fallocate(m_fd, 0, 0, static_cast<off_t>(m_map_size)) == 0 ? 0 : errno;
+#           endif
+            if (error == EOPNOTSUPP || error == ENOSYS) {
+                error = ::ftruncate(m_fd, static_cast<off_t>(m_map_size)) == 0 ? 0 : errno;
+            }
+            if (error != 0) {
+                throw std::runtime_error("Failed to preallocate ring log " + m_path + ": " + std::strerror(error));
+            }
+            void* map = ::mmap(nullptr, m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+            if (map == MAP_FAILED) throw std::runtime_error("Failed to map ring log: " + m_path);
+            m_map = static_cast<char*>(map);
+            m_header = reinterpret_cast<detail::RingLogHeader*>(m_map);
+            m_data = m_map + detail::kRingHeaderSize;
+            if (same_size && detail::is_ring_log_header(*m_header) && m_header->capacity == m_capacity) {
+                const std::vector<detail::RingFrameRef> frames = detail::find_ring_frames(m_data, m_capacity);
+                if (!frames.empty()) {
+                    m_sequence = frames.back().sequence;
+                    m_cursor = frames.back().offset + detail::ring_frame_size(frames.back().size);
+                }
+                return;
+            }
+            if (same_size) std::memset(m_map, 0, m_map_size);
+            detail::RingLogHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, detail::kRingLogMagic, sizeof(header.magic));
+            header.version = detail::kRingLogVersion;
+            header.header_size = static_cast<uint32_t>(detail::kRingHeaderSize);
+            header.capacity = m_capacity;
+            std::memcpy(m_header, &header, sizeof(header));
+        }
+
+        /// \brief Unmaps and closes the file.
+        void close_ring() {
+            if (m_map) ::munmap(m_map, m_map_size);
+            if (m_fd >= 0) ::close(m_fd);
+            m_map = nullptr;
+            m_header = nullptr;
+            m_data = nullptr;
+            m_fd = -1;
+        }
+
+        /// \brief Frames a record at the cursor, starting a new lap if it does not fit.
+        ///
+        /// The payload is the message and a line break; messages longer than the data
+        /// area are cut.
+        void write_record(const char* message, size_t size) {
+            uint64_t limit = m_capacity - detail::kFrameHeaderSize - 1;
+            if (limit > detail::kFrameMaxPayload - 1) limit = detail::kFrameMaxPayload - 1;
+            if (size > limit) size = static_cast<size_t>(limit);
+            const size_t payload = size + 1;
+            const uint64_t frame = detail::ring_frame_size(payload);
+            if (m_cursor + frame > m_capacity) {
+                // Old frames in the unused tail would be mistaken for records of this lap.
+                std::memset(m_data + m_cursor, 0, static_cast<size_t>(m_capacity - m_cursor));
+                m_cursor = 0;
+                ++m_header->generation;
+            }
+            char* out = m_data + m_cursor;
+            std::memcpy(out + detail::kFrameHeaderSize, message, size);
+            out[detail::kFrameHeaderSize + size] = '\n';
+            std::memset(out + detail::kFrameHeaderSize + payload, 0,
+                        static_cast<size_t>(frame - detail::kFrameHeaderSize - payload));
+            detail::make_frame_header(out, ++m_sequence, out + detail::kFrameHeaderSize, payload);
+            m_cursor += frame;
+            m_header->cursor = m_cursor;
+            m_header->sequence = m_sequence;
+            m_bytes_written.fetch_add(frame, std::memory_order_relaxed);
+        }
+    }; // RingFileLogger
+
+#endif
+
+}; // namespace logit
+
+#endif // _LOGIT_RING_FILE_LOGGER_HPP_INCLUDED
@@ -17,6 +17,7 @@
 #include <ctime>
 #include <random>
 #include <algorithm>
+#include <memory>
 #include <unordered_map>
 #include <regex>
 
@@ -31,6 +32,11 @@ namespace logit {
             bool        async     = false;
             int         auto_delete_days = 30;
             size_t      hash_length = 8;
+            CompressType compress   = CompressType::NONE;
+            int         compress_level = 1;
+            std::string compress_dictionary;
+            bool        pack = false;
+            uint64_t    pack_segment_size = 64 * 1024 * 1024;
         };
 
         UniqueFileLogger() { warn(); }
@@ -70,6 +76,17 @@ namespace logit {
     /// - Unique file generation for each log message.
     /// - Automatic deletion of old files.
     /// - Synchronous or asynchronous operation.
+    /// - Optional gzip/zstd compression of each file, with a trained zstd dictionary
+    ///   (`Config::compress_dictionary`) that keeps small files small.
+    /// - Pack mode (`Config::pack`) that appends messages to segment files instead.
+    ///
+    /// In pack mode each message is appended to the current segment (`*.pack`, see
+    /// UniquePack.hpp) and indexed by id in `*.pack.idx`, so a message costs two appends
+    /// instead of a new file. A segment is started with the first message, when the
+    /// segment reaches `pack_segment_size` and when the UTC day of the records changes;
+    /// old segments are removed only then, not after every message. `LastFilePath` and
+    /// `LastFileName` report the message as `<segment>#<id>`; `UniquePackReader` and the
+    /// `logit-unique-extract` tool read it back.
     class UniqueFileLogger : public ILogger {
     public:
 
@@ -80,6 +97,11 @@ namespace logit {
             bool        async               = true; ///< Flag indicating whether logging should be asynchronous.
             int         auto_delete_days    = 30;   ///< Number of days after which old log files are deleted.
             size_t      hash_length         = 8;    ///< Length of the hash used in filenames.
+            CompressType compress           = CompressType::NONE; ///< GZIP or ZSTD writes `.log.gz`/`.log.zst` files; other values write plain files.
+            int         compress_level      = 1;    ///< Compression level.
+            std::string compress_dictionary;        ///< zstd dictionary file, e.g. `LOGIT_ZSTD_DICTIONARY_NAME`; relative paths are resolved against `directory` (empty = none).
+            bool        pack                = false; ///< Append messages to indexed segment files instead of writing one file per message.
+            uint64_t    pack_segment_size   = 64 * 1024 * 1024; ///< Segment size in bytes after which pack mode starts a new segment.
         };
 
         /// \brief Default constructor that uses default configuration.
@@ -157,6 +179,7 @@ namespace logit {
                 m_pending_logs_cv.notify_all();
                 info_lock.unlock();
 
+                if (m_config.pack) return;
                 try {
                     remove_old_logs();
                 } catch (const std::exception& e) {
@@ -198,6 +221,7 @@ namespace logit {
                 }
                 info_lock.unlock();
 
+                if (m_config.pack) return;
                 try {
                     remove_old_logs();
                 } catch (const std::exception& e) {
@@ -266,6 +290,14 @@ namespace logit {
     private:
         mutable std::mutex m_mutex;    ///< Mutex to protect file operations.
         Config             m_config;   ///< Configuration for the unique file logger.
+        std::unique_ptr<detail::CompressedFileWriter> m_writer; ///< Compressor reused for every file; null without compression.
+        std::unique_ptr<detail::IFileWriter> m_pack; ///< Writer of the current segment in pack mode.
+        detail::FdFileWriter m_pack_index;     ///< Writer of the index of the current segment.
+        std::string        m_pack_path;        ///< Path of the current segment.
+        uint64_t           m_pack_size = 0;    ///< Bytes in the current segment.
+        uint64_t           m_pack_next_id = 0; ///< Id of the next message in the current segment.
+        int64_t            m_pack_day = 0;     ///< Start of the UTC day of the current segment, in seconds.
+        CompressType       m_pack_compress = CompressType::NONE; ///< Compression of the segment payloads.
 
         struct ThreadLogInfo {
             int pending_logs;
@@ -298,15 +330,53 @@ namespace logit {
             std::lock_guard<std::mutex> lock(m_mutex);
             try {
                 initialize_directory();
+                create_writer();
                 remove_old_logs();
             } catch (const std::exception& e) {
                 std::cerr << "Initialization error: " << e.what() << std::endl;
             }
         }
 
-        /// \brief Stops the logging process by waiting for tasks.
+        /// \brief Creates the compressor, loading the zstd dictionary if one is configured.
+        ///
+        /// In pack mode the compressor writes the segments and closes a frame after every
+        /// message, so each message can be decompressed on its own.
+        void create_writer() {
+            if (!detail::CompressedFileWriter::is_supported(m_config.compress)) {
+                if (m_config.pack) m_pack.reset(new detail::FdFileWriter());
+                return;
+            }
+            std::shared_ptr<const ZstdDictionary> dictionary;
+            if (m_config.compress == CompressType::ZSTD && !m_config.compress_dictionary.empty()) {
+                try {
+                    dictionary = ZstdDictionary::load(
+                        detail::resolve_dictionary_path(get_directory_path(), m_config.compress_dictionary),
+                        m_config.compress_level);
+                } catch (const std::exception& e) {
+                    std::cerr << "Dictionary error: " << e.what() << std::endl;
+                }
+            }
+            if (m_config.pack) {
+                m_pack_compress = m_config.compress;
+                m_pack.reset(new detail::CompressedFileWriter(
+                    std::unique_ptr<detail::IFileWriter>(new detail::FdFileWriter()),
+                    m_config.compress, m_config.compress_level, 1, 0, false, dictionary));
+                return;
+            }
+            m_writer.reset(new detail::CompressedFileWriter(
+                std::unique_ptr<detail::IFileWriter>(new detail::FdFileWriter()),
+                m_config.compress, m_config.compress_level, 0, 0, false, dictionary));
+        }
+
+        /// \brief Stops the logging process by waiting for tasks and closing the segment.
         void stop_logging() {
             wait();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            try {
+                close_segment();
+            } catch (const std::exception& e) {
+                std::cerr << "Log error: " << e.what() << std::endl;
+            }
         }
 
         /// \brief Initializes the logging directory.
@@ -325,7 +395,16 @@ namespace logit {
         /// \param timestamp_ms The timestamp of the log message in milliseconds.
         /// \return The name of the file the message was written to.
         std::string write_log(const std::string& message, const int64_t& timestamp_ms) {
+            if (m_pack) return write_packed(message, timestamp_ms);
             std::string file_path = create_unique_file_path(timestamp_ms);
+            if (m_writer) {
+                if (!m_writer->open(file_path, 64 * 1024)) {
+                    throw std::runtime_error("Failed to open log file: " + file_path);
+                }
+                m_writer->write(message.data(), message.size());
+                m_writer->close();
+                return file_path;
+            }
 #           if defined(_WIN32)
             std::ofstream file(utf8_to_ansi(file_path), std::ios_base::binary);
 #           else
@@ -339,13 +418,88 @@ namespace logit {
             return file_path;
         }
 
+        /// \brief Appends a log message to the current segment and indexes it.
+        /// \param message The log message to write.
+        /// \param timestamp_ms The timestamp of the log message in milliseconds.
+        /// \return The reference `<segment path>#<id>` of the message.
+        std::string write_packed(const std::string& message, const int64_t& timestamp_ms) {
+            const int64_t day = time_shield::start_of_day(time_shield::ms_to_sec(timestamp_ms));
+            if (!m_pack->is_open() || m_pack_size >= m_config.pack_segment_size || day != m_pack_day) {
+                open_segment(timestamp_ms, day);
+            }
+            try {
+                m_pack->write(message.data(), message.size());
+                m_pack->flush();
+            } catch (...) {
+                // Offsets after a failed write are unknown; the next message starts a new segment.
+                try {
+                    close_segment();
+                } catch (...) {}
+                throw;
+            }
+            const uint64_t end = m_pack->file_size();
+            UniquePackEntry entry;
+            entry.id = m_pack_next_id++;
+            entry.timestamp_ms = timestamp_ms;
+            entry.offset = m_pack_size;
+            entry.length = end - m_pack_size;
+            m_pack_size = end;
+            // The entry follows its payload, so the index never points at missing data.
+            std::string data;
+            detail::encode_unique_pack_entry(data, entry);
+            m_pack_index.write(data.data(), data.size());
+            m_pack_index.flush();
+            return m_pack_path + "#" + std::to_string(entry.id);
+        }
+
+        /// \brief Closes the current segment and starts a new one, then removes old segments.
+        /// \param timestamp_ms The timestamp of the first message of the segment.
+        /// \param day Start of the UTC day of the message, in seconds.
+        void open_segment(const int64_t& timestamp_ms, int64_t day) {
+            const bool first = m_pack_path.empty();
+            close_segment();
+            const std::string path = get_directory_path() + "/" + format_timestamp(timestamp_ms) + "-" +
+                                     generate_fixed_length_hash(m_config.hash_length) + ".pack";
+            if (!m_pack->open(path, 64 * 1024)) {
+                throw std::runtime_error("Failed to open log segment: " + path);
+            }
+            if (!m_pack_index.open(detail::unique_pack_index_path(path), 4096)) {
+                m_pack->close();
+                throw std::runtime_error("Failed to open log segment index: " + path);
+            }
+            const std::string header = detail::encode_unique_pack_header(m_pack_compress);
+            m_pack_index.write(header.data(), header.size());
+            m_pack_index.flush();
+            m_pack_path = path;
+            m_pack_size = 0;
+            m_pack_next_id = 0;
+            m_pack_day = day;
+            // Retention runs at startup and on every new segment instead of after each message.
+            if (first) return;
+            try {
+                remove_old_logs();
+            } catch (const std::exception& e) {
+                std::cerr << "Log error: " << e.what() << std::endl;
+            }
+        }
+
+        /// \brief Closes the current segment and its index.
+        void close_segment() {
+            if (!m_pack) return;
+            m_pack->close();
+            m_pack_index.close();
+        }
+
         /// \brief Creates a unique file path based on the timestamp and a hash.
         /// \param timestamp_ms The timestamp in milliseconds.
         /// \return The unique file path.
         std::string create_unique_file_path(const int64_t& timestamp_ms) const {
             const std::string timestamp_str = format_timestamp(timestamp_ms);
             const std::string hash_str = generate_fixed_length_hash(m_config.hash_length);
-            return get_directory_path() + "/" + timestamp_str + "-" + hash_str + ".log";
+            const std::string extension = m_writer
+                ? std::string(".log") + detail::CompressedFileWriter::extension(m_config.compress)
+                : std::string(".log");
+            return get_directory_path() + "/" + timestamp_str + "-" + hash_str + extension;
         }
 
         /// \brief Formats the timestamp into a string with date and time.
@@ -397,7 +551,7 @@ namespace logit {
             for (const auto& entry : fs::directory_iterator(dir_path)) {
                 if (!fs::is_regular_file(entry.status())) continue;
                 std::string filename = entry.path().filename().string();
-                if (is_valid_log_filename(filename)) {
+                if (is_valid_log_filename(filename) && !is_open_segment(filename)) {
                     const int64_t file_ts = get_date_ts_from_filename(filename);
                     if (file_ts < threshold_ts) {
                         fs::remove(entry.path());
@@ -405,10 +559,10 @@ namespace logit {
                 }
             }
 #           else
-            const std::vector<std::string> file_list = get_list_files(get_directory_path());
+            const std::vector<std::string> file_list = get_list_files(get_directory_path(), false);
             for (const auto& file_path : file_list) {
                 std::string filename = get_file_name(file_path);
-                if (is_valid_log_filename(filename)) {
+                if (is_valid_log_filename(filename) && !is_open_segment(filename)) {
                     const int64_t file_ts = get_date_ts_from_filename(filename);
                     if (file_ts < threshold_ts) {
 #                       if defined(_WIN32)
@@ -427,10 +581,17 @@ namespace logit {
         /// \return True if the filename matches the pattern, false otherwise.
         bool is_valid_log_filename(const std::string& filename) const {
             static const std::regex pattern(
-                R"(^(\d{4}-\d{2}-\d{2}_\d{2}-\d{2}-\d{2}-\d{3})-[-_A-Za-z0-9]+\.log(\.gz|\.zst)?$)");
+                R"(^(\d{4}-\d{2}-\d{2}_\d{2}-\d{2}-\d{2}-\d{3})-[-_A-Za-z0-9]+\.(log(\.gz|\.zst)?|pack(\.idx)?)$)");
             return std::regex_match(filename, pattern);
         }
 
+        /// \brief Checks if the filename belongs to the segment pack mode is writing.
+        bool is_open_segment(const std::string& filename) const {
+            if (m_pack_path.empty()) return false;
+            const std::string name = get_file_name(m_pack_path);
+            return filename.compare(0, name.size(), name) == 0;
+        }
+
         /// \brief Extracts the date timestamp from the filename.
         /// \param filename The filename to extract the date from.
         /// \return The date timestamp.
@@ -0,0 +1,15 @@
+#pragma once
+#ifndef _LOGIT_READERS_HPP_INCLUDED
+#define _LOGIT_READERS_HPP_INCLUDED
+
+/// \file readers.hpp
+/// \brief Aggregates the readers of files written by the loggers.
+
+#include "config.hpp"
+#include "enums.hpp"
+#include "utils.hpp"
+#include "readers/SeekableZstdReader.hpp"
+#include "readers/LogReader.hpp"
+#include "readers/UniquePackReader.hpp"
+
+#endif // _LOGIT_READERS_HPP_INCLUDED
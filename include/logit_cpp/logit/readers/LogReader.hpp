@@ -0,0 +1,327 @@
+#pragma once
+#ifndef _LOGIT_LOG_READER_HPP_INCLUDED
+#define _LOGIT_LOG_READER_HPP_INCLUDED
+
+/// \file LogReader.hpp
+/// \brief Time-range reads from log files with a time index.
+
+#include "../detail/TimeIndex.hpp"
+#include "../detail/ZstdDictionary.hpp"
+#include "../detail/ZstdSeekTable.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <time_shield/time_parser.hpp>
+
+#if defined(LOGIT_HAS_ZLIB)
+#   include <zlib.h>
+#endif
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#endif
+
+namespace logit {
+
+    /// \class LogReader
+    /// \brief Streams the part of a log file that covers a time range.
+    ///
+    /// `FileLogger` with `Config::time_index` writes a sparse index beside each file that
+    /// maps record timestamps to offsets in the uncompressed content. The reader
+    /// binary-searches it and streams only the bytes between the last entry before the
+    /// range and the first entry after it, so the output starts and ends on record
+    /// boundaries and may include up to one index step of records outside the range.
+    ///
+    /// Plain files are read from the located offset. `.gz` and `.zst` files are
+    /// decompressed from the start, or from the right frame of a zstd file with a seek
+    /// table, and decoding stops at the end of the range. Files without an index are
+    /// streamed whole. Timestamps are expected to grow along the file, as they do for
+    /// records of a single logger.
+    class LogReader {
+    public:
+        /// \brief Loads the time index of a log file.
+        /// \param path Path of the log file (UTF-8), compressed or not.
+        /// \param dictionary Dictionary a zstd file was compressed with (optional).
+        /// \throws std::runtime_error if the file cannot be opened.
+        explicit LogReader(const std::string& path, std::shared_ptr<const ZstdDictionary> dictionary = nullptr)
+            : m_path(path), m_dictionary(std::move(dictionary)) {
+#           if defined(_WIN32)
+            std::ifstream probe(utf8_to_ansi(path).c_str(), std::ios::binary);
+#           else
+            std::ifstream probe(path.c_str(), std::ios::binary);
+#           endif
+            if (!probe) {
+                throw std::runtime_error("Failed to open log: " + path);
+            }
+            m_has_index = detail::read_time_index(detail::time_index_path(path), m_index);
+            if (ends_with(path, ".gz")) m_type = CompressType::GZIP;
+            if (ends_with(path, ".zst")) m_type = CompressType::ZSTD;
+        }
+
+        /// \brief Returns the path of the log file.
+        const std::string& path() const { return m_path; }
+
+        /// \brief Returns true if the file has a time index.
+        bool has_index() const { return m_has_index; }
+
+        /// \brief Returns the entries of the time index in file order.
+        const std::vector<TimeIndexEntry>& index() const { return m_index; }
+
+        /// \brief Finds the uncompressed byte range that holds the records of a time range.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \param begin Receives the first offset.
+        /// \param end Receives the end offset, or the maximal `uint64_t` for the end of the file.
+        void locate(int64_t from_ms, int64_t to_ms, uint64_t& begin, uint64_t& end) const {
+            begin = 0;
+            end = (std::numeric_limits<uint64_t>::max)();
+            if (from_ms > to_ms) {
+                end = 0;
+                return;
+            }
+            if (m_index.empty()) return;
+            // Records between two entries are not older than the first of them.
+            auto first = std::lower_bound(m_index.begin(), m_index.end(), from_ms,
+                [](const TimeIndexEntry& entry, int64_t ts) { return entry.timestamp_ms < ts; });
+            if (first != m_index.begin()) begin = (first - 1)->offset;
+            auto last = std::upper_bound(m_index.begin(), m_index.end(), to_ms,
+                [](int64_t ts, const TimeIndexEntry& entry) { return ts < entry.timestamp_ms; });
+            if (last != m_index.end()) end = (std::max)(begin, last->offset);
+        }
+
+        /// \brief Streams the records of a time range.
+        /// \tparam Callback Callable accepting `(const char* data, size_t size)`.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \param callback Receives the content in file order.
+        /// \return Number of bytes passed to the callback.
+        /// \throws std::runtime_error if the file cannot be read or decompressed.
+        template <typename Callback>
+        uint64_t read_range(int64_t from_ms, int64_t to_ms, Callback callback) const {
+            uint64_t begin = 0;
+            uint64_t end = 0;
+            locate(from_ms, to_ms, begin, end);
+            if (begin >= end) return 0;
+            Window<Callback> window(begin, end, callback);
+            if (m_type == CompressType::GZIP) {
+                read_gzip(window);
+            } else if (m_type == CompressType::ZSTD) {
+                read_zstd(window);
+            } else {
+                read_plain(window);
+            }
+            return window.emitted;
+        }
+
+        /// \brief Returns the records of a time range as a string.
+        std::string read_range(int64_t from_ms, int64_t to_ms) const {
+            std::string out;
+            read_range(from_ms, to_ms, [&out](const char* data, size_t size) { out.append(data, size); });
+            return out;
+        }
+
+#       if !defined(__EMSCRIPTEN__)
+        /// \brief Lists the log files of a directory that may hold records of a time range.
+        ///
+        /// Files are selected by the date in their name and ordered by date, rotated files
+        /// before the current file of the day. Compressed files are included; index files
+        /// are not.
+        /// \param directory Log directory (UTF-8).
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \return Paths of the files.
+        static std::vector<std::string> find_files(const std::string& directory, int64_t from_ms, int64_t to_ms) {
+            struct Candidate {
+                std::string key;
+                std::string path;
+                bool operator<(const Candidate& other) const { return key < other.key; }
+            };
+            std::vector<Candidate> candidates;
+            for (const auto& path : get_list_files(directory, false)) {
+                const std::string name = path.substr(path.find_last_of("/\\") + 1);
+                if (!is_log_name(name)) continue;
+                const int64_t day_ms = time_shield::ts(name.substr(0, 10)) * 1000;
+                if (day_ms > to_ms || day_ms + time_shield::SEC_PER_DAY * 1000 <= from_ms) continue;
+                // The current file of a day ("YYYY-MM-DD.log...") sorts after its rotated files.
+                const bool current = name.compare(10, 4, ".log") == 0;
+                Candidate candidate;
+                candidate.key = name.substr(0, 10) + (current ? "\x7f" : "") + name.substr(10);
+                candidate.path = path;
+                candidates.push_back(candidate);
+            }
+            std::sort(candidates.begin(), candidates.end());
+            std::vector<std::string> files;
+            for (const auto& candidate : candidates) files.push_back(candidate.path);
+            return files;
+        }
+#       endif
+
+    private:
+        /// \brief Passes the part of the content inside `[begin, end)` to a callback.
+        template <typename Callback>
+        struct Window {
+            uint64_t begin;
+            uint64_t end;
+            uint64_t position;
+            uint64_t emitted;
+            Callback& callback;
+
+            Window(uint64_t first, uint64_t last, Callback& cb)
+                : begin(first), end(last), position(0), emitted(0), callback(cb) {}
+
+            /// \brief Consumes content at `position`; returns false once the window is complete.
+            bool put(const char* data, size_t size) {
+                const uint64_t chunk_begin = position;
+                const uint64_t chunk_end = position + size;
+                position = chunk_end;
+                if (chunk_end > begin && chunk_begin < end) {
+                    const uint64_t from = (std::max)(chunk_begin, begin);
+                    const uint64_t to = (std::min)(chunk_end, end);
+                    callback(data + (from - chunk_begin), static_cast<size_t>(to - from));
+                    emitted += to - from;
+                }
+                return position < end;
+            }
+        };
+
+        std::string m_path;                          ///< Path of the log file.
+        std::shared_ptr<const ZstdDictionary> m_dictionary; ///< Dictionary of a zstd file, if any.
+        std::vector<TimeIndexEntry> m_index;         ///< Entries of the time index.
+        bool m_has_index = false;                    ///< The file has a time index.
+        CompressType m_type = CompressType::NONE;    ///< Compression of the file.
+
+        static bool ends_with(const std::string& value, const std::string& suffix) {
+            return value.size() >= suffix.size() &&
+                   value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+
+        /// \brief Checks whether a file name is a dated log file or its compressed copy.
+        static bool is_log_name(const std::string& name) {
+            if (name.size() < 14 || name[4] != '-' || name[7] != '-') return false;
+            for (size_t i = 0; i < 10; ++i) {
+                if (i != 4 && i != 7 && (name[i] < '0' || name[i] > '9')) return false;
+            }
+            return ends_with(name, ".log") || ends_with(name, ".log.gz") || ends_with(name, ".log.zst");
+        }
+
+        void open_input(std::ifstream& file) const {
+#           if defined(_WIN32)
+            file.open(utf8_to_ansi(m_path).c_str(), std::ios::binary);
+#           else
+            file.open(m_path.c_str(), std::ios::binary);
+#           endif
+            if (!file) {
+                throw std::runtime_error("Failed to open log: " + m_path);
+            }
+        }
+
+        template <typename Callback>
+        void read_plain(Window<Callback>& window) const {
+            std::ifstream file;
+            open_input(file);
+            file.seekg(static_cast<std::streamoff>(window.begin));
+            if (!file) return;
+            window.position = window.begin;
+            std::vector<char> buffer(64 * 1024);
+            while (file) {
+                file.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+                const size_t got = static_cast<size_t>(file.gcount());
+                if (got == 0 || !window.put(&buffer[0], got)) break;
+            }
+        }
+
+        template <typename Callback>
+        void read_gzip(Window<Callback>& window) const {
+#           if defined(LOGIT_HAS_ZLIB)
+            std::ifstream file;
+            open_input(file);
+            z_stream zs = z_stream();
+            // 32 added to the window bits detects the gzip header.
+            if (inflateInit2(&zs, 15 + 32) != Z_OK) throw std::runtime_error("Failed to create gzip decoder");
+            std::vector<char> in_buf(64 * 1024);
+            std::vector<char> out_buf(256 * 1024);
+            bool more = true;
+            while (more) {
+                file.read(&in_buf[0], static_cast<std::streamsize>(in_buf.size()));
+                const size_t got = static_cast<size_t>(file.gcount());
+                if (got == 0) break;
+                zs.next_in = reinterpret_cast<Bytef*>(&in_buf[0]);
+                zs.avail_in = static_cast<uInt>(got);
+                while (more && zs.avail_in > 0) {
+                    zs.next_out = reinterpret_cast<Bytef*>(&out_buf[0]);
+                    zs.avail_out = static_cast<uInt>(out_buf.size());
+                    const int res = inflate(&zs, Z_NO_FLUSH);
+                    if (res != Z_OK && res != Z_STREAM_END && res != Z_BUF_ERROR) {
+                        inflateEnd(&zs);
+                        throw std::runtime_error("Corrupt gzip log: " + m_path);
+                    }
+                    const size_t produced = out_buf.size() - zs.avail_out;
+                    if (produced > 0 && !window.put(&out_buf[0], produced)) more = false;
+                    // Files are sequences of gzip members.
+                    if (res == Z_STREAM_END) inflateReset(&zs);
+                    else if (res == Z_BUF_ERROR) break;
+                }
+            }
+            inflateEnd(&zs);
+#           else
+            (void)window;
+            throw std::runtime_error("Reading gzip logs requires LOGIT_HAS_ZLIB");
+#           endif
+        }
+
+        template <typename Callback>
+        void read_zstd(Window<Callback>& window) const {
+#           if defined(LOGIT_HAS_ZSTD)
+            std::ifstream file;
+            open_input(file);
+            // With a complete seek table decoding starts at the frame holding `begin`.
+            std::vector<detail::SeekTableEntry> frames;
+            uint64_t file_size = 0;
+            if (detail::read_seek_table(m_path, frames, file_size) > 0) {
+                uint64_t offset = 0;
+                uint64_t content = 0;
+                for (const auto& frame : frames) {
+                    if (frame.decompressed_size == 0 || content + frame.decompressed_size > window.begin) break;
+                    offset += frame.compressed_size;
+                    content += frame.decompressed_size;
+                }
+                file.seekg(static_cast<std::streamoff>(offset));
+                window.position = content;
+            }
+            std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+            if (!dctx) throw std::runtime_error("Failed to create zstd decoder");
+            if (m_dictionary && !m_dictionary->attach(dctx.get())) {
+                throw std::runtime_error("Failed to attach zstd dictionary");
+            }
+            std::vector<char> in_buf(ZSTD_DStreamInSize());
+            std::vector<char> out_buf(ZSTD_DStreamOutSize());
+            bool more = true;
+            while (more) {
+                file.read(&in_buf[0], static_cast<std::streamsize>(in_buf.size()));
+                const size_t got = static_cast<size_t>(file.gcount());
+                if (got == 0) break;
+                ZSTD_inBuffer in = { &in_buf[0], got, 0 };
+                while (more) {
+                    ZSTD_outBuffer out = { &out_buf[0], out_buf.size(), 0 };
+                    const size_t res = ZSTD_decompressStream(dctx.get(), &out, &in);
+                    if (ZSTD_isError(res)) {
+                        throw std::runtime_error("Corrupt zstd log " + m_path + ": " + ZSTD_getErrorName(res));
+                    }
+                    if (out.pos > 0 && !window.put(&out_buf[0], out.pos)) more = false;
+                    if (in.pos == in.size && out.pos < out.size) break;
+                }
+            }
+#           else
+            (void)window;
+            throw std::runtime_error("Reading zstd logs requires LOGIT_HAS_ZSTD");
+#           endif
+        }
+    }; // class LogReader
+
+}; // namespace logit
+
+#endif // _LOGIT_LOG_READER_HPP_INCLUDED
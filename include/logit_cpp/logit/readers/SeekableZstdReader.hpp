@@ -0,0 +1,180 @@
+#pragma once
+#ifndef _LOGIT_SEEKABLE_ZSTD_READER_HPP_INCLUDED
+#define _LOGIT_SEEKABLE_ZSTD_READER_HPP_INCLUDED
+
+/// \file SeekableZstdReader.hpp
+/// \brief Random access by time into zstd log files written with a seek table.
+
+#include "../detail/ZstdDictionary.hpp"
+#include "../detail/ZstdSeekTable.hpp"
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#endif
+
+namespace logit {
+
+    /// \class SeekableZstdReader
+    /// \brief Decompresses only the frames of a zstd log file that cover a time range.
+    ///
+    /// Files written by `FileLogger` with `compress_live`, `CompressType::ZSTD` and
+    /// `compress_seekable` end with a seek table that maps the first timestamp of every
+    /// frame to its position. A frame is selected when its span, from its first timestamp to
+    /// the first timestamp of the next frame, overlaps the requested range. Whole frames are
+    /// returned, so the output may begin and end with records outside the range.
+    ///
+    /// Files without a table (plain zstd files or files of a crashed process) are read as a
+    /// single frame. Requires `LOGIT_HAS_ZSTD` for decompression.
+    class SeekableZstdReader {
+    public:
+        /// \struct Frame
+        /// \brief Position and start time of one frame.
+        struct Frame {
+            int64_t  first_ts_ms = 0;       ///< Timestamp of the first record.
+            uint64_t offset = 0;            ///< Offset of the frame in the file.
+            uint64_t compressed_size = 0;   ///< Size of the frame in the file.
+            uint64_t decompressed_size = 0; ///< Size of the frame content (0 if unknown).
+        };
+
+        /// \brief Loads the seek table of a file.
+        /// \param path File path (UTF-8).
+        /// \param dictionary Dictionary the file was compressed with (optional).
+        /// \throws std::runtime_error if the file cannot be opened.
+        explicit SeekableZstdReader(const std::string& path,
+                                    std::shared_ptr<const ZstdDictionary> dictionary = nullptr)
+            : m_path(path), m_dictionary(std::move(dictionary)) {
+            std::vector<detail::SeekTableEntry> entries;
+            uint64_t file_size = 0;
+            const uint64_t table_size = detail::read_seek_table(path, entries, file_size);
+#           if defined(_WIN32)
+            std::ifstream probe(utf8_to_ansi(path).c_str(), std::ios::binary);
+#           else
+            std::ifstream probe(path.c_str(), std::ios::binary);
+#           endif
+            if (!probe) {
+                throw std::runtime_error("Failed to open compressed log: " + path);
+            }
+            m_has_table = table_size > 0;
+            uint64_t offset = 0;
+            for (const auto& entry : entries) {
+                Frame frame;
+                frame.first_ts_ms = entry.first_ts_ms;
+                frame.offset = offset;
+                frame.compressed_size = entry.compressed_size;
+                frame.decompressed_size = entry.decompressed_size;
+                m_frames.push_back(frame);
+                offset += entry.compressed_size;
+            }
+            if (!m_has_table && file_size > 0) {
+                Frame frame;
+                frame.first_ts_ms = (std::numeric_limits<int64_t>::min)();
+                frame.compressed_size = file_size;
+                m_frames.push_back(frame);
+            }
+        }
+
+        /// \brief Returns true if the file ends with a seek table.
+        bool has_seek_table() const { return m_has_table; }
+
+        /// \brief Returns the frames of the file in file order.
+        const std::vector<Frame>& frames() const { return m_frames; }
+
+        /// \brief Checks whether a frame may hold records of a time range.
+        /// \param index Frame index.
+        /// \param from_ms Start of the range (inclusive).
+        /// \param to_ms End of the range (inclusive).
+        bool frame_overlaps(size_t index, int64_t from_ms, int64_t to_ms) const {
+            if (m_frames[index].first_ts_ms > to_ms) return false;
+            return index + 1 == m_frames.size() || m_frames[index + 1].first_ts_ms >= from_ms;
+        }
+
+        /// \brief Decompresses the frames overlapping a time range.
+        /// \tparam Callback Callable accepting `(const char* data, size_t size)`.
+        /// \param from_ms Start of the range in milliseconds (inclusive).
+        /// \param to_ms End of the range in milliseconds (inclusive).
+        /// \param callback Receives the decompressed data in file order.
+        /// \return Number of decompressed bytes.
+        /// \throws std::runtime_error if zstd support is disabled or the file cannot be read.
+        template <typename Callback>
+        uint64_t read_range(int64_t from_ms, int64_t to_ms, Callback callback) const {
+#           if defined(LOGIT_HAS_ZSTD)
+#           if defined(_WIN32)
+            std::ifstream file(utf8_to_ansi(m_path).c_str(), std::ios::binary);
+#           else
+            std::ifstream file(m_path.c_str(), std::ios::binary);
+#           endif
+            if (!file) {
+                throw std::runtime_error("Failed to open compressed log: " + m_path);
+            }
+            std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+            if (!dctx) throw std::runtime_error("Failed to create zstd decoder");
+            if (m_dictionary && !m_dictionary->attach(dctx.get())) {
+                throw std::runtime_error("Failed to attach zstd dictionary");
+            }
+            std::vector<char> in_buf(ZSTD_DStreamInSize());
+            std::vector<char> out_buf(ZSTD_DStreamOutSize());
+            uint64_t total = 0;
+            for (size_t i = 0; i < m_frames.size(); ++i) {
+                if (!frame_overlaps(i, from_ms, to_ms)) continue;
+                // Every frame starts a new session so a torn frame cannot spoil the next one.
+                ZSTD_DCtx_reset(dctx.get(), ZSTD_reset_session_only);
+                file.clear();
+                file.seekg(static_cast<std::streamoff>(m_frames[i].offset));
+                uint64_t left = m_frames[i].compressed_size;
+                bool ok = true;
+                while (ok && left > 0) {
+                    const size_t chunk = left < in_buf.size() ? static_cast<size_t>(left) : in_buf.size();
+                    if (!file.read(&in_buf[0], static_cast<std::streamsize>(chunk))) break;
+                    left -= chunk;
+                    ZSTD_inBuffer in = { &in_buf[0], chunk, 0 };
+                    for (;;) {
+                        ZSTD_outBuffer out = { &out_buf[0], out_buf.size(), 0 };
+                        const size_t res = ZSTD_decompressStream(dctx.get(), &out, &in);
+                        if (ZSTD_isError(res)) {
+                            ok = false;
+                            break;
+                        }
+                        if (out.pos > 0) {
+                            callback(static_cast<const char*>(&out_buf[0]), out.pos);
+                            total += out.pos;
+                        }
+                        if (in.pos == in.size && out.pos < out.size) break;
+                    }
+                }
+            }
+            return total;
+#           else
+            (void)from_ms; (void)to_ms; (void)callback;
+            throw std::runtime_error("SeekableZstdReader requires LOGIT_HAS_ZSTD");
+#           endif
+        }
+
+        /// \brief Decompresses the frames overlapping a time range into a string.
+        std::string read_range(int64_t from_ms, int64_t to_ms) const {
+            std::string out;
+            read_range(from_ms, to_ms, [&out](const char* data, size_t size) { out.append(data, size); });
+            return out;
+        }
+
+        /// \brief Decompresses the whole file.
+        std::string read_all() const {
+            return read_range((std::numeric_limits<int64_t>::min)(), (std::numeric_limits<int64_t>::max)());
+        }
+
+    private:
+        std::string m_path;          ///< Path of the file.
+        std::shared_ptr<const ZstdDictionary> m_dictionary; ///< Dictionary of the file, if any.
+        std::vector<Frame> m_frames; ///< Frames in file order.
+        bool m_has_table = false;    ///< The file ends with a seek table.
+    }; // class SeekableZstdReader
+
+}; // namespace logit
+
+#endif // _LOGIT_SEEKABLE_ZSTD_READER_HPP_INCLUDED
@@ -0,0 +1,203 @@
+#pragma once
+#ifndef _LOGIT_UNIQUE_PACK_READER_HPP_INCLUDED
+#define _LOGIT_UNIQUE_PACK_READER_HPP_INCLUDED
+
+/// \file UniquePackReader.hpp
+/// \brief Extracts messages from the segments written by `UniqueFileLogger` in pack mode.
+
+#include "../detail/UniquePack.hpp"
+#include "../detail/ZstdDictionary.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(LOGIT_HAS_ZLIB)
+#   include <zlib.h>
+#endif
+#if defined(LOGIT_HAS_ZSTD)
+#   include <zstd.h>
+#endif
+
+namespace logit {
+
+    /// \class UniquePackReader
+    /// \brief Reads single messages of a segment by id.
+    ///
+    /// `UniqueFileLogger` with `Config::pack` reports `LastFilePath` as a reference
+    /// `<segment path>#<id>`; `read_reference()` resolves it in one call. The index is
+    /// loaded once, so extracting many messages of a segment costs one seek each.
+    /// Compressed payloads are decompressed with the dictionary the logger used, if any.
+    class UniquePackReader {
+    public:
+        /// \brief Loads the index of a segment.
+        /// \param path Path of the segment (UTF-8).
+        /// \param dictionary Dictionary the zstd payloads were compressed with (optional).
+        /// \throws std::runtime_error if the segment or its index cannot be read.
+        explicit UniquePackReader(const std::string& path, std::shared_ptr<const ZstdDictionary> dictionary = nullptr)
+            : m_path(path), m_dictionary(std::move(dictionary)) {
+            open_input(m_file);
+            if (!detail::read_unique_pack_index(detail::unique_pack_index_path(path), m_compress, m_entries)) {
+                throw std::runtime_error("Failed to read segment index: " + path);
+            }
+            // Entries beyond the segment belong to payloads lost in a crash.
+            m_file.seekg(0, std::ios::end);
+            const uint64_t size = static_cast<uint64_t>(m_file.tellg());
+            while (!m_entries.empty() && m_entries.back().offset + m_entries.back().length > size) {
+                m_entries.pop_back();
+            }
+        }
+
+        /// \brief Returns the path of the segment.
+        const std::string& path() const { return m_path; }
+
+        /// \brief Returns the compression of the payloads.
+        CompressType compress() const { return m_compress; }
+
+        /// \brief Returns the index entries in id order.
+        const std::vector<UniquePackEntry>& entries() const { return m_entries; }
+
+        /// \brief Finds the entry of a message.
+        /// \return False if the segment has no message with this id.
+        bool find(uint64_t id, UniquePackEntry& entry) const {
+            auto it = std::lower_bound(m_entries.begin(), m_entries.end(), id,
+                [](const UniquePackEntry& e, uint64_t value) { return e.id < value; });
+            if (it == m_entries.end() || it->id != id) return false;
+            entry = *it;
+            return true;
+        }
+
+        /// \brief Returns a message.
+        /// \throws std::out_of_range if the id is unknown.
+        /// \throws std::runtime_error if the payload cannot be read or decompressed.
+        std::string read(uint64_t id) {
+            UniquePackEntry entry;
+            if (!find(id, entry)) {
+                throw std::out_of_range("No message " + std::to_string(id) + " in segment: " + m_path);
+            }
+            return read(entry);
+        }
+
+        /// \brief Returns the message of an entry.
+        /// \throws std::runtime_error if the payload cannot be read or decompressed.
+        std::string read(const UniquePackEntry& entry) {
+            std::string stored(static_cast<size_t>(entry.length), '\0');
+            m_file.clear();
+            m_file.seekg(static_cast<std::streamoff>(entry.offset));
+            if (entry.length > 0 && !m_file.read(&stored[0], static_cast<std::streamsize>(stored.size()))) {
+                throw std::runtime_error("Truncated segment: " + m_path);
+            }
+            if (m_compress == CompressType::GZIP) return inflate_gzip(stored);
+            if (m_compress == CompressType::ZSTD) return decompress_zstd(stored);
+            return stored;
+        }
+
+        /// \brief Splits a reference `<segment path>#<id>` as reported by `LastFilePath`.
+        /// \return False if the text is not a reference.
+        static bool parse_reference(const std::string& reference, std::string& path, uint64_t& id) {
+            const size_t hash = reference.find_last_of('#');
+            if (hash == std::string::npos || hash == 0 || hash + 1 == reference.size()) return false;
+            char* end = nullptr;
+            const unsigned long long value = std::strtoull(reference.c_str() + hash + 1, &end, 10);
+            if (!end || *end != '\0' || reference[hash + 1] == '-') return false;
+            path = reference.substr(0, hash);
+            id = static_cast<uint64_t>(value);
+            return true;
+        }
+
+        /// \brief Returns the message a reference `<segment path>#<id>` points to.
+        /// \throws std::invalid_argument if the text is not a reference.
+        /// \throws std::runtime_error or std::out_of_range if the message cannot be read.
+        static std::string read_reference(const std::string& reference,
+                                          std::shared_ptr<const ZstdDictionary> dictionary = nullptr) {
+            std::string path;
+            uint64_t id = 0;
+            if (!parse_reference(reference, path, id)) {
+                throw std::invalid_argument("Not a segment reference: " + reference);
+            }
+            UniquePackReader reader(path, std::move(dictionary));
+            return reader.read(id);
+        }
+
+    private:
+        std::string m_path;                          ///< Path of the segment.
+        std::shared_ptr<const ZstdDictionary> m_dictionary; ///< Dictionary of zstd payloads, if any.
+        std::vector<UniquePackEntry> m_entries;      ///< Entries of the index.
+        CompressType m_compress = CompressType::NONE; ///< Compression of the payloads.
+        std::ifstream m_file;                        ///< Open segment.
+
+        void open_input(std::ifstream& file) const {
+#           if defined(_WIN32)
+            file.open(utf8_to_ansi(m_path).c_str(), std::ios::binary);
+#           else
+            file.open(m_path.c_str(), std::ios::binary);
+#           endif
+            if (!file) {
+                throw std::runtime_error("Failed to open segment: " + m_path);
+            }
+        }
+
+        std::string inflate_gzip(const std::string& stored) const {
+#           if defined(LOGIT_HAS_ZLIB)
+            std::string out;
+            if (stored.empty()) return out;
+            z_stream zs = z_stream();
+            // 32 added to the window bits detects the gzip header.
+            if (inflateInit2(&zs, 15 + 32) != Z_OK) throw std::runtime_error("Failed to create gzip decoder");
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(stored.data()));
+            zs.avail_in = static_cast<uInt>(stored.size());
+            char buffer[16 * 1024];
+            int res = Z_OK;
+            while (res == Z_OK) {
+                zs.next_out = reinterpret_cast<Bytef*>(buffer);
+                zs.avail_out = sizeof(buffer);
+                res = inflate(&zs, Z_NO_FLUSH);
+                out.append(buffer, sizeof(buffer) - zs.avail_out);
+            }
+            inflateEnd(&zs);
+            if (res != Z_STREAM_END) throw std::runtime_error("Corrupt gzip message in segment: " + m_path);
+            return out;
+#           else
+            (void)stored;
+            throw std::runtime_error("Reading gzip segments requires LOGIT_HAS_ZLIB");
+#           endif
+        }
+
+        std::string decompress_zstd(const std::string& stored) const {
+#           if defined(LOGIT_HAS_ZSTD)
+            std::string out;
+            if (stored.empty()) return out;
+            std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+            if (!dctx) throw std::runtime_error("Failed to create zstd decoder");
+            if (m_dictionary && !m_dictionary->attach(dctx.get())) {
+                throw std::runtime_error("Failed to attach zstd dictionary");
+            }
+            std::vector<char> buffer(ZSTD_DStreamOutSize());
+            ZSTD_inBuffer in = { stored.data(), stored.size(), 0 };
+            size_t res = 1;
+            while (res != 0) {
+                ZSTD_outBuffer output = { &buffer[0], buffer.size(), 0 };
+                res = ZSTD_decompressStream(dctx.get(), &output, &in);
+                if (ZSTD_isError(res)) {
+                    throw std::runtime_error("Corrupt zstd message in segment " + m_path + ": " + ZSTD_getErrorName(res));
+                }
+                out.append(&buffer[0], output.pos);
+                if (res != 0 && in.pos == in.size && output.pos < output.size) {
+                    throw std::runtime_error("Truncated zstd message in segment: " + m_path);
+                }
+            }
+            return out;
+#           else
+            (void)stored;
+            throw std::runtime_error("Reading zstd segments requires LOGIT_HAS_ZSTD");
+#           endif
+        }
+    }; // class UniquePackReader
+
+}; // namespace logit
+
+#endif // _LOGIT_UNIQUE_PACK_READER_HPP_INCLUDED
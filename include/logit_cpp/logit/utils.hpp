@@ -13,7 +13,14 @@
 #include "config.hpp"
 #include "enums.hpp"
 #include "utils/format.hpp"
+#include "utils/number_utils.hpp"
+#include "utils/json_utils.hpp"
+#include "utils/thread_utils.hpp"
+#include "utils/binary_codec.hpp"
+#include "utils/crc32c.hpp"
+#include "utils/ArgumentName.hpp"
 #include "utils/VariableValue.hpp"
+#include "utils/ArgsArray.hpp"
 #include "utils/argument_utils.hpp"
 #include "utils/encoding_utils.hpp"
 #include "utils/path_utils.hpp"
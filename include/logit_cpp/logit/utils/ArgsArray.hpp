@@ -0,0 +1,183 @@
+#pragma once
+#ifndef _LOGIT_ARGS_ARRAY_HPP_INCLUDED
+#define _LOGIT_ARGS_ARRAY_HPP_INCLUDED
+
+/// \file ArgsArray.hpp
+/// \brief Argument container of a log record with inline storage.
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace logit {
+
+    /// \class ArgsArray
+    /// \brief Vector-like array of `VariableValue` that keeps the first arguments inline.
+    ///
+    /// Up to `LOGIT_ARGS_INLINE_CAPACITY` values live inside the object itself, so a typical
+    /// log call fills its record without touching the heap. Larger argument lists move to a
+    /// heap buffer that grows like `std::vector`.
+    class ArgsArray {
+    public:
+        using value_type = VariableValue;
+        using iterator = VariableValue*;
+        using const_iterator = const VariableValue*;
+
+        /// \brief Number of values stored without a heap allocation.
+        static const size_t inline_capacity = LOGIT_ARGS_INLINE_CAPACITY;
+
+        /// \brief Constructs an empty array.
+        ArgsArray() : m_data(inline_data()), m_size(0), m_capacity(inline_capacity) {}
+
+        /// \brief Copy constructor.
+        ArgsArray(const ArgsArray& other) : ArgsArray() {
+            reserve(other.m_size);
+            for (size_t i = 0; i < other.m_size; ++i) {
+                new (m_data + i) VariableValue(other.m_data[i]);
+            }
+            m_size = other.m_size;
+        }
+
+        /// \brief Copies the values of a vector, e.g. the result of `args_to_array()`.
+        ArgsArray(const std::vector<VariableValue>& values) : ArgsArray() {
+            reserve(values.size());
+            for (size_t i = 0; i < values.size(); ++i) emplace_back(values[i]);
+        }
+
+        /// \brief Move constructor; takes over a heap buffer.
+        ArgsArray(ArgsArray&& other) noexcept : ArgsArray() {
+            take(other);
+        }
+
+        /// \brief Copy assignment operator.
+        ArgsArray& operator=(const ArgsArray& other) {
+            if (this != &other) {
+                clear();
+                reserve(other.m_size);
+                for (size_t i = 0; i < other.m_size; ++i) {
+                    new (m_data + i) VariableValue(other.m_data[i]);
+                }
+                m_size = other.m_size;
+            }
+            return *this;
+        }
+
+        /// \brief Move assignment operator.
+        ArgsArray& operator=(ArgsArray&& other) noexcept {
+            if (this != &other) {
+                clear();
+                free_heap();
+                take(other);
+            }
+            return *this;
+        }
+
+        /// \brief Destructor.
+        ~ArgsArray() {
+            clear();
+            free_heap();
+        }
+
+        size_t size() const { return m_size; }              ///< Number of values.
+        bool empty() const { return m_size == 0; }          ///< True if there are no values.
+        size_t capacity() const { return m_capacity; }      ///< Values that fit without reallocating.
+
+        VariableValue* data() { return m_data; }                    ///< Pointer to the first value.
+        const VariableValue* data() const { return m_data; }        ///< Pointer to the first value.
+        iterator begin() { return m_data; }                         ///< Iterator to the first value.
+        iterator end() { return m_data + m_size; }                  ///< Iterator past the last value.
+        const_iterator begin() const { return m_data; }             ///< Iterator to the first value.
+        const_iterator end() const { return m_data + m_size; }      ///< Iterator past the last value.
+
+        VariableValue& operator[](size_t index) { return m_data[index]; }             ///< Value at `index`.
+        const VariableValue& operator[](size_t index) const { return m_data[index]; } ///< Value at `index`.
+        VariableValue& front() { return m_data[0]; }                                  ///< First value.
+        const VariableValue& front() const { return m_data[0]; }                      ///< First value.
+        VariableValue& back() { return m_data[m_size - 1]; }                          ///< Last value.
+        const VariableValue& back() const { return m_data[m_size - 1]; }              ///< Last value.
+
+        /// \brief Ensures room for at least `capacity` values.
+        void reserve(size_t capacity) {
+            if (capacity <= m_capacity) return;
+            VariableValue* data = static_cast<VariableValue*>(::operator new(capacity * sizeof(VariableValue)));
+            for (size_t i = 0; i < m_size; ++i) {
+                new (data + i) VariableValue(std::move(m_data[i]));
+                m_data[i].~VariableValue();
+            }
+            free_heap();
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        /// \brief Constructs a value in place at the end.
+        template <typename... Args>
+        VariableValue& emplace_back(Args&&... args) {
+            if (m_size == m_capacity) {
+                // The arguments may refer to a value of this array.
+                VariableValue value(std::forward<Args>(args)...);
+                reserve(m_capacity * 2);
+                new (m_data + m_size) VariableValue(std::move(value));
+            } else {
+                new (m_data + m_size) VariableValue(std::forward<Args>(args)...);
+            }
+            return m_data[m_size++];
+        }
+
+        void push_back(const VariableValue& value) { emplace_back(value); }        ///< Appends a copy.
+        void push_back(VariableValue&& value) { emplace_back(std::move(value)); }  ///< Appends a value.
+
+        /// \brief Removes the last value.
+        void pop_back() {
+            m_data[--m_size].~VariableValue();
+        }
+
+        /// \brief Removes all values; the storage is kept.
+        void clear() {
+            for (size_t i = 0; i < m_size; ++i) {
+                m_data[i].~VariableValue();
+            }
+            m_size = 0;
+        }
+
+    private:
+        typename std::aligned_storage<sizeof(VariableValue) * LOGIT_ARGS_INLINE_CAPACITY,
+                                      alignof(VariableValue)>::type m_inline; ///< Inline storage.
+        VariableValue* m_data;  ///< Inline storage or heap buffer.
+        size_t m_size;          ///< Number of values.
+        size_t m_capacity;      ///< Capacity of `m_data`.
+
+        VariableValue* inline_data() {
+            return reinterpret_cast<VariableValue*>(&m_inline);
+        }
+
+        /// \brief Releases a heap buffer and returns to inline storage.
+        void free_heap() {
+            if (m_data != inline_data()) ::operator delete(m_data);
+            m_data = inline_data();
+            m_capacity = inline_capacity;
+        }
+
+        /// \brief Moves the values of an array into this empty array.
+        void take(ArgsArray& other) {
+            if (other.m_data != other.inline_data()) {
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_data = other.inline_data();
+                other.m_size = 0;
+                other.m_capacity = inline_capacity;
+                return;
+            }
+            for (size_t i = 0; i < other.m_size; ++i) {
+                new (m_data + i) VariableValue(std::move(other.m_data[i]));
+            }
+            m_size = other.m_size;
+            other.clear();
+        }
+    }; // class ArgsArray
+
+}; // namespace logit
+
+#endif // _LOGIT_ARGS_ARRAY_HPP_INCLUDED
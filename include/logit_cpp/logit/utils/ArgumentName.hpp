@@ -0,0 +1,103 @@
+#pragma once
+#ifndef _LOGIT_ARGUMENT_NAME_HPP_INCLUDED
+#define _LOGIT_ARGUMENT_NAME_HPP_INCLUDED
+
+/// \file ArgumentName.hpp
+/// \brief Pointer-sized handle to an interned argument name.
+
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace logit {
+
+    /// \class ArgumentName
+    /// \brief Refers to an argument name stored once per process.
+    ///
+    /// Argument names come from the source text of the logging call, so the set of distinct
+    /// names is small and fixed. Each name is interned on first use and never released,
+    /// which lets values carry a single pointer instead of their own string copy. The
+    /// handle converts to `const std::string&` and compares with strings, so code written
+    /// for a `std::string` name keeps compiling.
+    class ArgumentName {
+    public:
+        /// \brief Constructs an empty name.
+        ArgumentName() : m_name(&empty_name()) {}
+
+        /// \brief Constructs a handle to the interned copy of a name.
+        /// \param name Argument name.
+        ArgumentName(const std::string& name) : m_name(intern(name)) {}
+
+        /// \brief Constructs a handle to the interned copy of a name.
+        /// \param name Null-terminated argument name.
+        ArgumentName(const char* name) : m_name(intern(std::string(name ? name : ""))) {}
+
+        /// \brief Returns the name text.
+        const std::string& str() const { return *m_name; }
+
+        /// \brief Converts to the name text.
+        operator const std::string&() const { return *m_name; }
+
+        const char* c_str() const { return m_name->c_str(); } ///< Null-terminated name.
+        const char* data() const { return m_name->data(); }   ///< Pointer to the name characters.
+        size_t size() const { return m_name->size(); }        ///< Length of the name.
+        bool empty() const { return m_name->empty(); }        ///< True if the name is empty.
+
+        /// \brief Returns the character at `index`, or `'\0'` at `size()`.
+        char operator[](size_t index) const { return (*m_name)[index]; }
+
+        friend bool operator==(const ArgumentName& lhs, const ArgumentName& rhs) { return lhs.m_name == rhs.m_name; }
+        friend bool operator!=(const ArgumentName& lhs, const ArgumentName& rhs) { return lhs.m_name != rhs.m_name; }
+        friend bool operator==(const ArgumentName& lhs, const std::string& rhs) { return *lhs.m_name == rhs; }
+        friend bool operator!=(const ArgumentName& lhs, const std::string& rhs) { return *lhs.m_name != rhs; }
+        friend bool operator==(const ArgumentName& lhs, const char* rhs) { return *lhs.m_name == rhs; }
+        friend bool operator!=(const ArgumentName& lhs, const char* rhs) { return *lhs.m_name != rhs; }
+        friend bool operator==(const std::string& lhs, const ArgumentName& rhs) { return lhs == *rhs.m_name; }
+        friend bool operator!=(const std::string& lhs, const ArgumentName& rhs) { return lhs != *rhs.m_name; }
+        friend bool operator==(const char* lhs, const ArgumentName& rhs) { return lhs == *rhs.m_name; }
+        friend bool operator!=(const char* lhs, const ArgumentName& rhs) { return lhs != *rhs.m_name; }
+
+        /// \brief Writes the name to a stream.
+        friend std::ostream& operator<<(std::ostream& os, const ArgumentName& name) {
+            return os << *name.m_name;
+        }
+
+        /// \brief Returns the interned copy of a name.
+        ///
+        /// Each thread remembers the names it has already seen; the process-wide lock is
+        /// taken only the first time a thread meets a name.
+        /// \param name Argument name.
+        /// \return Pointer that stays valid for the lifetime of the process.
+        static const std::string* intern(const std::string& name) {
+            if (name.empty()) return &empty_name();
+            static thread_local std::unordered_map<std::string, const std::string*> seen;
+            auto it = seen.find(name);
+            if (it != seen.end()) return it->second;
+            // Intentionally leaked so names stay valid while loggers flush at exit.
+            static std::unordered_set<std::string>* names = new std::unordered_set<std::string>();
+            static std::mutex* mutex = new std::mutex();
+            const std::string* interned = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(*mutex);
+                interned = &*names->insert(name).first;
+            }
+            seen.emplace(name, interned);
+            return interned;
+        }
+
+    private:
+        const std::string* m_name; ///< Interned name text.
+
+        /// \brief Returns the shared empty name.
+        static const std::string& empty_name() {
+            static const std::string* name = new std::string();
+            return *name;
+        }
+    }; // class ArgumentName
+
+}; // namespace logit
+
+#endif // _LOGIT_ARGUMENT_NAME_HPP_INCLUDED
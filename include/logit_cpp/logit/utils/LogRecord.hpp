@@ -22,8 +22,9 @@ namespace logit {
         const std::string   function;       ///< Function name.
         const std::string   format;         ///< Format string for the message.
         const std::string   arg_names;      ///< Argument names for the log.
-        std::vector<VariableValue> args_array;  ///< Argument values for the log.
+        ArgsArray           args_array;     ///< Argument values for the log.
         std::thread::id     thread_id;      ///< ID of the logging thread.
+        std::string         thread_label;   ///< Thread text overriding `thread_id` when not empty (set by decoders).
         const int           logger_index;   ///< Logger index (-1 to log to all).
         const bool          print_mode;     ///< Flag to determine whether arguments are printed in a raw format without special symbols.
         const bool          fmt_mode;       ///< Flag indicating if fmt formatting should be used.
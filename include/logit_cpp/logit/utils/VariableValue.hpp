@@ -9,12 +9,14 @@
 #include <string>
 #include <iostream>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <exception>
 #include <iomanip> // std::put_time
 #include <chrono>
 #include <sstream>
 #include <memory>
+#include <system_error>
 #if __cplusplus >= 201703L
 #include <filesystem>
 #include <optional>
@@ -39,13 +41,17 @@ namespace logit {
 
     /// \struct VariableValue
     /// \brief Structure for storing values of various types, including enumerations.
+    ///
+    /// The value occupies 32 bytes on 64-bit targets: an interned name, the type tag and a
+    /// 16-byte payload that holds a POD value, an error code, a string of up to 15 bytes
+    /// inline or a pointer to a longer heap string.
     struct VariableValue {
-        std::string name;       ///< Variable name.
+        ArgumentName name;      ///< Variable name.
         bool is_literal;        ///< Flag indicating if the variable is a literal.
 
         /// \enum ValueType
         /// \brief Enumeration of possible value types for VariableValue.
-        enum class ValueType {
+        enum class ValueType : uint8_t {
             INT8_VAL,           ///< Value of type `int8_t` (signed 8-bit integer).
             UINT8_VAL,          ///< Value of type `uint8_t` (unsigned 8-bit integer).
             INT16_VAL,          ///< Value of type `int16_t` (signed 16-bit integer).
@@ -73,7 +79,15 @@ namespace logit {
             UNKNOWN_VAL         ///< Unknown or unsupported value type.
         } type;                 ///< Specifies the type of the stored value in the VariableValue structure.
 
-        union {
+    private:
+        static const uint8_t heap_string = 0xFF;    ///< `m_small_size` marker of a heap string.
+        static const size_t small_capacity = 15;    ///< Longest string stored inline.
+
+        uint8_t m_small_size = 0;                   ///< Inline string length or `heap_string`.
+
+    public:
+        /// \brief Storage of POD values.
+        union PodValue {
             int8_t     int8_value;
             uint8_t    uint8_value;
             int16_t    int16_value;
@@ -87,45 +101,60 @@ namespace logit {
             float      float_value;
             double     double_value;
             long double long_double_value;
-        } pod_value; ///< Union to store POD types.
+        };
 
-        std::string string_value;           ///< Variable to store string, exception messages, and enums.
-        std::error_code error_code_value;   ///< Variable to store std::error_code.
+        union {
+            PodValue pod_value;         ///< POD value.
+            struct {
+                char*  data;
+                size_t size;
+            } m_heap;                   ///< Null-terminated string longer than `small_capacity`.
+            char m_small[small_capacity + 1]; ///< Null-terminated inline string.
+            struct {
+                int value;
+                const std::error_category* category;
+            } m_error;                  ///< Error code; the message is produced on demand.
+        };
 
         // Constructors for each type.
         template <typename T>
-        VariableValue(const std::string& name, T value,
+        VariableValue(const ArgumentName& name, T value,
                       typename std::enable_if<std::is_same<T, bool>::value>::type* = nullptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::BOOL_VAL) {
             pod_value.bool_value = value;
         }
 
         template <typename T>
-        VariableValue(const std::string& name, T value,
+        VariableValue(const ArgumentName& name, T value,
                       typename std::enable_if<std::is_same<T, char>::value>::type* = nullptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::CHAR_VAL) {
             pod_value.char_value = value;
         }
 
-        explicit VariableValue(const std::string& name, const std::string& value)
-            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::STRING_VAL), string_value(value) {
+        explicit VariableValue(const ArgumentName& name, const std::string& value)
+            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::STRING_VAL) {
+            assign_string(value.data(), value.size());
         }
 
-        explicit VariableValue(const std::string& name, const char* value) :
+        explicit VariableValue(const ArgumentName& name, const char* value) :
             VariableValue(name, std::string(value)) {}
 
         template <typename T>
-        VariableValue(const std::string& name, const T& value,
+        VariableValue(const ArgumentName& name, const T& value,
                       typename std::enable_if<std::is_base_of<std::exception, T>::value>::type* = nullptr)
-            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::EXCEPTION_VAL), string_value(value.what()) {
+            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::EXCEPTION_VAL) {
+            const char* what = value.what();
+            assign_string(what, std::strlen(what));
         }
 
-        explicit VariableValue(const std::string& name, const std::error_code& ec)
-            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::ERROR_CODE_VAL), error_code_value(ec) {
+        explicit VariableValue(const ArgumentName& name, const std::error_code& ec)
+            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::ERROR_CODE_VAL) {
+            m_error.value = ec.value();
+            m_error.category = &ec.category();
         }
 
         template <typename T>
-        VariableValue(const std::string& name, T value,
+        VariableValue(const ArgumentName& name, T value,
             typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::UNKNOWN_VAL) {
             if (std::is_same<T, float>::value) {
@@ -146,9 +175,10 @@ namespace logit {
 #endif
 
         template <typename T>
-        VariableValue(const std::string& name, T value,
+        VariableValue(const ArgumentName& name, T value,
             typename std::enable_if<
-                std::is_integral<T>::value && !std::is_same<T, bool>::value
+                std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                !std::is_same<T, char>::value
             >::type* = nullptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::UNKNOWN_VAL) {
             
@@ -192,35 +222,37 @@ namespace logit {
         /// \param name The variable name.
         /// \param value The enumeration value.
         template <typename EnumType>
-        VariableValue(const std::string& name, EnumType value,
+        VariableValue(const ArgumentName& name, EnumType value,
             typename std::enable_if<std::is_enum<EnumType>::value>::type* = 0)
             : name(name), is_literal(is_valid_literal_name(name)),
-              type(ValueType::ENUM_VAL), string_value(enum_to_string(value)) {
+              type(ValueType::ENUM_VAL) {
+            assign_string(enum_to_string(value));
         }
 
         template <typename Rep, typename Period>
-        VariableValue(const std::string& name, const std::chrono::duration<Rep, Period>& duration)
+        VariableValue(const ArgumentName& name, const std::chrono::duration<Rep, Period>& duration)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::DURATION_VAL) {
-            string_value = std::to_string(duration.count()) + " " + duration_units<Period>();
+            assign_string(std::to_string(duration.count()) + " " + duration_units<Period>());
         }
 
         template <typename Clock, typename Duration>
-        VariableValue(const std::string& name, const std::chrono::time_point<Clock, Duration>& time_point)
+        VariableValue(const ArgumentName& name, const std::chrono::time_point<Clock, Duration>& time_point)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::TIME_POINT_VAL) {
             auto ts_ms = std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch());
-            string_value = time_shield::to_human_readable_ms(ts_ms.count());
+            assign_string(time_shield::to_human_readable_ms(ts_ms.count()));
         }
 
 #       if __cplusplus >= 201703L
 
-        explicit VariableValue(const std::string& name, const std::filesystem::path& path)
-            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::PATH_VAL), string_value(path.string()) {
+        explicit VariableValue(const ArgumentName& name, const std::filesystem::path& path)
+            : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::PATH_VAL) {
+            assign_string(path.string());
         }
 
         template <typename... Ts>
-        explicit VariableValue(const std::string& name, const std::variant<Ts...>& variant)
+        explicit VariableValue(const ArgumentName& name, const std::variant<Ts...>& variant)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::VARIANT_VAL) {
-            string_value = std::visit([](const auto& value) -> std::string {
+            assign_string(std::visit([](const auto& value) -> std::string {
                 if constexpr (std::is_arithmetic_v<decltype(value)>) {
                     return std::to_string(value);
                 } else if constexpr (std::is_same_v<decltype(value), std::string>) {
@@ -230,101 +262,144 @@ namespace logit {
                     oss << value;
                     return oss.str();
                 }
-            }, variant);
+            }, variant));
         }
 
         template <typename T>
-        explicit VariableValue(const std::string& name, const std::optional<T>& optional)
+        explicit VariableValue(const ArgumentName& name, const std::optional<T>& optional)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::OPTIONAL_VAL) {
             if (optional) {
                 if constexpr (std::is_arithmetic_v<T>) {
-                    string_value = std::to_string(*optional);
+                    assign_string(std::to_string(*optional));
                 } else if constexpr (std::is_same_v<T, std::string>) {
-                    string_value = *optional;
+                    assign_string(*optional);
                 } else {
                     std::ostringstream oss;
                     oss << *optional;
-                    string_value = oss.str();
+                    assign_string(oss.str());
                 }
             } else {
-                string_value = "nullopt";
+                assign_string("nullopt", 7);
             }
         }
 
 #       endif
 
-        explicit VariableValue(const std::string& name, void* ptr)
+        explicit VariableValue(const ArgumentName& name, void* ptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::POINTER_VAL) {
             std::ostringstream oss;
             oss << ptr;
-            string_value = oss.str();
+            assign_string(oss.str());
         }
 
         template <typename T>
-        explicit VariableValue(const std::string& name, const std::shared_ptr<T>& ptr)
+        explicit VariableValue(const ArgumentName& name, const std::shared_ptr<T>& ptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::SMART_POINTER_VAL) {
             std::ostringstream oss;
             if (ptr) oss << "shared_ptr@" << ptr.get();
             else oss << "nullptr";
-            string_value = oss.str();
+            assign_string(oss.str());
         }
 
         template <typename T>
-        explicit VariableValue(const std::string& name, const std::unique_ptr<T>& ptr)
+        explicit VariableValue(const ArgumentName& name, const std::unique_ptr<T>& ptr)
             : name(name), is_literal(is_valid_literal_name(name)), type(ValueType::SMART_POINTER_VAL) {
             std::ostringstream oss;
             if (ptr) oss << "unique_ptr@" << ptr.get();
             else oss << "nullptr";
-            string_value = oss.str();
+            assign_string(oss.str());
         }
 
         /// \brief Copy constructor.
         VariableValue(const VariableValue& other)
+            : name(other.name), is_literal(other.is_literal), type(other.type) {
+            copy_payload(other);
+        }
+
+        /// \brief Move constructor; takes over a heap string.
+        VariableValue(VariableValue&& other) noexcept
             : name(other.name), is_literal(other.is_literal), type(other.type),
-              string_value(other.string_value),
-              error_code_value(other.error_code_value) {
-            if (is_pod_type(type)) {
-                pod_value = other.pod_value;
-            }
+              m_small_size(other.m_small_size) {
+            std::memcpy(m_small, other.m_small, sizeof(m_small));
+            other.m_small_size = 0;
         }
 
         /// \brief Assignment operator.
         VariableValue& operator=(const VariableValue& other) {
             if (this == &other) return *this; // Self-assignment check.
-
+            release();
             name = other.name;
             is_literal = other.is_literal;
             type = other.type;
-            string_value = other.string_value;
-            error_code_value = other.error_code_value;
-
-            if (is_pod_type(type)) {
-                pod_value = other.pod_value;
-            }
+            copy_payload(other);
+            return *this;
+        }
 
+        /// \brief Move assignment operator.
+        VariableValue& operator=(VariableValue&& other) noexcept {
+            if (this == &other) return *this;
+            release();
+            name = other.name;
+            is_literal = other.is_literal;
+            type = other.type;
+            m_small_size = other.m_small_size;
+            std::memcpy(m_small, other.m_small, sizeof(m_small));
+            other.m_small_size = 0;
             return *this;
         }
 
         /// \brief Destructor.
-        ~VariableValue() = default;
+        ~VariableValue() {
+            release();
+        }
+
+        /// \brief Returns the text of string-like values (strings, enums, paths, pointers...).
+        /// \return Null-terminated text, or an empty string for other types.
+        const char* string_data() const {
+            if (!is_string_type(type)) return "";
+            return m_small_size == heap_string ? m_heap.data : m_small;
+        }
+
+        /// \brief Returns the length of `string_data()`.
+        size_t string_size() const {
+            if (!is_string_type(type)) return 0;
+            return m_small_size == heap_string ? m_heap.size : m_small_size;
+        }
+
+        /// \brief Returns a copy of the text of string-like values.
+        std::string string_value() const {
+            return std::string(string_data(), string_size());
+        }
+
+        /// \brief Returns the stored error code.
+        std::error_code error_code_value() const {
+            if (type != ValueType::ERROR_CODE_VAL) return std::error_code();
+            return std::error_code(m_error.value, *m_error.category);
+        }
+
+        /// \brief Changes the kind of a string-like value, keeping its text.
+        /// \param string_type Target type; ignored unless both types hold text.
+        void set_string_type(ValueType string_type) {
+            if (is_string_type(type) && is_string_type(string_type)) type = string_type;
+        }
 
         /// \brief Method to get the value as a string.
+        ///
+        /// Floating-point values use the shortest representation that reads back to the
+        /// same value, e.g. `0.5` rather than `0.500000`.
         /// \return String representation of the value.
         std::string to_string() const {
+            std::string out;
+            append_to(out);
+            return out;
+        }
+
+        /// \brief Appends the string representation of the value to a buffer.
+        ///
+        /// Numeric values are converted without temporary allocations.
+        /// \param out Buffer receiving the text.
+        void append_to(std::string& out) const {
             switch (type) {
-                case ValueType::INT8_VAL:    return std::to_string(pod_value.int8_value);
-                case ValueType::UINT8_VAL:   return std::to_string(pod_value.uint8_value);
-                case ValueType::INT16_VAL:   return std::to_string(pod_value.int16_value);
-                case ValueType::UINT16_VAL:  return std::to_string(pod_value.uint16_value);
-                case ValueType::INT32_VAL:   return std::to_string(pod_value.int32_value);
-                case ValueType::UINT32_VAL:  return std::to_string(pod_value.uint32_value);
-                case ValueType::INT64_VAL:   return std::to_string(pod_value.int64_value);
-                case ValueType::UINT64_VAL:  return std::to_string(pod_value.uint64_value);
-                case ValueType::BOOL_VAL:    return pod_value.bool_value ? "true" : "false";
-                case ValueType::CHAR_VAL:    return std::string(1, pod_value.char_value);
-                case ValueType::FLOAT_VAL:   return std::to_string(pod_value.float_value);
-                case ValueType::DOUBLE_VAL:  return std::to_string(pod_value.double_value);
-                case ValueType::LONG_DOUBLE_VAL: return std::to_string(static_cast<double>(pod_value.long_double_value));
                 case ValueType::STRING_VAL:
                 case ValueType::EXCEPTION_VAL:
                 case ValueType::ENUM_VAL:
@@ -335,12 +410,45 @@ namespace logit {
                 case ValueType::SMART_POINTER_VAL:
                 case ValueType::VARIANT_VAL:
                 case ValueType::OPTIONAL_VAL:
-                    return string_value;
+                    out.append(string_data(), string_size());
+                    return;
                 case ValueType::ERROR_CODE_VAL:
-                    return error_code_value.message() + " (" + std::to_string(error_code_value.value()) + ")";
-                default: break;
+                    out += error_code_value().message();
+                    out += " (";
+                    detail::append_int(out, m_error.value);
+                    out.push_back(')');
+                    return;
+                default: {
+                    char buf[detail::number_buffer_size];
+                    const size_t size = write_pod(buf);
+                    out.append(buf, size);
+                    return;
+                }
             }
-            return "unknown";
+        }
+
+        /// \brief Writes the string representation of the value to a character buffer.
+        ///
+        /// Behaves like `snprintf` without the terminating null: at most `size` characters
+        /// are written and the full length of the text is returned.
+        /// \param buffer Destination buffer.
+        /// \param size Capacity of the destination buffer.
+        /// \return Length of the complete text.
+        size_t write_to(char* buffer, size_t size) const {
+            if (is_pod_type(type) || type == ValueType::UNKNOWN_VAL) {
+                char buf[detail::number_buffer_size];
+                const size_t length = write_pod(buf);
+                std::memcpy(buffer, buf, length < size ? length : size);
+                return length;
+            }
+            if (type == ValueType::ERROR_CODE_VAL) {
+                const std::string text = to_string();
+                std::memcpy(buffer, text.data(), text.size() < size ? text.size() : size);
+                return text.size();
+            }
+            const size_t length = string_size();
+            std::memcpy(buffer, string_data(), length < size ? length : size);
+            return length;
         }
 
         /// \brief Method to get the value as a formatted string.
@@ -371,9 +479,9 @@ namespace logit {
                 case ValueType::SMART_POINTER_VAL:
                 case ValueType::VARIANT_VAL:
                 case ValueType::OPTIONAL_VAL:
-                    return format(fmt, string_value.c_str());
+                    return format(fmt, string_data());
                 case ValueType::ERROR_CODE_VAL:
-                    return format(fmt, error_code_value.message().c_str(), error_code_value.value());
+                    return format(fmt, error_code_value().message().c_str(), m_error.value);
                 default: break;
             }
             return "unknown";
@@ -408,9 +516,9 @@ namespace logit {
                 case ValueType::SMART_POINTER_VAL:
                 case ValueType::VARIANT_VAL:
                 case ValueType::OPTIONAL_VAL:
-                    return fmt::format(fmt, string_value);
+                    return fmt::format(fmt, string_value());
                 case ValueType::ERROR_CODE_VAL:
-                    return fmt::format(fmt, error_code_value.message(), error_code_value.value());
+                    return fmt::format(fmt, error_code_value().message(), m_error.value);
                 default: break;
             }
             return "unknown";
@@ -418,6 +526,93 @@ namespace logit {
 #endif
 
     private:
+        /// \brief Stores a copy of a string payload.
+        void assign_string(const char* data, size_t size) {
+            if (size <= small_capacity) {
+                std::memcpy(m_small, data, size);
+                m_small[size] = '\0';
+                m_small_size = static_cast<uint8_t>(size);
+                return;
+            }
+            m_heap.data = new char[size + 1];
+            std::memcpy(m_heap.data, data, size);
+            m_heap.data[size] = '\0';
+            m_heap.size = size;
+            m_small_size = heap_string;
+        }
+
+        /// \brief Stores a copy of a string payload.
+        void assign_string(const std::string& value) {
+            assign_string(value.data(), value.size());
+        }
+
+        /// \brief Copies the payload of another value of the same type.
+        void copy_payload(const VariableValue& other) {
+            if (other.m_small_size == heap_string) {
+                assign_string(other.m_heap.data, other.m_heap.size);
+                return;
+            }
+            m_small_size = other.m_small_size;
+            std::memcpy(m_small, other.m_small, sizeof(m_small));
+        }
+
+        /// \brief Frees a heap string.
+        void release() {
+            if (m_small_size == heap_string) delete[] m_heap.data;
+            m_small_size = 0;
+        }
+
+        /// \brief Checks whether a type keeps its value as text.
+        static bool is_string_type(ValueType type) {
+            switch (type) {
+                case ValueType::STRING_VAL:
+                case ValueType::EXCEPTION_VAL:
+                case ValueType::ENUM_VAL:
+                case ValueType::PATH_VAL:
+                case ValueType::DURATION_VAL:
+                case ValueType::TIME_POINT_VAL:
+                case ValueType::POINTER_VAL:
+                case ValueType::SMART_POINTER_VAL:
+                case ValueType::VARIANT_VAL:
+                case ValueType::OPTIONAL_VAL:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /// \brief Writes POD values and `unknown` for other types.
+        /// \param buf Buffer of at least `detail::number_buffer_size` bytes.
+        /// \return Number of characters written.
+        size_t write_pod(char* buf) const {
+            char* last = buf;
+            switch (type) {
+                case ValueType::INT8_VAL:    last = detail::write_int(buf, pod_value.int8_value); break;
+                case ValueType::UINT8_VAL:   last = detail::write_uint(buf, pod_value.uint8_value); break;
+                case ValueType::INT16_VAL:   last = detail::write_int(buf, pod_value.int16_value); break;
+                case ValueType::UINT16_VAL:  last = detail::write_uint(buf, pod_value.uint16_value); break;
+                case ValueType::INT32_VAL:   last = detail::write_int(buf, pod_value.int32_value); break;
+                case ValueType::UINT32_VAL:  last = detail::write_uint(buf, pod_value.uint32_value); break;
+                case ValueType::INT64_VAL:   last = detail::write_int(buf, pod_value.int64_value); break;
+                case ValueType::UINT64_VAL:  last = detail::write_uint(buf, pod_value.uint64_value); break;
+                case ValueType::BOOL_VAL:
+                    std::memcpy(buf, pod_value.bool_value ? "true" : "false", pod_value.bool_value ? 4 : 5);
+                    last = buf + (pod_value.bool_value ? 4 : 5);
+                    break;
+                case ValueType::CHAR_VAL:    *last++ = pod_value.char_value; break;
+                case ValueType::FLOAT_VAL:   last = detail::write_float(buf, pod_value.float_value); break;
+                case ValueType::DOUBLE_VAL:  last = detail::write_double(buf, pod_value.double_value); break;
+                case ValueType::LONG_DOUBLE_VAL:
+                    last = detail::write_double(buf, static_cast<double>(pod_value.long_double_value));
+                    break;
+                default:
+                    std::memcpy(buf, "unknown", 7);
+                    last = buf + 7;
+                    break;
+            }
+            return static_cast<size_t>(last - buf);
+        }
+
         /// \brief Helper function to check if a name is a valid literal.
         /// \param name The name to check.
         /// \return True if valid, false otherwise.
@@ -473,6 +668,8 @@ namespace logit {
         }
     }; // VariableValue
 
+    static_assert(sizeof(void*) != 8 || sizeof(VariableValue) == 32, "VariableValue is expected to take 32 bytes");
+
 } // namespace logit
 
 #endif // _LOGIT_VARIABLE_VALUE_HPP_INCLUDED
@@ -5,37 +5,13 @@
 /// \file argument_utils.hpp
 /// \brief Functions for working with arguments and converting them to value arrays.
 
+#include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace logit {
 
-    /// \brief Base case of recursion for argument conversion — when there are no more arguments.
-    /// \param name_iter Iterator for the argument name list.
-    /// \return An empty vector, as there are no more arguments to process.
-    inline std::vector<VariableValue> args_to_array(std::vector<std::string>::const_iterator /*name_iter*/) {
-        return {};
-    }
-
-    /// \brief Recursive function to convert arguments into an array of tuples (name, value).
-    /// \tparam T Type of the first argument.
-    /// \tparam Ts Types of the remaining arguments.
-    /// \param name_iter Iterator for the argument name list.
-    /// \param first_arg The first argument.
-    /// \param args The remaining arguments.
-    /// \return A vector of tuples containing argument names and values.
-    template <typename T, typename... Ts>
-    std::vector<VariableValue> args_to_array(std::vector<std::string>::const_iterator name_iter, const T& first_arg, const Ts&... args) {
-        // Create a vector and add the first element (name, value)
-        std::vector<VariableValue> result;
-        result.push_back(VariableValue(*name_iter, first_arg));
-        name_iter++;
-        // Recursively add the remaining elements
-        auto tail_result = args_to_array(name_iter, args...);
-        result.insert(result.end(), tail_result.begin(), tail_result.end());
-        return result;
-    }
-
     using crev_it_t = std::string::const_reverse_iterator;
 
     /// \brief Checks if the '>' character is the closing of a template argument list.
@@ -143,6 +119,67 @@ namespace logit {
         return result;
     }
 
+    /// \brief Returns the interned names of a call site's arguments.
+    ///
+    /// Each thread splits a distinct `arg_names` string once and keeps the result, so
+    /// repeated calls neither allocate nor lock. The names themselves are interned
+    /// (`ArgumentName`) and outlive the thread.
+    /// \param arg_names Comma-separated argument names as written in the logging call.
+    /// \return Names that stay valid while the calling thread runs.
+    inline const std::vector<ArgumentName>& argument_names(const std::string& arg_names) {
+        static thread_local std::unordered_map<std::string, std::vector<ArgumentName>> cache;
+        auto it = cache.find(arg_names);
+        if (it != cache.end()) return it->second;
+        const std::vector<std::string> parts = split_arguments(arg_names);
+        return cache.emplace(arg_names, std::vector<ArgumentName>(parts.begin(), parts.end())).first->second;
+    }
+
+#ifdef _MSC_VER
+#   pragma warning(push)
+#   pragma warning(disable : 4127) // conditional expression is constant
+#endif
+
+    /// \brief Appends the arguments of a logging call to a record's argument array.
+    /// \tparam Ts Types of the arguments.
+    /// \param out Argument array to fill.
+    /// \param names Argument names; missing names are left empty.
+    /// \param args Argument values.
+    template <typename... Ts>
+    void fill_args_array(ArgsArray& out, const std::vector<ArgumentName>& names, const Ts&... args) {
+        out.reserve(out.size() + sizeof...(Ts));
+        size_t index = 0;
+#       if __cplusplus >= 201703L
+        ((out.emplace_back(index < names.size() ? names[index] : ArgumentName(), args), ++index), ...);
+#       else
+        const int expand[] = {0, ((out.emplace_back(index < names.size() ? names[index] : ArgumentName(), args), ++index), 0)...};
+        (void)expand;
+#       endif
+    }
+
+#ifdef _MSC_VER
+#   pragma warning(pop)
+#endif
+
+    /// \brief Converts arguments into values named after a list of names.
+    ///
+    /// Kept for code written against earlier versions; loggers fill
+    /// `LogRecord::args_array` in place with `fill_args_array()`.
+    /// \param name_iter Iterator to the name of the first argument.
+    /// \param args Argument values.
+    /// \return Values in argument order.
+    template <typename... Ts>
+    std::vector<VariableValue> args_to_array(std::vector<std::string>::const_iterator name_iter, const Ts&... args) {
+        std::vector<VariableValue> result;
+        result.reserve(sizeof...(Ts));
+#       if __cplusplus >= 201703L
+        (result.emplace_back(*name_iter++, args), ...);
+#       else
+        const int expand[] = {0, (result.emplace_back(*name_iter++, args), 0)...};
+        (void)expand;
+#       endif
+        return result;
+    }
+
 }; // namespace logit
 
 #endif // _LOGIT_ARGUMENT_UTILS_HPP_INCLUDED
@@ -0,0 +1,216 @@
+#pragma once
+#ifndef _LOGIT_BINARY_CODEC_HPP_INCLUDED
+#define _LOGIT_BINARY_CODEC_HPP_INCLUDED
+
+/// \file binary_codec.hpp
+/// \brief Low-level encoding primitives of the LogIt binary log format.
+///
+/// A binary log file starts with the 8-byte magic `LOGITBIN` followed by a varint format
+/// version. The rest of the file is a sequence of records:
+///
+/// \code
+/// [u8 kind][varint payload size][payload]
+/// \endcode
+///
+/// - `CallSite` payload: u64 site id, file, varint line, function, format, arg names, u8 flags.
+/// - `Thread` payload: varint thread index, thread ID text.
+/// - `Event` payload: u64 site id, varint timestamp, varint thread index, u8 level,
+///   varint argument count, then per argument a u8 `VariableValue::ValueType` and the value.
+///
+/// Strings are stored as a varint length followed by the bytes. Signed integers use zigzag
+/// varints, floating-point values are stored as little-endian IEEE-754 bit patterns.
+/// Call-site and thread definitions are written once per file, before the first event
+/// that references them.
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+namespace logit { namespace detail {
+
+    /// \brief Magic bytes at the start of every binary log file.
+    static const char kBinaryLogMagic[8] = { 'L', 'O', 'G', 'I', 'T', 'B', 'I', 'N' };
+
+    /// \brief Current binary log format version.
+    static const uint32_t kBinaryLogVersion = 1;
+
+    /// \enum BinaryRecordKind
+    /// \brief Kinds of records stored in a binary log.
+    enum class BinaryRecordKind : uint8_t {
+        CallSite = 1, ///< Static call-site description.
+        Thread   = 2, ///< Thread index to thread ID text mapping.
+        Event    = 3  ///< Single log event.
+    };
+
+    /// \brief Appends an unsigned LEB128 varint.
+    inline void put_varint(std::string& out, uint64_t value) {
+        char buf[10];
+        size_t n = 0;
+        while (value >= 0x80) {
+            buf[n++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        buf[n++] = static_cast<char>(value);
+        out.append(buf, n);
+    }
+
+    /// \brief Appends a signed integer as a zigzag varint.
+    inline void put_svarint(std::string& out, int64_t value) {
+        put_varint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    /// \brief Appends a fixed-width little-endian integer.
+    inline void put_fixed(std::string& out, uint64_t value, size_t bytes) {
+        char buf[8];
+        for (size_t i = 0; i < bytes; ++i) {
+            buf[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        out.append(buf, bytes);
+    }
+
+    /// \brief Appends a length-prefixed string.
+    inline void put_string(std::string& out, const char* data, size_t size) {
+        put_varint(out, size);
+        out.append(data, size);
+    }
+
+    /// \brief Appends a length-prefixed string.
+    inline void put_string(std::string& out, const std::string& value) {
+        put_string(out, value.data(), value.size());
+    }
+
+    /// \brief Reserves room for a record header and returns the payload start offset.
+    ///
+    /// The payload is appended right after the call; `end_record()` then writes the
+    /// payload size and closes the unused part of the reserved header.
+    inline size_t begin_record(std::string& out, BinaryRecordKind kind) {
+        out.push_back(static_cast<char>(kind));
+        out.append(5, '\0');
+        return out.size();
+    }
+
+    /// \brief Writes the payload size of a record started with `begin_record()`.
+    inline void end_record(std::string& out, size_t payload_start) {
+        const size_t payload_size = out.size() - payload_start;
+        char header[10];
+        size_t n = 0;
+        uint64_t size = static_cast<uint64_t>(payload_size);
+        while (size >= 0x80) {
+            header[n++] = static_cast<char>((size & 0x7F) | 0x80);
+            size >>= 7;
+        }
+        header[n++] = static_cast<char>(size);
+        const size_t header_pos = payload_start - 5;
+        if (n < 5) {
+            std::memmove(&out[header_pos + n], &out[payload_start], payload_size);
+            out.resize(out.size() - (5 - n));
+            std::memcpy(&out[header_pos], header, n);
+        } else {
+            out.replace(header_pos, 5, header, n);
+        }
+    }
+
+    /// \brief Computes the 64-bit FNV-1a hash of a byte range, continuing from `hash`.
+    inline uint64_t fnv1a64(const char* data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /// \class BinaryCursor
+    /// \brief Bounds-checked reader over an encoded byte range.
+    ///
+    /// All getters return false once the input is exhausted or malformed, which lets the
+    /// decoder stop cleanly at a torn record at the end of a file.
+    class BinaryCursor {
+    public:
+        BinaryCursor(const char* data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+        size_t position() const { return m_pos; }
+        size_t remaining() const { return m_size - m_pos; }
+        const char* current() const { return m_data + m_pos; }
+
+        bool skip(size_t n) {
+            if (remaining() < n) return false;
+            m_pos += n;
+            return true;
+        }
+
+        bool get_u8(uint8_t& value) {
+            if (remaining() < 1) return false;
+            value = static_cast<uint8_t>(m_data[m_pos++]);
+            return true;
+        }
+
+        bool get_varint(uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = 0;
+                if (!get_u8(byte)) return false;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+            return false;
+        }
+
+        bool get_svarint(int64_t& value) {
+            uint64_t raw = 0;
+            if (!get_varint(raw)) return false;
+            value = static_cast<int64_t>((raw >> 1) ^ (~(raw & 1) + 1));
+            return true;
+        }
+
+        bool get_fixed(uint64_t& value, size_t bytes) {
+            if (remaining() < bytes) return false;
+            value = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(m_data[m_pos + i])) << (8 * i);
+            }
+            m_pos += bytes;
+            return true;
+        }
+
+        bool get_string(std::string& value) {
+            uint64_t size = 0;
+            if (!get_varint(size) || remaining() < size) return false;
+            value.assign(m_data + m_pos, static_cast<size_t>(size));
+            m_pos += static_cast<size_t>(size);
+            return true;
+        }
+
+        /// \brief Reads a record header.
+        /// \param kind Receives the record kind.
+        /// \param payload Receives a pointer to the payload.
+        /// \param payload_size Receives the payload size.
+        /// \return False if the record is incomplete.
+        bool get_record(uint8_t& kind, const char*& payload, size_t& payload_size) {
+            const size_t start = m_pos;
+            uint64_t size = 0;
+            if (!get_u8(kind) || !get_varint(size) || remaining() < size) {
+                m_pos = start;
+                return false;
+            }
+            payload = m_data + m_pos;
+            payload_size = static_cast<size_t>(size);
+            m_pos += payload_size;
+            return true;
+        }
+
+    private:
+        const char* m_data;
+        size_t      m_size;
+        size_t      m_pos;
+    };
+
+    /// \brief Appends the file header of a binary log.
+    inline void put_binary_log_header(std::string& out) {
+        out.append(kBinaryLogMagic, sizeof(kBinaryLogMagic));
+        put_varint(out, kBinaryLogVersion);
+    }
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_BINARY_CODEC_HPP_INCLUDED
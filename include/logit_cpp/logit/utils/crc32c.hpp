@@ -0,0 +1,100 @@
+#pragma once
+#ifndef _LOGIT_CRC32C_HPP_INCLUDED
+#define _LOGIT_CRC32C_HPP_INCLUDED
+
+/// \file crc32c.hpp
+/// \brief CRC-32C (Castagnoli) checksum.
+///
+/// Uses the SSE4.2 `crc32` instruction or the ARMv8 CRC extension when the compiler
+/// targets them (e.g. `-msse4.2`, `-march=native`, `-march=armv8-a+crc`) and a
+/// table-driven implementation otherwise.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#   include <nmmintrin.h>
+#   define LOGIT_CRC32C_SSE42 1
+#elif defined(__ARM_FEATURE_CRC32)
+#   include <arm_acle.h>
+#   define LOGIT_CRC32C_ARM 1
+#endif
+
+namespace logit {
+
+    namespace detail {
+
+        /// \brief Returns the lookup table of the portable implementation.
+        inline const uint32_t* crc32c_table() {
+            struct Table {
+                uint32_t values[256];
+                Table() {
+                    for (uint32_t i = 0; i < 256; ++i) {
+                        uint32_t crc = i;
+                        for (int bit = 0; bit < 8; ++bit) {
+                            crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1U)));
+                        }
+                        values[i] = crc;
+                    }
+                }
+            };
+            static const Table table;
+            return table.values;
+        }
+
+    } // namespace detail
+
+    /// \brief Extends a CRC-32C over a byte range.
+    /// \param crc Checksum of the preceding data (0 for the first block).
+    /// \param data Bytes to add.
+    /// \param size Number of bytes.
+    /// \return Checksum of the preceding data followed by `data`.
+    inline uint32_t crc32c_extend(uint32_t crc, const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+#       if defined(LOGIT_CRC32C_SSE42) && (defined(__x86_64__) || defined(_M_X64))
+        uint64_t crc64 = crc;
+        for (; size >= 8; size -= 8, p += 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+        }
+        crc = static_cast<uint32_t>(crc64);
+        for (; size > 0; --size, ++p) crc = _mm_crc32_u8(crc, *p);
+#       elif defined(LOGIT_CRC32C_SSE42)
+        for (; size >= 4; size -= 4, p += 4) {
+            uint32_t word;
+            std::memcpy(&word, p, 4);
+            crc = _mm_crc32_u32(crc, word);
+        }
+        for (; size > 0; --size, ++p) crc = _mm_crc32_u8(crc, *p);
+#       elif defined(LOGIT_CRC32C_ARM) && (defined(__aarch64__) || defined(_M_ARM64))
+        for (; size >= 8; size -= 8, p += 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            crc = __crc32cd(crc, word);
+        }
+        for (; size > 0; --size, ++p) crc = __crc32cb(crc, *p);
+#       elif defined(LOGIT_CRC32C_ARM)
+        for (; size >= 4; size -= 4, p += 4) {
+            uint32_t word;
+            std::memcpy(&word, p, 4);
+            crc = __crc32cw(crc, word);
+        }
+        for (; size > 0; --size, ++p) crc = __crc32cb(crc, *p);
+#       else
+        const uint32_t* table = detail::crc32c_table();
+        for (; size > 0; --size, ++p) crc = table[(crc ^ *p) & 0xFFU] ^ (crc >> 8);
+#       endif
+        return ~crc;
+    }
+
+    /// \brief Computes the CRC-32C of a byte range.
+    inline uint32_t crc32c(const void* data, std::size_t size) {
+        return crc32c_extend(0, data, size);
+    }
+
+}; // namespace logit
+
+#endif // _LOGIT_CRC32C_HPP_INCLUDED
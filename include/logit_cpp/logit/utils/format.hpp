@@ -13,7 +13,8 @@ namespace logit {
 
     /// \brief Formats a string according to the specified format.
     ///
-    /// This function uses a `vsnprintf`-based implementation.
+    /// This function uses a `vsnprintf`-based implementation. The text is first rendered
+    /// into a stack buffer; the heap is used only for results that do not fit.
     ///
     /// \param fmt The format string (similar to printf format).
     /// \param ... A variable number of arguments matching the format string.
@@ -22,16 +23,25 @@ namespace logit {
     inline std::string format(const char *fmt, ...) {
         va_list args;
         va_start(args, fmt);
-        std::vector<char> buffer(1024);
+        char stack_buffer[256];
+        va_list args_copy;
+        va_copy(args_copy, args); // Copy args to prevent modifying the original list.
+        int res = vsnprintf(stack_buffer, sizeof(stack_buffer), fmt, args_copy);
+        va_end(args_copy); // Clean up the copied argument list.
+        if (res >= 0 && res < static_cast<int>(sizeof(stack_buffer))) {
+            va_end(args);
+            return std::string(stack_buffer, static_cast<size_t>(res));
+        }
+
+        std::vector<char> buffer(res < 0 ? sizeof(stack_buffer) * 2 : static_cast<size_t>(res) + 1);
         for (;;) {
-            va_list args_copy;
-            va_copy(args_copy, args); // Copy args to prevent modifying the original list.
-            int res = vsnprintf(buffer.data(), buffer.size(), fmt, args_copy);
-            va_end(args_copy); // Clean up the copied argument list.
+            va_copy(args_copy, args);
+            res = vsnprintf(buffer.data(), buffer.size(), fmt, args_copy);
+            va_end(args_copy);
 
             if ((res >= 0) && (res < static_cast<int>(buffer.size()))) {
                 va_end(args); // Clean up the original argument list.
-                return std::string(buffer.data()); // Return the formatted string.
+                return std::string(buffer.data(), static_cast<size_t>(res)); // Return the formatted string.
             }
 
             // If the buffer was too small, resize it.
@@ -0,0 +1,174 @@
+#pragma once
+#ifndef _LOGIT_JSON_UTILS_HPP_INCLUDED
+#define _LOGIT_JSON_UTILS_HPP_INCLUDED
+
+/// \file json_utils.hpp
+/// \brief Helpers for escaping strings embedded into JSON documents.
+///
+/// The escaper scans the input in 16 or 32 byte blocks (SSE2/AVX2) looking for quotes,
+/// backslashes and control characters. Clean blocks are copied in one go; only the rare
+/// special characters fall back to the scalar path.
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define LOGIT_JSON_ESCAPE_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define LOGIT_JSON_ESCAPE_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace logit {
+
+    namespace detail {
+
+        /// \brief Returns the index of the lowest set bit of a non-zero mask.
+        inline unsigned json_lowest_bit(uint32_t mask) {
+#           if defined(_MSC_VER)
+            unsigned long index = 0;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#           else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#           endif
+        }
+
+        /// \brief Checks whether a byte must be escaped inside a JSON string.
+        inline bool json_needs_escape(unsigned char c) {
+            return c < 0x20 || c == '"' || c == '\\';
+        }
+
+        /// \brief Appends the escaped form of a single special character.
+        inline void append_json_escape_char(std::string& out, unsigned char c) {
+            switch (c) {
+                case '"':  out.append("\\\"", 2); break;
+                case '\\': out.append("\\\\", 2); break;
+                case '\b': out.append("\\b", 2); break;
+                case '\f': out.append("\\f", 2); break;
+                case '\n': out.append("\\n", 2); break;
+                case '\r': out.append("\\r", 2); break;
+                case '\t': out.append("\\t", 2); break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    char buf[6] = { '\\', 'u', '0', '0', hex[(c >> 4) & 0xF], hex[c & 0xF] };
+                    out.append(buf, sizeof(buf));
+                    break;
+                }
+            }
+        }
+
+    } // namespace detail
+
+    /// \brief Appends a JSON-escaped copy of a character range to the output buffer.
+    ///
+    /// The surrounding quotes are not written. Bytes >= 0x80 are copied unchanged, so
+    /// valid UTF-8 input stays valid UTF-8.
+    /// \param out Destination buffer.
+    /// \param data Pointer to the characters to escape.
+    /// \param size Number of characters to escape.
+    inline void append_json_escaped(std::string& out, const char* data, std::size_t size) {
+        const char* const end = data + size;
+        const char* run = data; // start of the pending clean run
+        const char* p = data;
+#       if defined(LOGIT_JSON_ESCAPE_AVX2)
+        const __m256i quote32 = _mm256_set1_epi8('"');
+        const __m256i slash32 = _mm256_set1_epi8('\\');
+        const __m256i ctrl32  = _mm256_set1_epi8(0x1F);
+        while (end - p >= 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote32), _mm256_cmpeq_epi8(chunk, slash32)),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, ctrl32), ctrl32));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask == 0) {
+                p += 32;
+                continue;
+            }
+            while (mask != 0) {
+                const char* hit = p + detail::json_lowest_bit(mask);
+                out.append(run, static_cast<std::size_t>(hit - run));
+                detail::append_json_escape_char(out, static_cast<unsigned char>(*hit));
+                run = hit + 1;
+                mask &= mask - 1;
+            }
+            p += 32;
+        }
+#       endif
+#       if defined(LOGIT_JSON_ESCAPE_SSE2)
+        const __m128i quote16 = _mm_set1_epi8('"');
+        const __m128i slash16 = _mm_set1_epi8('\\');
+        const __m128i ctrl16  = _mm_set1_epi8(0x1F);
+        while (end - p >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, slash16)),
+                _mm_cmpeq_epi8(_mm_max_epu8(chunk, ctrl16), ctrl16));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+            if (mask == 0) {
+                p += 16;
+                continue;
+            }
+            while (mask != 0) {
+                const char* hit = p + detail::json_lowest_bit(mask);
+                out.append(run, static_cast<std::size_t>(hit - run));
+                detail::append_json_escape_char(out, static_cast<unsigned char>(*hit));
+                run = hit + 1;
+                mask &= mask - 1;
+            }
+            p += 16;
+        }
+#       endif
+        for (; p < end; ++p) {
+            const unsigned char c = static_cast<unsigned char>(*p);
+            if (!detail::json_needs_escape(c)) continue;
+            out.append(run, static_cast<std::size_t>(p - run));
+            detail::append_json_escape_char(out, c);
+            run = p + 1;
+        }
+        out.append(run, static_cast<std::size_t>(end - run));
+    }
+
+    /// \brief Appends a JSON-escaped copy of a string to the output buffer.
+    /// \param out Destination buffer.
+    /// \param input String to escape.
+    inline void append_json_escaped(std::string& out, const std::string& input) {
+        append_json_escaped(out, input.data(), input.size());
+    }
+
+    /// \brief Appends a quoted JSON string literal to the output buffer.
+    /// \param out Destination buffer.
+    /// \param data Pointer to the characters to escape.
+    /// \param size Number of characters to escape.
+    inline void append_json_string(std::string& out, const char* data, std::size_t size) {
+        out.push_back('"');
+        append_json_escaped(out, data, size);
+        out.push_back('"');
+    }
+
+    /// \brief Appends a quoted JSON string literal to the output buffer.
+    /// \param out Destination buffer.
+    /// \param input String to escape.
+    inline void append_json_string(std::string& out, const std::string& input) {
+        append_json_string(out, input.data(), input.size());
+    }
+
+    /// \brief Escapes special characters in a string for embedding into JSON.
+    /// \param input The input string that may contain special characters.
+    /// \return A properly escaped JSON string (without surrounding quotes).
+    inline std::string escape_json(const std::string& input) {
+        std::string out;
+        out.reserve(input.size() + 8);
+        append_json_escaped(out, input.data(), input.size());
+        return out;
+    }
+
+}; // namespace logit
+
+#endif // _LOGIT_JSON_UTILS_HPP_INCLUDED
@@ -0,0 +1,178 @@
+#pragma once
+#ifndef _LOGIT_NUMBER_UTILS_HPP_INCLUDED
+#define _LOGIT_NUMBER_UTILS_HPP_INCLUDED
+
+/// \file number_utils.hpp
+/// \brief Allocation-free conversion of numbers to decimal text.
+///
+/// Integers are written with a two-digits-per-step loop. Floating-point values use the
+/// shortest representation that parses back to the same value: `std::to_chars` when the
+/// standard library provides it for floating-point types, otherwise the `%.*g` rendering
+/// with the fewest significant digits that round-trips.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#   define LOGIT_HAS_FLOAT_TO_CHARS 1
+#else
+#   define LOGIT_HAS_FLOAT_TO_CHARS 0
+#endif
+
+namespace logit { namespace detail {
+
+    /// \brief Buffer size sufficient for any number written by the helpers below.
+    constexpr size_t number_buffer_size = 32;
+
+    /// \brief Writes an unsigned integer in decimal form.
+    /// \param first Start of a buffer of at least `number_buffer_size` bytes.
+    /// \return Pointer past the last written character.
+    inline char* write_uint(char* first, uint64_t value) {
+        static const char digits[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        char buf[20];
+        char* p = buf + sizeof(buf);
+        while (value >= 100) {
+            const unsigned idx = static_cast<unsigned>(value % 100) * 2;
+            value /= 100;
+            *--p = digits[idx + 1];
+            *--p = digits[idx];
+        }
+        if (value >= 10) {
+            const unsigned idx = static_cast<unsigned>(value) * 2;
+            *--p = digits[idx + 1];
+            *--p = digits[idx];
+        } else {
+            *--p = static_cast<char>('0' + value);
+        }
+        const size_t size = static_cast<size_t>(buf + sizeof(buf) - p);
+        std::memcpy(first, p, size);
+        return first + size;
+    }
+
+    /// \brief Writes a signed integer in decimal form.
+    /// \param first Start of a buffer of at least `number_buffer_size` bytes.
+    /// \return Pointer past the last written character.
+    inline char* write_int(char* first, int64_t value) {
+        if (value < 0) {
+            *first++ = '-';
+            return write_uint(first, static_cast<uint64_t>(0) - static_cast<uint64_t>(value));
+        }
+        return write_uint(first, static_cast<uint64_t>(value));
+    }
+
+    /// \brief Writes `nan`, `inf` or `-inf` for non-finite values.
+    /// \return Pointer past the last written character, or null for finite values.
+    inline char* write_non_finite(char* first, double value) {
+        if (std::isnan(value)) {
+            std::memcpy(first, "nan", 3);
+            return first + 3;
+        }
+        if (std::isinf(value)) {
+            if (value < 0) *first++ = '-';
+            std::memcpy(first, "inf", 3);
+            return first + 3;
+        }
+        return nullptr;
+    }
+
+#   if !LOGIT_HAS_FLOAT_TO_CHARS
+    /// \brief Parses text written by `snprintf` back into a `double`.
+    inline void parse_g(const char* text, double& value) { value = std::strtod(text, nullptr); }
+
+    /// \brief Parses text written by `snprintf` back into a `float`.
+    inline void parse_g(const char* text, float& value) { value = std::strtof(text, nullptr); }
+
+    /// \brief Writes a finite value with the fewest `%.*g` digits that parse back to it.
+    ///
+    /// More digits never stop a value from round-tripping, so the precision is found by
+    /// binary search. Candidates are parsed before the decimal separator is touched, so
+    /// `snprintf` and `strtod` agree on the locale; the separator is then replaced by `.`.
+    /// \param max_precision Digits that always round-trip (17 for `double`, 9 for `float`).
+    template<class T>
+    inline char* write_shortest_g(char* first, T value, int max_precision) {
+        int low = 1;
+        int high = max_precision;
+        while (low < high) {
+            const int precision = low + (high - low) / 2;
+            std::snprintf(first, number_buffer_size, "%.*g", precision, static_cast<double>(value));
+            T parsed = 0;
+            parse_g(first, parsed);
+            if (parsed == value) high = precision;
+            else low = precision + 1;
+        }
+        const int n = std::snprintf(first, number_buffer_size, "%.*g", low, static_cast<double>(value));
+        const char* end = first + (n > 0 ? n : 0);
+        char* last = first;
+        for (const char* p = first; p != end; ++p) {
+            const char c = *p;
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e') {
+                *last++ = c;
+            } else if (last == first || last[-1] != '.') {
+                *last++ = '.'; // a locale separator may take several bytes
+            }
+        }
+        return last;
+    }
+#   endif
+
+    /// \brief Writes a double using the shortest round-trip representation.
+    /// \param first Start of a buffer of at least `number_buffer_size` bytes.
+    /// \return Pointer past the last written character.
+    inline char* write_double(char* first, double value) {
+        if (char* last = write_non_finite(first, value)) return last;
+#       if LOGIT_HAS_FLOAT_TO_CHARS
+        return std::to_chars(first, first + number_buffer_size, value).ptr;
+#       else
+        return write_shortest_g(first, value, 17);
+#       endif
+    }
+
+    /// \brief Writes a float using the shortest round-trip representation.
+    /// \param first Start of a buffer of at least `number_buffer_size` bytes.
+    /// \return Pointer past the last written character.
+    inline char* write_float(char* first, float value) {
+        if (char* last = write_non_finite(first, value)) return last;
+#       if LOGIT_HAS_FLOAT_TO_CHARS
+        return std::to_chars(first, first + number_buffer_size, value).ptr;
+#       else
+        return write_shortest_g(first, value, 9);
+#       endif
+    }
+
+    /// \brief Appends an unsigned integer to a string.
+    inline void append_uint(std::string& out, uint64_t value) {
+        char buf[number_buffer_size];
+        out.append(buf, static_cast<size_t>(write_uint(buf, value) - buf));
+    }
+
+    /// \brief Appends a signed integer to a string.
+    inline void append_int(std::string& out, int64_t value) {
+        char buf[number_buffer_size];
+        out.append(buf, static_cast<size_t>(write_int(buf, value) - buf));
+    }
+
+    /// \brief Appends a double in its shortest round-trip form to a string.
+    inline void append_double(std::string& out, double value) {
+        char buf[number_buffer_size];
+        out.append(buf, static_cast<size_t>(write_double(buf, value) - buf));
+    }
+
+    /// \brief Appends a float in its shortest round-trip form to a string.
+    inline void append_float(std::string& out, float value) {
+        char buf[number_buffer_size];
+        out.append(buf, static_cast<size_t>(write_float(buf, value) - buf));
+    }
+
+}} // namespace logit::detail
+
+#endif // _LOGIT_NUMBER_UTILS_HPP_INCLUDED
@@ -44,7 +44,7 @@ namespace logit {
 
     inline std::string get_exec_dir() { return "./"; }
 
-    inline std::vector<std::string> get_list_files(const std::string&) = delete;
+    inline std::vector<std::string> get_list_files(const std::string&, bool = true) = delete;
 
     inline std::string get_file_name(const std::string& file_path) {
         size_t pos = file_path.find_last_of("/\\");
@@ -134,10 +134,11 @@ namespace logit {
 #       endif
     }
 
-    /// \brief Recursively retrieves a list of all files in a directory.
+    /// \brief Retrieves a list of all files in a directory.
     /// \param path The directory path to search (UTF-8 encoded).
+    /// \param recursive Also list the files of subdirectories.
     /// \return A vector of strings (UTF-8) containing the full paths of all files found.
-    std::vector<std::string> get_list_files(const std::string& path) {
+    std::vector<std::string> get_list_files(const std::string& path, bool recursive = true) {
         std::vector<std::string> list_files;
 #       ifdef _WIN32
         // Use wide versions of functions to correctly handle non-ASCII characters.
@@ -172,6 +173,7 @@ namespace logit {
                 std::wstring wfull_path = wsearch_path + fd.cFileName;
 
                 if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                    if (!recursive) continue;
                     // Recursively process subdirectories.
                     std::vector<std::string> sub_files = get_list_files(wstring_to_utf8(wfull_path));
                     list_files.insert(list_files.end(), sub_files.begin(), sub_files.end());
@@ -206,6 +208,7 @@ namespace logit {
                 struct stat statbuf;
                 if (stat(full_path.c_str(), &statbuf) == 0) {
                     if (S_ISDIR(statbuf.st_mode)) {
+                        if (!recursive) continue;
                         std::vector<std::string> sub_files = get_list_files(full_path);
                         list_files.insert(list_files.end(), sub_files.begin(), sub_files.end());
                     } else if (S_ISREG(statbuf.st_mode)) {
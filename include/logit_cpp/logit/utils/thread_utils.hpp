@@ -0,0 +1,40 @@
+#pragma once
+#ifndef _LOGIT_THREAD_UTILS_HPP_INCLUDED
+#define _LOGIT_THREAD_UTILS_HPP_INCLUDED
+
+/// \file thread_utils.hpp
+/// \brief Helpers for rendering thread identifiers.
+
+#include <string>
+#include <sstream>
+#include <thread>
+
+namespace logit {
+
+    /// \brief Converts a thread ID to its textual form, caching the result per thread.
+    ///
+    /// The text matches `operator<<` for `std::thread::id`. Records are formatted on the
+    /// thread that produced them, so the cached value is reused for almost every call and
+    /// the stream conversion happens once per thread.
+    /// \param thread_id The thread ID to convert.
+    /// \return Reference to a thread-local string holding the ID text.
+    inline const std::string& thread_id_to_string(const std::thread::id& thread_id) {
+        struct Cache {
+            std::thread::id id;
+            std::string text;
+            bool valid = false;
+        };
+        static thread_local Cache cache;
+        if (!cache.valid || cache.id != thread_id) {
+            std::ostringstream oss;
+            oss << thread_id;
+            cache.text = oss.str();
+            cache.id = thread_id;
+            cache.valid = true;
+        }
+        return cache.text;
+    }
+
+}; // namespace logit
+
+#endif // _LOGIT_THREAD_UTILS_HPP_INCLUDED
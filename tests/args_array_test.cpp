@@ -0,0 +1,80 @@
+#include <logit/utils.hpp>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Checks the compact VariableValue storage, the inline ArgsArray and interned argument names.
+
+int main() {
+    if (sizeof(void*) == 8 && sizeof(logit::VariableValue) != 32) return 1;
+
+    // Short strings stay inline, long ones move to the heap; both survive copies and moves.
+    const std::string short_text = "short";
+    const std::string long_text(100, 'x');
+    logit::VariableValue small("small", short_text);
+    logit::VariableValue large("large", long_text);
+    logit::VariableValue small_copy = small;
+    logit::VariableValue large_copy = large;
+    if (small_copy.to_string() != short_text || large_copy.to_string() != long_text) return 1;
+    logit::VariableValue large_moved = std::move(large_copy);
+    if (large_moved.to_string() != long_text || large_moved.string_size() != long_text.size()) return 1;
+    small_copy = large;
+    if (small_copy.to_string() != long_text) return 1;
+    large_moved = small;
+    if (large_moved.to_string() != short_text) return 1;
+
+    // Error codes keep value and category; the message is produced on demand.
+    const std::error_code ec = std::make_error_code(std::errc::timed_out);
+    logit::VariableValue error("ec", ec);
+    if (error.error_code_value() != ec) return 1;
+
+    // Long double values keep their precision (and a copy keeps it too).
+    const long double precise = 1.0L + 1.0L / (1ULL << 62);
+    logit::VariableValue extended("extended", precise);
+    logit::VariableValue extended_copy = extended;
+    if (extended_copy.pod_value.long_double_value != precise) return 1;
+
+    // Names are interned: equal names share storage.
+    logit::ArgumentName a("request_id");
+    logit::ArgumentName b(std::string("request_id"));
+    if (a != b || a.data() != b.data() || a != "request_id") return 1;
+    if (!logit::ArgumentName().empty()) return 1;
+
+    const std::vector<logit::ArgumentName>& names = logit::argument_names("x, y, std::min(a, b)");
+    if (names.size() != 3 || names[2] != "std::min(a, b)") return 1;
+    if (&logit::argument_names("x, y, std::min(a, b)") != &names) return 1;
+
+    // Inline capacity first, then growth on the heap.
+    logit::ArgsArray args;
+    const size_t count = logit::ArgsArray::inline_capacity + 5;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 2 == 0) args.emplace_back("i", static_cast<int>(i));
+        else args.emplace_back("s", std::string(30, static_cast<char>('a' + i % 26)));
+    }
+    if (args.size() != count || args.capacity() < count) return 1;
+    logit::ArgsArray copy = args;
+    logit::ArgsArray moved = std::move(copy);
+    if (!copy.empty() || moved.size() != count) return 1;
+    for (size_t i = 0; i < count; ++i) {
+        if (moved[i].to_string() != args[i].to_string()) return 1;
+    }
+
+    // Arguments are filled in order; extra values get an empty name.
+    logit::ArgsArray filled;
+    logit::fill_args_array(filled, logit::argument_names("first, second"), 1, std::string("two"), 3.5);
+    if (filled.size() != 3) return 1;
+    if (filled[0].name != "first" || filled[1].name != "second" || !filled[2].name.empty()) return 1;
+    if (filled[1].to_string() != "two" || filled[2].to_string() != "3.5") return 1;
+
+    // Code written for std::string names and args_to_array() keeps compiling.
+    const std::string& as_string = filled[0].name;
+    if (as_string != "first" || std::string("first") != filled[0].name || "first" != filled[0].name) return 1;
+    const std::vector<std::string> legacy_names = {"a", "b"};
+    const std::vector<logit::VariableValue> legacy = logit::args_to_array(legacy_names.begin(), 7, std::string("text"));
+    if (legacy.size() != 2 || legacy[0].name != "a" || legacy[1].to_string() != "text") return 1;
+    logit::ArgsArray converted = logit::args_to_array(legacy_names.begin(), 1, 2);
+    if (converted.size() != 2 || converted[1].name != "b" || converted[1].to_string() != "2") return 1;
+
+    return 0;
+}
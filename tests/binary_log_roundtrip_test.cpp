@@ -0,0 +1,105 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Writes the same events through a text and a binary FileLogger and checks that the
+// decoded binary log renders to exactly the same text. Definitions are formatted once
+// and repeated by the logger in every rotated file.
+
+static size_t count_of(const std::string& text, const std::string& part) {
+    size_t count = 0;
+    for (size_t pos = text.find(part); pos != std::string::npos; pos = text.find(part, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+int main() {
+    std::system("rm -rf binary_roundtrip_bin binary_roundtrip_txt");
+    const std::string pattern = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%g:%#] [thread:%t] %v";
+
+    logit::FileLogger::Config bin_cfg;
+    bin_cfg.directory = "binary_roundtrip_bin";
+    bin_cfg.binary = true;
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(new logit::FileLogger(bin_cfg)),
+        std::unique_ptr<logit::BinaryLogFormatter>(new logit::BinaryLogFormatter()));
+
+    logit::FileLogger::Config txt_cfg;
+    txt_cfg.directory = "binary_roundtrip_txt";
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(new logit::FileLogger(txt_cfg)),
+        std::unique_ptr<logit::SimpleLogFormatter>(new logit::SimpleLogFormatter(pattern)));
+
+    for (int i = 0; i < 5; ++i) {
+        const double ratio = i / 4.0;
+        const std::string name = "item \"" + std::to_string(i) + "\"";
+        LOGIT_INFO(i, ratio, name, i % 2 == 0);
+        LOGIT_PRINTF_WARN("step %d of %d", i, 5);
+    }
+    std::thread worker([]() {
+        const uint64_t big = 18446744073709551615ULL;
+        const int8_t small = -5;
+        LOGIT_ERROR("worker", big, small, 'x', 2.5f);
+    });
+    worker.join();
+
+    LOGIT_WAIT();
+    const std::string bin_path = LOGIT_GET_LAST_FILE_PATH(0);
+    const std::string txt_path = LOGIT_GET_LAST_FILE_PATH(1);
+    LOGIT_SHUTDOWN();
+
+    const std::string raw = read_file(bin_path);
+    if (raw.compare(0, 8, "LOGITBIN") != 0) return 1;
+    // Call sites are defined once per file regardless of how many events they produced.
+    if (count_of(raw, "i, ratio, name") != 1) return 1;
+
+    logit::BinaryLogReader reader(bin_path);
+    logit::SimpleLogFormatter formatter(pattern);
+    std::ostringstream decoded;
+    if (reader.render(formatter, decoded) != 11) return 1;
+    if (decoded.str() != read_file(txt_path)) return 1;
+
+    // The formatter keeps no state: definitions are added by the logger.
+    logit::BinaryLogFormatter binary;
+    logit::LogRecord record(logit::LogLevel::LOG_LVL_INFO, LOGIT_CURRENT_TIMESTAMP_MS(), __FILE__, __LINE__,
+                            LOGIT_FUNCTION, "rotated {}", "", 0, true);
+    const std::string first = binary.format(record);
+    const std::string event = binary.format(record);
+    if (event.empty() || static_cast<uint8_t>(event[0]) != static_cast<uint8_t>(logit::detail::BinaryRecordKind::Event) ||
+        event != first) return 1;
+
+    // Each rotated file still decodes on its own, also when one formatter serves two loggers.
+    std::system("rm -rf binary_roundtrip_rotation binary_roundtrip_shared");
+    bin_cfg.directory = "binary_roundtrip_rotation";
+    bin_cfg.async = false;
+    bin_cfg.max_file_size_bytes = 256;
+    logit::FileLogger::Config second_cfg = bin_cfg;
+    second_cfg.directory = "binary_roundtrip_shared";
+    second_cfg.max_file_size_bytes = 0;
+    std::string rotation_path;
+    std::string second_path;
+    {
+        logit::BinaryLogFormatter rotation_formatter;
+        logit::FileLogger logger(bin_cfg);
+        logit::FileLogger second(second_cfg);
+        rotation_path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        second_path = second.get_string_param(logit::LoggerParam::LastFilePath);
+        for (int i = 0; i < 40; ++i) {
+            const std::string message = rotation_formatter.format(record);
+            logger.log(record, message);
+            second.log(record, message);
+        }
+    }
+    const std::string rotated = rotation_path.substr(0, rotation_path.size() - 4) + ".001.log";
+    for (const std::string& path : { rotation_path, rotated, second_path }) {
+        logit::BinaryLogReader rotation_reader(path);
+        std::ostringstream text;
+        const size_t count = rotation_reader.render(formatter, text);
+        if (count == 0 || count_of(text.str(), "rotated") != count) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Sends records through the buffered descriptor mode of ConsoleLogger into files that
+// replace stdout and stderr. Records must arrive complete and in order, warnings must go
+// to stderr, and records queued while the worker is busy must be written as one batch.
+// Records dropped by QueuePolicy::DropNewest must not keep later batches from ending.
+
+static const int record_count = 500; // stays below the capacity of the task queue
+
+int main() {
+    const char* out_path = "console_logger_fd_test.out";
+    const char* err_path = "console_logger_fd_test.err";
+    const int saved_out = ::dup(1);
+    const int saved_err = ::dup(2);
+    const int out_fd = ::open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    const int err_fd = ::open(err_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    std::fflush(stdout);
+    ::dup2(out_fd, 1);
+    ::dup2(err_fd, 2);
+
+    logit::ConsoleLogger::Config cfg;
+    cfg.direct_fd = true;
+    cfg.split_stderr = true;
+    int64_t write_calls = 0;
+    std::string expected_out;
+    std::string expected_err;
+    {
+        logit::ConsoleLogger logger(cfg);
+        logger.wait();
+        const int64_t before = logger.get_int_param(logit::LoggerParam::WriteCallCount);
+        // Hold the worker so that all records are queued before the first one is written.
+        std::atomic<bool> release(false);
+        logit::detail::TaskExecutor::get_instance().add_task([&release]() {
+            while (!release.load()) std::this_thread::yield();
+        });
+        for (int i = 0; i < record_count; ++i) {
+            const std::string line = "info record " + std::to_string(i);
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO), line);
+            expected_out += line + "\n";
+        }
+        release.store(true);
+        logger.wait();
+        write_calls = logger.get_int_param(logit::LoggerParam::WriteCallCount) - before;
+        logger.log(make_record(logit::LogLevel::LOG_LVL_WARN), "warning");
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO), "after warning");
+        expected_err += "warning\n";
+        expected_out += "after warning\n";
+    }
+
+    ::dup2(saved_out, 1);
+    ::dup2(saved_err, 2);
+    ::close(out_fd);
+    ::close(err_fd);
+
+    const std::string out = read_file(out_path);
+    const std::string err = read_file(err_path);
+    // The color reset written on construction precedes the records.
+    const std::string reset = logit::to_string(cfg.default_color);
+    if (out != reset + expected_out || err != expected_err) {
+        std::printf("unexpected output: %zu/%zu bytes\n", out.size(), err.size());
+        return 1;
+    }
+    if (write_calls != 1) {
+        std::printf("too many writes: %lld\n", static_cast<long long>(write_calls));
+        return 1;
+    }
+    std::remove(out_path);
+    std::remove(err_path);
+
+    // Without a flush interval only the end of a batch writes the buffer out.
+    const char* drop_path = "console_logger_fd_drop_test.out";
+    const int drop_fd = ::open(drop_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ::dup2(drop_fd, 1);
+    cfg.split_stderr = false;
+    cfg.flush_interval_ms = 0;
+    std::string drop_out;
+    {
+        logit::ConsoleLogger logger(cfg);
+        logger.wait();
+        logit::detail::TaskExecutor& executor = logit::detail::TaskExecutor::get_instance();
+        executor.set_max_queue_size(16);
+        executor.set_queue_policy(logit::detail::QueuePolicy::DropNewest);
+        executor.reset_dropped_tasks();
+        std::atomic<bool> release(false);
+        executor.add_task([&release]() {
+            while (!release.load()) std::this_thread::yield();
+        });
+        for (int i = 0; i < 100; ++i) {
+            logger.log(make_record(logit::LogLevel::LOG_LVL_INFO), "dropped " + std::to_string(i));
+        }
+        release.store(true);
+        executor.wait();
+        const bool dropped = executor.dropped_tasks() > 0;
+        logger.log(make_record(logit::LogLevel::LOG_LVL_INFO), "after drops");
+        executor.wait();
+        drop_out = read_file(drop_path);
+        executor.set_queue_policy(logit::detail::QueuePolicy::Block);
+        executor.set_max_queue_size(0);
+        if (!dropped) drop_out.clear();
+    }
+    ::dup2(saved_out, 1);
+    ::close(drop_fd);
+    std::remove(drop_path);
+    if (drop_out.size() < 12 || drop_out.compare(drop_out.size() - 12, 12, "after drops\n") != 0) {
+        std::printf("record after drops still buffered\n");
+        return 1;
+    }
+    return 0;
+}
+#endif
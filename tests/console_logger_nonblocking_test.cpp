@@ -0,0 +1,99 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Points stdout at a pipe nobody reads. Logging in non-blocking mode must not block;
+// records beyond the pending limit are dropped and counted. Once a reader drains the
+// pipe, every line must be a complete record in order. Each gap is marked by a notice
+// with the number of records dropped there, and the newest record comes last.
+
+static const int record_count = 20000;
+
+int main() {
+    int pipe_fds[2];
+    if (::pipe(pipe_fds) != 0) return 1;
+    const int saved_out = ::dup(1);
+    std::fflush(stdout);
+    ::dup2(pipe_fds[1], 1);
+
+    logit::ConsoleLogger::Config cfg;
+    cfg.async = false;
+    cfg.non_blocking = true;
+    cfg.buffer_size = 4096;
+    cfg.pending_limit = 16 * 1024;
+    logit::ConsoleLogger logger(cfg);
+
+    // About 640 KiB against a 64 KiB pipe; without non-blocking writes this would hang.
+    for (int i = 0; i < record_count; ++i) {
+        char line[64];
+        std::snprintf(line, sizeof(line), "console record %05d padding padding", i);
+        logger.log(make_record(), line);
+    }
+#   if defined(__linux__)
+    // The descriptor of the application keeps blocking semantics.
+    if ((::fcntl(1, F_GETFL) & O_NONBLOCK) != 0) return 1;
+#   endif
+
+    std::string output;
+    std::thread reader([&output, &pipe_fds]() {
+        char buf[4096];
+        ssize_t got;
+        while ((got = ::read(pipe_fds[0], buf, sizeof(buf))) > 0) output.append(buf, static_cast<size_t>(got));
+    });
+    // Waiting hands the pending records and the notice to the reader.
+    logger.wait();
+    logger.log(make_record(), "last record");
+    logger.wait();
+    const int64_t dropped = logger.get_int_param(logit::LoggerParam::DroppedRecords);
+    ::dup2(saved_out, 1);
+    ::close(pipe_fds[1]);
+    // The logger's own descriptor for the pipe must be closed before the reader sees EOF.
+    logger.set_config(logit::ConsoleLogger::Config());
+    reader.join();
+
+    if (dropped <= 0 || dropped >= record_count) {
+        std::printf("dropped %lld\n", static_cast<long long>(dropped));
+        return 1;
+    }
+    std::istringstream in(output);
+    std::string line;
+    int previous = -1;
+    int records = 0;
+    long long reported = 0;
+    bool last = false;
+    while (std::getline(in, line)) {
+        if (line.find("\033[") == 0) line = line.substr(line.find('m') + 1);
+        int i = -1;
+        long long count = 0;
+        if (last) {
+            std::printf("line after the last record: %s\n", line.c_str());
+            return 1;
+        }
+        if (std::sscanf(line.c_str(), "console record %d", &i) == 1 && line.size() == 36) {
+            if (i <= previous) return 1;
+            previous = i;
+            ++records;
+        } else if (std::sscanf(line.c_str(), "[logit] dropped %lld console records", &count) == 1 && count > 0) {
+            reported += count;
+        } else if (line == "last record") {
+            last = true;
+        } else {
+            std::printf("unexpected line: %s\n", line.c_str());
+            return 1;
+        }
+    }
+    if (!last || reported != dropped || records + dropped != record_count) {
+        std::printf("records %d, dropped %lld, reported %lld\n", records, static_cast<long long>(dropped), reported);
+        return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,51 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// A child process crashes with SIGSEGV; the crash log must hold the messages, the
+// marker and the context sections: registers, a backtrace and the memory map.
+
+int main() {
+    logit::CrashPosixLogger::Config cfg;
+    cfg.log_path = "crash_logger_context_test.log";
+    std::remove(cfg.log_path.c_str());
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        logit::CrashPosixLogger* logger = new logit::CrashPosixLogger(cfg);
+        logit::CrashPosixLogger::install_signal_handler(SIGSEGV);
+        logger->log(logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, LOGIT_CURRENT_TIMESTAMP_MS(), __FILE__,
+                                     __LINE__, LOGIT_FUNCTION, "", "", 0, false), "about to crash");
+        std::raise(SIGSEGV);
+        _exit(1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 128 + SIGSEGV) return 1;
+
+    const std::string text = read_file(cfg.log_path);
+    const size_t marker = text.find("about to crash\n\n== CRASH SIGNAL " + std::to_string(SIGSEGV) + " ==\n");
+    const size_t context = text.find("== CONTEXT ==\nfault_addr 0x");
+    const size_t backtrace = text.find("== BACKTRACE ==\n");
+    if (marker == std::string::npos || context == std::string::npos || backtrace == std::string::npos) return 1;
+    if (context < marker || backtrace < context || text.find("== END ==\n") == std::string::npos) return 1;
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+    if (text.find("\npc 0x", context) > backtrace) return 1;
+#endif
+#if defined(__linux__)
+    // The copy of /proc/self/maps names this executable, so frames can be resolved offline.
+    const size_t maps = text.find("== MAPS ==\n");
+    if (maps == std::string::npos || text.find("crash_logger_context_test", maps) == std::string::npos) return 1;
+    if (text.find("#0 0x", backtrace) > maps) return 1;
+#endif
+    std::remove(cfg.log_path.c_str());
+    return 0;
+}
+#endif
@@ -0,0 +1,66 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Keeps more than 64 KiB of messages in a file-backed crash buffer, checks that they
+// survive SIGKILL and that the next start moves the file aside as `.prev`.
+
+static std::string make_line(int i) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "crash message %06d", i);
+    return buf;
+}
+
+int main() {
+    const std::string map_path = "crash_logger_map_test.buf";
+    std::remove(map_path.c_str());
+    std::remove((map_path + ".prev").c_str());
+
+    logit::CrashPosixLogger::Config cfg;
+    cfg.log_path = "crash_logger_map_test.log";
+    cfg.buffer_size = 1024 * 1024;
+    cfg.map_path = map_path;
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        logit::CrashPosixLogger* logger = new logit::CrashPosixLogger(cfg);
+        for (int i = 0; i < 20000; ++i) logger->log(make_record(), make_line(i));
+        ::kill(::getpid(), SIGKILL);
+        _exit(1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFSIGNALED(status)) return 1;
+
+    // About 410 KiB of messages, far beyond the former 64 KiB limit, are all kept in order.
+    std::string text = logit::CrashPosixLogger::read_map_file(map_path);
+    if (text.size() != 20000 * 21 || text.find(make_line(0) + "\n" + make_line(1) + "\n") != 0) return 1;
+    if (text.substr(text.size() - 21) != make_line(19999) + "\n") return 1;
+    if (text.find("CRASH SIGNAL") != std::string::npos) return 1;
+
+    {
+        logit::CrashPosixLogger logger(cfg);
+        logger.log(make_record(), "next run");
+        if (logit::CrashPosixLogger::read_map_file(map_path) != "next run\n") return 1;
+    }
+    if (logit::CrashPosixLogger::read_map_file(map_path + ".prev") != text) return 1;
+
+    // A clean shutdown leaves nothing to keep.
+    {
+        logit::CrashPosixLogger logger(cfg);
+    }
+    if (logit::CrashPosixLogger::read_map_file(map_path + ".prev") != text) return 1;
+    std::remove(map_path.c_str());
+    std::remove((map_path + ".prev").c_str());
+    std::remove(cfg.log_path.c_str());
+    return 0;
+}
+#endif
@@ -0,0 +1,163 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Several threads log into per-thread sub-rings. The dump of the signal handler and
+// `read_map_file()` must return whole records, each thread's newest ones in order, and
+// records written one after another in time order. Sub-rings return to the pool when
+// their thread exits, survive switching between loggers, and threads beyond the pool
+// are counted as sharing.
+
+static const int thread_count = 4;
+static const int record_count = 2000;
+
+static void run_threads(logit::CrashPosixLogger& logger) {
+    logger.log(make_record(), "first");
+    // Threads stay alive until all are done, so none takes over the sub-ring of another.
+    std::atomic<int> done(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.push_back(std::thread([&logger, &done, t]() {
+            for (int i = 0; i < record_count; ++i) {
+                char line[32];
+                std::snprintf(line, sizeof(line), "thread %d record %05d", t, i);
+                logger.log(make_record(), line);
+            }
+            done.fetch_add(1);
+            while (done.load() < thread_count) std::this_thread::yield();
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    logger.log(make_record(), "last");
+}
+
+// Checks that every thread's records are consecutive and end with its last one; returns
+// the number of records or -1.
+static int check(const std::string& text, int min_records) {
+    std::istringstream in(text);
+    std::string line;
+    std::vector<int> next(thread_count, -1);
+    int records = 0;
+    bool last = false;
+    while (std::getline(in, line)) {
+        if (last) return -1;
+        if (line == "first") {
+            if (records != 0) return -1;
+            continue;
+        }
+        if (line == "last") {
+            last = true;
+            continue;
+        }
+        int t = -1;
+        int i = -1;
+        if (std::sscanf(line.c_str(), "thread %d record %d", &t, &i) != 2 || line.size() != 21) return -1;
+        if (t < 0 || t >= thread_count || (next[t] >= 0 && i != next[t])) return -1;
+        next[t] = i + 1;
+        ++records;
+    }
+    for (int t = 0; t < thread_count; ++t) {
+        if (next[t] != record_count) return -1;
+    }
+    return last && records >= min_records ? records : -1;
+}
+
+/// Starts `count` threads that each log once and stay alive until all have logged.
+static void run_concurrent(logit::CrashPosixLogger& logger, int count) {
+    std::atomic<int> logged(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < count; ++t) {
+        threads.push_back(std::thread([&logger, &logged, count]() {
+            logger.log(make_record(), "concurrent");
+            logged.fetch_add(1);
+            while (logged.load() < count) std::this_thread::yield();
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+}
+
+static bool check_claims() {
+    logit::CrashPosixLogger::Config cfg;
+    cfg.log_path = "crash_logger_thread_rings_claims_test.log";
+    cfg.buffer_size = 16 * 1024;
+    cfg.thread_rings = 2;
+    logit::CrashPosixLogger first(cfg);
+    logit::CrashPosixLogger second(cfg);
+
+    // Exited threads give their sub-ring back.
+    for (int i = 0; i < 20; ++i) {
+        std::thread([&first]() { first.log(make_record(), "short-lived"); }).join();
+    }
+    run_concurrent(first, 2);
+    if (first.shared_threads() != 0) return false;
+
+    // Alternating between loggers keeps one sub-ring per logger.
+    for (int i = 0; i < 100; ++i) {
+        first.log(make_record(), "first");
+        second.log(make_record(), "second");
+    }
+    run_concurrent(first, 1);
+    if (first.shared_threads() != 0 || second.shared_threads() != 0) return false;
+
+    // The calling thread holds one sub-ring, so two more threads exhaust the pool.
+    run_concurrent(first, 2);
+    std::remove(cfg.log_path.c_str());
+    return first.shared_threads() == 1;
+}
+
+int main() {
+    if (!check_claims()) return 1;
+
+    logit::CrashPosixLogger::Config cfg;
+    cfg.thread_rings = thread_count;
+
+    // Large enough for everything: the mapped file holds all records in time order.
+    cfg.log_path = "crash_logger_thread_rings_test.log";
+    cfg.map_path = "crash_logger_thread_rings_test.buf";
+    cfg.buffer_size = 1024 * 1024;
+    std::remove(cfg.log_path.c_str());
+    std::remove(cfg.map_path.c_str());
+    {
+        logit::CrashPosixLogger logger(cfg);
+        run_threads(logger);
+        const std::string text = logit::CrashPosixLogger::read_map_file(cfg.map_path);
+        if (check(text, thread_count * record_count) != thread_count * record_count) return 1;
+        if (text.find("first\n") != 0) return 1;
+    }
+
+    // A small heap buffer wraps many times; the handler dumps the newest records.
+    cfg.map_path.clear();
+    cfg.buffer_size = 16 * 1024;
+    const pid_t pid = fork();
+    if (pid == 0) {
+        logit::CrashPosixLogger* logger = new logit::CrashPosixLogger(cfg);
+        logit::CrashPosixLogger::install_signal_handler(SIGABRT);
+        run_threads(*logger);
+        std::abort();
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 128 + SIGABRT) return 1;
+    std::string text = read_file(cfg.log_path);
+    const std::string marker = "\n== CRASH SIGNAL " + std::to_string(SIGABRT) + " ==\n";
+    const size_t marker_pos = text.find(marker);
+    if (marker_pos == std::string::npos) return 1;
+    text.resize(marker_pos);
+    if (check(text, 100) < 0) return 1;
+    std::remove(cfg.log_path.c_str());
+    std::remove("crash_logger_thread_rings_test.buf");
+    return 0;
+}
+#endif
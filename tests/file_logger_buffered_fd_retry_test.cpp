@@ -0,0 +1,85 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#if !defined(_WIN32)
+#   include <signal.h>
+#   include <sys/resource.h>
+#endif
+
+// A short or failed write must not lose data: the bytes that did not reach the file
+// stay in the FdFileWriter buffer and are written by the next flush. The file size
+// limit (RLIMIT_FSIZE) makes the kernel cut a write short and then reject the next one.
+
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+
+static bool set_file_limit(rlim_t limit) {
+    struct rlimit rl;
+    if (::getrlimit(RLIMIT_FSIZE, &rl) != 0) return false;
+    rl.rlim_cur = limit;
+    return ::setrlimit(RLIMIT_FSIZE, &rl) == 0;
+}
+
+static bool write_fails(logit::detail::FdFileWriter& writer, const std::string& line) {
+    try {
+        writer.write_line(line.data(), line.size());
+    } catch (const std::system_error&) {
+        return true;
+    }
+    return false;
+}
+
+static bool flush_fails(logit::detail::FdFileWriter& writer) {
+    try {
+        writer.flush();
+    } catch (const std::system_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    std::system("rm -rf buffered_fd_retry && mkdir -p buffered_fd_retry");
+    const std::string path = logit::get_exec_dir() + "/buffered_fd_retry/test.log";
+    struct rlimit original;
+    if (::getrlimit(RLIMIT_FSIZE, &original) != 0) return 1;
+    ::signal(SIGXFSZ, SIG_IGN);
+
+    const std::string first(30, 'a');
+    const std::string second(30, 'b');
+    const std::string large(50, 'c');
+    const std::string fourth(30, 'd');
+    const std::string dropped(60, 'e');
+    const std::string expected = first + "\n" + second + "\n" + large + "\n" + fourth + "\n";
+
+    logit::detail::FdFileWriter writer;
+    if (!writer.open(path, 64)) return 1;
+    writer.write_line(first.data(), first.size());
+    writer.write_line(second.data(), second.size());
+
+    // The buffered records and the large one go out in one call; only 100 bytes fit,
+    // so the large record is torn and its tail must be kept.
+    if (!set_file_limit(100)) return 1;
+    if (!write_fails(writer, large)) return 1;
+    if (read_file(path) != expected.substr(0, 100)) return 1;
+
+    // A later record is buffered behind the kept tail; a failed flush keeps both.
+    writer.write_line(fourth.data(), fourth.size());
+    if (!flush_fails(writer)) return 1;
+    if (writer.empty()) return 1;
+
+    // A record that was not started and does not fit next to the kept bytes is dropped.
+    if (!write_fails(writer, dropped)) return 1;
+
+    if (!set_file_limit(original.rlim_cur)) return 1;
+    writer.flush();
+    if (!writer.empty()) return 1;
+    writer.close();
+    return read_file(path) == expected ? 0 : 1;
+}
+
+#endif
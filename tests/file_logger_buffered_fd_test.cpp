@@ -0,0 +1,63 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <memory>
+#include <string>
+
+// Checks FileWriteMode::BufferedFd: records stay in the user-space buffer until the
+// size, level or time policy flushes them, and the writer counters are exposed.
+
+int main() {
+    logit::FileLogger::Config cfg;
+    cfg.directory = "buffered_fd_test";
+    cfg.async = false;
+    cfg.write_mode = logit::FileWriteMode::BufferedFd;
+    cfg.write_buffer_size = 4096;
+    cfg.flush_interval_ms = 0;
+    cfg.flush_level = logit::LogLevel::LOG_LVL_ERROR;
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(new logit::FileLogger(cfg)),
+        std::unique_ptr<logit::SimpleLogFormatter>(new logit::SimpleLogFormatter("%v")));
+    const std::string path = LOGIT_GET_LAST_FILE_PATH(0);
+    const size_t initial = read_file(path).size();
+
+    for (int i = 0; i < 10; ++i) {
+        LOGIT_PRINT_INFO("message ", i);
+    }
+    if (read_file(path).size() != initial) return 1;
+    if (logit::Logger::get_instance().get_int_param(0, logit::LoggerParam::FlushCount) != 0) return 1;
+
+    // Records at the flush level are written at once, together with the buffered ones.
+    LOGIT_PRINT_ERROR("failure");
+    std::string text = read_file(path).substr(initial);
+    if (text.find("message 9\nfailure\n") == std::string::npos) return 1;
+    if (logit::Logger::get_instance().get_int_param(0, logit::LoggerParam::FlushCount) != 1) return 1;
+    if (logit::Logger::get_instance().get_int_param(0, logit::LoggerParam::WriteCallCount) != 1) return 1;
+
+    // A record larger than the buffer goes out in a single call with the buffered data.
+    LOGIT_PRINT_INFO("small");
+    const std::string large(5000, 'x');
+    LOGIT_PRINT_INFO(large);
+    text = read_file(path).substr(initial);
+    if (text.find("small\n" + large + "\n") == std::string::npos) return 1;
+    if (logit::Logger::get_instance().get_int_param(0, logit::LoggerParam::WriteCallCount) != 2) return 1;
+    const double per_write = logit::Logger::get_instance().get_float_param(0, logit::LoggerParam::BytesPerWrite);
+    if (per_write * 2 != static_cast<double>(text.size())) return 1;
+
+    LOGIT_PRINT_INFO("tail");
+    LOGIT_WAIT();
+    if (read_file(path).substr(initial).find("tail\n") == std::string::npos) return 1;
+    LOGIT_SHUTDOWN();
+
+    // The time policy flushes idle buffers from the maintenance thread.
+    logit::FileLogger::Config timed = cfg;
+    timed.directory = "buffered_fd_timed_test";
+    timed.flush_interval_ms = 5;
+    logit::FileLogger logger(timed);
+    const std::string timed_path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    const size_t timed_initial = read_file(timed_path).size();
+    logger.log(make_record(), "timed");
+    logger.wait_maintenance();
+    if (read_file(timed_path).substr(timed_initial) != "timed\n") return 1;
+    if (logger.write_stats().flushes != 1) return 1;
+    return 0;
+}
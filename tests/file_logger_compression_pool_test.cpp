@@ -0,0 +1,52 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#if defined(LOGIT_HAS_ZLIB)
+#include <cstdio>
+#include <string>
+
+// Checks the compression pool: a burst of rotations is compressed by several threads,
+// and the counters report every file and a non-zero compression rate.
+
+int main() {
+    logit::FileLogger::Config cfg;
+    cfg.directory = "compression_pool_test";
+    cfg.async = false;
+    cfg.compress = logit::CompressType::GZIP;
+    cfg.compress_threads = 4;
+    cfg.compress_nice = 5;
+    cfg.max_file_size_bytes = 4096;
+
+    logit::FileLogger logger(cfg);
+    const std::string path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    for (int i = 0; i < 4000; ++i) {
+        logger.log(make_record(), "pool record " + std::to_string(i));
+    }
+    logger.wait();
+    logger.wait_compression();
+
+    const logit::CompressionStats stats = logger.compression_stats();
+    if (stats.queue_depth != 0 || stats.failures != 0) return 1;
+
+    const std::string base = path.substr(0, path.size() - 4);
+    uint64_t rotated = 0;
+    for (;; ++rotated) {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), ".%03u.log", static_cast<unsigned>(rotated + 1));
+        const std::string name = base + suffix;
+        if (!file_exists(name + ".gz")) {
+            if (file_exists(name)) return 1;
+            break;
+        }
+        const std::string content = gunzip(read_file(name + ".gz"));
+        if (content.empty() || content.compare(0, 12, "pool record ") != 0) return 1;
+    }
+    if (rotated < 10 || stats.files != rotated) return 1;
+    if (stats.bytes_out == 0 || stats.bytes_out >= stats.bytes_in) return 1;
+    if (stats.bytes_per_sec() <= 0.0) return 1;
+    if (logger.get_int_param(logit::LoggerParam::CompressionQueueDepth) != 0) return 1;
+    if (logger.get_float_param(logit::LoggerParam::CompressionBytesPerSec) <= 0.0) return 1;
+    return 0;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,81 @@
+#include <logit.hpp>
+#include <cstdlib>
+#include <stdexcept>
+
+// Checks FileLogger::validate_config: unsupported option combinations are rejected by the
+// constructor instead of being changed, and the supported ones still construct.
+
+/// Returns true if the constructor rejects the configuration.
+static bool rejected(const logit::FileLogger::Config& cfg) {
+    try {
+        logit::FileLogger logger(cfg);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    std::system("rm -rf config_validation_test");
+    logit::FileLogger::Config base;
+    base.directory = "config_validation_test";
+    base.async = false;
+    if (rejected(base)) return 1;
+
+    // Group commit and live compression need a descriptor writer.
+    logit::FileLogger::Config cfg = base;
+    cfg.group_commit = true;
+    if (!rejected(cfg)) return 1;
+    cfg.write_mode = logit::FileWriteMode::BufferedFd;
+    if (rejected(cfg)) return 1;
+
+    cfg = base;
+    cfg.compress_live = true;
+    cfg.write_mode = logit::FileWriteMode::BufferedFd;
+    if (!rejected(cfg)) return 1; // CompressType::NONE
+#   if defined(LOGIT_HAS_ZLIB)
+    cfg.compress = logit::CompressType::GZIP;
+    if (rejected(cfg)) return 1;
+    cfg.write_mode = logit::FileWriteMode::Stream;
+    if (!rejected(cfg)) return 1;
+#   endif
+
+    cfg = base;
+    cfg.compress = logit::CompressType::ZSTD;
+    cfg.compress_seekable = true;
+    if (!rejected(cfg)) return 1;
+
+    // io_uring is used only where it works.
+    cfg = base;
+    cfg.write_mode = logit::FileWriteMode::IoUring;
+    if (rejected(cfg) == logit::IoUringFileLogger::is_available()) return 1;
+
+#   if !defined(_WIN32)
+    cfg = base;
+    cfg.write_mode = logit::FileWriteMode::Mmap;
+    cfg.binary = true;
+    if (!rejected(cfg)) return 1;
+    cfg.framed = true;
+    if (rejected(cfg)) return 1;
+
+    // Shared mode writes every text record with one O_APPEND write.
+    logit::FileLogger::Config shared = base;
+    shared.shared = true;
+    shared.write_mode = logit::FileWriteMode::BufferedFd;
+    shared.flush_level = logit::LogLevel::LOG_LVL_TRACE;
+    if (rejected(shared)) return 1;
+    cfg = shared;
+    cfg.write_mode = logit::FileWriteMode::Stream;
+    if (!rejected(cfg)) return 1;
+    cfg = shared;
+    cfg.flush_level = logit::LogLevel::LOG_LVL_ERROR;
+    if (!rejected(cfg)) return 1;
+    cfg = shared;
+    cfg.binary = true;
+    if (!rejected(cfg)) return 1;
+    cfg = shared;
+    cfg.time_index = true;
+    if (!rejected(cfg)) return 1;
+#   endif
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <string>
+
+// Writes framed text and binary logs, then damages them: a torn tail is cut off when the
+// logger reopens the file, and a corrupted frame in the middle is reported as a gap.
+
+int main() {
+    std::system("rm -rf framed_test framed_plain_test framed_binary_test");
+    if (logit::crc32c("123456789", 9) != 0xE3069283U) return 1;
+
+    logit::FileLogger::Config cfg;
+    cfg.directory = "framed_test";
+    cfg.async = false;
+    cfg.framed = true;
+    std::string path;
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(), "first");
+        logger.log(make_record(), "second");
+        logger.log(make_record(), "third");
+        path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+    logit::FrameScanResult scan = logit::scan_framed_log(path);
+    if (!scan.framed || scan.records != 3 || scan.first_sequence != 1 || scan.last_sequence != 3) return 1;
+    if (scan.torn_tail() || !scan.gaps.empty()) return 1;
+    if (logit::read_framed_log(path) != "first\nsecond\nthird\n") return 1;
+
+    // A record cut short by a crash is dropped on open; numbering continues.
+    const std::string intact = read_file(path);
+    write_file(path, intact + std::string("\x09\x00\x00\x00partial", 11));
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(), "fourth");
+    }
+    scan = logit::scan_framed_log(path);
+    if (scan.records != 4 || scan.last_sequence != 4 || scan.torn_tail() || !scan.gaps.empty()) return 1;
+    if (logit::read_framed_log(path) != "first\nsecond\nthird\nfourth\n") return 1;
+
+    // A damaged frame in the middle is skipped and reported.
+    std::string damaged = read_file(path);
+    const size_t second = damaged.find("second");
+    damaged[second] = 'S';
+    write_file(path, damaged);
+    scan = logit::scan_framed_log(path);
+    if (scan.records != 3 || scan.gaps.size() != 1 || scan.torn_tail()) return 1;
+    if (scan.gaps[0].bytes != 16 + 7 || scan.gaps[0].missing_records != 1) return 1;
+    if (logit::read_framed_log(path) != "first\nthird\nfourth\n") return 1;
+
+    // An existing unframed file is rotated aside instead of being truncated.
+    const std::string plain_dir = logit::get_exec_dir() + "/framed_plain_test";
+    logit::create_directories(plain_dir);
+    const std::string name = path.substr(path.find_last_of("/\\") + 1);
+    write_file(plain_dir + "/" + name, "plain\n");
+    cfg.directory = "framed_plain_test";
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(), "framed");
+    }
+    if (read_file(plain_dir + "/" + name.substr(0, name.size() - 4) + ".001.log") != "plain\n") return 1;
+    if (logit::read_framed_log(plain_dir + "/" + name) != "framed\n") return 1;
+
+    // Binary logs are framed as a whole and decoded transparently.
+    logit::FileLogger::Config bin_cfg;
+    bin_cfg.directory = "framed_binary_test";
+    bin_cfg.binary = true;
+    bin_cfg.framed = true;
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(new logit::FileLogger(bin_cfg)),
+        std::unique_ptr<logit::BinaryLogFormatter>(new logit::BinaryLogFormatter()));
+    for (int i = 0; i < 5; ++i) LOGIT_INFO("event", i);
+    LOGIT_WAIT();
+    const std::string bin_path = LOGIT_GET_LAST_FILE_PATH(0);
+    LOGIT_SHUTDOWN();
+    if (logit::scan_framed_log(bin_path).records != 5) return 1;
+    logit::BinaryLogReader reader(bin_path);
+    int events = 0;
+    reader.for_each([&events](const logit::LogRecord&) { ++events; });
+    return events == 5 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Checks the group commit mode through the logging macros: durable records are in the
+// file when the call returns and concurrent producers share fdatasync calls.
+
+int main() {
+    // Concurrent producers going through the logging macros join batches instead of
+    // syncing one record at a time; the wait runs outside the lock of Logger.
+    logit::FileLogger::Config cfg;
+    cfg.directory = "group_commit_sync_test";
+    cfg.async = false;
+    cfg.write_mode = logit::FileWriteMode::BufferedFd;
+    cfg.group_commit = true;
+    cfg.group_commit_delay_us = 2000;
+    cfg.flush_interval_ms = 0;
+    cfg.flush_level = logit::LogLevel::LOG_LVL_FATAL;
+    logit::FileLogger* sync_logger = new logit::FileLogger(cfg);
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(sync_logger),
+        std::unique_ptr<logit::SimpleLogFormatter>(new logit::SimpleLogFormatter("%v")));
+    const std::string sync_path = LOGIT_GET_LAST_FILE_PATH(0);
+    const int threads = 8;
+    const int per_thread = 20;
+    std::atomic<int> missing(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                const std::string text = "t" + std::to_string(t) + "-" + std::to_string(i) + ";";
+                LOGIT_PRINT_ERROR(text);
+                if (read_file(sync_path).find(text) == std::string::npos) ++missing;
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    if (missing != 0) return 1;
+    const logit::FileWriteStats stats = sync_logger->write_stats();
+    if (stats.syncs == 0 || stats.syncs >= static_cast<uint64_t>(threads * per_thread) / 2) return 1;
+    if (stats.sync_failures != 0) return 1;
+
+    // Records below the durable level do not sync.
+    LOGIT_PRINT_INFO("info");
+    if (sync_logger->write_stats().syncs != stats.syncs) return 1;
+
+    // Asynchronous logger: the producer returns only after the worker wrote and synced the record.
+    logit::FileLogger::Config async_cfg = cfg;
+    async_cfg.directory = "group_commit_test";
+    async_cfg.async = true;
+    async_cfg.group_commit_delay_us = 0;
+    logit::Logger::get_instance().add_logger(
+        std::unique_ptr<logit::FileLogger>(new logit::FileLogger(async_cfg)),
+        std::unique_ptr<logit::SimpleLogFormatter>(new logit::SimpleLogFormatter("%v")), true);
+    const std::string path = LOGIT_GET_LAST_FILE_PATH(1);
+    LOGIT_PRINT_INFO_TO(1, "buffered");
+    LOGIT_PRINT_WARN_TO(1, "durable");
+    if (read_file(path).find("buffered\ndurable\n") == std::string::npos) return 1;
+    LOGIT_SHUTDOWN();
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <string>
+
+// Checks IoUringFileLogger: records, including ones larger than a registered buffer,
+// reach the file in order. Without io_uring support the logger selects BufferedFd.
+
+int main() {
+    logit::FileLogger::Config cfg;
+    cfg.directory = "io_uring_test";
+    cfg.async = false;
+    cfg.write_buffer_size = 4096;
+    cfg.uring_queue_depth = 2;
+    cfg.flush_interval_ms = 0;
+    std::string expected;
+    std::string path;
+    size_t initial = 0;
+    {
+        logit::IoUringFileLogger logger(cfg);
+        path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        initial = read_file(path).size();
+        for (int i = 0; i < 500; ++i) {
+            const std::string text = "record " + std::to_string(i);
+            logger.log(make_record(), text);
+            expected += text + "\n";
+        }
+        const std::string large(10000, 'z');
+        logger.log(make_record(), large);
+        expected += large + "\n";
+        logger.log(make_record(), "last");
+        expected += "last\n";
+        logger.wait();
+        if (read_file(path).substr(initial) != expected) return 1;
+        if (logger.write_stats().bytes_written != expected.size()) return 1;
+
+        logger.log(make_record(), "closing");
+        expected += "closing\n";
+    }
+    if (read_file(path).substr(initial) != expected) return 1;
+    return 0;
+}
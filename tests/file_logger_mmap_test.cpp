@@ -0,0 +1,111 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+
+// Checks FileWriteMode::Mmap: the file grows in preallocated extents while open, records
+// span several windows, and closing truncates the file to the written bytes. A zero tail
+// left by an unclean shutdown is skipped on reopen, also for framed binary logs whose
+// records end with zero bytes; unframed binary logs are rejected.
+
+static uint64_t disk_size(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+}
+
+int main() {
+    std::system("rm -rf mmap_binary_test");
+    logit::FileLogger::Config cfg;
+    cfg.directory = "mmap_test";
+    cfg.async = false;
+    cfg.write_mode = logit::FileWriteMode::Mmap;
+    cfg.mmap_extent_bytes = 64 * 1024;
+    cfg.mmap_window_bytes = 16 * 1024;
+    std::string expected;
+    std::string path;
+    size_t initial = 0;
+    {
+        logit::FileLogger logger(cfg);
+        path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        initial = read_file(path).size();
+        for (int i = 0; i < 3000; ++i) {
+            const std::string text = "record " + std::to_string(i);
+            logger.log(make_record(), text);
+            expected += text + "\n";
+        }
+        const std::string large(40000, 'z');
+        logger.log(make_record(), large);
+        expected += large + "\n";
+        logger.wait();
+        const uint64_t written = initial + expected.size();
+        if (disk_size(path) <= written || disk_size(path) % cfg.mmap_window_bytes != 0) return 1;
+        if (read_file(path).substr(initial, expected.size()) != expected) return 1;
+        if (logger.write_stats().bytes_written != expected.size()) return 1;
+    }
+    if (read_file(path).substr(initial) != expected) return 1;
+
+    // Simulate a crash that left the preallocated tail behind.
+    {
+        std::ofstream f(path.c_str(), std::ios::binary | std::ios::app);
+        f << std::string(5000, '\0');
+    }
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(), "after crash");
+        expected += "after crash\n";
+    }
+    if (read_file(path).substr(initial) != expected) return 1;
+
+    // Size-based rotation: every closed file holds exactly its records.
+    logit::FileLogger::Config rotate_cfg = cfg;
+    rotate_cfg.directory = "mmap_rotation_test";
+    rotate_cfg.max_file_size_bytes = 1000;
+    std::string rotate_path;
+    {
+        logit::FileLogger logger(rotate_cfg);
+        rotate_path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        for (int i = 0; i < 200; ++i) {
+            logger.log(make_record(), "rotation record " + std::to_string(i));
+        }
+        const std::string rotated = rotate_path.substr(0, rotate_path.size() - 4) + ".001.log";
+        const std::string content = read_file(rotated);
+        if (content.empty() || content.size() > rotate_cfg.max_file_size_bytes) return 1;
+        if (content.find('\0') != std::string::npos || content[content.size() - 1] != '\n') return 1;
+    }
+    if (disk_size(rotate_path) > rotate_cfg.max_file_size_bytes) return 1;
+
+    // Binary records may end with zero bytes: framing finds the end after a crash.
+    logit::FileLogger::Config binary_cfg = cfg;
+    binary_cfg.directory = "mmap_binary_test";
+    binary_cfg.binary = true;
+    binary_cfg.framed = true;
+    const std::string zero_record("binary\0\0", 8);
+    std::string binary_path;
+    {
+        logit::FileLogger logger(binary_cfg);
+        binary_path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        for (int i = 0; i < 3; ++i) logger.log(make_record(), zero_record);
+    }
+    {
+        std::ofstream f(binary_path.c_str(), std::ios::binary | std::ios::app);
+        f << std::string(5000, '\0');
+    }
+    {
+        logit::FileLogger logger(binary_cfg);
+        logger.log(make_record(), zero_record);
+    }
+    if (logit::read_framed_log(binary_path) != zero_record + zero_record + zero_record + zero_record) return 1;
+
+    // Nothing marks the end of unframed binary logs in a preallocated file.
+    binary_cfg.directory = "mmap_binary_unframed_test";
+    binary_cfg.framed = false;
+    try {
+        logit::FileLogger logger(binary_cfg);
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+    return 0;
+}
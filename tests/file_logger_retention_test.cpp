@@ -0,0 +1,52 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Checks the retention scheduler: startup and periodic passes remove expired files,
+// while writes alone leave the directory untouched until wait() requests a pass.
+
+int main() {
+    const std::string dir = logit::get_exec_dir() + "/retention_test";
+    logit::create_directories(dir);
+    const std::string startup_old = dir + "/2000-01-01.log";
+    const std::string periodic_old = dir + "/2000-01-02.log";
+    const std::string shutdown_old = dir + "/2000-01-03.log";
+    std::ofstream(startup_old.c_str()).close();
+
+    {
+        logit::FileLogger::Config cfg;
+        cfg.directory = "retention_test";
+        cfg.async = false;
+        cfg.retention_interval_ms = 20;
+        logit::FileLogger logger(cfg);
+        if (file_exists(startup_old)) return 1;
+
+        // Files that appear later are picked up by the periodic rescan.
+        std::ofstream(periodic_old.c_str()).close();
+        logger.wait_maintenance();
+        if (file_exists(periodic_old)) return 1;
+    }
+
+    logit::FileLogger::Config cfg;
+    cfg.directory = "retention_test";
+    cfg.async = false;
+    cfg.retention_interval_ms = 0;
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(), "first");
+        std::ofstream(shutdown_old.c_str()).close();
+        logger.log(make_record(), "second");
+        logger.log(make_record(), "third");
+        if (!file_exists(shutdown_old)) return 1;
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        // wait() only requests the pass; the destructor completes it.
+        logger.wait();
+    }
+
+    if (file_exists(shutdown_old)) return 1;
+    if (!file_exists(current)) return 1;
+    return 0;
+}
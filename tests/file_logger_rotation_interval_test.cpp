@@ -0,0 +1,59 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Checks hourly rotation on record timestamps and that rotation continues the sequence
+// of files left by an earlier run and trims them to `max_rotated_files`.
+
+int main() {
+    std::system("rm -rf rotation_hourly rotation_resume");
+    const int64_t minute = 60 * 1000;
+    const int64_t base = (time_shield::start_of_day(time_shield::ms_to_sec(LOGIT_CURRENT_TIMESTAMP_MS())) + 3600) * 1000;
+
+    logit::FileLogger::Config cfg;
+    cfg.directory = "rotation_hourly";
+    cfg.async = false;
+    cfg.rotation_interval_minutes = 60;
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(base), "a");
+        logger.log(make_record(base + 10 * minute), "b");
+        logger.log(make_record(base + 65 * minute), "c");
+        logger.log(make_record(base + 130 * minute), "d");
+        // A late record of the previous hour stays in the current file.
+        logger.log(make_record(base + 119 * minute), "e");
+        logger.log(make_record(base + 131 * minute), "f");
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+    const std::string stem = current.substr(0, current.size() - 4);
+    if (read_file(stem + ".001.log") != "a\nb\n") return 1;
+    if (read_file(stem + ".002.log") != "c\n") return 1;
+    if (read_file(current) != "d\ne\nf\n") return 1;
+    if (file_exists(stem + ".003.log")) return 1;
+
+    // Size rotation after a restart continues after the highest existing index.
+    const std::string dir = logit::get_exec_dir() + "/rotation_resume";
+    logit::create_directories(dir);
+    const std::string date = current.substr(current.find_last_of("/\\") + 1, 10);
+    std::ofstream(dir + "/" + date + ".001.log") << "old\n";
+    std::ofstream(dir + "/" + date + ".005.log") << "old\n";
+    logit::FileLogger::Config size_cfg;
+    size_cfg.directory = "rotation_resume";
+    size_cfg.async = false;
+    size_cfg.max_file_size_bytes = 4;
+    size_cfg.max_rotated_files = 2;
+    {
+        logit::FileLogger logger(size_cfg);
+        logger.log(make_record(base), "x1");
+        logger.log(make_record(base + 1), "x2");
+        logger.log(make_record(base + 2), "x3");
+    }
+    if (file_exists(dir + "/" + date + ".001.log") || file_exists(dir + "/" + date + ".005.log")) return 1;
+    if (read_file(dir + "/" + date + ".006.log") != "x1\n") return 1;
+    if (read_file(dir + "/" + date + ".007.log") != "x2\n") return 1;
+    if (read_file(dir + "/" + date + ".log") != "x3\n") return 1;
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Rotated files of the same date in a subdirectory of the log directory belong to
+// someone else: they must neither move the sequence numbers nor be removed by
+// `max_rotated_files`.
+
+int main() {
+    std::system("rm -rf rotation_subdir && mkdir -p rotation_subdir/archive");
+    const int64_t now_ms = LOGIT_CURRENT_TIMESTAMP_MS();
+    const std::string date = time_shield::to_iso8601_date(time_shield::start_of_day(time_shield::ms_to_sec(now_ms)));
+    const std::string dir = logit::get_exec_dir() + "/rotation_subdir";
+    const std::string foreign = dir + "/archive/" + date + ".007.log";
+    {
+        std::ofstream f(foreign.c_str());
+        f << "foreign\n";
+    }
+
+    logit::FileLogger::Config cfg;
+    cfg.directory = "rotation_subdir";
+    cfg.async = false;
+    cfg.max_file_size_bytes = 20;
+    cfg.max_rotated_files = 1;
+    cfg.naming = logit::RotationNaming::Sequence;
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 0; i < 3; ++i) logger.log(make_record(now_ms), "0123456789");
+    }
+
+    if (!file_exists(foreign)) return 1;
+    if (file_exists(dir + "/" + date + ".001.log")) return 1;
+    if (!file_exists(dir + "/" + date + ".002.log")) return 1;
+    return file_exists(dir + "/" + date + ".008.log") ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#if defined(LOGIT_HAS_ZSTD)
+#include <zstd.h>
+#include <string>
+
+// Checks seekable zstd output: frames end at record boundaries, the seek table maps
+// timestamps to frames, a time range decompresses only a few frames, reopening extends
+// the table and regular zstd decoders still read the file.
+
+static std::string zstd_decode(const std::string& data) {
+    std::string out;
+    ZSTD_DStream* stream = ZSTD_createDStream();
+    ZSTD_inBuffer in = { data.data(), data.size(), 0 };
+    char buf[65536];
+    while (in.pos < in.size) {
+        ZSTD_outBuffer o = { buf, sizeof(buf), 0 };
+        if (ZSTD_isError(ZSTD_decompressStream(stream, &o, &in))) break;
+        out.append(buf, o.pos);
+    }
+    ZSTD_freeDStream(stream);
+    return out;
+}
+
+static std::string line(int i) {
+    return "seekable record " + std::to_string(i);
+}
+
+int main() {
+    const int64_t base = time_shield::start_of_day(time_shield::ms_to_sec(LOGIT_CURRENT_TIMESTAMP_MS())) * 1000 + 1000;
+    logit::FileLogger::Config cfg;
+    cfg.directory = "seekable_zstd_test";
+    cfg.async = false;
+    cfg.compress = logit::CompressType::ZSTD;
+    cfg.write_mode = logit::FileWriteMode::BufferedFd;
+    cfg.compress_live = true;
+    cfg.compress_seekable = true;
+    cfg.compress_frame_bytes = 4096;
+    std::string expected;
+    std::string path;
+    {
+        logit::FileLogger logger(cfg);
+        path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        for (int i = 0; i < 5000; ++i) {
+            logger.log(logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, base + i * 10, __FILE__, __LINE__,
+                                        LOGIT_FUNCTION, "", "", 0, false), line(i));
+            expected += line(i) + "\n";
+        }
+    }
+    if (zstd_decode(read_file(path)) != expected) return 1;
+
+    logit::SeekableZstdReader reader(path);
+    if (!reader.has_seek_table() || reader.frames().size() < 10) return 1;
+    if (reader.read_all() != expected) return 1;
+    const std::string window = reader.read_range(base + 20000, base + 21000);
+    if (window.find(line(2000) + "\n") == std::string::npos) return 1;
+    if (window.find(line(2100) + "\n") == std::string::npos) return 1;
+    if (window.size() > 4 * cfg.compress_frame_bytes) return 1;
+    for (size_t i = 0; i < reader.frames().size(); ++i) {
+        const std::string frame = reader.read_range(reader.frames()[i].first_ts_ms, reader.frames()[i].first_ts_ms);
+        if (frame.empty() || frame[frame.size() - 1] != '\n') return 1;
+    }
+
+    // Appending after a restart keeps one table that covers all frames.
+    const size_t frames_before = reader.frames().size();
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 5000; i < 5100; ++i) {
+            logger.log(logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, base + i * 10, __FILE__, __LINE__,
+                                        LOGIT_FUNCTION, "", "", 0, false), line(i));
+            expected += line(i) + "\n";
+        }
+    }
+    logit::SeekableZstdReader reopened(path);
+    if (!reopened.has_seek_table() || reopened.frames().size() <= frames_before) return 1;
+    if (reopened.read_all() != expected) return 1;
+    if (reopened.read_range(base + 50500, base + 50600).find(line(5050)) == std::string::npos) return 1;
+    return 0;
+}
+#else
+int main() { return 0; }
+#endif
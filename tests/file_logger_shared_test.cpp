@@ -0,0 +1,160 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Several processes write one directory with size rotation in shared mode. Every record
+// must end up exactly once, intact, and no file may grow beyond the size limit, also when
+// rotated files are compressed right away or many processes rotate at the same time.
+
+static const int process_count = 4;
+static const int record_count = 400;
+static const uint64_t max_size = 2048;
+
+static std::vector<std::string> list_logs(const std::string& dir, const std::string& suffix = ".log") {
+    std::vector<std::string> files;
+    DIR* d = opendir(dir.c_str());
+    if (!d) return files;
+    while (dirent* entry = readdir(d)) {
+        const std::string name = entry->d_name;
+        if (name.size() > suffix.size() && name.substr(name.size() - suffix.size()) == suffix) {
+            files.push_back(dir + "/" + name);
+        }
+    }
+    closedir(d);
+    return files;
+}
+
+// Starts the writers together: each waits until the parent closes the barrier pipe.
+static void run_writers(const logit::FileLogger::Config& cfg, int processes = process_count) {
+    int barrier[2];
+    if (pipe(barrier) != 0) std::abort();
+    std::vector<pid_t> children;
+    for (int p = 0; p < processes; ++p) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            close(barrier[1]);
+            char byte;
+            while (read(barrier[0], &byte, 1) > 0) {}
+            {
+                logit::FileLogger logger(cfg);
+                for (int i = 0; i < record_count; ++i) {
+                    char line[64];
+                    std::snprintf(line, sizeof(line), "process %d record %04d", p, i);
+                    logger.log(make_record(), line);
+                }
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    close(barrier[0]);
+    close(barrier[1]);
+    for (size_t i = 0; i < children.size(); ++i) waitpid(children[i], nullptr, 0);
+}
+
+// Adds the records of one file to `seen`; returns false on a malformed or duplicate record.
+static bool collect(const std::string& text, std::set<std::string>& seen) {
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        int p = -1;
+        int i = -1;
+        if (std::sscanf(line.c_str(), "process %d record %d", &p, &i) != 2 || line.size() != 21) return false;
+        if (!seen.insert(line).second) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::system("rm -rf shared_text_test shared_framed_test shared_gzip_test shared_contention_test");
+    const std::string exec_dir = logit::get_exec_dir();
+
+    logit::FileLogger::Config cfg;
+    cfg.async = false;
+    cfg.shared = true;
+    cfg.write_mode = logit::FileWriteMode::BufferedFd;
+    cfg.flush_level = logit::LogLevel::LOG_LVL_TRACE;
+    cfg.max_file_size_bytes = max_size;
+
+    cfg.directory = "shared_text_test";
+    run_writers(cfg);
+    std::vector<std::string> files = list_logs(exec_dir + "/shared_text_test");
+    if (files.size() < 10) return 1;
+    std::set<std::string> seen;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const std::string text = read_file(files[i]);
+        if (text.size() > max_size || !collect(text, seen)) return 1;
+    }
+    if (seen.size() != process_count * record_count) return 1;
+
+    // Many processes reaching the limit at once: each file is rotated once, failed
+    // reservations do not count, and the shared size matches the current file.
+    logit::FileLogger::Config contention_cfg = cfg;
+    contention_cfg.directory = "shared_contention_test";
+    contention_cfg.max_file_size_bytes = 256;
+    const int contention_processes = 10; // single-digit ids keep the record length fixed
+    run_writers(contention_cfg, contention_processes);
+    files = list_logs(exec_dir + "/shared_contention_test");
+    seen.clear();
+    std::string current;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const std::string text = read_file(files[i]);
+        if (text.size() > contention_cfg.max_file_size_bytes || !collect(text, seen)) return 1;
+        if (files[i].size() - files[i].rfind('/') - 1 == std::string("2024-01-01.log").size()) current = text;
+    }
+    if (seen.size() != contention_processes * record_count) return 1;
+    logit::detail::SharedLogState state;
+    if (!state.open(exec_dir + "/shared_contention_test/" LOGIT_SHARED_STATE_NAME)) return 1;
+    if (state.header().size.load() != current.size()) return 1;
+    state.close();
+
+#   if defined(LOGIT_HAS_ZLIB)
+    // Records appended while another process rotates must not end up in the compressed copy.
+    logit::FileLogger::Config gzip_cfg = cfg;
+    gzip_cfg.directory = "shared_gzip_test";
+    gzip_cfg.compress = logit::CompressType::GZIP;
+    gzip_cfg.compress_async = false;
+    run_writers(gzip_cfg);
+    seen.clear();
+    files = list_logs(exec_dir + "/shared_gzip_test");
+    const std::vector<std::string> compressed = list_logs(exec_dir + "/shared_gzip_test", ".log.gz");
+    if (files.size() != 1 || compressed.empty() || !collect(read_file(files[0]), seen)) return 1;
+    for (size_t i = 0; i < compressed.size(); ++i) {
+        if (!collect(gunzip(read_file(compressed[i])), seen)) return 1;
+    }
+    if (seen.size() != process_count * record_count) return 1;
+#   endif
+
+    // Framed records get one sequence across all processes.
+    cfg.directory = "shared_framed_test";
+    cfg.framed = true;
+    run_writers(cfg);
+    files = list_logs(exec_dir + "/shared_framed_test");
+    seen.clear();
+    uint64_t records = 0;
+    uint64_t highest = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const logit::FrameScanResult scan = logit::scan_framed_log(files[i]);
+        if (!scan.framed || scan.torn_tail() || scan.file_size > max_size) return 1;
+        for (size_t g = 0; g < scan.gaps.size(); ++g) {
+            if (scan.gaps[g].bytes != 0) return 1;
+        }
+        records += scan.records;
+        if (scan.last_sequence > highest) highest = scan.last_sequence;
+        if (!collect(logit::read_framed_log(files[i]), seen)) return 1;
+    }
+    if (records != process_count * record_count || highest != records) return 1;
+    return seen.size() == records ? 0 : 1;
+}
+#endif
@@ -0,0 +1,115 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Writes records with known timestamps, checks the `.idx` sidecar and reads time ranges
+// back with LogReader from the current file and from a rotated, compressed file.
+
+static std::string make_line(int i) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "line %02d", i);
+    return buf; // 8 bytes with the newline
+}
+
+static bool has_lines(const std::string& text, int first, int last) {
+    for (int i = first; i <= last; ++i) {
+        if (text.find(make_line(i)) == std::string::npos) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::system("rm -rf time_index_test time_index_rotation_test time_index_zstd_test");
+    const int64_t base = (time_shield::start_of_day(time_shield::ms_to_sec(LOGIT_CURRENT_TIMESTAMP_MS())) + 3600) * 1000;
+
+    logit::FileLogger::Config cfg;
+    cfg.directory = "time_index_test";
+    cfg.async = false;
+    cfg.time_index = true;
+    cfg.time_index_records = 4;
+    cfg.time_index_interval_ms = 0;
+    std::string current;
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 0; i < 20; ++i) logger.log(make_record(base + i * 100), make_line(i));
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+
+    // Every fourth record is indexed.
+    std::vector<logit::TimeIndexEntry> entries;
+    if (!logit::detail::read_time_index(current + ".idx", entries) || entries.size() != 5) return 1;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].timestamp_ms != base + static_cast<int64_t>(i) * 400) return 1;
+        if (entries[i].offset != i * 32) return 1;
+    }
+
+    const logit::LogReader reader(current);
+    if (!reader.has_index()) return 1;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    reader.locate(base + 500, base + 700, begin, end);
+    if (begin != 32 || end != 64) return 1;
+    const std::string range = reader.read_range(base + 500, base + 700);
+    if (range.size() != 32 || !has_lines(range, 4, 7)) return 1;
+    if (reader.read_range(base + 1700, base + 5000).find(make_line(19)) == std::string::npos) return 1;
+    if (!reader.read_range(base + 700, base + 500).empty()) return 1;
+
+    // Reopening keeps the index in step with the file.
+    {
+        logit::FileLogger logger(cfg);
+        logger.log(make_record(base + 2000), make_line(20));
+    }
+    if (!logit::detail::read_time_index(current + ".idx", entries) || entries.size() != 6) return 1;
+    if (entries.back().timestamp_ms != base + 2000 || entries.back().offset != 160) return 1;
+
+#   if defined(LOGIT_HAS_ZLIB)
+    // The index follows a file through rotation and compression.
+    cfg.directory = "time_index_rotation_test";
+    cfg.compress = logit::CompressType::GZIP;
+    cfg.compress_async = false;
+    cfg.max_file_size_bytes = 80;
+    {
+        logit::FileLogger logger(cfg);
+        for (int i = 0; i < 20; ++i) logger.log(make_record(base + i * 100), make_line(i));
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+    const std::string rotated = current.substr(0, current.size() - 4) + ".001.log.gz";
+    if (!logit::LogReader(rotated).has_index()) return 1;
+    const std::vector<std::string> files =
+        logit::LogReader::find_files(logit::get_exec_dir() + "/time_index_rotation_test", base, base + 2000);
+    if (files.size() != 2) return 1;
+    if (files[0].substr(files[0].size() - 11) != ".001.log.gz" || files[1].substr(files[1].size() - 4) != ".log") return 1;
+    const std::string old_range = logit::LogReader(files[0]).read_range(base + 100, base + 300);
+    if (!has_lines(old_range, 1, 3) || old_range.find(make_line(8)) != std::string::npos) return 1;
+    const std::string new_range = logit::LogReader(files[1]).read_range(base + 1500, base + 1600);
+    if (!has_lines(new_range, 15, 16) || new_range.find(make_line(10)) != std::string::npos) return 1;
+#   endif
+
+#   if defined(LOGIT_HAS_ZSTD)
+    // Seekable zstd output is read from the frame that holds the first indexed record.
+    logit::FileLogger::Config zcfg;
+    zcfg.directory = "time_index_zstd_test";
+    zcfg.async = false;
+    zcfg.time_index = true;
+    zcfg.time_index_records = 4;
+    zcfg.time_index_interval_ms = 0;
+    zcfg.compress = logit::CompressType::ZSTD;
+    zcfg.write_mode = logit::FileWriteMode::BufferedFd;
+    zcfg.compress_live = true;
+    zcfg.compress_seekable = true;
+    zcfg.compress_frame_bytes = 40;
+    {
+        logit::FileLogger logger(zcfg);
+        for (int i = 0; i < 20; ++i) logger.log(make_record(base + i * 100), make_line(i));
+        current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+    const logit::LogReader zreader(current);
+    if (!zreader.has_index() || zreader.index().size() != 5) return 1;
+    const std::string zrange = zreader.read_range(base + 900, base + 1100);
+    if (zrange.size() != 32 || !has_lines(zrange, 8, 11)) return 1;
+#   endif
+    return 0;
+}
@@ -19,6 +19,13 @@ public:
             return m_last_file;
         case logit::LoggerParam::LastLogTimestamp:
         case logit::LoggerParam::TimeSinceLastLog:
+        case logit::LoggerParam::FlushCount:
+        case logit::LoggerParam::WriteCallCount:
+        case logit::LoggerParam::BytesWritten:
+        case logit::LoggerParam::BytesPerWrite:
+        case logit::LoggerParam::CompressionQueueDepth:
+        case logit::LoggerParam::CompressionBytesPerSec:
+        case logit::LoggerParam::DroppedRecords:
             return {};
         }
         return {};
@@ -33,6 +40,14 @@ public:
         case logit::LoggerParam::LastFileName:
         case logit::LoggerParam::LastFilePath:
             return static_cast<int64_t>(m_count);
+        case logit::LoggerParam::FlushCount:
+        case logit::LoggerParam::WriteCallCount:
+        case logit::LoggerParam::BytesWritten:
+        case logit::LoggerParam::BytesPerWrite:
+        case logit::LoggerParam::CompressionQueueDepth:
+        case logit::LoggerParam::CompressionBytesPerSec:
+        case logit::LoggerParam::DroppedRecords:
+            return 0;
         }
         return 0;
     }
@@ -0,0 +1,66 @@
+#include <logit/formatter.hpp>
+#include <string>
+
+// Checks typed output, the field schema and the SIMD string escaper of JsonLogFormatter.
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+int main() {
+    // Escaper: long inputs exercise the vector path, short ones the scalar tail.
+    std::string input(70, 'a');
+    input[3] = '"';
+    input[20] = '\\';
+    input[40] = '\n';
+    input[69] = '\x01';
+    std::string expected(70, 'a');
+    expected.replace(69, 1, "\\u0001");
+    expected.replace(40, 1, "\\n");
+    expected.replace(20, 1, "\\\\");
+    expected.replace(3, 1, "\\\"");
+    if (logit::escape_json(input) != expected) return 1;
+    if (logit::escape_json("\xD0\x9F\xD1\x80\xD0\xB8") != "\xD0\x9F\xD1\x80\xD0\xB8") return 1;
+
+    logit::LogRecord record(
+        logit::LogLevel::LOG_LVL_WARN,
+        1700000000123,
+        "src/main.cpp",
+        42,
+        "run",
+        "",
+        "count, ratio, ok, name",
+        -1,
+        false);
+    record.args_array.emplace_back("count", -17);
+    record.args_array.emplace_back("ratio", 0.5);
+    record.args_array.emplace_back("ok", true);
+    record.args_array.emplace_back("name", std::string("say \"hi\""));
+
+    logit::JsonLogFormatter formatter;
+    const std::string json = formatter.format(record);
+    if (json.front() != '{' || json.back() != '}') return 1;
+    if (!contains(json, "\"timestamp_ms\":1700000000123")) return 1;
+    if (!contains(json, "\"level\":\"WARN\"")) return 1;
+    if (!contains(json, "\"line\":42")) return 1;
+    if (!contains(json, "\"args\":{\"count\":-17,\"ratio\":0.5,\"ok\":true,\"name\":\"say \\\"hi\\\"\"}")) return 1;
+    if (!contains(json, "\"message\":\"count: -17, ratio: 0.5, ok: true, say \\\"hi\\\"\"")) return 1;
+
+    // format_to appends to the existing buffer.
+    std::string buffer = "prefix";
+    formatter.format_to(record, buffer);
+    if (buffer != "prefix" + json) return 1;
+
+    // Custom schema with renamed keys and flattened arguments.
+    logit::JsonLogFormatter::Config config;
+    config.fields.clear();
+    config.fields.emplace_back(logit::RecordField::LevelValue, "lvl");
+    config.fields.emplace_back(logit::RecordField::FileName, "src");
+    config.fields.emplace_back(logit::RecordField::Args, "");
+    config.flatten_args = true;
+    logit::JsonLogFormatter custom(config);
+    const std::string flat = custom.format(record);
+    if (flat != "{\"lvl\":3,\"src\":\"main.cpp\",\"count\":-17,\"ratio\":0.5,\"ok\":true,\"name\":\"say \\\"hi\\\"\"}") return 1;
+
+    return 0;
+}
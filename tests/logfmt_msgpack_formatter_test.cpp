@@ -0,0 +1,90 @@
+#include <logit/formatter.hpp>
+#include <string>
+
+// Checks the typed output of LogfmtFormatter and the MessagePack encoding of MsgpackFormatter.
+
+static std::string bytes(const char* data, size_t size) {
+    return std::string(data, size);
+}
+
+int main() {
+    logit::LogRecord record(
+        logit::LogLevel::LOG_LVL_WARN,
+        1700000000123,
+        "src/main.cpp",
+        42,
+        "run",
+        "",
+        "count, ratio, ok, name",
+        -1,
+        false);
+    record.args_array.emplace_back("count", -17);
+    record.args_array.emplace_back("ratio", 0.5);
+    record.args_array.emplace_back("ok", true);
+    record.args_array.emplace_back("name", std::string("say \"hi\""));
+
+    // logfmt: bare numbers and booleans, quoted strings only when needed.
+    logit::LogfmtFormatter::Config logfmt_cfg;
+    logfmt_cfg.fields.clear();
+    logfmt_cfg.fields.emplace_back(logit::RecordField::Level, "level");
+    logfmt_cfg.fields.emplace_back(logit::RecordField::FileName, "src file");
+    logfmt_cfg.fields.emplace_back(logit::RecordField::Line, "line");
+    logfmt_cfg.fields.emplace_back(logit::RecordField::Args, "");
+    logit::LogfmtFormatter logfmt(logfmt_cfg);
+    const std::string line = logfmt.format(record);
+    if (line != "level=warn src_file=main.cpp line=42 count=-17 ratio=0.5 ok=true name=\"say \\\"hi\\\"\"") return 1;
+
+    std::string buffer = "prefix ";
+    logfmt.format_to(record, buffer);
+    if (buffer != "prefix " + line) return 1;
+
+    logit::LogfmtFormatter full;
+    const std::string full_line = full.format(record);
+    if (full_line.find("message=\"count: -17, ratio: 0.5, ok: true, say \\\"hi\\\"\"") == std::string::npos) return 1;
+
+    // MessagePack: nested argument map.
+    logit::MsgpackFormatter::Config pack_cfg;
+    pack_cfg.fields.clear();
+    pack_cfg.fields.emplace_back(logit::RecordField::TimestampMs, "ts");
+    pack_cfg.fields.emplace_back(logit::RecordField::Level, "lvl");
+    pack_cfg.fields.emplace_back(logit::RecordField::Args, "args");
+    logit::MsgpackFormatter msgpack(pack_cfg);
+    const std::string packed = msgpack.format(record);
+    const char expected[] =
+        "\x83"                                   // map with 3 entries
+        "\xA2" "ts" "\xCF\x00\x00\x01\x8B\xCF\xE5\x68\x7B"
+        "\xA3" "lvl" "\xA4" "WARN"
+        "\xA4" "args" "\x84"
+        "\xA5" "count" "\xEF"
+        "\xA5" "ratio" "\xCB\x3F\xE0\x00\x00\x00\x00\x00\x00"
+        "\xA2" "ok" "\xC3"
+        "\xA4" "name" "\xA8" "say \"hi\"";
+    if (packed != bytes(expected, sizeof(expected) - 1)) return 1;
+
+    // Flattened arguments extend the top-level map.
+    pack_cfg.flatten_args = true;
+    msgpack.set_config(pack_cfg);
+    const std::string flat = msgpack.format(record);
+    if (static_cast<unsigned char>(flat[0]) != 0x86) return 1;
+
+    // The message is written straight into the buffer behind its length header.
+    logit::MsgpackFormatter::Config message_cfg;
+    message_cfg.fields.clear();
+    message_cfg.fields.emplace_back(logit::RecordField::Message, "msg");
+    msgpack.set_config(message_cfg);
+    const std::string text = "count: -17, ratio: 0.5, ok: true, say \"hi\"";
+    if (msgpack.format(record) != bytes("\x81\xA3" "msg" "\xD9", 6) + static_cast<char>(text.size()) + text) return 1;
+    logit::LogRecord plain(logit::LogLevel::LOG_LVL_INFO, 0, "a.cpp", 1, "f", "short", "", -1, false);
+    if (msgpack.format(plain) != bytes("\x81\xA3" "msg" "\xA5" "short", 11)) return 1;
+
+    // Integer widths.
+    std::string ints;
+    logit::MsgpackFormatter::append_int(ints, -1);
+    logit::MsgpackFormatter::append_int(ints, 127);
+    logit::MsgpackFormatter::append_int(ints, 200);
+    logit::MsgpackFormatter::append_int(ints, -200);
+    logit::MsgpackFormatter::append_int(ints, 70000);
+    if (ints != bytes("\xFF\x7F\xCC\xC8\xD1\xFF\x38\xCE\x00\x01\x11\x70", 12)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#if defined(_WIN32)
+int main() { return 0; }
+#else
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Wraps a small ring several times and reads the newest records back in order, continues
+// the sequence after a restart and keeps records of a process killed with SIGKILL.
+
+static std::string make_line(int i) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "record %05d", i);
+    return buf; // 12 bytes with the newline, 32 bytes per frame
+}
+
+// Returns true if `text` holds consecutive records `first`..`last`.
+static bool has_run(const std::string& text, int first, int last) {
+    std::string expected;
+    for (int i = first; i <= last; ++i) expected += make_line(i) + "\n";
+    return text == expected;
+}
+
+int main() {
+    std::system("rm -rf ring_test");
+    logit::RingFileLogger::Config cfg;
+    cfg.directory = "ring_test";
+    cfg.size_bytes = 4096;
+    std::string path;
+    {
+        logit::RingFileLogger logger(cfg);
+        for (int i = 1; i <= 1000; ++i) logger.log(make_record(), make_line(i));
+        path = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    }
+    logit::RingScanResult scan = logit::scan_ring_log(path, [](uint64_t, const char*, size_t) {});
+    if (!scan.valid || scan.capacity != 4096 || scan.generation == 0) return 1;
+    if (scan.records != 128 || scan.last_sequence != 1000 || scan.first_sequence != 873) return 1;
+    if (!has_run(logit::read_ring_log(path), 873, 1000)) return 1;
+
+    // A restart continues after the newest record.
+    {
+        logit::RingFileLogger logger(cfg);
+        logger.log(make_record(), make_line(1001));
+    }
+    scan = logit::scan_ring_log(path, [](uint64_t, const char*, size_t) {});
+    if (scan.last_sequence != 1001 || !has_run(logit::read_ring_log(path), 874, 1001)) return 1;
+
+    // Records survive a process that is killed without any cleanup.
+    const pid_t pid = fork();
+    if (pid == 0) {
+        logit::RingFileLogger* logger = new logit::RingFileLogger(cfg);
+        for (int i = 1002; i <= 1050; ++i) logger->log(make_record(), make_line(i));
+        ::kill(::getpid(), SIGKILL);
+        _exit(1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFSIGNALED(status)) return 1;
+    return has_run(logit::read_ring_log(path), 923, 1050) ? 0 : 1;
+}
+#endif
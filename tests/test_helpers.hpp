@@ -0,0 +1,78 @@
+#pragma once
+#ifndef _LOGIT_TEST_HELPERS_HPP_INCLUDED
+#define _LOGIT_TEST_HELPERS_HPP_INCLUDED
+
+/// \file test_helpers.hpp
+/// \brief File access, record and decoding helpers shared by the tests.
+
+#include <logit.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if defined(LOGIT_HAS_ZLIB)
+#   include <zlib.h>
+#endif
+
+/// \brief Returns the content of a file, or an empty string if it cannot be read.
+inline std::string read_file(const std::string& path) {
+    std::ifstream f(path.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+/// \brief Replaces the content of a file.
+inline void write_file(const std::string& path, const std::string& content) {
+    std::ofstream f(path.c_str(), std::ios::binary | std::ios::trunc);
+    f.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+/// \brief Returns true if the file can be opened.
+inline bool file_exists(const std::string& path) {
+    std::ifstream f(path.c_str());
+    return f.good();
+}
+
+/// \brief Returns a record of the calling function with the current time.
+inline logit::LogRecord make_record(logit::LogLevel level = logit::LogLevel::LOG_LVL_INFO) {
+    return logit::LogRecord(level, LOGIT_CURRENT_TIMESTAMP_MS(), __FILE__, __LINE__,
+                            LOGIT_FUNCTION, "", "", 0, false);
+}
+
+/// \brief Returns an info record with the given timestamp.
+inline logit::LogRecord make_record(int64_t timestamp_ms) {
+    return logit::LogRecord(logit::LogLevel::LOG_LVL_INFO, timestamp_ms, __FILE__, __LINE__,
+                            LOGIT_FUNCTION, "", "", 0, false);
+}
+
+#if defined(LOGIT_HAS_ZLIB)
+/// \brief Decodes concatenated gzip members; stops quietly at the end of a partial member.
+/// \param members Receives the number of complete members (optional).
+inline std::string gunzip(const std::string& data, int* members = nullptr) {
+    std::string out;
+    size_t pos = 0;
+    int count = 0;
+    while (pos < data.size()) {
+        z_stream zs = z_stream();
+        if (inflateInit2(&zs, 15 + 16) != Z_OK) break;
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data() + pos));
+        zs.avail_in = static_cast<uInt>(data.size() - pos);
+        char buf[4096];
+        int res = Z_OK;
+        while (res == Z_OK) {
+            zs.next_out = reinterpret_cast<Bytef*>(buf);
+            zs.avail_out = sizeof(buf);
+            res = inflate(&zs, Z_NO_FLUSH);
+            out.append(buf, sizeof(buf) - zs.avail_out);
+        }
+        pos = data.size() - zs.avail_in;
+        inflateEnd(&zs);
+        if (res != Z_STREAM_END) break;
+        ++count;
+    }
+    if (members) *members = count;
+    return out;
+}
+#endif
+
+#endif // _LOGIT_TEST_HELPERS_HPP_INCLUDED
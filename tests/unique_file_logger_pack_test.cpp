@@ -0,0 +1,91 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Writes messages with UniqueFileLogger in pack mode and reads each one back through the
+// reference reported as LastFilePath: one segment and one index instead of a file per
+// message, new segments once a segment is full, and per-message compression.
+
+static std::string make_message(int i) {
+    return "request " + std::to_string(i) + " {\"user\":" + std::to_string(i * 7919 % 1000) +
+           ",\"items\":[1,2,3],\"status\":\"ok\",\"status\":\"ok\",\"status\":\"ok\"}\n";
+}
+
+static size_t count_files(const std::string& directory) {
+    return logit::get_list_files(logit::get_exec_dir() + "/" + directory).size();
+}
+
+/// Logs `count` messages synchronously and checks every reference.
+static bool check_sync(const std::string& directory, logit::CompressType compress, uint64_t segment_size,
+                       int count, size_t& files) {
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = directory;
+    cfg.async = false;
+    cfg.pack = true;
+    cfg.pack_segment_size = segment_size;
+    cfg.compress = compress;
+    std::vector<std::string> references;
+    {
+        logit::UniqueFileLogger logger(cfg);
+        for (int i = 0; i < count; ++i) {
+            logger.log(make_record(), make_message(i));
+            references.push_back(logger.get_string_param(logit::LoggerParam::LastFilePath));
+        }
+        const std::string name = logger.get_string_param(logit::LoggerParam::LastFileName);
+        const std::string& last = references.back();
+        if (name.empty() || name.find('/') != std::string::npos ||
+            last.compare(last.size() - name.size(), name.size(), name) != 0) return false;
+    }
+    std::string segment;
+    uint64_t id = 0;
+    for (int i = 0; i < count; ++i) {
+        std::string path;
+        if (!logit::UniquePackReader::parse_reference(references[i], path, id)) return false;
+        if (path.size() < 5 || path.substr(path.size() - 5) != ".pack") return false;
+        if (logit::UniquePackReader::read_reference(references[i]) != make_message(i)) return false;
+        segment = path;
+    }
+    // Ids restart at 0 in every segment and the index covers all messages of the last one.
+    logit::UniquePackReader reader(segment);
+    if (reader.entries().empty() || reader.entries().back().id != id) return false;
+    if (reader.compress() != compress) return false;
+    for (const auto& entry : reader.entries()) {
+        if (compress != logit::CompressType::NONE && entry.length >= make_message(0).size()) return false;
+    }
+    if (!logit::UniquePackReader::parse_reference(references.front(), segment, id) || id != 0) return false;
+    files = count_files(directory);
+    return true;
+}
+
+int main() {
+    std::system("rm -rf unique_pack_test unique_pack_rotation_test unique_pack_gzip_test unique_pack_async_test");
+    size_t files = 0;
+
+    // One segment and its index hold every message.
+    if (!check_sync("unique_pack_test", logit::CompressType::NONE, 64 * 1024 * 1024, 1000, files)) return 1;
+    if (files != 2) return 1;
+
+    // A small segment size starts new segments; old references stay valid.
+    if (!check_sync("unique_pack_rotation_test", logit::CompressType::NONE, 4096, 300, files)) return 1;
+    if (files < 6 || files % 2 != 0) return 1;
+
+#   if defined(LOGIT_HAS_ZLIB)
+    // Each message is a gzip member of its own.
+    if (!check_sync("unique_pack_gzip_test", logit::CompressType::GZIP, 64 * 1024 * 1024, 200, files)) return 1;
+    if (files != 2) return 1;
+#   endif
+
+    // Asynchronous logging reports the last message of the calling thread.
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = "unique_pack_async_test";
+    cfg.async = true;
+    cfg.pack = true;
+    logit::UniqueFileLogger logger(cfg);
+    for (int i = 0; i < 200; ++i) logger.log(make_record(), make_message(i));
+    const std::string last = logger.get_string_param(logit::LoggerParam::LastFilePath);
+    if (last.size() < 4 || last.substr(last.size() - 4) != "#199") return 1;
+    if (logit::UniquePackReader::read_reference(last) != make_message(199)) return 1;
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <logit/utils.hpp>
+#include <clocale>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+
+// Checks the allocation-free numeric rendering of VariableValue and the stack-buffer path of format().
+
+static bool renders(const logit::VariableValue& value, const std::string& expected) {
+    std::string out = "x=";
+    value.append_to(out);
+    if (out != "x=" + expected) return false;
+    if (value.to_string() != expected) return false;
+    char buffer[64];
+    const size_t size = value.write_to(buffer, sizeof(buffer));
+    return size == expected.size() && std::string(buffer, size) == expected;
+}
+
+int main() {
+    if (!renders(logit::VariableValue("v", 0), "0")) return 1;
+    if (!renders(logit::VariableValue("v", -17), "-17")) return 1;
+    if (!renders(logit::VariableValue("v", std::numeric_limits<int64_t>::min()), "-9223372036854775808")) return 1;
+    if (!renders(logit::VariableValue("v", std::numeric_limits<uint64_t>::max()), "18446744073709551615")) return 1;
+    if (!renders(logit::VariableValue("v", static_cast<uint8_t>(200)), "200")) return 1;
+    if (!renders(logit::VariableValue("v", true), "true")) return 1;
+    if (!renders(logit::VariableValue("v", 'c'), "c")) return 1;
+
+    // Shortest representation that parses back to the same value.
+    if (!renders(logit::VariableValue("v", 0.5), "0.5")) return 1;
+    if (!renders(logit::VariableValue("v", 0.1), "0.1")) return 1;
+    if (!renders(logit::VariableValue("v", 0.1 + 0.2), "0.30000000000000004")) return 1;
+    if (!renders(logit::VariableValue("v", 1e20), "1e+20")) return 1;
+    if (!renders(logit::VariableValue("v", 2.5f), "2.5")) return 1;
+    if (!renders(logit::VariableValue("v", 0.1f), "0.1")) return 1;
+    if (!renders(logit::VariableValue("v", std::numeric_limits<double>::infinity()), "inf")) return 1;
+
+    if (!renders(logit::VariableValue("v", 1.0 / 3.0), "0.3333333333333333")) return 1;
+    if (!renders(logit::VariableValue("v", 1e23), "1e+23")) return 1;
+    if (!renders(logit::VariableValue("v", 5e-324), "5e-324")) return 1;
+    if (!renders(logit::VariableValue("v", 1.0f / 3.0f), "0.33333334")) return 1;
+
+    // A locale with a decimal comma still renders a point.
+    if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") || std::setlocale(LC_NUMERIC, "de_DE")) {
+        const bool ok = renders(logit::VariableValue("v", 1.0 / 3.0), "0.3333333333333333") &&
+                        renders(logit::VariableValue("v", 0.5f), "0.5");
+        std::setlocale(LC_NUMERIC, "C");
+        if (!ok) return 1;
+    }
+
+    if (!renders(logit::VariableValue("v", std::string("hello")), "hello")) return 1;
+    const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+    if (!renders(logit::VariableValue("v", ec), ec.message() + " (" + std::to_string(ec.value()) + ")")) return 1;
+
+    // write_to reports the full length even when the buffer is too small.
+    char small[4];
+    if (logit::VariableValue("v", 123456).write_to(small, sizeof(small)) != 6) return 1;
+    if (std::string(small, 4) != "1234") return 1;
+
+    // format() falls back to the heap for long results.
+    const std::string long_text(1000, 'a');
+    if (logit::format("%s-%d", long_text.c_str(), 7) != long_text + "-7") return 1;
+    if (logit::format("%d:%s", 3, "ok") != "3:ok") return 1;
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <logit.hpp>
+#include "test_helpers.hpp"
+#if defined(LOGIT_HAS_ZSTD)
+#include <zstd.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Trains a dictionary on sample output, stores it beside the logs and checks that
+// UniqueFileLogger and rotated FileLogger files reference it, shrink and read back.
+
+static std::string make_line(int i) {
+    static const char* const actions[] = { "login", "logout", "upload", "download" };
+    return "[2024-05-01 12:00:00.000] [INFO ] [thread:1234] user=" + std::to_string(i * 7919 % 1000) +
+           " action=" + actions[i % 4] + " path=/api/v1/items/" + std::to_string(i) +
+           " status=ok latency_ms=" + std::to_string(i % 97) + "\n";
+}
+
+static std::string unique_log(const std::string& directory, bool dictionary, const std::string& message) {
+    logit::UniqueFileLogger::Config cfg;
+    cfg.directory = directory;
+    cfg.async = false;
+    cfg.compress = logit::CompressType::ZSTD;
+    cfg.compress_level = 3;
+    if (dictionary) cfg.compress_dictionary = LOGIT_ZSTD_DICTIONARY_NAME;
+    logit::UniqueFileLogger logger(cfg);
+    logger.log(make_record(), message);
+    return logger.get_string_param(logit::LoggerParam::LastFilePath);
+}
+
+int main() {
+    std::system("rm -rf dict_unique_test dict_unique_plain_test dict_rotation_test");
+
+    std::string text;
+    for (int i = 0; i < 4000; ++i) text += make_line(i);
+    std::vector<std::string> samples;
+    logit::split_dictionary_samples(text, 1024, samples);
+    if (samples.size() < 100) return 1;
+    for (const auto& sample : samples) {
+        if (sample.size() > 1024 || sample[sample.size() - 1] != '\n') return 1;
+    }
+    const std::string content = logit::train_zstd_dictionary(samples, 16 * 1024);
+    if (content.empty() || content.size() > 16 * 1024) return 1;
+
+    const std::string unique_dir = logit::get_exec_dir() + "/dict_unique_test";
+    const std::string rotation_dir = logit::get_exec_dir() + "/dict_rotation_test";
+    logit::create_directories(unique_dir);
+    logit::create_directories(rotation_dir);
+    write_file(unique_dir + "/" + LOGIT_ZSTD_DICTIONARY_NAME, content);
+    write_file(rotation_dir + "/" + LOGIT_ZSTD_DICTIONARY_NAME, content);
+    const std::shared_ptr<const logit::ZstdDictionary> dictionary =
+        logit::ZstdDictionary::load(unique_dir + "/" + LOGIT_ZSTD_DICTIONARY_NAME, 3);
+    if (dictionary->id() == 0) return 1;
+
+    // One small file per message: the dictionary makes it much smaller.
+    const std::string message = make_line(5000) + make_line(5001);
+    const std::string with_dict = unique_log("dict_unique_test", true, message);
+    const std::string without_dict = unique_log("dict_unique_plain_test", false, message);
+    if (with_dict.size() < 8 || with_dict.substr(with_dict.size() - 8) != ".log.zst") return 1;
+    const std::string packed = read_file(with_dict);
+    const std::string plain = read_file(without_dict);
+    if (packed.empty() || plain.empty() || packed.size() * 3 / 2 > plain.size()) return 1;
+    if (ZSTD_getDictID_fromFrame(packed.data(), packed.size()) != dictionary->id()) return 1;
+    if (logit::SeekableZstdReader(with_dict, dictionary).read_all() != message) return 1;
+    if (logit::SeekableZstdReader(without_dict).read_all() != message) return 1;
+    // The dictionary survives the retention pass of the next logger.
+    unique_log("dict_unique_test", true, message);
+    if (read_file(unique_dir + "/" + LOGIT_ZSTD_DICTIONARY_NAME) != content) return 1;
+
+    // Rotated files are compressed against the dictionary as well.
+    logit::FileLogger::Config cfg;
+    cfg.directory = "dict_rotation_test";
+    cfg.async = false;
+    cfg.compress = logit::CompressType::ZSTD;
+    cfg.compress_level = 3;
+    cfg.compress_async = false;
+    cfg.compress_dictionary = LOGIT_ZSTD_DICTIONARY_NAME;
+    cfg.max_file_size_bytes = 300;
+    std::string rotated;
+    {
+        logit::FileLogger logger(cfg);
+        const std::string current = logger.get_string_param(logit::LoggerParam::LastFilePath);
+        logger.log(make_record(), make_line(1));
+        logger.log(make_record(), make_line(2));
+        logger.log(make_record(), make_line(3));
+        rotated = current.substr(0, current.size() - 4) + ".001.log.zst";
+    }
+    const std::string archive = read_file(rotated);
+    if (archive.empty() || ZSTD_getDictID_fromFrame(archive.data(), archive.size()) != dictionary->id()) return 1;
+    const std::string restored = logit::SeekableZstdReader(rotated, dictionary).read_all();
+    if (restored.find("path=/api/v1/items/1") == std::string::npos) return 1;
+    return 0;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,97 @@
+/// \file logit_decode.cpp
+/// \brief Command line tool that renders binary LogIt logs as text.
+///
+/// Usage:
+/// \code
+/// logit-decode [-p PATTERN] [-j] [-o OFFSET_MS] FILE...
+/// \endcode
+///
+/// - `-p PATTERN` pattern for `SimpleLogFormatter` (defaults to `LOGIT_FILE_LOGGER_PATTERN`).
+/// - `-j` print records as JSON using `JsonLogFormatter`.
+/// - `-o OFFSET_MS` timezone offset applied to timestamps, in milliseconds.
+///
+/// Framed logs (`FileLogger::Config::framed`) are unwrapped; framed text logs are printed
+/// as they are. `RingFileLogger` files are printed oldest record first.
+
+#include <logit.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [-p PATTERN] [-j] [-o OFFSET_MS] FILE..." << std::endl
+              << "  -p PATTERN    SimpleLogFormatter pattern (default: " << LOGIT_FILE_LOGGER_PATTERN << ")" << std::endl
+              << "  -j            print records as JSON" << std::endl
+              << "  -o OFFSET_MS  timezone offset in milliseconds" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string pattern = LOGIT_FILE_LOGGER_PATTERN;
+    bool json = false;
+    int64_t offset_ms = 0;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "-p" || arg == "--pattern") && i + 1 < argc) {
+            pattern = argv[++i];
+        } else if (arg == "-j" || arg == "--json") {
+            json = true;
+        } else if ((arg == "-o" || arg == "--offset") && i + 1 < argc) {
+            offset_ms = std::strtoll(argv[++i], nullptr, 10);
+        } else if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            print_usage(argv[0]);
+            return 2;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::unique_ptr<logit::ILogFormatter> formatter;
+    if (json) {
+        formatter.reset(new logit::JsonLogFormatter());
+    } else {
+        formatter.reset(new logit::SimpleLogFormatter(pattern));
+    }
+    formatter->set_timestamp_offset(offset_ms);
+
+    int status = 0;
+    for (const auto& path : files) {
+        try {
+            std::string content;
+            const logit::RingScanResult ring = logit::scan_ring_log(path,
+                [&content](uint64_t, const char* data, size_t size) { content.append(data, size); });
+            if (ring.valid) {
+                std::cout.write(content.data(), static_cast<std::streamsize>(content.size()));
+                continue;
+            }
+            const logit::FrameScanResult scan = logit::scan_framed_log(path,
+                [&content](uint64_t, const char* data, size_t size) { content.append(data, size); });
+            if (scan.framed && scan.records > 0 &&
+                !logit::BinaryLogReader::has_binary_header(content.data(), content.size())) {
+                std::cout.write(content.data(), static_cast<std::streamsize>(content.size()));
+                continue;
+            }
+            logit::BinaryLogReader reader(path);
+            reader.render(*formatter, std::cout);
+        } catch (const std::exception& e) {
+            std::cerr << "logit-decode: " << e.what() << std::endl;
+            status = 1;
+        }
+    }
+    std::cout.flush();
+    return status;
+}
@@ -0,0 +1,156 @@
+/// \file logit_range.cpp
+/// \brief Command line tool that prints the records of a time range from log files.
+///
+/// Usage:
+/// \code
+/// logit-range -f FROM -t TO [-D DICTIONARY] [-p PATTERN] PATH...
+/// \endcode
+///
+/// - `PATH` a log file (plain, `.gz` or `.zst`) or a log directory; directories contribute
+///   the current and rotated files dated within the range, in chronological order.
+/// - `-f FROM`, `-t TO` range bounds in UTC, as `YYYY-MM-DD[THH:MM[:SS[.mmm]]]` or as
+///   milliseconds since the epoch; both bounds are inclusive.
+/// - `-D DICTIONARY` zstd dictionary the files were compressed with.
+/// - `-p PATTERN` pattern used to render binary logs (defaults to `LOGIT_FILE_LOGGER_PATTERN`).
+///
+/// Files written with `FileLogger::Config::time_index` are read from the nearest index
+/// entries; the output may include records up to one index step outside the range.
+/// Files without an index are printed whole. Binary logs are decoded and filtered by the
+/// timestamp of each record.
+
+#include <logit.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " -f FROM -t TO [-D DICTIONARY] [-p PATTERN] PATH..." << std::endl
+              << "  -f FROM        start, YYYY-MM-DD[THH:MM[:SS[.mmm]]] (UTC) or epoch milliseconds" << std::endl
+              << "  -t TO          end (inclusive), same formats" << std::endl
+              << "  -D DICTIONARY  zstd dictionary of compressed files" << std::endl
+              << "  -p PATTERN     pattern for binary logs (default: " << LOGIT_FILE_LOGGER_PATTERN << ")" << std::endl;
+}
+
+bool is_directory(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR;
+}
+
+/// \brief Parses epoch milliseconds or a UTC date with an optional time.
+bool parse_time(const std::string& text, int64_t& ms) {
+    if (text.empty()) return false;
+    if (text.find('-') == std::string::npos) {
+        char* end = nullptr;
+        ms = std::strtoll(text.c_str(), &end, 10);
+        return end && *end == '\0';
+    }
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-') return false;
+    int hour = 0, minute = 0, second = 0, milli = 0;
+    if (text.size() > 10) {
+        if (text[10] != 'T' && text[10] != ' ') return false;
+        if (std::sscanf(text.c_str() + 11, "%d:%d:%d.%d", &hour, &minute, &second, &milli) < 2) return false;
+    }
+    ms = (time_shield::ts(text.substr(0, 10)) + hour * 3600 + minute * 60 + second) * 1000 + milli;
+    return true;
+}
+
+bool is_binary_log(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    char head[16] = {0};
+    file.read(head, sizeof(head));
+    return logit::BinaryLogReader::has_binary_header(head, static_cast<size_t>(file.gcount()));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int64_t from_ms = (std::numeric_limits<int64_t>::min)();
+    int64_t to_ms = (std::numeric_limits<int64_t>::max)();
+    bool has_from = false;
+    bool has_to = false;
+    std::string dictionary_path;
+    std::string pattern = LOGIT_FILE_LOGGER_PATTERN;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "-f" || arg == "--from") && i + 1 < argc) {
+            has_from = parse_time(argv[++i], from_ms);
+            if (!has_from) break;
+        } else if ((arg == "-t" || arg == "--to") && i + 1 < argc) {
+            has_to = parse_time(argv[++i], to_ms);
+            if (!has_to) break;
+        } else if ((arg == "-D" || arg == "--dictionary") && i + 1 < argc) {
+            dictionary_path = argv[++i];
+        } else if ((arg == "-p" || arg == "--pattern") && i + 1 < argc) {
+            pattern = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            print_usage(argv[0]);
+            return 2;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (!has_from || !has_to || paths.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::shared_ptr<const logit::ZstdDictionary> dictionary;
+    if (!dictionary_path.empty()) {
+        try {
+            dictionary = logit::ZstdDictionary::load(dictionary_path, 3);
+        } catch (const std::exception& e) {
+            std::cerr << "logit-range: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        if (is_directory(path)) {
+            const std::vector<std::string> found = logit::LogReader::find_files(path, from_ms, to_ms);
+            files.insert(files.end(), found.begin(), found.end());
+        } else {
+            files.push_back(path);
+        }
+    }
+
+    const logit::SimpleLogFormatter formatter(pattern);
+    int status = 0;
+    for (const auto& file : files) {
+        try {
+            if (is_binary_log(file)) {
+                logit::BinaryLogReader reader(file);
+                std::string line;
+                reader.for_each([&](const logit::LogRecord& record) {
+                    if (record.timestamp_ms < from_ms || record.timestamp_ms > to_ms) return;
+                    line.clear();
+                    formatter.format_to(record, line);
+                    line.push_back('\n');
+                    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+                });
+                continue;
+            }
+            const logit::LogReader reader(file, dictionary);
+            reader.read_range(from_ms, to_ms, [](const char* data, size_t size) {
+                std::cout.write(data, static_cast<std::streamsize>(size));
+            });
+        } catch (const std::exception& e) {
+            std::cerr << "logit-range: " << e.what() << std::endl;
+            status = 1;
+        }
+    }
+    std::cout.flush();
+    return status;
+}
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Symbolizes the backtraces in a crash log written by CrashPosixLogger.
+
+The crash log holds raw return addresses and a copy of /proc/self/maps. This
+script maps every address to a module and file offset and resolves it with
+addr2line, so no core dump is needed. Run it on a machine that has the same
+binaries (or their debug versions, see --root).
+
+    logit-symbolize crash.log
+    logit-symbolize --root /srv/symbols crash.log
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+FRAME_RE = re.compile(r"^#(\d+)\s+0x([0-9a-fA-F]+)")
+PC_RE = re.compile(r"^pc\s+0x([0-9a-fA-F]+)")
+MAPS_RE = re.compile(r"^([0-9a-f]+)-([0-9a-f]+)\s+(\S{4})\s+([0-9a-f]+)\s+\S+\s+\d+\s*(.*)$")
+
+
+def parse_crashes(lines):
+    """Splits the log into crashes, each with its frames and mappings."""
+    crashes = []
+    crash = None
+    section = None
+    for line in lines:
+        line = line.rstrip("\n")
+        if line.startswith("== CRASH SIGNAL"):
+            crash = {"header": line, "pc": None, "frames": [], "maps": []}
+            crashes.append(crash)
+            section = None
+            continue
+        if crash is None:
+            continue
+        if line.startswith("== ") and line.endswith(" =="):
+            section = line[3:-3]
+            continue
+        if section == "CONTEXT":
+            match = PC_RE.match(line)
+            if match:
+                crash["pc"] = int(match.group(1), 16)
+        elif section == "BACKTRACE":
+            match = FRAME_RE.match(line)
+            if match:
+                crash["frames"].append(int(match.group(2), 16))
+        elif section == "MAPS":
+            match = MAPS_RE.match(line)
+            if match and "x" in match.group(3) and match.group(5).startswith("/"):
+                crash["maps"].append((int(match.group(1), 16), int(match.group(2), 16),
+                                      int(match.group(4), 16), match.group(5)))
+    return crashes
+
+
+def locate(address, maps):
+    for start, end, offset, path in maps:
+        if start <= address < end:
+            return path, address - start + offset
+    return None, None
+
+
+def addr2line(module, offsets, addr2line_tool):
+    """Returns 'function at file:line' for each offset."""
+    if not os.path.exists(module):
+        return ["??"] * len(offsets)
+    cmd = [addr2line_tool, "-f", "-C", "-e", module] + ["0x%x" % o for o in offsets]
+    try:
+        out = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                             universal_newlines=True, check=False).stdout.splitlines()
+    except OSError:
+        return ["??"] * len(offsets)
+    names = []
+    for i in range(len(offsets)):
+        function = out[2 * i] if 2 * i < len(out) else "??"
+        location = out[2 * i + 1] if 2 * i + 1 < len(out) else "??:0"
+        names.append("%s at %s" % (function, location))
+    return names
+
+
+def symbolize(crash, root, addr2line_tool, out):
+    out.write(crash["header"] + "\n")
+    addresses = list(crash["frames"])
+    if crash["pc"] is not None:
+        addresses.insert(0, crash["pc"])
+    resolved = []
+    by_module = {}
+    for index, address in enumerate(addresses):
+        module, offset = locate(address, crash["maps"])
+        # Return addresses point after the call; look up the call itself.
+        if module is not None and offset > 0 and (crash["pc"] is None or index > 0):
+            offset -= 1
+        resolved.append((address, module, offset))
+        if module is not None:
+            by_module.setdefault(module, []).append(offset)
+    names = {}
+    for module, offsets in by_module.items():
+        path = os.path.join(root, module.lstrip("/")) if root else module
+        for offset, name in zip(offsets, addr2line(path, offsets, addr2line_tool)):
+            names[(module, offset)] = name
+    for index, (address, module, offset) in enumerate(resolved):
+        if module is None:
+            out.write("#%-3d 0x%016x ??\n" % (index, address))
+        else:
+            out.write("#%-3d 0x%016x %s+0x%x %s\n" % (index, address, os.path.basename(module), offset,
+                                                      names.get((module, offset), "??")))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolize CrashPosixLogger backtraces")
+    parser.add_argument("crash_log", help="crash log written by CrashPosixLogger")
+    parser.add_argument("--root", default="", help="directory that mirrors the crashed machine's file system")
+    parser.add_argument("--addr2line", default="addr2line", help="addr2line executable (e.g. llvm-addr2line)")
+    args = parser.parse_args()
+    with open(args.crash_log, "r", errors="replace") as f:
+        crashes = parse_crashes(f)
+    if not crashes:
+        sys.stderr.write("no crash found in %s\n" % args.crash_log)
+        return 1
+    for crash in crashes:
+        symbolize(crash, args.root, args.addr2line, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,131 @@
+/// \file logit_unique_extract.cpp
+/// \brief Command line tool that extracts messages from UniqueFileLogger segments.
+///
+/// Usage:
+/// \code
+/// logit-unique-extract [-l] [-o DIRECTORY] [-D DICTIONARY] REFERENCE...
+/// \endcode
+///
+/// - `REFERENCE` a segment (`*.pack`), which selects all its messages, or one message as
+///   `SEGMENT#ID`, the form `UniqueFileLogger` reports as `LastFilePath` in pack mode.
+/// - `-l` lists id, timestamp (ms), offset and stored length instead of the messages.
+/// - `-o DIRECTORY` writes each message to `DIRECTORY/<segment>-<id>.log` instead of
+///   standard output, restoring the one-file-per-message layout.
+/// - `-D DICTIONARY` zstd dictionary the messages were compressed with.
+
+#include <logit.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [-l] [-o DIRECTORY] [-D DICTIONARY] REFERENCE..." << std::endl
+              << "  REFERENCE      segment file, or SEGMENT#ID for one message" << std::endl
+              << "  -l             list the index instead of printing messages" << std::endl
+              << "  -o DIRECTORY   write each message to its own file" << std::endl
+              << "  -D DICTIONARY  zstd dictionary of compressed segments" << std::endl;
+}
+
+bool is_file(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFREG;
+}
+
+std::string base_name(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool list = false;
+    std::string output_dir;
+    std::string dictionary_path;
+    std::vector<std::string> references;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-l" || arg == "--list") {
+            list = true;
+        } else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output_dir = argv[++i];
+        } else if ((arg == "-D" || arg == "--dictionary") && i + 1 < argc) {
+            dictionary_path = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            print_usage(argv[0]);
+            return 2;
+        } else {
+            references.push_back(arg);
+        }
+    }
+    if (references.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::shared_ptr<const logit::ZstdDictionary> dictionary;
+    if (!dictionary_path.empty()) {
+        try {
+            dictionary = logit::ZstdDictionary::load(dictionary_path, 3);
+        } catch (const std::exception& e) {
+            std::cerr << "logit-unique-extract: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    int status = 0;
+    for (const auto& reference : references) {
+        try {
+            std::string segment = reference;
+            uint64_t id = 0;
+            bool single = false;
+            if (!is_file(reference)) {
+                single = logit::UniquePackReader::parse_reference(reference, segment, id);
+            }
+            logit::UniquePackReader reader(segment, dictionary);
+            std::vector<logit::UniquePackEntry> entries;
+            if (single) {
+                logit::UniquePackEntry entry;
+                if (!reader.find(id, entry)) {
+                    std::cerr << "logit-unique-extract: no message " << id << " in " << segment << std::endl;
+                    status = 1;
+                    continue;
+                }
+                entries.push_back(entry);
+            } else {
+                entries = reader.entries();
+            }
+            for (const auto& entry : entries) {
+                if (list) {
+                    std::cout << entry.id << '\t' << entry.timestamp_ms << '\t'
+                              << entry.offset << '\t' << entry.length << '\n';
+                    continue;
+                }
+                const std::string message = reader.read(entry);
+                if (output_dir.empty()) {
+                    std::cout.write(message.data(), static_cast<std::streamsize>(message.size()));
+                    continue;
+                }
+                const std::string path = output_dir + "/" + base_name(segment) + "-" + std::to_string(entry.id) + ".log";
+                std::ofstream file(path.c_str(), std::ios::binary);
+                if (!file.write(message.data(), static_cast<std::streamsize>(message.size()))) {
+                    std::cerr << "logit-unique-extract: failed to write " << path << std::endl;
+                    status = 1;
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "logit-unique-extract: " << e.what() << std::endl;
+            status = 1;
+        }
+    }
+    std::cout.flush();
+    return status;
+}
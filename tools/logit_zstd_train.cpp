@@ -0,0 +1,127 @@
+/// \file logit_zstd_train.cpp
+/// \brief Command line tool that trains a zstd dictionary on existing log files.
+///
+/// Usage:
+/// \code
+/// logit-zstd-train [-s DICT_BYTES] [-b SAMPLE_BYTES] [-o OUTPUT] PATH...
+/// \endcode
+///
+/// - `PATH` a log file or a directory; directories contribute all uncompressed `.log` files below them.
+/// - `-s DICT_BYTES` maximal dictionary size (default: 112640).
+/// - `-b SAMPLE_BYTES` size of the training samples cut from large files (default: 4096).
+/// - `-o OUTPUT` output file (default: `LOGIT_ZSTD_DICTIONARY_NAME` beside the first input).
+///
+/// Point `FileLogger::Config::compress_dictionary` or `UniqueFileLogger::Config::compress_dictionary`
+/// at the output to compress new files with the dictionary.
+
+#include <logit.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [-s DICT_BYTES] [-b SAMPLE_BYTES] [-o OUTPUT] PATH..." << std::endl
+              << "  -s DICT_BYTES    maximal dictionary size (default: " << logit::kZstdDictionaryDefaultSize << ")" << std::endl
+              << "  -b SAMPLE_BYTES  sample size for large files (default: 4096)" << std::endl
+              << "  -o OUTPUT        output file (default: " << LOGIT_ZSTD_DICTIONARY_NAME << " beside the first PATH)" << std::endl;
+}
+
+bool is_directory(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR;
+}
+
+bool ends_with(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() &&
+           value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string parent_directory(const std::string& path) {
+    const size_t pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? std::string(".") : path.substr(0, pos);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t dict_bytes = logit::kZstdDictionaryDefaultSize;
+    size_t sample_bytes = 4096;
+    std::string output;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "-s" || arg == "--size") && i + 1 < argc) {
+            dict_bytes = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if ((arg == "-b" || arg == "--sample") && i + 1 < argc) {
+            sample_bytes = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            print_usage(argv[0]);
+            return 2;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty() || dict_bytes == 0 || sample_bytes == 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    if (output.empty()) {
+        const std::string base = is_directory(paths[0]) ? paths[0] : parent_directory(paths[0]);
+        output = base + "/" + LOGIT_ZSTD_DICTIONARY_NAME;
+    }
+
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        if (!is_directory(path)) {
+            files.push_back(path);
+            continue;
+        }
+        for (const auto& file : logit::get_list_files(path)) {
+            if (ends_with(file, ".log")) files.push_back(file);
+        }
+    }
+
+    std::vector<std::string> samples;
+    uint64_t total = 0;
+    for (const auto& file : files) {
+        std::ifstream in(file.c_str(), std::ios::binary);
+        if (!in) {
+            std::cerr << "logit-zstd-train: cannot read " << file << std::endl;
+            continue;
+        }
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        logit::split_dictionary_samples(content, sample_bytes, samples);
+        total += content.size();
+    }
+
+    try {
+        const std::string dictionary = logit::train_zstd_dictionary(samples, dict_bytes);
+        std::ofstream out(output.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(dictionary.data(), static_cast<std::streamsize>(dictionary.size()));
+        out.close();
+        if (!out) {
+            std::cerr << "logit-zstd-train: cannot write " << output << std::endl;
+            return 1;
+        }
+        const logit::ZstdDictionary loaded(dictionary, 3);
+        std::cout << output << ": " << dictionary.size() << " bytes, id " << loaded.id()
+                  << ", trained on " << samples.size() << " samples (" << total << " bytes) from "
+                  << files.size() << " files" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "logit-zstd-train: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}